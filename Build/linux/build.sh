@@ -112,6 +112,8 @@ For each enable-*, there is a disable-* option, and vice versa.
 -v, --verbose, verbose  Print out commands
     --minimal-build,    Enable minimal build
     minimal-build
+    --lockfree-fifo,    Use lock-free queues between the pipeline stages
+    lockfree-fifo
     --external-cpuinfo,
     external-cpuinfo    Use external cpuinfo library
 
@@ -354,6 +356,7 @@ parse_options() {
             ;;
         verbose) CMAKE_EXTRA_FLAGS="$CMAKE_EXTRA_FLAGS -DCMAKE_VERBOSE_MAKEFILE=1" && shift ;;
         minimal-build) CMAKE_EXTRA_FLAGS="$CMAKE_EXTRA_FLAGS -DMINIMAL_BUILD=ON" && shift ;;
+        lockfree-fifo) CMAKE_EXTRA_FLAGS="$CMAKE_EXTRA_FLAGS -DSVT_AV1_LOCKFREE_FIFO=ON" && shift ;;
         external-cpuinfo) CMAKE_EXTRA_FLAGS="$CMAKE_EXTRA_FLAGS -DUSE_EXTERNAL_CPUINFO=ON" && shift ;;
         *) print_message "Unknown option: $1" && shift ;;
         esac
@@ -397,6 +400,7 @@ else
             test) parse_options tests && shift ;;
             verbose) parse_options verbose && shift ;;
             minimal-build) parse_options minimal-build && shift ;;
+            lockfree-fifo) parse_options lockfree-fifo && shift ;;
             external-cpuinfo) parse_options external-cpuinfo && shift ;;
             asm | bindir | cc | cxx | gen | jobs | pgo-dir | pgo-videos | prefix | sanitizer | target_system | android-ndk)
                 parse_equal_option "$1" "$2"
@@ -520,6 +524,7 @@ else
             toolchain=*) parse_options toolchain="${1#*=}" && shift ;;
             verbose) parse_options verbose && shift ;;
             minimal-build) parse_options minimal-build && shift ;;
+            lockfree-fifo) parse_options lockfree-fifo && shift ;;
             external-cpuinfo) parse_options external-cpuinfo && shift ;;
             end) ${IN_SCRIPT:-false} && exit ;;
             *) die "Error, unknown option: $1" ;;
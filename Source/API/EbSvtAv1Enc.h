@@ -18,6 +18,7 @@ extern "C" {
 
 #include <stdint.h>
 #include "EbSvtAv1.h"
+#include "EbSvtAv1ExtFrameBuf.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -153,6 +154,23 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    /* EbSvtIOFormat: layout of the input pictures the encoder can reference in place
+     * (see zero_copy_input). width x height is the luma plane including the org_x/org_y
+     * padding around the picture; the planes passed in luma/cb/cr must use these strides
+     * and have the padding addressable around them. Available after svt_av1_enc_init(). */
+    SVT_AV1_STREAM_INFO_INPUT_LAYOUT,
+    /* SvtAv1PipelineProfile: busy and blocked time of every kernel thread and the
+     * per-picture task trace, collected when pipeline_profile is set. */
+    SVT_AV1_STREAM_INFO_PIPELINE_PROFILE,
+    /* SvtAv1MemoryUsage: memory allocated by the encoder per allocation type,
+     * available after svt_av1_enc_init(). */
+    SVT_AV1_STREAM_INFO_MEMORY_USAGE,
+    /* SvtAv1FixedBuf: the first pass stats entries completed since the previous query,
+     * in frame order, to append to the stats while the first pass runs. The first query
+     * starts with a SvtAv1StatsHeader with entry_count 0, and after the EOS packet the
+     * last query returns the rest, ending with the totals entry. The buffer is owned by
+     * the encoder and valid until the next query. */
+    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
@@ -166,6 +184,77 @@ typedef struct SvtAv1FixedBuf {
     uint64_t sz; /**< Length of the buffer, in chars */
 } SvtAv1FixedBuf; /**< alias for struct aom_fixed_buf */
 
+#define SVT_AV1_STATS_MAGIC "SVTS"
+#define SVT_AV1_STATS_VERSION 1
+
+/*!\brief Header of the multi-pass stats
+ *
+ * rc_stats_buffer holds the first pass stats entries, ending with the totals entry,
+ * either bare or after this header. With the header the final pass checks the stats
+ * were written by a compatible encoder and uses the entries in place, so a stats
+ * file can be memory mapped privately rather than read: the entries are modified
+ * while the final pass is set up. The entries start header_size bytes in, a multiple
+ * of 64, and entry_count 0 means they run to the end of the buffer, as when the
+ * stats were appended while the first pass ran and the header was not updated.
+ */
+typedef struct SvtAv1StatsHeader {
+    char     magic[4]; /**< SVT_AV1_STATS_MAGIC, not nul terminated */
+    uint32_t version; /**< SVT_AV1_STATS_VERSION of the encoder which wrote the stats */
+    uint32_t entry_size; /**< Size of one entry, in chars */
+    uint32_t header_size; /**< Offset of the first entry, in chars */
+    uint64_t entry_count; /**< Number of entries including the totals, 0 if not known */
+    uint8_t  reserved[40];
+} SvtAv1StatsHeader;
+
+/*!\brief Pipeline profile of one kernel thread */
+typedef struct SvtAv1ThreadProfile {
+    const char *stage; /**< Kernel name, e.g. "motion_estimation" */
+    uint32_t    thread_index; /**< Index of the thread within its kernel */
+    uint64_t    task_count; /**< Number of input objects processed */
+    uint64_t    busy_us; /**< Time spent processing input objects, in microseconds */
+    uint64_t    wait_us; /**< Time blocked waiting for an input object, in microseconds */
+} SvtAv1ThreadProfile;
+
+/*!\brief One input object processed by a kernel thread */
+typedef struct SvtAv1PipelineEvent {
+    uint32_t thread; /**< Index of the thread in SvtAv1PipelineProfile.threads */
+    uint64_t picture_number; /**< Picture the task belongs to, UINT64_MAX if not known */
+    uint64_t start_us; /**< Stage enter time, in microseconds since svt_av1_enc_init() */
+    uint64_t end_us; /**< Stage exit time, in microseconds since svt_av1_enc_init() */
+} SvtAv1PipelineEvent;
+
+/*!\brief Pipeline profile returned by SVT_AV1_STREAM_INFO_PIPELINE_PROFILE
+ *
+ * The arrays are owned by the encoder and are valid until the next query or
+ * svt_av1_enc_deinit(). Query after the EOS packet for complete figures.
+ * The thread counters cover the whole encode, the events are the last 65536
+ * tasks, oldest first.
+ */
+typedef struct SvtAv1PipelineProfile {
+    uint32_t                   thread_count;
+    const SvtAv1ThreadProfile *threads;
+    uint64_t                   event_count;
+    const SvtAv1PipelineEvent *events;
+} SvtAv1PipelineProfile;
+
+/*!\brief Memory usage returned by SVT_AV1_STREAM_INFO_MEMORY_USAGE
+ *
+ * Memory the encoder holds when queried: what svt_av1_enc_set_parameter(),
+ * svt_av1_enc_init(), the threads of the encoder and svt_av1_enc_send_picture()
+ * allocated and did not free yet, including the buffers allocated while encoding
+ * such as the sub-pel planes cached by the references and the bitstream buffers
+ * not yet released by svt_av1_enc_release_out_buffer().
+ */
+typedef struct SvtAv1MemoryUsage {
+    uint64_t total_bytes; /**< malloc_bytes + calloc_bytes + aligned_bytes */
+    uint64_t malloc_bytes; /**< Bytes allocated with malloc */
+    uint64_t calloc_bytes; /**< Bytes allocated with calloc */
+    uint64_t aligned_bytes; /**< Bytes allocated aligned */
+    uint32_t mutex_count;
+    uint32_t semaphore_count;
+    uint32_t thread_count;
+} SvtAv1MemoryUsage;
+
 /** Indicates how an S-Frame should be inserted.
 */
 typedef enum EbSFrameMode {
@@ -589,7 +678,8 @@ typedef struct EbSvtAv1EncConfiguration {
      */
     int64_t maximum_buffer_size_ms;
 
-    // input / output buffer to be used for multi-pass encoding
+    // input / output buffer to be used for multi-pass encoding, optionally starting
+    // with a SvtAv1StatsHeader
     SvtAv1FixedBuf rc_stats_buffer;
     int            pass;
 
@@ -831,6 +921,9 @@ typedef struct EbSvtAv1EncConfiguration {
      *  0 = Socket 0.
      *  1 = Socket 1.
      *
+     * When a socket is set, the picture pools are allocated from a thread bound to
+     * that socket so their memory is placed on the socket's NUMA node.
+     *
      * Default is -1. */
     int32_t target_socket;
 
@@ -1094,11 +1187,81 @@ typedef struct EbSvtAv1EncConfiguration {
      */
     Bool spy_rd;
 
+    /* @brief Adaptive threading. Every pipeline stage gets up to one thread per
+     * available core and the stages share one worker token per core: a thread
+     * only runs while it holds a token and gives it back whenever it waits on a
+     * queue, so the cores follow the stages that have work queued instead of the
+     * fixed per-stage thread counts selected by level_of_parallelism.
+     * Uses more memory than the fixed thread counts.
+     * Default is 0 */
+    Bool adaptive_threading;
+
+    /* @brief Pipeline profiling. Records the busy and blocked time of every kernel
+     * thread and the enter/exit time of each picture in each stage, retrieved with
+     * SVT_AV1_STREAM_INFO_PIPELINE_PROFILE.
+     * Default is 0 */
+    Bool pipeline_profile;
+
+    /* @brief Reference the input pictures in place instead of copying them
+     * 0: copy every input picture into an encoder-owned buffer
+     * 1: read the caller's planes directly. The encoder pads and temporally filters
+     *    the planes in place, so they must stay allocated and must not be modified
+     *    until release_input_frame is called for the picture. Only 8-bit pictures
+     *    laid out as reported by SVT_AV1_STREAM_INFO_INPUT_LAYOUT are referenced;
+     *    any other picture is copied and released before svt_av1_enc_send_picture()
+     *    returns.
+     * Default is 0 */
+    Bool zero_copy_input;
+
+    /* @brief Parallel segments. The input is cut in segments of
+     * intra_period_length + 1 pictures, and N encoders encode every Nth
+     * segment concurrently behind this handle. Every segment is encoded as a
+     * standalone stream, the encoder is reset between its segments.
+     * svt_av1_enc_get_packet() still returns the packets in input order.
+     * Each encoder allocates its own picture buffers; with adaptive_threading
+     * the encoders share one worker token per core.
+     * Requires a single pass random access encode without recon output and
+     * a key frame interval (intra_period_length != -1), not supported with CBR.
+     * 0 or 1: one encoder
+     * Default is 0 */
+    uint32_t parallel_segments;
+
+    /* @brief Called when the encoder no longer uses an input picture sent with
+     * zero_copy_input set. fb->buffer is the p_buffer of the EbBufferHeaderType given
+     * to svt_av1_enc_send_picture(), fb->buffer_size its n_filled_len and
+     * fb->private_data is release_input_frame_private. The callback runs on an encoder
+     * thread and must not call back into the encoder.
+     * Default is NULL */
+    // Kept 8-byte aligned by the fields above: the padding below assumes no alignment hole
+    EbReleaseFrameBuffer release_input_frame;
+    void                *release_input_frame_private;
+
+    /* @brief Memory budget in MB. The sub-pel planes cached by the references are
+     * dropped first, then the picture pools are shrunk, first the extra mini-gops
+     * buffered ahead of picture management and then the pictures coded in parallel,
+     * until their footprint fits. The footprint is measured by allocating one object
+     * of each pool; the kernel contexts and the sequence level buffers, which do not
+     * change with the pool sizes, are only checked once svt_av1_enc_init() created
+     * them. SVT_AV1_STREAM_INFO_MEMORY_USAGE reports the memory held. With
+     * parallel_segments the budget is split between the encoders.
+     * 0: no budget
+     * Default is 0 */
+    uint32_t memory_budget_mb;
+
+    /* @brief Back the picture buffers of the encoder pools with transparent 2 MB
+     * huge pages, lowering the TLB misses of motion estimation and compensation.
+     * Linux only, takes effect when transparent huge pages are enabled in madvise or
+     * always mode (/sys/kernel/mm/transparent_hugepage/enabled).
+     * Default is 0 */
+    Bool huge_pages;
+
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
 #if CLN_LP_LVLS
-    uint8_t padding[128 - 4 * sizeof(Bool) - 11 * sizeof(uint8_t) - sizeof(int8_t) - sizeof(uint32_t) - sizeof(double)];
+    uint8_t padding[128 - 8 * sizeof(Bool) - 11 * sizeof(uint8_t) - sizeof(int8_t) - 3 * sizeof(uint32_t) -
+                    sizeof(double) - 2 * sizeof(void *)];
 #else
-    uint8_t padding[128 - 4 * sizeof(Bool) - 11 * sizeof(uint8_t) - sizeof(int8_t) - sizeof(double)];
+    uint8_t padding[128 - 8 * sizeof(Bool) - 11 * sizeof(uint8_t) - sizeof(int8_t) - 2 * sizeof(uint32_t) -
+                    sizeof(double) - 2 * sizeof(void *)];
 #endif
 
 } EbSvtAv1EncConfiguration;
@@ -1205,6 +1368,17 @@ EB_API void svt_av1_enc_release_out_buffer(EbBufferHeaderType **p_buffer);
      * @ *p_buffer           Output buffer. */
 EB_API EbErrorType svt_av1_get_recon(EbComponentType *svt_enc_component, EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Scale a picture with the resize filters of the encoder, e.g. to feed
+     * the encoders of an ABR ladder from one read of the source.
+     * Both pictures use the color format and bit depth of src (16-bit samples above
+     * 8 bits), the sizes are given by their width and height. Available once any
+     * encoder handle has been initialized with svt_av1_enc_init().
+     *
+     * Parameter:
+     * @ *src    Input picture.
+     * @ *dst    Output picture, its planes allocated by the caller. */
+EB_API EbErrorType svt_av1_scale_picture(const EbSvtIOFormat *src, EbSvtIOFormat *dst);
+
 /* OPTIONAL: get stream information
      *
      * Parameter:
@@ -1213,6 +1387,16 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType *svt_enc_component, EbBuffe
      * @ *info         output, the type depends on id */
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *svt_enc_component, uint32_t stream_info_id, void *info);
 
+/* OPTIONAL: Start a new stream with the same configuration, keeping the threads and
+     * buffers of svt_av1_enc_init(). A stream still open is terminated with an EOS and
+     * its remaining packets are discarded. The next picture sent starts the new stream
+     * with a key frame and a new sequence header, as after svt_av1_enc_init().
+     * Only for single pass encoding, and not after a resolution change on the fly.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler. */
+EB_API EbErrorType svt_av1_enc_reset(EbComponentType *svt_enc_component);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -26,6 +26,7 @@
 #else
 #include <unistd.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #endif
 
 #include "app_output_ivf.h"
@@ -41,6 +42,7 @@
 #define COLORH_TOKEN "--color-help"
 #define VERSION_TOKEN "--version"
 #define CHANNEL_NUMBER_TOKEN "--nch"
+#define LADDER_TOKEN "--ladder"
 #define COMMAND_LINE_MAX_SIZE 2048
 #define CONFIG_FILE_TOKEN "-c"
 #define CONFIG_FILE_LONG_TOKEN "--config"
@@ -54,10 +56,12 @@
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
 #define STAT_FILE_TOKEN "--stat-file"
+#define PIPELINE_TRACE_TOKEN "--pipeline-trace"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
 #define BUFFERED_INPUT_TOKEN "--nb"
+#define ZERO_COPY_INPUT_TOKEN "--zero-copy-input"
 #define NO_PROGRESS_TOKEN "--no-progress" // tbd if it should be removed
 #define PROGRESS_TOKEN "--progress"
 #define QP_TOKEN "-q"
@@ -143,6 +147,10 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define ADAPTIVE_THREADING_TOKEN "--adaptive-threading"
+#define PARALLEL_SEGMENTS_TOKEN "--parallel-segments"
+#define MEMORY_BUDGET_TOKEN "--memory-budget"
+#define HUGE_PAGES_TOKEN "--huge-pages"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 
 //double dash
@@ -415,6 +423,10 @@ static EbErrorType set_cfg_qp_file(EbConfig *cfg, const char *token, const char
 static EbErrorType set_cfg_stat_file(EbConfig *cfg, const char *token, const char *value) {
     return open_file(&cfg->stat_file, token, value, "wb");
 }
+static EbErrorType set_cfg_pipeline_trace_file(EbConfig *cfg, const char *token, const char *value) {
+    cfg->config.pipeline_profile = TRUE;
+    return open_file(&cfg->pipeline_trace_file, token, value, "w");
+}
 static EbErrorType set_cfg_roi_map_file(EbConfig *cfg, const char *token, const char *value) {
     return open_file(&cfg->roi_map_file, token, value, "r");
 }
@@ -484,6 +496,12 @@ static EbErrorType set_cfg_frames_to_be_skipped(EbConfig *cfg, const char *token
 static EbErrorType set_buffered_input(EbConfig *cfg, const char *token, const char *value) {
     return str_to_int(token, value, &cfg->buffered_input);
 }
+static EbErrorType set_zero_copy_input(EbConfig *cfg, const char *token, const char *value) {
+    int32_t     zero_copy_input;
+    EbErrorType err      = str_to_int(token, value, &zero_copy_input);
+    cfg->zero_copy_input = err == EB_ErrorNone && zero_copy_input != 0;
+    return err;
+}
 static EbErrorType set_cfg_force_key_frames(EbConfig *cfg, const char *token, const char *value) {
     (void)token;
     struct forced_key_frames fkf;
@@ -704,6 +722,10 @@ ConfigEntry config_entry_options[] = {
      STAT_FILE_TOKEN,
      "PSNR / SSIM per picture stat output file path, requires `--enable-stat-report 1`",
      set_cfg_stat_file},
+    {SINGLE_INPUT,
+     PIPELINE_TRACE_TOKEN,
+     "Pipeline stage trace output file path (Chrome trace JSON), also prints the time each stage is busy",
+     set_cfg_pipeline_trace_file},
 
     {SINGLE_INPUT,
      PROGRESS_TOKEN,
@@ -779,6 +801,11 @@ ConfigEntry config_entry_global_options[] = {
      "Buffer `n` input frames into memory and use them to encode, default is -1 [-1: no frames "
      "buffered, 1-`(2^31)-1`]",
      set_buffered_input},
+    {SINGLE_INPUT,
+     ZERO_COPY_INPUT_TOKEN,
+     "Read the 8-bit input frames into buffers the encoder reads in place instead of copying them, "
+     "default is 0 [0-1]",
+     set_zero_copy_input},
     {SINGLE_INPUT,
      ENCODER_COLOR_FORMAT,
      "Color format, only yuv420 is supported at this time, default is 1 [0: yuv400, 1: yuv420, 2: "
@@ -850,6 +877,25 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     ADAPTIVE_THREADING_TOKEN,
+     "Share one worker per core between the pipeline stages, moving the cores to the stages "
+     "with queued work, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     PARALLEL_SEGMENTS_TOKEN,
+     "Number of independent segments (of --keyint pictures) encoded at the same time, 0 or 1 "
+     "encode the input as one sequence, default is 0 [0-16]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     MEMORY_BUDGET_TOKEN,
+     "Memory budget in MB, lowers the number of pictures buffered and coded in parallel to fit, "
+     "0 is no budget, default is 0 [0-2^32-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     HUGE_PAGES_TOKEN,
+     "Back the picture buffers with transparent 2 MB huge pages (Linux), default is 0 [0-1]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1343,6 +1389,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, OUTPUT_RECON_LONG_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, STAT_FILE_TOKEN, "StatFile", set_cfg_stat_file},
+    {SINGLE_INPUT, PIPELINE_TRACE_TOKEN, "PipelineTraceFile", set_cfg_pipeline_trace_file},
     {SINGLE_INPUT, PROGRESS_TOKEN, "Progress", set_progress},
     {SINGLE_INPUT, NO_PROGRESS_TOKEN, "NoProgress", set_no_progress},
     {SINGLE_INPUT, PRESET_TOKEN, "EncoderMode", set_cfg_generic_token},
@@ -1360,6 +1407,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, NUMBER_OF_PICTURES_LONG_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", set_buffered_input},
+    {SINGLE_INPUT, ZERO_COPY_INPUT_TOKEN, "ZeroCopyInput", set_zero_copy_input},
 
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TO_SKIP, "FrameToBeSkipped", set_cfg_frames_to_be_skipped},
 
@@ -1391,6 +1439,10 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, ADAPTIVE_THREADING_TOKEN, "AdaptiveThreading", set_cfg_generic_token},
+    {SINGLE_INPUT, PARALLEL_SEGMENTS_TOKEN, "ParallelSegments", set_cfg_generic_token},
+    {SINGLE_INPUT, MEMORY_BUDGET_TOKEN, "MemoryBudget", set_cfg_generic_token},
+    {SINGLE_INPUT, HUGE_PAGES_TOKEN, "HugePages", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1579,6 +1631,24 @@ EbConfig *svt_config_ctor() {
     return app_cfg;
 }
 
+/* release config->rc_stats_buffer loaded by load_twopass_stats_in() */
+static void release_twopass_stats_in(EbConfig *cfg) {
+    void *buf = cfg->config.rc_stats_buffer.buf;
+    if (!buf)
+        return;
+    if (cfg->input_stat_map_size) {
+#ifdef _WIN32
+        UnmapViewOfFile(buf);
+#else
+        munmap(buf, cfg->input_stat_map_size);
+#endif
+        cfg->input_stat_map_size = 0;
+    } else
+        free(buf);
+    cfg->config.rc_stats_buffer.buf = NULL;
+    cfg->config.rc_stats_buffer.sz  = 0;
+}
+
 /**********************************
  * Destructor
  **********************************/
@@ -1624,6 +1694,17 @@ void svt_config_dtor(EbConfig *app_cfg) {
         app_cfg->output_stat_file = (FILE *)NULL;
     }
 
+    if (app_cfg->input_stat_file) {
+        release_twopass_stats_in(app_cfg);
+        fclose(app_cfg->input_stat_file);
+        app_cfg->input_stat_file = (FILE *)NULL;
+    }
+
+    if (app_cfg->pipeline_trace_file) {
+        fclose(app_cfg->pipeline_trace_file);
+        app_cfg->pipeline_trace_file = (FILE *)NULL;
+    }
+
     if (app_cfg->roi_map_file) {
         fclose(app_cfg->roi_map_file);
         app_cfg->roi_map_file = (FILE *)NULL;
@@ -1827,6 +1908,27 @@ static EbErrorType read_config_file(EbConfig *app_cfg, const char *config_path,
     return return_error;
 }
 
+/* maps the stats file copy-on-write, the library modifies the entries while it sets up the final pass */
+static void *map_twopass_stats_in(EbConfig *cfg, size_t size) {
+#ifdef _WIN32
+    HANDLE fhandle = (HANDLE)_get_osfhandle(_fileno(cfg->input_stat_file));
+    HANDLE map     = CreateFileMapping(fhandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!map)
+        return NULL;
+    // the view keeps the mapping alive
+    void *base = MapViewOfFile(map, FILE_MAP_COPY, 0, 0, size);
+    CloseHandle(map);
+    return base;
+#else
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(cfg->input_stat_file), 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    // the entries are scanned from the first to the last, when the final pass starts and as it encodes
+    posix_madvise(base, size, POSIX_MADV_SEQUENTIAL);
+    return base;
+#endif
+}
+
 /* get config->rc_stats_buffer from config->input_stat_file */
 Bool load_twopass_stats_in(EbConfig *cfg) {
     EbSvtAv1EncConfiguration *config = &cfg->config;
@@ -1839,22 +1941,26 @@ Bool load_twopass_stats_in(EbConfig *cfg) {
     struct stat file_stat;
     int         ret         = fstat(fd, &file_stat);
 #endif
-    if (ret) {
+    if (ret || file_stat.st_size == 0) {
         return FALSE;
     }
+    config->rc_stats_buffer.sz  = (uint64_t)file_stat.st_size;
+    config->rc_stats_buffer.buf = map_twopass_stats_in(cfg, file_stat.st_size);
+    if (config->rc_stats_buffer.buf) {
+        cfg->input_stat_map_size = (uint64_t)file_stat.st_size;
+        return TRUE;
+    }
+    // read it when it can't be mapped
     config->rc_stats_buffer.buf = malloc(file_stat.st_size);
     if (config->rc_stats_buffer.buf) {
-        config->rc_stats_buffer.sz = (uint64_t)file_stat.st_size;
         if (fread(config->rc_stats_buffer.buf, 1, file_stat.st_size, cfg->input_stat_file) !=
             (size_t)file_stat.st_size) {
             return FALSE;
         }
-        if (file_stat.st_size == 0) {
-            return FALSE;
-        }
     }
     return config->rc_stats_buffer.buf != NULL;
 }
+
 EbErrorType handle_stats_file(EbConfig *app_cfg, EncPass enc_pass, const SvtAv1FixedBuf *rc_stats_buffer,
                               uint32_t channel_number) {
     switch (enc_pass) {
@@ -1925,7 +2031,7 @@ static EbErrorType app_verify_config(EbConfig *app_cfg, uint32_t channel_number)
     EbErrorType return_error = EB_ErrorNone;
 
     // Check Input File
-    if (app_cfg->input_file == (FILE *)NULL) {
+    if (app_cfg->input_file == (FILE *)NULL && !app_cfg->ladder_source) {
         fprintf(app_cfg->error_log_file, "Error instance %u: Invalid Input File\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -1965,6 +2071,15 @@ static EbErrorType app_verify_config(EbConfig *app_cfg, uint32_t channel_number)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (app_cfg->zero_copy_input &&
+        (app_cfg->buffered_input != -1 || app_cfg->ladder || app_cfg->config.encoder_bit_depth > 8)) {
+        fprintf(app_cfg->error_log_file,
+                "Error instance %u: Zero-copy input needs 8-bit input and is not available with buffered "
+                "input or the ladder mode\n",
+                channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (app_cfg->config.use_qp_file == TRUE && app_cfg->qp_file == NULL) {
         fprintf(app_cfg->error_log_file,
                 "Error instance %u: Could not find QP file, UseQpFile is set to 1\n",
@@ -2805,6 +2920,60 @@ fail:
 /******************************************
 * Read Command Line
 ******************************************/
+/******************************************************
+* Ladder mode: instance 1 reads the source and the other instances are
+* rungs encoding its pictures at their own -w / -h (the source size when
+* not given). A rung takes the input properties of the source. Only the
+* read and the scaling of the source are shared: each rung is a separate
+* library instance running its own analysis and scene change detection.
+******************************************************/
+static EbErrorType set_ladder_rungs(EncChannel *channels, uint32_t num_channels) {
+    EbConfig *source = channels[0].app_cfg;
+    if (num_channels < 2) {
+        fprintf(stderr, "[SVT-Error]: %s needs at least two channels\n", LADDER_TOKEN);
+        return EB_ErrorBadParameter;
+    }
+    source->ladder         = true;
+    source->ladder_picture = source;
+    for (uint32_t index = 1; index < num_channels; ++index) {
+        EbConfig *cfg = channels[index].app_cfg;
+        if (cfg->input_file || cfg->buffered_input != -1 || cfg->frames_to_be_skipped) {
+            fprintf(cfg->error_log_file,
+                    "Error instance %u: A ladder rung takes its input from instance 1\n",
+                    index + 1);
+            return EB_ErrorBadParameter;
+        }
+        if (!cfg->config.source_width)
+            cfg->config.source_width = source->config.source_width;
+        if (!cfg->config.source_height)
+            cfg->config.source_height = source->config.source_height;
+        if (cfg->config.source_width > source->config.source_width ||
+            cfg->config.source_height > source->config.source_height) {
+            fprintf(cfg->error_log_file,
+                    "Error instance %u: A ladder rung cannot be larger than the source\n",
+                    index + 1);
+            return EB_ErrorBadParameter;
+        }
+        cfg->config.encoder_bit_depth      = source->config.encoder_bit_depth;
+        cfg->config.encoder_color_format   = source->config.encoder_color_format;
+        cfg->config.frame_rate_numerator   = source->config.frame_rate_numerator;
+        cfg->config.frame_rate_denominator = source->config.frame_rate_denominator;
+        cfg->ladder                        = true;
+        cfg->ladder_source                 = source;
+        cfg->ladder_picture                = cfg;
+        // Scale the source once per resolution
+        for (uint32_t prev = 0; prev < index; ++prev) {
+            EbConfig *prev_cfg = channels[prev].app_cfg;
+            if (prev_cfg->config.source_width == cfg->config.source_width &&
+                prev_cfg->config.source_height == cfg->config.source_height) {
+                cfg->ladder_picture = prev_cfg->ladder_picture;
+                break;
+            }
+        }
+    }
+    return EB_ErrorNone;
+}
+
 EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *channels, uint32_t num_channels) {
     EbErrorType return_error = EB_ErrorNone;
     char        config_string[COMMAND_LINE_MAX_SIZE]; // for one input options
@@ -2831,9 +3000,11 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         }
     }
 
-    // First handle --nch and --passes as a single argument options
+    // First handle --nch, --passes and --ladder as a single argument options
     find_token_multiple_inputs(1, argc, argv, CHANNEL_NUMBER_TOKEN, config_strings, cmd_copy, arg_copy);
     find_token_multiple_inputs(1, argc, argv, PASSES_TOKEN, config_strings, cmd_copy, arg_copy);
+    const bool ladder = find_token_multiple_inputs(1, argc, argv, LADDER_TOKEN, config_strings, cmd_copy, arg_copy) &&
+        strtol(config_strings[0], NULL, 0) != 0;
 
     /***************************************************************************************************/
     /****************  Find configuration files tokens and call respective functions  ******************/
@@ -2949,6 +3120,11 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         }
     }
 
+    if (ladder && set_ladder_rungs(channels, num_channels) != EB_ErrorNone) {
+        free_config_strings(num_channels, config_strings);
+        return EB_ErrorBadParameter;
+    }
+
     /***************************************************************************************************/
     /**************************************   Verify configuration parameters   ************************/
     /***************************************************************************************************/
@@ -2976,10 +3152,13 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
                 // Assuming no errors, set the frames to be encoded to the number of frames in the input yuv
                 if (c->return_error == EB_ErrorNone && !n_specified)
                     app_cfg->frames_to_be_encoded = input_frame_count - app_cfg->frames_to_be_skipped;
+                // A ladder rung encodes every frame read by the source
+                if (app_cfg->ladder_source)
+                    app_cfg->frames_to_be_encoded = app_cfg->ladder_source->frames_to_be_encoded;
 
                 // For pipe input it is fine if we have -1 here (we will update on end of stream)
                 if (app_cfg->frames_to_be_encoded == -1 && app_cfg->input_file != stdin &&
-                    !app_cfg->input_file_is_fifo) {
+                    !app_cfg->input_file_is_fifo && !app_cfg->ladder_source) {
                     fprintf(app_cfg->error_log_file,
                             "Error instance %u: Input yuv does not contain enough frames \n",
                             index + 1);
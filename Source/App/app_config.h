@@ -71,6 +71,7 @@ typedef struct EbPerformanceContext {
 
     double total_execution_time; // includes init
     double total_encode_time; // not including init
+    double total_init_time; // svt_av1_enc_init() and the setup before it
 
     uint64_t total_latency;
     uint32_t max_latency;
@@ -96,6 +97,9 @@ typedef struct EbPerformanceContext {
 
     uint64_t sum_qp;
 
+    uint64_t input_wait_us; // time waiting for the reader thread
+    uint64_t output_wait_us; // time waiting for the writer thread
+
 } EbPerformanceContext;
 
 typedef struct MemMapFile {
@@ -131,13 +135,17 @@ typedef struct EbConfig {
     FILE      *recon_file;
     FILE      *error_log_file;
     FILE      *stat_file;
+    FILE      *pipeline_trace_file;
     FILE      *qp_file;
     /* two pass */
-    const char *stats;
-    FILE       *input_stat_file;
-    FILE       *output_stat_file;
-    Bool        y4m_input;
-    char        y4m_buf[9];
+    const char       *stats;
+    FILE             *input_stat_file;
+    FILE             *output_stat_file;
+    uint64_t          output_stat_size; // bytes appended to output_stat_file
+    SvtAv1StatsHeader output_stat_header;
+    uint64_t          input_stat_map_size; // rc_stats_buffer maps input_stat_file when not 0
+    Bool              y4m_input;
+    char              y4m_buf[9];
 
     uint8_t progress; // 0 = no progress output, 1 = normal, 2 = aomenc style verbose progress
     /****************************************
@@ -199,6 +207,33 @@ typedef struct EbConfig {
 #endif
 
     char *fgs_table_path;
+
+    /****************************************
+     * Ladder mode: the source channel reads the input once and every
+     * rung encodes its pictures scaled to the rung resolution, the
+     * analysis of the pictures is not shared between the channels
+     ****************************************/
+    bool ladder; // set on the source and on the rungs
+    // Source channel of a rung, NULL for the source itself
+    struct EbConfig *ladder_source;
+    // Channel whose input buffer holds the pictures of a rung: the rung itself when
+    // it scales them, else the source or an earlier rung of the same resolution
+    struct EbConfig *ladder_picture;
+
+    /****************************************
+     * I/O threads: the input is read and the output written on their own
+     * threads so the encoder does not wait for a pipe
+     ****************************************/
+    bool              read_ahead; // fread input, the reader is started after the skipped frames
+    struct AppReader *reader;
+    struct AppWriter *writer;
+
+    /****************************************
+     * Zero-copy input: the frames are read into buffers laid out as the
+     * input buffers of the encoder, which reads them in place
+     ****************************************/
+    bool                 zero_copy_input;
+    struct AppFramePool *frame_pool;
 } EbConfig;
 
 typedef struct EncChannel {
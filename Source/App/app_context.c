@@ -21,6 +21,7 @@
 #include "EbSvtAv1.h"
 #include "app_context.h"
 #include "app_config.h"
+#include "app_io_thread.h"
 #if DEBUG_ROI
 #include <inttypes.h>
 #endif
@@ -78,6 +79,13 @@ static EbErrorType allocate_frame_buffer(EbConfig *app_cfg, EbSvtIOFormat *input
     return EB_ErrorNone;
 }
 
+// The input pictures are read or scaled into a buffer of the channel, except with buffered,
+// memory mapped or zero-copy input and for the ladder rungs using the pictures of another channel
+static bool has_frame_buffer(const EbConfig *app_cfg) {
+    return app_cfg->buffered_input == -1 && !app_cfg->mmap.enable && !app_cfg->zero_copy_input &&
+        (!app_cfg->ladder_source || app_cfg->ladder_picture == app_cfg);
+}
+
 static EbErrorType allocate_input_buffers(EbConfig *app_cfg) {
     app_cfg->input_buffer_pool = malloc(sizeof(EbBufferHeaderType));
     if (app_cfg->input_buffer_pool == NULL)
@@ -86,14 +94,21 @@ static EbErrorType allocate_input_buffers(EbConfig *app_cfg) {
     // Initialize Header
     app_cfg->input_buffer_pool->size = sizeof(EbBufferHeaderType);
 
+    // A zero-copy channel sends the frames of its pool
+    if (app_cfg->zero_copy_input) {
+        app_cfg->input_buffer_pool->p_buffer      = NULL;
+        app_cfg->input_buffer_pool->p_app_private = NULL;
+        app_cfg->input_buffer_pool->pic_type      = EB_AV1_INVALID_PICTURE;
+        return EB_ErrorNone;
+    }
+
     EbSvtIOFormat *p_buffer = malloc(sizeof(EbSvtIOFormat));
 
     if (p_buffer == NULL)
         return EB_ErrorInsufficientResources;
 
     // Allocate frame buffer for the p_buffer
-    if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable &&
-        allocate_frame_buffer(app_cfg, p_buffer) != EB_ErrorNone) {
+    if (has_frame_buffer(app_cfg) && allocate_frame_buffer(app_cfg, p_buffer) != EB_ErrorNone) {
         free(p_buffer);
         free(app_cfg->input_buffer_pool);
         app_cfg->input_buffer_pool = NULL;
@@ -368,7 +383,7 @@ fail:
 static void deallocate_buffers(EbConfig *app_cfg) {
     // Deallocate input buffers
     if (app_cfg->input_buffer_pool) {
-        if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable) {
+        if (has_frame_buffer(app_cfg)) {
             EbSvtIOFormat *input_ptr = (EbSvtIOFormat *)app_cfg->input_buffer_pool->p_buffer;
             if (input_ptr) {
                 free(input_ptr->luma);
@@ -380,6 +395,12 @@ static void deallocate_buffers(EbConfig *app_cfg) {
         free(app_cfg->input_buffer_pool);
     }
 
+    // The encoder is deinitialized, it holds no frame of the pool
+    if (app_cfg->frame_pool) {
+        app_frame_pool_close(app_cfg->frame_pool);
+        app_cfg->frame_pool = NULL;
+    }
+
     // Deallocate output recon buffers
     if (app_cfg->recon_buffer) {
         free(app_cfg->recon_buffer->p_buffer);
@@ -414,6 +435,16 @@ EbErrorType init_encoder(EbConfig *app_cfg, uint32_t instance_idx) {
         }
     }
 
+    if (app_cfg->zero_copy_input) {
+        // The frames are read into buffers of the pool, the encoder gives them back once done
+        app_cfg->frame_pool = app_frame_pool_open();
+        if (!app_cfg->frame_pool)
+            return EB_ErrorInsufficientResources;
+        app_cfg->config.zero_copy_input             = TRUE;
+        app_cfg->config.release_input_frame         = app_frame_pool_release;
+        app_cfg->config.release_input_frame_private = app_cfg->frame_pool;
+    }
+
     // Send over all configuration parameters
     // Set the Parameters
     EbErrorType return_error = svt_av1_enc_set_parameter(app_cfg->svt_encoder_handle, &app_cfg->config);
@@ -426,6 +457,11 @@ EbErrorType init_encoder(EbConfig *app_cfg, uint32_t instance_idx) {
     if (return_error != EB_ErrorNone) {
         return return_error;
     }
+    if (app_cfg->frame_pool) {
+        return_error = app_frame_pool_set_layout(app_cfg->frame_pool, app_cfg->svt_encoder_handle);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
 
     ///************************* LIBRARY INIT [END] *********************///
 
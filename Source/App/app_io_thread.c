@@ -0,0 +1,454 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "app_io_thread.h"
+#include "app_output_ivf.h"
+#include "svt_time.h"
+
+/***************************************
+ * Thread, lock and condition of the I/O threads
+ ***************************************/
+#ifdef _WIN32
+typedef HANDLE             AppThread;
+typedef CRITICAL_SECTION   AppMutex;
+typedef CONDITION_VARIABLE AppCond;
+
+static bool app_thread_create(AppThread *thread, DWORD(WINAPI *fn)(LPVOID), void *arg) {
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread != NULL;
+}
+static void app_thread_join(AppThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#define APP_THREAD_FN(name, arg) static DWORD WINAPI name(LPVOID arg)
+#define APP_THREAD_RETURN return 0
+static void app_mutex_init(AppMutex *m) { InitializeCriticalSection(m); }
+static void app_mutex_destroy(AppMutex *m) { DeleteCriticalSection(m); }
+static void app_mutex_lock(AppMutex *m) { EnterCriticalSection(m); }
+static void app_mutex_unlock(AppMutex *m) { LeaveCriticalSection(m); }
+static void app_cond_init(AppCond *c) { InitializeConditionVariable(c); }
+static void app_cond_destroy(AppCond *c) { (void)c; }
+static void app_cond_wait(AppCond *c, AppMutex *m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void app_cond_signal(AppCond *c) { WakeConditionVariable(c); }
+#else
+typedef pthread_t       AppThread;
+typedef pthread_mutex_t AppMutex;
+typedef pthread_cond_t  AppCond;
+
+static bool app_thread_create(AppThread *thread, void *(*fn)(void *), void *arg) {
+    return !pthread_create(thread, NULL, fn, arg);
+}
+static void app_thread_join(AppThread thread) { pthread_join(thread, NULL); }
+#define APP_THREAD_FN(name, arg) static void *name(void *arg)
+#define APP_THREAD_RETURN return NULL
+static void app_mutex_init(AppMutex *m) { pthread_mutex_init(m, NULL); }
+static void app_mutex_destroy(AppMutex *m) { pthread_mutex_destroy(m); }
+static void app_mutex_lock(AppMutex *m) { pthread_mutex_lock(m); }
+static void app_mutex_unlock(AppMutex *m) { pthread_mutex_unlock(m); }
+static void app_cond_init(AppCond *c) { pthread_cond_init(c, NULL); }
+static void app_cond_destroy(AppCond *c) { pthread_cond_destroy(c); }
+static void app_cond_wait(AppCond *c, AppMutex *m) { pthread_cond_wait(c, m); }
+static void app_cond_signal(AppCond *c) { pthread_cond_signal(c); }
+#endif
+
+static uint64_t app_time_us(void) {
+    uint64_t s, us;
+    app_svt_av1_get_time(&s, &us);
+    return s * 1000000 + us;
+}
+
+/***************************************
+ * Reader
+ ***************************************/
+typedef struct AppFrame {
+    EbBufferHeaderType header;
+    EbSvtIOFormat      picture;
+    uint8_t           *buffer;
+    bool               end; // last entry of a piped input
+} AppFrame;
+
+struct AppReader {
+    EbConfig    *app_cfg;
+    uint8_t      is_16bit;
+    uint64_t     frame_limit;
+    AppReadFrame read_frame;
+
+    // planes of the input buffer of the channel, given back on close
+    EbSvtIOFormat own_picture;
+
+    AppFrame *frames;
+    uint32_t  depth;
+    uint32_t  head; // frame held by the encoder, or next one to give it
+    uint32_t  count; // frames read and not released yet, the held one included
+    bool      held;
+    bool      done; // set by the reader once it read its last frame
+    bool      quit;
+
+    AppMutex  mutex;
+    AppCond   filled;
+    AppCond   released;
+    AppThread thread;
+};
+
+APP_THREAD_FN(app_reader_kernel, arg) {
+    AppReader *reader = (AppReader *)arg;
+    for (uint64_t frame_idx = 0; !reader->frame_limit || frame_idx < reader->frame_limit; frame_idx++) {
+        app_mutex_lock(&reader->mutex);
+        while (reader->count == reader->depth && !reader->quit) app_cond_wait(&reader->released, &reader->mutex);
+        const bool quit  = reader->quit;
+        AppFrame  *frame = &reader->frames[(reader->head + reader->count) % reader->depth];
+        app_mutex_unlock(&reader->mutex);
+        if (quit)
+            break;
+
+        // the entry is only seen by the encoder once counted, so it is read without the lock
+        frame->end = !reader->read_frame(reader->app_cfg, reader->is_16bit, &frame->header, frame_idx == 0);
+
+        app_mutex_lock(&reader->mutex);
+        reader->count++;
+        app_cond_signal(&reader->filled);
+        app_mutex_unlock(&reader->mutex);
+        if (frame->end)
+            break;
+    }
+    app_mutex_lock(&reader->mutex);
+    reader->done = true;
+    app_cond_signal(&reader->filled);
+    app_mutex_unlock(&reader->mutex);
+    APP_THREAD_RETURN;
+}
+
+AppReader *app_reader_open(EbConfig *app_cfg, uint8_t is_16bit, uint32_t depth, uint64_t frame_limit,
+                           AppReadFrame read_frame) {
+    const uint8_t color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subsampling_y = ((color_format == EB_YUV444 || color_format == EB_YUV422) ? 1 : 2) - 1;
+    const size_t  luma_size     = (size_t)app_cfg->input_padded_width * app_cfg->input_padded_height << is_16bit;
+    const size_t  chroma_size   = ((size_t)(app_cfg->input_padded_width + subsampling_x) >> subsampling_x) *
+        ((app_cfg->input_padded_height + subsampling_y) >> subsampling_y) << is_16bit;
+
+    AppReader *reader = calloc(1, sizeof(*reader));
+    if (!reader)
+        return NULL;
+    reader->app_cfg     = app_cfg;
+    reader->is_16bit    = is_16bit;
+    reader->frame_limit = frame_limit;
+    reader->read_frame  = read_frame;
+    reader->own_picture = *(EbSvtIOFormat *)app_cfg->input_buffer_pool->p_buffer;
+    reader->depth       = depth < 2 ? 2 : depth;
+    reader->frames      = calloc(reader->depth, sizeof(*reader->frames));
+    if (!reader->frames) {
+        free(reader);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < reader->depth; i++) {
+        AppFrame *frame = &reader->frames[i];
+        frame->buffer   = malloc(luma_size + 2 * chroma_size);
+        if (!frame->buffer) {
+            while (i--) free(reader->frames[i].buffer);
+            free(reader->frames);
+            free(reader);
+            return NULL;
+        }
+        frame->picture.luma    = frame->buffer;
+        frame->picture.cb      = frame->buffer + luma_size;
+        frame->picture.cr      = frame->buffer + luma_size + chroma_size;
+        frame->header.size     = sizeof(frame->header);
+        frame->header.p_buffer = (uint8_t *)&frame->picture;
+    }
+    app_mutex_init(&reader->mutex);
+    app_cond_init(&reader->filled);
+    app_cond_init(&reader->released);
+    if (!app_thread_create(&reader->thread, app_reader_kernel, reader)) {
+        app_cond_destroy(&reader->released);
+        app_cond_destroy(&reader->filled);
+        app_mutex_destroy(&reader->mutex);
+        for (uint32_t i = 0; i < reader->depth; i++) free(reader->frames[i].buffer);
+        free(reader->frames);
+        free(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+bool app_reader_get(AppReader *reader, EbBufferHeaderType *header_ptr, uint64_t *wait_us) {
+    app_mutex_lock(&reader->mutex);
+    if (reader->held) {
+        reader->head = (reader->head + 1) % reader->depth;
+        reader->count--;
+        reader->held = false;
+        app_cond_signal(&reader->released);
+    }
+    if (!reader->count && !reader->done) {
+        const uint64_t start = app_time_us();
+        while (!reader->count && !reader->done) app_cond_wait(&reader->filled, &reader->mutex);
+        *wait_us += app_time_us() - start;
+    }
+    if (!reader->count) {
+        // past the frame limit
+        app_mutex_unlock(&reader->mutex);
+        header_ptr->n_filled_len = 0;
+        return true;
+    }
+    const AppFrame *frame = &reader->frames[reader->head];
+    reader->held          = true;
+    app_mutex_unlock(&reader->mutex);
+
+    EbSvtIOFormat *input_ptr = (EbSvtIOFormat *)header_ptr->p_buffer;
+    input_ptr->luma          = frame->picture.luma;
+    input_ptr->cb            = frame->picture.cb;
+    input_ptr->cr            = frame->picture.cr;
+    input_ptr->y_stride      = frame->picture.y_stride;
+    input_ptr->cb_stride     = frame->picture.cb_stride;
+    input_ptr->cr_stride     = frame->picture.cr_stride;
+    header_ptr->n_filled_len = frame->header.n_filled_len;
+    return !frame->end;
+}
+
+void app_reader_close(AppReader *reader, EbBufferHeaderType *header_ptr) {
+    app_mutex_lock(&reader->mutex);
+    reader->quit = true;
+    app_cond_signal(&reader->released);
+    app_mutex_unlock(&reader->mutex);
+    app_thread_join(reader->thread);
+
+    *(EbSvtIOFormat *)header_ptr->p_buffer = reader->own_picture;
+    app_cond_destroy(&reader->released);
+    app_cond_destroy(&reader->filled);
+    app_mutex_destroy(&reader->mutex);
+    for (uint32_t i = 0; i < reader->depth; i++) free(reader->frames[i].buffer);
+    free(reader->frames);
+    free(reader);
+}
+
+/***************************************
+ * Writer
+ ***************************************/
+typedef struct AppPacket {
+    EbBufferHeaderType *packet;
+    int32_t             stream_length; // negative when not preceded by the stream header
+} AppPacket;
+
+struct AppWriter {
+    EbConfig *app_cfg;
+
+    AppPacket *packets;
+    uint32_t   depth;
+    uint32_t   head; // next packet to write
+    uint32_t   count;
+    bool       quit;
+
+    AppMutex  mutex;
+    AppCond   queued;
+    AppCond   written;
+    AppThread thread;
+};
+
+APP_THREAD_FN(app_writer_kernel, arg) {
+    AppWriter *writer  = (AppWriter *)arg;
+    EbConfig  *app_cfg = writer->app_cfg;
+    for (;;) {
+        app_mutex_lock(&writer->mutex);
+        while (!writer->count && !writer->quit) app_cond_wait(&writer->queued, &writer->mutex);
+        if (!writer->count) {
+            app_mutex_unlock(&writer->mutex);
+            break;
+        }
+        AppPacket entry = writer->packets[writer->head];
+        app_mutex_unlock(&writer->mutex);
+
+        if (entry.stream_length >= 0)
+            write_ivf_stream_header(app_cfg, entry.stream_length);
+        write_ivf_frame_header(app_cfg, entry.packet->n_filled_len);
+        fwrite(entry.packet->p_buffer, 1, entry.packet->n_filled_len, app_cfg->bitstream_file);
+        svt_av1_enc_release_out_buffer(&entry.packet);
+
+        app_mutex_lock(&writer->mutex);
+        writer->head = (writer->head + 1) % writer->depth;
+        writer->count--;
+        app_cond_signal(&writer->written);
+        app_mutex_unlock(&writer->mutex);
+    }
+    APP_THREAD_RETURN;
+}
+
+AppWriter *app_writer_open(EbConfig *app_cfg, uint32_t depth) {
+    AppWriter *writer = calloc(1, sizeof(*writer));
+    if (!writer)
+        return NULL;
+    writer->app_cfg = app_cfg;
+    writer->depth   = depth ? depth : 1;
+    writer->packets = calloc(writer->depth, sizeof(*writer->packets));
+    if (!writer->packets) {
+        free(writer);
+        return NULL;
+    }
+    app_mutex_init(&writer->mutex);
+    app_cond_init(&writer->queued);
+    app_cond_init(&writer->written);
+    if (!app_thread_create(&writer->thread, app_writer_kernel, writer)) {
+        app_cond_destroy(&writer->written);
+        app_cond_destroy(&writer->queued);
+        app_mutex_destroy(&writer->mutex);
+        free(writer->packets);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+void app_writer_push(AppWriter *writer, EbBufferHeaderType *packet, int32_t stream_length, uint64_t *wait_us) {
+    app_mutex_lock(&writer->mutex);
+    if (writer->count == writer->depth) {
+        const uint64_t start = app_time_us();
+        while (writer->count == writer->depth) app_cond_wait(&writer->written, &writer->mutex);
+        *wait_us += app_time_us() - start;
+    }
+    writer->packets[(writer->head + writer->count) % writer->depth] = (AppPacket){packet, stream_length};
+    writer->count++;
+    app_cond_signal(&writer->queued);
+    app_mutex_unlock(&writer->mutex);
+}
+
+void app_writer_close(AppWriter *writer, uint64_t *wait_us) {
+    const uint64_t start = app_time_us();
+    app_mutex_lock(&writer->mutex);
+    writer->quit = true;
+    app_cond_signal(&writer->queued);
+    app_mutex_unlock(&writer->mutex);
+    app_thread_join(writer->thread);
+    *wait_us += app_time_us() - start;
+
+    app_cond_destroy(&writer->written);
+    app_cond_destroy(&writer->queued);
+    app_mutex_destroy(&writer->mutex);
+    free(writer->packets);
+    free(writer);
+}
+
+/***************************************
+ * Frame pool of the zero-copy input
+ ***************************************/
+typedef struct AppPoolFrame {
+    EbSvtIOFormat        picture; // first, the encoder gives back the picture sent to it
+    uint8_t             *buffer;
+    struct AppPoolFrame *next_free;
+} AppPoolFrame;
+
+struct AppFramePool {
+    EbSvtIOFormat layout;
+    size_t        luma_size;
+    size_t        chroma_size;
+
+    AppPoolFrame **frames; // every frame allocated
+    uint32_t       count;
+    AppPoolFrame  *free_list;
+
+    AppMutex mutex;
+};
+
+// Alignment of the planes, as the encoder allocates its own input buffers
+#define APP_FRAME_ALIGN 64
+
+AppFramePool *app_frame_pool_open(void) {
+    AppFramePool *pool = calloc(1, sizeof(*pool));
+    if (pool)
+        app_mutex_init(&pool->mutex);
+    return pool;
+}
+
+EbErrorType app_frame_pool_set_layout(AppFramePool *pool, EbComponentType *handle) {
+    EbErrorType ret = svt_av1_enc_get_stream_info(handle, SVT_AV1_STREAM_INFO_INPUT_LAYOUT, &pool->layout);
+    if (ret != EB_ErrorNone)
+        return ret;
+    const EbSvtIOFormat *layout        = &pool->layout;
+    const uint8_t        subsampling_y = (layout->color_fmt == EB_YUV444 || layout->color_fmt == EB_YUV422) ? 0 : 1;
+    pool->luma_size                    = (size_t)layout->y_stride * layout->height;
+    pool->chroma_size = (size_t)layout->cb_stride * ((layout->height + subsampling_y) >> subsampling_y);
+    return EB_ErrorNone;
+}
+
+static AppPoolFrame *app_frame_pool_alloc(AppFramePool *pool) {
+    const EbSvtIOFormat *layout        = &pool->layout;
+    const uint8_t        subsampling_x = layout->color_fmt == EB_YUV444 ? 0 : 1;
+    const uint8_t        subsampling_y = (layout->color_fmt == EB_YUV444 || layout->color_fmt == EB_YUV422) ? 0 : 1;
+    const size_t         luma_size     = (pool->luma_size + APP_FRAME_ALIGN - 1) & ~(size_t)(APP_FRAME_ALIGN - 1);
+    const size_t chroma_size = (pool->chroma_size + APP_FRAME_ALIGN - 1) & ~(size_t)(APP_FRAME_ALIGN - 1);
+
+    AppPoolFrame **frames = realloc(pool->frames, (pool->count + 1) * sizeof(*frames));
+    if (!frames)
+        return NULL;
+    pool->frames        = frames;
+    AppPoolFrame *frame = calloc(1, sizeof(*frame));
+    if (!frame)
+        return NULL;
+    frame->buffer = malloc(luma_size + 2 * chroma_size + APP_FRAME_ALIGN - 1);
+    if (!frame->buffer) {
+        free(frame);
+        return NULL;
+    }
+    uint8_t *luma = (uint8_t *)(((uintptr_t)frame->buffer + APP_FRAME_ALIGN - 1) & ~(uintptr_t)(APP_FRAME_ALIGN - 1));
+    uint8_t *cb   = luma + luma_size;
+    uint8_t *cr   = cb + chroma_size;
+    const size_t chroma_offset =
+        (size_t)(layout->org_y >> subsampling_y) * layout->cb_stride + (layout->org_x >> subsampling_x);
+    frame->picture      = *layout;
+    frame->picture.luma = luma + (size_t)layout->org_y * layout->y_stride + layout->org_x;
+    frame->picture.cb   = cb + chroma_offset;
+    frame->picture.cr   = cr + chroma_offset;
+    pool->frames[pool->count++] = frame;
+    return frame;
+}
+
+EbSvtIOFormat *app_frame_pool_get(AppFramePool *pool) {
+    app_mutex_lock(&pool->mutex);
+    AppPoolFrame *frame = pool->free_list;
+    if (frame)
+        pool->free_list = frame->next_free;
+    app_mutex_unlock(&pool->mutex);
+    // the frames held by the encoder are bounded by its input pool
+    if (!frame)
+        frame = app_frame_pool_alloc(pool);
+    return frame ? &frame->picture : NULL;
+}
+
+void app_frame_pool_put(AppFramePool *pool, EbSvtIOFormat *picture) {
+    AppPoolFrame *frame = (AppPoolFrame *)picture;
+    app_mutex_lock(&pool->mutex);
+    frame->next_free = pool->free_list;
+    pool->free_list  = frame;
+    app_mutex_unlock(&pool->mutex);
+}
+
+int app_frame_pool_release(EbExtFrameBuf *fb, void *private_data) {
+    app_frame_pool_put((AppFramePool *)private_data, (EbSvtIOFormat *)fb->buffer);
+    return 0;
+}
+
+void app_frame_pool_close(AppFramePool *pool) {
+    for (uint32_t i = 0; i < pool->count; i++) {
+        free(pool->frames[i]->buffer);
+        free(pool->frames[i]);
+    }
+    free(pool->frames);
+    app_mutex_destroy(&pool->mutex);
+    free(pool);
+}
@@ -0,0 +1,65 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppIoThread_h
+#define EbAppIoThread_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "app_config.h"
+
+/* Reads one frame into the planes of header_ptr and sets its n_filled_len, returns false at
+ * the end of a piped input. first_frame is set for the first frame read from the input. */
+typedef bool (*AppReadFrame)(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr, bool first_frame);
+
+/* Reader thread: reads up to depth - 1 frames ahead of the encoder into a ring of frames, the
+ * frame last given to the encoder being held until the next one is asked for */
+typedef struct AppReader AppReader;
+
+// frame_limit is the number of frames to read at most, 0 when unknown
+AppReader *app_reader_open(EbConfig *app_cfg, uint8_t is_16bit, uint32_t depth, uint64_t frame_limit,
+                           AppReadFrame read_frame);
+/* Points the planes of header_ptr at the next frame and sets its n_filled_len, returns false
+ * at the end of a piped input. The time spent waiting for the reader is added to wait_us. */
+bool app_reader_get(AppReader *reader, EbBufferHeaderType *header_ptr, uint64_t *wait_us);
+// Stops the reader and gives header_ptr its own planes back
+void app_reader_close(AppReader *reader, EbBufferHeaderType *header_ptr);
+
+/* Writer thread: writes the packets to the IVF output in order and releases them */
+typedef struct AppWriter AppWriter;
+
+AppWriter *app_writer_open(EbConfig *app_cfg, uint32_t depth);
+/* Queues a packet, preceded by the IVF stream header when stream_length is not negative. The
+ * writer owns the packet from then on. The time spent waiting for a free entry is added to
+ * wait_us. */
+void app_writer_push(AppWriter *writer, EbBufferHeaderType *packet, int32_t stream_length, uint64_t *wait_us);
+// Writes the queued packets and stops the writer, the time it takes is added to wait_us
+void app_writer_close(AppWriter *writer, uint64_t *wait_us);
+
+/* Frame pool of the zero-copy input: frames laid out as the input buffers of the encoder, which
+ * reads them in place until it gives them back through app_frame_pool_release() */
+typedef struct AppFramePool AppFramePool;
+
+AppFramePool *app_frame_pool_open(void);
+// Takes the layout of the frames from the encoder, once it is initialized
+EbErrorType app_frame_pool_set_layout(AppFramePool *pool, EbComponentType *handle);
+/* Returns a free frame, allocated when the encoder holds all the others, NULL when out of
+ * memory. Its planes and strides are set, the samples are to be read in. */
+EbSvtIOFormat *app_frame_pool_get(AppFramePool *pool);
+// Gives back a frame that was not sent to the encoder
+void app_frame_pool_put(AppFramePool *pool, EbSvtIOFormat *frame);
+// release_input_frame callback of the encoder, private_data is the pool
+int app_frame_pool_release(EbExtFrameBuf *fb, void *private_data);
+// Frees the frames, once the encoder is deinitialized
+void app_frame_pool_close(AppFramePool *pool);
+
+#endif // EbAppIoThread_h
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <signal.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <string.h>
 #include "app_config.h"
 #include "app_context.h"
@@ -65,6 +66,10 @@ void process_output_stream_buffer(EncChannel* c, EncApp* enc_app, int32_t* frame
 
 void init_reader(EbConfig* app_cfg);
 
+void init_writer(EbConfig* app_cfg);
+
+void deinit_io_threads(EbConfig* app_cfg);
+
 volatile int32_t keep_running = 1;
 
 void event_handler(int32_t dummy) {
@@ -100,7 +105,10 @@ typedef struct EncContext {
 
 //initilize memory mapped file handler
 static void init_memory_file_map(EbConfig* app_cfg) {
-    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo;
+    // The pictures of a ladder source are used by the rungs after it sent them, and zero-copy
+    // input is read into the frames of its pool, so they are read
+    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo && !app_cfg->ladder &&
+        !app_cfg->zero_copy_input;
 
     if (!app_cfg->mmap.enable)
         return;
@@ -226,6 +234,7 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             }
             init_memory_file_map(app_cfg);
             init_reader(app_cfg);
+            init_writer(app_cfg);
 
             app_svt_av1_get_time(&app_cfg->performance_context.lib_start_time[0],
                                  &app_cfg->performance_context.lib_start_time[1]);
@@ -237,6 +246,13 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             if (c->return_error == EB_ErrorNone) {
                 c->return_error = init_encoder(app_cfg, inst_cnt);
             }
+            uint64_t init_s_time, init_u_time;
+            app_svt_av1_get_time(&init_s_time, &init_u_time);
+            app_cfg->performance_context.total_init_time = app_svt_av1_compute_overall_elapsed_time(
+                app_cfg->performance_context.lib_start_time[0],
+                app_cfg->performance_context.lib_start_time[1],
+                init_s_time,
+                init_u_time);
             return_error = (EbErrorType)(return_error | c->return_error);
         } else
             c->active = FALSE;
@@ -248,6 +264,7 @@ static void enc_context_dctor(EncContext* enc_context) {
     // DeInit Encoder
     for (int32_t inst_cnt = enc_context->num_channels - 1; inst_cnt >= 0; --inst_cnt) {
         EncChannel* c = enc_context->channels + inst_cnt;
+        deinit_io_threads(c->app_cfg);
         deinit_memory_file_map(c->app_cfg);
         enc_channel_dctor(c, inst_cnt);
     }
@@ -346,6 +363,21 @@ static void print_summary(const EncContext* const enc_context) {
                         (float)app_cfg->performance_context.sum_cr_ssim / frame_count);
             }
 
+            SvtAv1MemoryUsage usage;
+            if (app_cfg->config.memory_budget_mb &&
+                svt_av1_enc_get_stream_info(
+                    app_cfg->svt_encoder_handle, SVT_AV1_STREAM_INFO_MEMORY_USAGE, &usage) == EB_ErrorNone) {
+                fprintf(stderr, "\nMemory Budget\tHeld\t\tMalloc\t\tCalloc\t\tAligned\t\tThreads\n");
+                fprintf(stderr,
+                        "%8u MB\t%6.1f MB\t%6.1f MB\t%6.1f MB\t%6.1f MB\t%u\n",
+                        app_cfg->config.memory_budget_mb,
+                        (double)usage.total_bytes / (1 << 20),
+                        (double)usage.malloc_bytes / (1 << 20),
+                        (double)usage.calloc_bytes / (1 << 20),
+                        (double)usage.aligned_bytes / (1 << 20),
+                        usage.thread_count);
+            }
+
             fflush(stdout);
         }
     }
@@ -363,15 +395,18 @@ static void print_performance(const EncContext* const enc_context) {
                      (app_cfg->config.pass == 2 && app_cfg->config.rate_control_mode == SVT_AV1_RC_MODE_CQP_OR_CRF) ||
                      app_cfg->config.pass == 3))
                     fprintf(stderr,
-                            "\nChannel %u\nAverage Speed:\t\t%.3f fps\nTotal Encoding Time:\t%.0f "
-                            "ms\nTotal Execution Time:\t%.0f ms\nAverage Latency:\t%.0f ms\nMax "
-                            "Latency:\t\t%u ms\n",
+                            "\nChannel %u\nAverage Speed:\t\t%.3f fps\nInitialization Time:\t%.0f ms\nTotal "
+                            "Encoding Time:\t%.0f ms\nTotal Execution Time:\t%.0f ms\nAverage Latency:\t%.0f ms\nMax "
+                            "Latency:\t\t%u ms\nInput Wait Time:\t%.0f ms\nOutput Wait Time:\t%.0f ms\n",
                             (uint32_t)(inst_cnt + 1),
                             app_cfg->performance_context.average_speed,
+                            app_cfg->performance_context.total_init_time * 1000,
                             app_cfg->performance_context.total_encode_time * 1000,
                             app_cfg->performance_context.total_execution_time * 1000,
                             app_cfg->performance_context.average_latency,
-                            (uint32_t)(app_cfg->performance_context.max_latency));
+                            (uint32_t)(app_cfg->performance_context.max_latency),
+                            app_cfg->performance_context.input_wait_us / 1000.0,
+                            app_cfg->performance_context.output_wait_us / 1000.0);
             } else
                 fprintf(stderr, "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
         } else if (c->return_error == EB_ErrorInsufficientResources)
@@ -384,6 +419,66 @@ static void print_performance(const EncContext* const enc_context) {
     }
 }
 
+/* Writes the pipeline profile of the finished channels as Chrome trace events, one track
+ * per kernel thread, and prints how busy each pipeline stage was. */
+static void write_pipeline_traces(const EncContext* const enc_context) {
+    for (uint32_t inst_cnt = 0; inst_cnt < enc_context->num_channels; ++inst_cnt) {
+        const EncChannel* c       = enc_context->channels + inst_cnt;
+        EbConfig*         app_cfg = c->app_cfg;
+        if (!app_cfg->pipeline_trace_file || c->exit_cond != APP_ExitConditionFinished ||
+            c->return_error != EB_ErrorNone)
+            continue;
+        SvtAv1PipelineProfile profile;
+        if (svt_av1_enc_get_stream_info(
+                app_cfg->svt_encoder_handle, SVT_AV1_STREAM_INFO_PIPELINE_PROFILE, &profile) != EB_ErrorNone) {
+            fprintf(stderr, "Could not get the pipeline profile of channel %u\n", inst_cnt + 1);
+            continue;
+        }
+        FILE* f = app_cfg->pipeline_trace_file;
+        fprintf(f, "{\"traceEvents\":[\n");
+        for (uint32_t t = 0; t < profile.thread_count; t++)
+            fprintf(f,
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}},\n",
+                    inst_cnt,
+                    t,
+                    profile.threads[t].stage,
+                    profile.threads[t].thread_index);
+        for (uint64_t e = 0; e < profile.event_count; e++) {
+            const SvtAv1PipelineEvent* event = &profile.events[e];
+            fprintf(f,
+                    "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%" PRIu64 ",\"dur\":%" PRIu64,
+                    profile.threads[event->thread].stage,
+                    inst_cnt,
+                    event->thread,
+                    event->start_us,
+                    event->end_us - event->start_us);
+            if (event->picture_number != UINT64_MAX)
+                fprintf(f, ",\"args\":{\"picture\":%" PRIu64 "}", event->picture_number);
+            fprintf(f, "}%s\n", e + 1 < profile.event_count ? "," : "");
+        }
+        fprintf(f, "]}\n");
+
+        fprintf(stderr, "\nChannel %u pipeline profile\nStage\t\t\t\tThreads\tTasks\tBusy ms\tWait ms\n", inst_cnt + 1);
+        for (uint32_t t = 0; t < profile.thread_count;) {
+            const char* stage   = profile.threads[t].stage;
+            uint32_t    threads = 0;
+            uint64_t    tasks = 0, busy_us = 0, wait_us = 0;
+            for (; t < profile.thread_count && profile.threads[t].stage == stage; t++, threads++) {
+                tasks += profile.threads[t].task_count;
+                busy_us += profile.threads[t].busy_us;
+                wait_us += profile.threads[t].wait_us;
+            }
+            fprintf(stderr,
+                    "%-32s%u\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\n",
+                    stage,
+                    threads,
+                    tasks,
+                    busy_us / 1000,
+                    wait_us / 1000);
+        }
+    }
+}
+
 static void print_warnnings(const EncContext* const enc_context) {
     char* const* warning = enc_context->warning;
     for (uint32_t warning_id = 0;; warning_id++) {
@@ -478,6 +573,7 @@ static EbErrorType encode(EncApp* enc_app, EncContext* enc_context) {
     }
     print_summary(enc_context);
     print_performance(enc_context);
+    write_pipeline_traces(enc_context);
     return return_error;
 }
 
@@ -36,6 +36,7 @@
 #endif
 
 #include "app_output_ivf.h"
+#include "app_io_thread.h"
 
 /***************************************
  * Macros
@@ -107,6 +108,7 @@ void log_error_output(FILE *error_log_file, uint32_t error_code) {
 }
 
 static void (*read_input)(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr);
+static void start_read_ahead(EbConfig *app_cfg, uint8_t is_16bit);
 
 /* returns a RAM address from a memory mapped file  */
 static void *svt_mmap(MemMapFile *h, size_t offset, size_t size) {
@@ -153,6 +155,55 @@ static void release_memory_mapped_file(EbConfig *app_cfg, uint8_t is_16bit, EbBu
     svt_munmap(&app_cfg->mmap, input_ptr->cr, luma_read_size >> (3 - color_format));
 }
 
+/* Gives a ladder rung the picture the source has just read, scaled to the rung
+ * resolution, or the one of an earlier channel of the same resolution */
+static void ladder_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    const EbConfig           *source     = app_cfg->ladder_source;
+    const EbBufferHeaderType *src_header = source->input_buffer_pool;
+    EbSvtIOFormat            *input_ptr  = (EbSvtIOFormat *)header_ptr->p_buffer;
+
+    // the end of a piped source is only known once reached
+    app_cfg->frames_to_be_encoded = source->frames_to_be_encoded;
+    header_ptr->n_filled_len      = 0;
+    if (!src_header->n_filled_len)
+        return;
+
+    const uint8_t  color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t  subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t  subsampling_y = ((color_format == EB_YUV444 || color_format == EB_YUV422) ? 1 : 2) - 1;
+    const uint64_t chroma_width  = (app_cfg->input_padded_width + subsampling_x) >> subsampling_x;
+    const uint64_t chroma_height = (app_cfg->input_padded_height + subsampling_y) >> subsampling_y;
+
+    if (app_cfg->ladder_picture == app_cfg) {
+        EbSvtIOFormat src = *(const EbSvtIOFormat *)src_header->p_buffer;
+        src.width         = source->input_padded_width;
+        src.height        = source->input_padded_height;
+        src.color_fmt     = (EbColorFormat)color_format;
+        src.bit_depth     = (EbBitDepth)app_cfg->config.encoder_bit_depth;
+        input_ptr->width  = app_cfg->input_padded_width;
+        input_ptr->height = app_cfg->input_padded_height;
+        if (svt_av1_scale_picture(&src, input_ptr) != EB_ErrorNone) {
+            fprintf(app_cfg->error_log_file, "Error instance %u: Could not scale the ladder source\n",
+                    app_cfg->instance_idx + 1);
+            app_cfg->stop_encoder = TRUE;
+            return;
+        }
+    } else {
+        const EbSvtIOFormat *picture = (const EbSvtIOFormat *)app_cfg->ladder_picture->input_buffer_pool->p_buffer;
+        input_ptr->luma              = picture->luma;
+        input_ptr->cb                = picture->cb;
+        input_ptr->cr                = picture->cr;
+        input_ptr->y_stride          = picture->y_stride;
+        input_ptr->cb_stride         = picture->cb_stride;
+        input_ptr->cr_stride         = picture->cr_stride;
+    }
+    header_ptr->n_filled_len = (uint32_t)(((uint64_t)app_cfg->input_padded_width * app_cfg->input_padded_height +
+                                           2 * chroma_width * chroma_height)
+                                          << is_16bit);
+    // key frames forced on the source are forced on every rung
+    header_ptr->pic_type = src_header->pic_type;
+}
+
 /**
  * Reads and extracts one qp from the qp_file
  * @param qp_file file to read a value from
@@ -237,12 +288,19 @@ static bool is_forced_keyframe(const EbConfig *app_cfg, uint64_t pts) {
 bool process_skip(EbConfig *app_cfg, EbBufferHeaderType *header_ptr) {
     const bool is_16bit = app_cfg->config.encoder_bit_depth > 8;
     for (int64_t i = 0; i < app_cfg->frames_to_be_skipped; i++) {
-        read_input(app_cfg, is_16bit, header_ptr);
+        if (app_cfg->ladder_source)
+            ladder_read_input_frames(app_cfg, is_16bit, header_ptr);
+        else
+            read_input(app_cfg, is_16bit, header_ptr);
 
         if (header_ptr->n_filled_len) {
             app_cfg->mmap.file_frame_it++;
             if (app_cfg->mmap.enable)
                 release_memory_mapped_file(app_cfg, is_16bit, header_ptr);
+            if (app_cfg->frame_pool) {
+                app_frame_pool_put(app_cfg->frame_pool, (EbSvtIOFormat *)header_ptr->p_buffer);
+                header_ptr->p_buffer = NULL;
+            }
         } else {
             return false;
         }
@@ -538,7 +596,12 @@ void process_input_buffer(EncChannel *channel) {
 #if FTR_RES_ON_FLY_SAMPLE
         test_update_input_pic_def(app_cfg->processed_frame_count, header_ptr, app_cfg);
 #endif
-        read_input(app_cfg, is_16bit, header_ptr);
+        if (app_cfg->read_ahead)
+            start_read_ahead(app_cfg, is_16bit);
+        if (app_cfg->ladder_source)
+            ladder_read_input_frames(app_cfg, is_16bit, header_ptr);
+        else
+            read_input(app_cfg, is_16bit, header_ptr);
 
         if (header_ptr->n_filled_len) {
             // Update the context parameters
@@ -582,6 +645,9 @@ void process_input_buffer(EncChannel *channel) {
 
             if (app_cfg->mmap.enable)
                 release_memory_mapped_file(app_cfg, is_16bit, header_ptr);
+            // the encoder gives the frame back to the pool once done with it
+            if (app_cfg->frame_pool)
+                header_ptr->p_buffer = NULL;
         }
         if ((app_cfg->processed_frame_count == (uint64_t)app_cfg->frames_to_be_encoded) || app_cfg->stop_encoder) {
             header_ptr->flags = EB_BUFFERFLAG_EOS;
@@ -667,7 +733,29 @@ static void mmap_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuffer
     }
 }
 
-static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+/* Reads rows of row_size bytes into a plane of stride bytes, the first skip bytes of the plane being
+ * already there. Returns the number of bytes in the plane. */
+static uint64_t fread_plane(uint8_t *dst, uint64_t stride, uint64_t row_size, uint64_t rows, uint64_t skip,
+                            FILE *input_file) {
+    if (stride == row_size)
+        return skip + fread(dst + skip, 1, row_size * rows - skip, input_file);
+    uint64_t filled = skip;
+    for (uint64_t row = 0; row < rows; row++) {
+        const uint64_t offset = row ? 0 : skip;
+        const uint64_t size   = row_size - offset;
+        const uint64_t read   = fread(dst + row * stride + offset, 1, size, input_file);
+        filled += read;
+        if (read != size)
+            break;
+    }
+    return filled;
+}
+
+/* Reads the next frame with fread, returns false at the end of a piped input. Also called by
+ * the reader thread, so it only changes the file position and header_ptr. The planes of a
+ * zero-copy frame keep the strides of the encoder. */
+static bool fread_input_frame(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr,
+                              bool first_frame) {
     const uint32_t input_padded_width  = app_cfg->input_padded_width;
     const uint32_t input_padded_height = app_cfg->input_padded_height;
     FILE          *input_file          = app_cfg->input_file;
@@ -679,9 +767,15 @@ static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuff
     const uint64_t chroma_width = (app_cfg->input_padded_width + subsampling_x) >> subsampling_x;
     const uint64_t chroma_height = (app_cfg->input_padded_height + subsampling_y) >> subsampling_y;
 
-    input_ptr->y_stride  = input_padded_width;
-    input_ptr->cr_stride = chroma_width;
-    input_ptr->cb_stride = chroma_width;
+    if (!app_cfg->frame_pool) {
+        input_ptr->y_stride  = input_padded_width;
+        input_ptr->cr_stride = chroma_width;
+        input_ptr->cb_stride = chroma_width;
+    }
+    const uint64_t luma_stride   = (uint64_t)input_ptr->y_stride << is_16bit;
+    const uint64_t chroma_stride = (uint64_t)input_ptr->cb_stride << is_16bit;
+    const uint64_t luma_row      = (uint64_t)input_padded_width << is_16bit;
+    const uint64_t chroma_row    = chroma_width << is_16bit;
 
     header_ptr->n_filled_len = 0;
 
@@ -693,20 +787,20 @@ static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuff
     uint64_t chroma_read_size = chroma_width * chroma_height << is_16bit;
     uint64_t read_size = luma_read_size + 2 * chroma_read_size;
 
-    uint8_t *eb_input_ptr   = input_ptr->luma;
-    if (!app_cfg->y4m_input && app_cfg->processed_frame_count == 0 &&
-        (app_cfg->input_file == stdin || app_cfg->input_file_is_fifo)) {
+    if (!app_cfg->y4m_input && first_frame && (app_cfg->input_file == stdin || app_cfg->input_file_is_fifo)) {
         /* 9 bytes were already buffered during the the YUV4MPEG2 header probe */
-        memcpy(eb_input_ptr, app_cfg->y4m_buf, YUV4MPEG2_IND_SIZE);
-        header_ptr->n_filled_len += YUV4MPEG2_IND_SIZE;
-        eb_input_ptr += YUV4MPEG2_IND_SIZE;
-        header_ptr->n_filled_len += (uint32_t)fread(eb_input_ptr, 1, luma_read_size - YUV4MPEG2_IND_SIZE, input_file);
+        memcpy(input_ptr->luma, app_cfg->y4m_buf, YUV4MPEG2_IND_SIZE);
+        header_ptr->n_filled_len += (uint32_t)fread_plane(
+            input_ptr->luma, luma_stride, luma_row, input_padded_height, YUV4MPEG2_IND_SIZE, input_file);
     } else {
-        header_ptr->n_filled_len += (uint32_t)fread(input_ptr->luma, 1, luma_read_size, input_file);
+        header_ptr->n_filled_len += (uint32_t)fread_plane(
+            input_ptr->luma, luma_stride, luma_row, input_padded_height, 0, input_file);
     }
 
-    header_ptr->n_filled_len += (uint32_t)fread(input_ptr->cb, 1, chroma_read_size, input_file);
-    header_ptr->n_filled_len += (uint32_t)fread(input_ptr->cr, 1, chroma_read_size, input_file);
+    header_ptr->n_filled_len += (uint32_t)fread_plane(
+        input_ptr->cb, chroma_stride, chroma_row, chroma_height, 0, input_file);
+    header_ptr->n_filled_len += (uint32_t)fread_plane(
+        input_ptr->cr, chroma_stride, chroma_row, chroma_height, 0, input_file);
 
     if (read_size != header_ptr->n_filled_len && !app_cfg->input_file_is_fifo) {
         fseek(input_file, 0, SEEK_SET);
@@ -714,24 +808,59 @@ static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuff
             read_and_skip_y4m_header(app_cfg->input_file);
             read_y4m_frame_delimiter(app_cfg->input_file, app_cfg->error_log_file);
         }
-        header_ptr->n_filled_len = (uint32_t)fread(input_ptr->luma, 1, luma_read_size, input_file);
-        header_ptr->n_filled_len += (uint32_t)fread(input_ptr->cb, 1, chroma_read_size, input_file);
-        header_ptr->n_filled_len += (uint32_t)fread(input_ptr->cr, 1, chroma_read_size, input_file);
+        header_ptr->n_filled_len = (uint32_t)fread_plane(
+            input_ptr->luma, luma_stride, luma_row, input_padded_height, 0, input_file);
+        header_ptr->n_filled_len += (uint32_t)fread_plane(
+            input_ptr->cb, chroma_stride, chroma_row, chroma_height, 0, input_file);
+        header_ptr->n_filled_len += (uint32_t)fread_plane(
+            input_ptr->cr, chroma_stride, chroma_row, chroma_height, 0, input_file);
     }
 
     if (feof(input_file) != 0) {
         if ((input_file == stdin) || (app_cfg->input_file_is_fifo)) {
-            //for a fifo, we only know this when we reach eof
-            app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
             if (header_ptr->n_filled_len != read_size) {
                 // not a completed frame
                 header_ptr->n_filled_len = 0;
             }
+            return false;
         } else {
             // If we reached the end of file, loop over again
             fseek(input_file, 0, SEEK_SET);
         }
     }
+    return true;
+}
+
+static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    const bool more = app_cfg->reader
+        ? app_reader_get(app_cfg->reader, header_ptr, &app_cfg->performance_context.input_wait_us)
+        : fread_input_frame(app_cfg, is_16bit, header_ptr, app_cfg->processed_frame_count == 0);
+    if (!more) {
+        //for a fifo, we only know this when we reach eof
+        app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
+    }
+}
+
+/* Reads the next frame into a frame of the zero-copy pool, sent in place of the planes of the
+ * channel: header_ptr points at the frame until it is sent or given back */
+static void zero_copy_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    EbSvtIOFormat *frame     = app_frame_pool_get(app_cfg->frame_pool);
+    header_ptr->n_filled_len = 0;
+    header_ptr->p_buffer     = (uint8_t *)frame;
+    if (!frame) {
+        fprintf(app_cfg->error_log_file, "Error instance %u: Could not allocate an input frame\n",
+                app_cfg->instance_idx + 1);
+        app_cfg->stop_encoder = TRUE;
+        return;
+    }
+    if (!fread_input_frame(app_cfg, is_16bit, header_ptr, app_cfg->processed_frame_count == 0)) {
+        //for a fifo, we only know this when we reach eof
+        app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
+    }
+    if (!header_ptr->n_filled_len) {
+        app_frame_pool_put(app_cfg->frame_pool, frame);
+        header_ptr->p_buffer = NULL;
+    }
 }
 
 static void buffered_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
@@ -762,12 +891,51 @@ static void buffered_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBu
 }
 
 void init_reader(EbConfig *app_cfg) {
+    // the ladder rungs are fed by ladder_read_input_frames()
+    if (app_cfg->ladder_source)
+        return;
     if (app_cfg->buffered_input != -1) {
         read_input = buffered_read_input_frames;
     } else if (app_cfg->mmap.enable) {
         read_input = mmap_read_input_frames;
+    } else if (app_cfg->zero_copy_input) {
+        read_input = zero_copy_read_input_frames;
     } else {
-        read_input = normal_read_input_frames;
+        read_input          = normal_read_input_frames;
+        app_cfg->read_ahead = true;
+    }
+}
+
+// Frames in the ring of the reader thread: the lookahead, plus the frame held by the encoder
+#define READ_AHEAD_MAX_DEPTH 9
+// Packets queued to the writer thread
+#define WRITE_BEHIND_DEPTH 16
+
+/* Starts the reader thread once the skipped frames are read, the input keeps being read on
+ * the encoding thread when it cannot be started */
+static void start_read_ahead(EbConfig *app_cfg, uint8_t is_16bit) {
+    const uint32_t look_ahead = app_cfg->config.look_ahead_distance;
+    const uint32_t depth      = look_ahead < READ_AHEAD_MAX_DEPTH ? look_ahead + 1 : READ_AHEAD_MAX_DEPTH;
+    // the number of frames of a pipe is only known at its end
+    const uint64_t frame_limit = app_cfg->frames_to_be_encoded > 0 ? (uint64_t)app_cfg->frames_to_be_encoded : 0;
+    app_cfg->read_ahead        = false;
+    app_cfg->reader            = app_reader_open(app_cfg, is_16bit, depth, frame_limit, fread_input_frame);
+}
+
+void init_writer(EbConfig *app_cfg) {
+    // the stream is written on the encoding thread when the writer cannot be started
+    if (app_cfg->bitstream_file)
+        app_cfg->writer = app_writer_open(app_cfg, WRITE_BEHIND_DEPTH);
+}
+
+void deinit_io_threads(EbConfig *app_cfg) {
+    if (app_cfg->reader) {
+        app_reader_close(app_cfg->reader, app_cfg->input_buffer_pool);
+        app_cfg->reader = NULL;
+    }
+    if (app_cfg->writer) {
+        app_writer_close(app_cfg->writer, &app_cfg->performance_context.output_wait_us);
+        app_cfg->writer = NULL;
     }
 }
 
@@ -840,15 +1008,60 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+/* Writes a packet to the IVF output, preceded by the stream header for the first frame, and
+ * releases it. Both are done by the writer thread when there is one. */
+static void write_output_packet(EbConfig *app_cfg, EbBufferHeaderType *header_ptr, bool stream_start) {
+    const int32_t stream_length = app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded;
+    if (app_cfg->writer) {
+        app_writer_push(app_cfg->writer,
+                        header_ptr,
+                        stream_start ? stream_length : -1,
+                        &app_cfg->performance_context.output_wait_us);
+        return;
+    }
+    if (app_cfg->bitstream_file) {
+        if (stream_start)
+            write_ivf_stream_header(app_cfg, stream_length);
+        write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
+        fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, app_cfg->bitstream_file);
+    }
+    svt_av1_enc_release_out_buffer(&header_ptr);
+}
+
+/* appends the first pass stats completed so far to the stats file, after the header the first time */
+static void append_first_pass_stats(EbConfig *app_cfg) {
+    SvtAv1FixedBuf new_stats;
+    if (!app_cfg->output_stat_file ||
+        svt_av1_enc_get_stream_info(
+            app_cfg->svt_encoder_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW, &new_stats) != EB_ErrorNone ||
+        !new_stats.sz)
+        return;
+    if (!app_cfg->output_stat_size)
+        memcpy(&app_cfg->output_stat_header, new_stats.buf, sizeof(app_cfg->output_stat_header));
+    fwrite(new_stats.buf, 1, new_stats.sz, app_cfg->output_stat_file);
+    app_cfg->output_stat_size += new_stats.sz;
+}
+
+/* appends the rest of the first pass stats and sets the entry count in the header */
+static void finish_first_pass_stats(EbConfig *app_cfg) {
+    SvtAv1StatsHeader *header = &app_cfg->output_stat_header;
+    append_first_pass_stats(app_cfg);
+    if (!app_cfg->output_stat_size)
+        return;
+    header->entry_count = (app_cfg->output_stat_size - header->header_size) / header->entry_size;
+    // when the stats file can't seek, entry_count stays 0 and the entries run to its end
+    if (!fseek(app_cfg->output_stat_file, 0, SEEK_SET)) {
+        fwrite(header, 1, sizeof(*header), app_cfg->output_stat_file);
+        fseek(app_cfg->output_stat_file, 0, SEEK_END);
+    }
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *app_cfg    = channel->app_cfg;
     AppPortActiveType   *port_state = &app_cfg->output_stream_port_active;
     EbBufferHeaderType  *header_ptr;
     EbComponentType     *component_handle = app_cfg->svt_encoder_handle;
     AppExitConditionType return_value     = APP_ExitConditionNone;
-    // Per channel variables
-    FILE *stream_file = app_cfg->bitstream_file;
-
     uint64_t *total_latency = &app_cfg->performance_context.total_latency;
     uint32_t *max_latency   = &app_cfg->performance_context.max_latency;
 
@@ -881,15 +1094,18 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 return_value = APP_ExitConditionFinished;
                 // Release the output buffer
                 svt_av1_enc_release_out_buffer(&header_ptr);
+                // Write the packets still queued
+                if (app_cfg->writer) {
+                    app_writer_close(app_cfg->writer, &app_cfg->performance_context.output_wait_us);
+                    app_cfg->writer = NULL;
+                }
 
                 if (app_cfg->config.pass == ENC_FIRST_PASS) {
+                    finish_first_pass_stats(app_cfg);
                     SvtAv1FixedBuf first_pass_stat;
                     EbErrorType    ret = svt_av1_enc_get_stream_info(
                         component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
                     if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
                         enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
                         if (enc_app->rc_twopasses_stats.buf) {
                             memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
@@ -919,16 +1135,6 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                     finish_s_time,
                     finish_u_time);
 
-                // Write Stream Data to file
-                if (stream_file) {
-                    if (app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
-                        write_ivf_stream_header(
-                            app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
-                    }
-                    write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                    fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
-                }
-
                 app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
 
                 if (app_cfg->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
@@ -936,8 +1142,13 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
 
                 // Update Output Port Activity State
                 return_value = APP_ExitConditionNone;
-                // Release the output buffer
-                svt_av1_enc_release_out_buffer(&header_ptr);
+                // Write Stream Data to file and release the output buffer
+                write_output_packet(
+                    app_cfg,
+                    header_ptr,
+                    app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF));
+                if (app_cfg->config.pass == ENC_FIRST_PASS)
+                    append_first_pass_stats(app_cfg);
 
                 ++*frame_count;
             }
@@ -1056,16 +1267,6 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 finish_s_time,
                 finish_u_time);
 
-            // Write Stream Data to file
-            if (stream_file) {
-                if (app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
-                    write_ivf_stream_header(
-                        app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
-                }
-                write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
-            }
-
             app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
 
             if (app_cfg->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
@@ -1074,18 +1275,23 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             // Update Output Port Activity State
             *port_state  = (flags & EB_BUFFERFLAG_EOS) ? APP_PortInactive : *port_state;
             return_value = (flags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
-            // Release the output buffer
-            svt_av1_enc_release_out_buffer(&header_ptr);
+            // Write Stream Data to file and release the output buffer
+            write_output_packet(
+                app_cfg, header_ptr, app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF));
+            if (app_cfg->config.pass == ENC_FIRST_PASS && !(flags & EB_BUFFERFLAG_EOS))
+                append_first_pass_stats(app_cfg);
 
             if (flags & EB_BUFFERFLAG_EOS) {
+                if (app_cfg->writer) {
+                    app_writer_close(app_cfg->writer, &app_cfg->performance_context.output_wait_us);
+                    app_cfg->writer = NULL;
+                }
                 if (app_cfg->config.pass == ENC_FIRST_PASS) {
+                    finish_first_pass_stats(app_cfg);
                     SvtAv1FixedBuf first_pass_stat;
                     EbErrorType    ret = svt_av1_enc_get_stream_info(
                         component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
                     if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
                         enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
                         if (enc_app->rc_twopasses_stats.buf) {
                             memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
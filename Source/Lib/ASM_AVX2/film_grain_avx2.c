@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "aom_dsp_rtcd.h"
+
+/* Looks up the scaling of 8 indices, interpolating between the 256 entries when the bit depth is above 8.
+ * The last entry is interpolated with itself, which gives the entry as the C version does. */
+static INLINE __m256i scale_lut_avx2(const int32_t *scaling_lut, const __m256i index, const int32_t bit_depth) {
+    if (bit_depth == 8)
+        return _mm256_i32gather_epi32(scaling_lut, index, 4);
+    const int32_t shift = bit_depth - 8;
+    const __m256i x     = _mm256_srai_epi32(index, shift);
+    const __m256i x1    = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_set1_epi32(255));
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << shift) - 1));
+    const __m256i s0    = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i s1    = _mm256_i32gather_epi32(scaling_lut, x1, 4);
+    const __m256i delta = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, s0), frac),
+                                           _mm256_set1_epi32(1 << (shift - 1)));
+    return _mm256_add_epi32(s0, _mm256_srai_epi32(delta, shift));
+}
+
+// Adds the scaled grain to 8 pixels and clamps them
+static INLINE __m256i add_noise_avx2(const int32_t *scaling_lut, const __m256i pix, const __m256i index,
+                                     const int32_t *grain, const __m256i round, const int32_t scaling_shift,
+                                     const __m256i min, const __m256i max, const int32_t bit_depth) {
+    const __m256i scale = scale_lut_avx2(scaling_lut, index, bit_depth);
+    const __m256i noise = _mm256_srai_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(scale, _mm256_loadu_si256((const __m256i *)grain)), round),
+        scaling_shift);
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(pix, noise), min), max);
+}
+
+static INLINE __m256i load_8_u8(const uint8_t *src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m256i load_8_u16(const uint16_t *src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE void store_8_u8(uint8_t *dst, const __m256i pix) {
+    const __m256i p16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(pix, pix), 0x08);
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(_mm256_castsi256_si128(p16), _mm256_castsi256_si128(p16)));
+}
+
+static INLINE void store_8_u16(uint16_t *dst, const __m256i pix) {
+    const __m256i p16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(pix, pix), 0x08);
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(p16));
+}
+
+// Rounded average of the 8 horizontal pairs of 16 luma samples
+static INLINE __m256i average_luma_pairs(const __m256i l16) {
+    const __m256i sum = _mm256_madd_epi16(l16, _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+// Index of the chroma scaling: clamp(((average_luma * luma_mult + mult * chroma) >> 6) + offset, 0, max_index)
+static INLINE __m256i chroma_index_avx2(const __m256i average_luma, const __m256i chroma, const __m256i luma_mult,
+                                        const __m256i mult, const __m256i offset, const __m256i max_index) {
+    const __m256i combined = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                              _mm256_mullo_epi32(chroma, mult));
+    const __m256i index    = _mm256_add_epi32(_mm256_srai_epi32(combined, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(index, _mm256_setzero_si256()), max_index);
+}
+
+void svt_av1_add_noise_luma_avx2(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                 int32_t grain_stride, int32_t width, int32_t height, int32_t scaling_shift,
+                                 int32_t min_luma, int32_t max_luma) {
+    const int32_t w8    = width & ~7;
+    const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m256i min   = _mm256_set1_epi32(min_luma);
+    const __m256i max   = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pix = load_8_u8(luma + j);
+            store_8_u8(luma + j, add_noise_avx2(scaling_lut, pix, pix, grain + j, round, scaling_shift, min, max, 8));
+        }
+        luma += luma_stride;
+        grain += grain_stride;
+    }
+    if (w8 < width)
+        svt_av1_add_noise_luma_c(scaling_lut,
+                                 luma - height * luma_stride + w8,
+                                 luma_stride,
+                                 grain - height * grain_stride + w8,
+                                 grain_stride,
+                                 width - w8,
+                                 height,
+                                 scaling_shift,
+                                 min_luma,
+                                 max_luma);
+}
+
+void svt_av1_add_noise_luma_hbd_avx2(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride,
+                                     const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height,
+                                     int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    const int32_t w8    = width & ~7;
+    const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m256i min   = _mm256_set1_epi32(min_luma);
+    const __m256i max   = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pix = load_8_u16(luma + j);
+            store_8_u16(luma + j,
+                        add_noise_avx2(scaling_lut, pix, pix, grain + j, round, scaling_shift, min, max, bit_depth));
+        }
+        luma += luma_stride;
+        grain += grain_stride;
+    }
+    if (w8 < width)
+        svt_av1_add_noise_luma_hbd_c(scaling_lut,
+                                     luma - height * luma_stride + w8,
+                                     luma_stride,
+                                     grain - height * grain_stride + w8,
+                                     grain_stride,
+                                     width - w8,
+                                     height,
+                                     scaling_shift,
+                                     min_luma,
+                                     max_luma,
+                                     bit_depth);
+}
+
+void svt_av1_add_noise_chroma_avx2(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride,
+                                   const uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                   int32_t grain_stride, int32_t width, int32_t height, int32_t luma_mult,
+                                   int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                                   int32_t max_chroma, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y) {
+    const int32_t w8        = width & ~7;
+    const __m256i round     = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m256i min       = _mm256_set1_epi32(min_chroma);
+    const __m256i max       = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_m    = _mm256_set1_epi32(luma_mult);
+    const __m256i chroma_m  = _mm256_set1_epi32(mult);
+    const __m256i offset_v  = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i average_luma = chroma_subsamp_x
+                ? average_luma_pairs(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(l + (j << 1)))))
+                : load_8_u8(l + j);
+            const __m256i pix   = load_8_u8(chroma + j);
+            const __m256i index = chroma_index_avx2(average_luma, pix, luma_m, chroma_m, offset_v, max_index);
+            store_8_u8(chroma + j,
+                       add_noise_avx2(scaling_lut, pix, index, grain + j, round, scaling_shift, min, max, 8));
+        }
+        chroma += chroma_stride;
+        grain += grain_stride;
+    }
+    if (w8 < width)
+        svt_av1_add_noise_chroma_c(scaling_lut,
+                                   chroma - height * chroma_stride + w8,
+                                   chroma_stride,
+                                   luma + (w8 << chroma_subsamp_x),
+                                   luma_stride,
+                                   grain - height * grain_stride + w8,
+                                   grain_stride,
+                                   width - w8,
+                                   height,
+                                   luma_mult,
+                                   mult,
+                                   offset,
+                                   scaling_shift,
+                                   min_chroma,
+                                   max_chroma,
+                                   chroma_subsamp_x,
+                                   chroma_subsamp_y);
+}
+
+void svt_av1_add_noise_chroma_hbd_avx2(const int32_t *scaling_lut, uint16_t *chroma, int32_t chroma_stride,
+                                       const uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                       int32_t grain_stride, int32_t width, int32_t height, int32_t luma_mult,
+                                       int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                                       int32_t max_chroma, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                       int32_t bit_depth) {
+    const int32_t w8        = width & ~7;
+    const __m256i round     = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m256i min       = _mm256_set1_epi32(min_chroma);
+    const __m256i max       = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_m    = _mm256_set1_epi32(luma_mult);
+    const __m256i chroma_m  = _mm256_set1_epi32(mult);
+    const __m256i offset_v  = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32((256 << (bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            // the luma samples are at most 12 bits, so the pair sums do not overflow the signed 16 bit madd
+            const __m256i average_luma = chroma_subsamp_x
+                ? average_luma_pairs(_mm256_loadu_si256((const __m256i *)(l + (j << 1))))
+                : load_8_u16(l + j);
+            const __m256i pix   = load_8_u16(chroma + j);
+            const __m256i index = chroma_index_avx2(average_luma, pix, luma_m, chroma_m, offset_v, max_index);
+            store_8_u16(chroma + j,
+                        add_noise_avx2(scaling_lut, pix, index, grain + j, round, scaling_shift, min, max, bit_depth));
+        }
+        chroma += chroma_stride;
+        grain += grain_stride;
+    }
+    if (w8 < width)
+        svt_av1_add_noise_chroma_hbd_c(scaling_lut,
+                                       chroma - height * chroma_stride + w8,
+                                       chroma_stride,
+                                       luma + (w8 << chroma_subsamp_x),
+                                       luma_stride,
+                                       grain - height * grain_stride + w8,
+                                       grain_stride,
+                                       width - w8,
+                                       height,
+                                       luma_mult,
+                                       mult,
+                                       offset,
+                                       scaling_shift,
+                                       min_chroma,
+                                       max_chroma,
+                                       chroma_subsamp_x,
+                                       chroma_subsamp_y,
+                                       bit_depth);
+}
@@ -0,0 +1,307 @@
+/*
+* Copyright(c) 2024 Gianni Rosato
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include "definitions.h"
+#include "common_dsp_rtcd.h"
+
+/*
+ * The C reference computes the Hadamard transforms with a pseudo-SIMD trick (two
+ * coefficients packed in one integer). The kernels below compute the same
+ * unnormalized transforms on real vector lanes:
+ *   8x8:     (sum|H8x8| + 2) >> 2, minus sum(pixels) >> 2 (then >> 8 for 8-bit)
+ *   4x4:     sum|H4x4| >> 1, minus sum(pixels) >> 2
+ *
+ * The high bit-depth C path runs its transforms through 32-bit temporaries, which
+ * drops the odd half of the first horizontal butterfly and leaves a carry of the
+ * sign of every dropped coefficient in the final sum. To stay bit-exact:
+ *   8x8 hbd: with A/B the 4-point vertical transforms of rows 0..3/4..7 of the
+ *            even horizontal half, satd = 2 * sum(max(|A|, |B|) + (A < 0 || B < 0))
+ *   4x4 hbd: with C the even horizontal half, satd = sum(|C| + (C < 0))
+ */
+
+/* Sums the four 32-bit values of each 128-bit lane of a and b:
+ * returns { sum(a.lo), sum(b.lo), -, -, sum(a.hi), sum(b.hi), -, - } */
+static INLINE __m256i hsum_lanes_epi32x2(const __m256i a, const __m256i b) {
+    const __m256i s = _mm256_hadd_epi32(a, b);
+    return _mm256_hadd_epi32(s, s);
+}
+
+/* Energy of one 8x8 block of an 8-bit plane, from its Hadamard and pixel sums */
+static INLINE int32_t psy_nrg_8x8(const uint32_t satd, const uint32_t sum) {
+    return (int32_t)((((uint64_t)satd + 2) >> 2) >> 8) - (int32_t)(sum >> 2);
+}
+
+/* Energy of one 8x8 block of a high bit-depth plane */
+static INLINE int32_t psy_nrg_8x8_hbd(const uint32_t satd, const uint32_t sum) {
+    return (int32_t)(((uint64_t)satd + 2) >> 2) - (int32_t)(sum >> 2);
+}
+
+/* Transposes the 8x8 16-bit blocks held in each 128-bit lane of in[0..7] */
+static INLINE void transpose_16bit_8x8_x2_avx2(const __m256i *const in, __m256i *const out) {
+    const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+    const __m256i a1 = _mm256_unpacklo_epi16(in[2], in[3]);
+    const __m256i a2 = _mm256_unpacklo_epi16(in[4], in[5]);
+    const __m256i a3 = _mm256_unpacklo_epi16(in[6], in[7]);
+    const __m256i a4 = _mm256_unpackhi_epi16(in[0], in[1]);
+    const __m256i a5 = _mm256_unpackhi_epi16(in[2], in[3]);
+    const __m256i a6 = _mm256_unpackhi_epi16(in[4], in[5]);
+    const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+    const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+    const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+    const __m256i b2 = _mm256_unpacklo_epi32(a4, a5);
+    const __m256i b3 = _mm256_unpacklo_epi32(a6, a7);
+    const __m256i b4 = _mm256_unpackhi_epi32(a0, a1);
+    const __m256i b5 = _mm256_unpackhi_epi32(a2, a3);
+    const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+    const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+    out[0] = _mm256_unpacklo_epi64(b0, b1);
+    out[1] = _mm256_unpackhi_epi64(b0, b1);
+    out[2] = _mm256_unpacklo_epi64(b4, b5);
+    out[3] = _mm256_unpackhi_epi64(b4, b5);
+    out[4] = _mm256_unpacklo_epi64(b2, b3);
+    out[5] = _mm256_unpackhi_epi64(b2, b3);
+    out[6] = _mm256_unpacklo_epi64(b6, b7);
+    out[7] = _mm256_unpackhi_epi64(b6, b7);
+}
+
+/* Two 4-point Hadamards across the rows held in r[0..3] and r[4..7] */
+static INLINE void hadamard_col4x2_epi16_avx2(__m256i *const r) {
+    const __m256i a0 = _mm256_add_epi16(r[0], r[1]);
+    const __m256i a1 = _mm256_sub_epi16(r[0], r[1]);
+    const __m256i a2 = _mm256_add_epi16(r[2], r[3]);
+    const __m256i a3 = _mm256_sub_epi16(r[2], r[3]);
+    const __m256i a4 = _mm256_add_epi16(r[4], r[5]);
+    const __m256i a5 = _mm256_sub_epi16(r[4], r[5]);
+    const __m256i a6 = _mm256_add_epi16(r[6], r[7]);
+    const __m256i a7 = _mm256_sub_epi16(r[6], r[7]);
+
+    r[0] = _mm256_add_epi16(a0, a2);
+    r[1] = _mm256_add_epi16(a1, a3);
+    r[2] = _mm256_sub_epi16(a0, a2);
+    r[3] = _mm256_sub_epi16(a1, a3);
+    r[4] = _mm256_add_epi16(a4, a6);
+    r[5] = _mm256_add_epi16(a5, a7);
+    r[6] = _mm256_sub_epi16(a4, a6);
+    r[7] = _mm256_sub_epi16(a5, a7);
+}
+
+/* 8-point Hadamard across the rows held in r[0..7]; r[0] ends up holding the column sums */
+static INLINE void hadamard_col8_epi16_avx2(__m256i *const r) {
+    hadamard_col4x2_epi16_avx2(r);
+    const __m256i b0 = r[0], b1 = r[1], b2 = r[2], b3 = r[3];
+
+    r[0] = _mm256_add_epi16(b0, r[4]);
+    r[1] = _mm256_add_epi16(b1, r[5]);
+    r[2] = _mm256_add_epi16(b2, r[6]);
+    r[3] = _mm256_add_epi16(b3, r[7]);
+    r[4] = _mm256_sub_epi16(b0, r[4]);
+    r[5] = _mm256_sub_epi16(b1, r[5]);
+    r[6] = _mm256_sub_epi16(b2, r[6]);
+    r[7] = _mm256_sub_epi16(b3, r[7]);
+}
+
+/* |energy(input) - energy(recon)| of one 8x8 block, input and recon are
+ * processed together in the low and high 128-bit lanes. */
+static INLINE uint32_t psy_diff_8x8_avx2(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                         uint32_t recon_stride) {
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i       r[8], t[8];
+
+    for (int i = 0; i < 8; i++) {
+        const __m128i in  = _mm_loadl_epi64((const __m128i *)(input + i * input_stride));
+        const __m128i rec = _mm_loadl_epi64((const __m128i *)(recon + i * recon_stride));
+        r[i]              = _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(in, rec));
+    }
+
+    hadamard_col8_epi16_avx2(r);
+    const __m256i sum = _mm256_madd_epi16(r[0], one);
+    transpose_16bit_8x8_x2_avx2(r, t);
+    hadamard_col8_epi16_avx2(t);
+
+    __m256i satd = _mm256_madd_epi16(_mm256_abs_epi16(t[0]), one);
+    for (int i = 1; i < 8; i++) satd = _mm256_add_epi32(satd, _mm256_madd_epi16(_mm256_abs_epi16(t[i]), one));
+
+    const __m256i res       = hsum_lanes_epi32x2(satd, sum);
+    const int32_t input_nrg = psy_nrg_8x8(_mm256_extract_epi32(res, 0), _mm256_extract_epi32(res, 1));
+    const int32_t recon_nrg = psy_nrg_8x8(_mm256_extract_epi32(res, 4), _mm256_extract_epi32(res, 5));
+    return abs(input_nrg - recon_nrg);
+}
+
+/* Same as psy_diff_8x8_avx2() for high bit-depth, see the top of the file */
+static INLINE uint32_t psy_diff_8x8_hbd_avx2(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                             uint32_t recon_stride) {
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i       r[8], t[8];
+
+    for (int i = 0; i < 8; i++) {
+        r[i] = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(input + i * input_stride))),
+            _mm_loadu_si128((const __m128i *)(recon + i * recon_stride)),
+            1);
+    }
+
+    __m256i rows = r[0];
+    for (int i = 1; i < 8; i++) rows = _mm256_add_epi16(rows, r[i]);
+    const __m256i sum = _mm256_madd_epi16(rows, one);
+
+    // Columns of t[] hold { A0..A3, B0..B3 } once transposed
+    hadamard_col4x2_epi16_avx2(r);
+    transpose_16bit_8x8_x2_avx2(r, t);
+
+    // Even half of the 8-point horizontal Hadamard
+    const __m256i p0 = _mm256_add_epi16(t[0], t[1]);
+    const __m256i p1 = _mm256_add_epi16(t[2], t[3]);
+    const __m256i p2 = _mm256_add_epi16(t[4], t[5]);
+    const __m256i p3 = _mm256_add_epi16(t[6], t[7]);
+    const __m256i q0 = _mm256_add_epi16(p0, p1);
+    const __m256i q1 = _mm256_sub_epi16(p0, p1);
+    const __m256i q2 = _mm256_add_epi16(p2, p3);
+    const __m256i q3 = _mm256_sub_epi16(p2, p3);
+    const __m256i h[4] = {_mm256_add_epi16(q0, q2),
+                          _mm256_add_epi16(q1, q3),
+                          _mm256_sub_epi16(q0, q2),
+                          _mm256_sub_epi16(q1, q3)};
+
+    // Every (A, B) pair is visited twice, which gives the factor of 2
+    __m256i satd = _mm256_setzero_si256();
+    for (int i = 0; i < 4; i++) {
+        const __m256i swap = _mm256_shuffle_epi32(h[i], 0x4e);
+        const __m256i term = _mm256_add_epi16(_mm256_max_epu16(_mm256_abs_epi16(h[i]), _mm256_abs_epi16(swap)),
+                                              _mm256_srli_epi16(_mm256_or_si256(h[i], swap), 15));
+        satd               = _mm256_add_epi32(satd, _mm256_madd_epi16(term, one));
+    }
+
+    const __m256i res       = hsum_lanes_epi32x2(satd, sum);
+    const int32_t input_nrg = psy_nrg_8x8_hbd(_mm256_extract_epi32(res, 0), _mm256_extract_epi32(res, 1));
+    const int32_t recon_nrg = psy_nrg_8x8_hbd(_mm256_extract_epi32(res, 4), _mm256_extract_epi32(res, 5));
+    return abs(input_nrg - recon_nrg);
+}
+
+/* 4x4 Hadamard of a pair of blocks; each row register holds { input row, recon row }
+ * as eight 16-bit values. Even 16-bit lanes of c[] hold input coefficients, odd
+ * lanes hold recon coefficients, and the low 64 bits of every c[] hold the even
+ * horizontal half. sum receives { sum(input), sum(recon) } in its low 32-bit lanes. */
+static INLINE void hadamard_4x4_x2_avx2(const __m128i *const r, __m128i *const c, __m128i *const sum) {
+    const __m128i a0  = _mm_add_epi16(r[0], r[1]);
+    const __m128i a1  = _mm_sub_epi16(r[0], r[1]);
+    const __m128i a2  = _mm_add_epi16(r[2], r[3]);
+    const __m128i a3  = _mm_sub_epi16(r[2], r[3]);
+    const __m128i v0  = _mm_add_epi16(a0, a2);
+    const __m128i v1  = _mm_add_epi16(a1, a3);
+    const __m128i v2  = _mm_sub_epi16(a0, a2);
+    const __m128i v3  = _mm_sub_epi16(a1, a3);
+    const __m128i s01 = _mm_hadd_epi16(v0, v1);
+    const __m128i d01 = _mm_hsub_epi16(v0, v1);
+    const __m128i s23 = _mm_hadd_epi16(v2, v3);
+    const __m128i d23 = _mm_hsub_epi16(v2, v3);
+    const __m128i v0s = _mm_madd_epi16(v0, _mm_set1_epi16(1));
+
+    c[0] = _mm_hadd_epi16(s01, d01);
+    c[1] = _mm_hsub_epi16(s01, d01);
+    c[2] = _mm_hadd_epi16(s23, d23);
+    c[3] = _mm_hsub_epi16(s23, d23);
+    *sum = _mm_hadd_epi32(v0s, v0s);
+}
+
+/* Sums the even and the odd 16-bit lanes of x: returns { sum(even), sum(odd), -, - } */
+static INLINE __m128i hsum_even_odd_epi16(const __m128i x) {
+    const __m128i even = _mm_and_si128(x, _mm_set1_epi32(0xffff));
+    const __m128i odd  = _mm_srli_epi32(x, 16);
+    const __m128i s    = _mm_hadd_epi32(even, odd);
+    return _mm_hadd_epi32(s, s);
+}
+
+static INLINE uint32_t psy_nrg_diff_4x4(const __m128i satd, const __m128i sum) {
+    const int32_t input_nrg = (int32_t)((uint32_t)_mm_extract_epi32(satd, 0) >> 1) -
+        (int32_t)((uint32_t)_mm_extract_epi32(sum, 0) >> 2);
+    const int32_t recon_nrg = (int32_t)((uint32_t)_mm_extract_epi32(satd, 1) >> 1) -
+        (int32_t)((uint32_t)_mm_extract_epi32(sum, 1) >> 2);
+    return abs(input_nrg - recon_nrg);
+}
+
+static uint64_t psy_distortion_4x4_avx2(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                        uint32_t recon_stride, uint32_t width, uint32_t height) {
+    uint64_t total_nrg = 0;
+
+    for (uint32_t i = 0; i < height; i += 4) {
+        for (uint32_t j = 0; j < width; j += 4) {
+            const uint8_t *in  = input + i * input_stride + j;
+            const uint8_t *rec = recon + i * recon_stride + j;
+            __m128i        r[4], c[4], sum;
+            for (int k = 0; k < 4; k++)
+                r[k] = _mm_cvtepu8_epi16(_mm_unpacklo_epi32(_mm_cvtsi32_si128(*(const int32_t *)(in + k * input_stride)),
+                                                            _mm_cvtsi32_si128(*(const int32_t *)(rec + k * recon_stride))));
+            hadamard_4x4_x2_avx2(r, c, &sum);
+            const __m128i satd = _mm_add_epi16(_mm_add_epi16(_mm_abs_epi16(c[0]), _mm_abs_epi16(c[1])),
+                                               _mm_add_epi16(_mm_abs_epi16(c[2]), _mm_abs_epi16(c[3])));
+            total_nrg += psy_nrg_diff_4x4(hsum_even_odd_epi16(satd), sum);
+        }
+    }
+    return total_nrg << 2;
+}
+
+static uint64_t psy_distortion_hbd_4x4_avx2(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                            uint32_t recon_stride, uint32_t width, uint32_t height) {
+    uint64_t total_nrg = 0;
+
+    for (uint32_t i = 0; i < height; i += 4) {
+        for (uint32_t j = 0; j < width; j += 4) {
+            const uint16_t *in  = input + i * input_stride + j;
+            const uint16_t *rec = recon + i * recon_stride + j;
+            __m128i         r[4], c[4], sum;
+            for (int k = 0; k < 4; k++)
+                r[k] = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(in + k * input_stride)),
+                                          _mm_loadl_epi64((const __m128i *)(rec + k * recon_stride)));
+            hadamard_4x4_x2_avx2(r, c, &sum);
+            const __m128i e0   = _mm_unpacklo_epi64(c[0], c[1]);
+            const __m128i e1   = _mm_unpacklo_epi64(c[2], c[3]);
+            const __m128i satd = _mm_add_epi16(
+                _mm_add_epi16(_mm_abs_epi16(e0), _mm_srli_epi16(e0, 15)),
+                _mm_add_epi16(_mm_abs_epi16(e1), _mm_srli_epi16(e1, 15)));
+            total_nrg += psy_nrg_diff_4x4(hsum_even_odd_epi16(satd), sum);
+        }
+    }
+    return total_nrg << 2;
+}
+
+uint64_t svt_psy_distortion_avx2(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                 uint32_t recon_stride, uint32_t width, uint32_t height) {
+    if (width < 8 || height < 8)
+        return psy_distortion_4x4_avx2(input, input_stride, recon, recon_stride, width, height);
+
+    uint64_t total_nrg = 0;
+    for (uint32_t i = 0; i < height; i += 8) {
+        for (uint32_t j = 0; j < width; j += 8) {
+            total_nrg += psy_diff_8x8_avx2(
+                input + i * input_stride + j, input_stride, recon + i * recon_stride + j, recon_stride);
+        }
+    }
+    return total_nrg << 2;
+}
+
+uint64_t svt_psy_distortion_hbd_avx2(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                     uint32_t recon_stride, uint32_t width, uint32_t height) {
+    if (width < 8 || height < 8)
+        return psy_distortion_hbd_4x4_avx2(input, input_stride, recon, recon_stride, width, height);
+
+    uint64_t total_nrg = 0;
+    for (uint32_t i = 0; i < height; i += 8) {
+        for (uint32_t j = 0; j < width; j += 8) {
+            total_nrg += psy_diff_8x8_hbd_avx2(
+                input + i * input_stride + j, input_stride, recon + i * recon_stride + j, recon_stride);
+        }
+    }
+    return total_nrg << 2;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include <math.h>
+#include "ransac.h"
+
+// Splits 4 interleaved (x, y) points into their x and y in point order
+static INLINE void load_points_4(const double *points, __m256d *x, __m256d *y) {
+    const __m256d p01 = _mm256_loadu_pd(points);
+    const __m256d p23 = _mm256_loadu_pd(points + 4);
+    *x                = _mm256_permute4x64_pd(_mm256_unpacklo_pd(p01, p23), 0xD8);
+    *y                = _mm256_permute4x64_pd(_mm256_unpackhi_pd(p01, p23), 0xD8);
+}
+
+/* The distances are computed with the operations of the C version, in the same order and without
+ * fused multiply-adds, and the inliers are accumulated in point order, so that the models chosen
+ * are the same. */
+int svt_av1_ransac_find_inliers_avx2(const double *mat, const double *corners1, const double *corners2, int npoints,
+                                     int *inlier_indices, double *sum_distance, double *sum_distance_squared) {
+    const __m256d m0        = _mm256_set1_pd(mat[0]);
+    const __m256d m1        = _mm256_set1_pd(mat[1]);
+    const __m256d m2        = _mm256_set1_pd(mat[2]);
+    const __m256d m3        = _mm256_set1_pd(mat[3]);
+    const __m256d m4        = _mm256_set1_pd(mat[4]);
+    const __m256d m5        = _mm256_set1_pd(mat[5]);
+    const __m256d threshold = _mm256_set1_pd(INLIER_THRESHOLD_POW2);
+    double        sum = 0, sum_sq = 0;
+    int           num_inliers = 0;
+    int           i           = 0;
+
+    for (; i + 4 <= npoints; i += 4) {
+        __m256d x, y, rx, ry;
+        load_points_4(corners1 + i * 2, &x, &y);
+        load_points_4(corners2 + i * 2, &rx, &ry);
+        const __m256d px = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m2, x), _mm256_mul_pd(m3, y)), m0);
+        const __m256d py = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m4, x), _mm256_mul_pd(m5, y)), m1);
+        const __m256d dx = _mm256_sub_pd(px, rx);
+        const __m256d dy = _mm256_sub_pd(py, ry);
+        const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        int           mask = _mm256_movemask_pd(_mm256_cmp_pd(d2, threshold, _CMP_LT_OQ));
+        if (!mask)
+            continue;
+        double distance_pow2[4], distance[4];
+        _mm256_storeu_pd(distance_pow2, d2);
+        _mm256_storeu_pd(distance, _mm256_sqrt_pd(d2));
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) {
+                inlier_indices[num_inliers++] = i + k;
+                sum += distance[k];
+                sum_sq += distance_pow2[k];
+            }
+        }
+    }
+    for (; i < npoints; ++i) {
+        const double x             = corners1[i * 2];
+        const double y             = corners1[i * 2 + 1];
+        const double dx            = mat[2] * x + mat[3] * y + mat[0] - corners2[i * 2];
+        const double dy            = mat[4] * x + mat[5] * y + mat[1] - corners2[i * 2 + 1];
+        const double distance_pow2 = dx * dx + dy * dy;
+
+        if (distance_pow2 < INLIER_THRESHOLD_POW2) {
+            inlier_indices[num_inliers++] = i;
+            sum += sqrt(distance_pow2);
+            sum_sq += distance_pow2;
+        }
+    }
+    *sum_distance         = sum;
+    *sum_distance_squared = sum_sq;
+    return num_inliers;
+}
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+
+#include "aom_dsp_rtcd.h"
+
+#define AOM_QM_BITS 5
+
+// Spreads the 8 int32_t quantizer parameters of p (DC, then AC) over 16 lanes: DC in lane 0, AC elsewhere
+static INLINE __m512i init_one_qp_avx512(const __m256i p) {
+    const __m512i x = _mm512_castsi256_si512(p);
+    return _mm512_mask_permutexvar_epi32(x, 0xFFFE, _mm512_set1_epi32(1), x);
+}
+
+// Replaces the DC parameter of lane 0 with the AC one, once the first 16 coefficients are done
+static INLINE void update_qp_avx512(__m512i *qp, const int count) {
+    const __m512i ac = _mm512_set1_epi32(1);
+    for (int i = 0; i < count; ++i) qp[i] = _mm512_permutexvar_epi32(ac, qp[i]);
+}
+
+static INLINE void init_qp_add_shift(const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+                                     const int16_t *dequant_ptr, const int16_t *quant_shift_ptr, __m512i *qp,
+                                     const int add_shift) {
+    __m128i       zbin        = _mm_loadu_si128((const __m128i *)zbin_ptr);
+    __m128i       round       = _mm_loadu_si128((const __m128i *)round_ptr);
+    const __m128i quant       = _mm_loadu_si128((const __m128i *)quant_ptr);
+    const __m128i dequant     = _mm_loadu_si128((const __m128i *)dequant_ptr);
+    const __m128i quant_shift = _mm_loadu_si128((const __m128i *)quant_shift_ptr);
+    if (add_shift) {
+        const __m128i add = _mm_set1_epi16((int16_t)add_shift);
+        zbin              = _mm_add_epi16(zbin, add);
+        round             = _mm_add_epi16(round, add);
+        zbin              = _mm_srli_epi16(zbin, add_shift);
+        round             = _mm_srli_epi16(round, add_shift);
+    }
+    qp[0] = init_one_qp_avx512(_mm256_cvtepi16_epi32(zbin));
+    qp[1] = init_one_qp_avx512(_mm256_cvtepi16_epi32(round));
+    qp[2] = init_one_qp_avx512(_mm256_cvtepi16_epi32(quant));
+    qp[3] = init_one_qp_avx512(_mm256_cvtepi16_epi32(dequant));
+    qp[4] = init_one_qp_avx512(_mm256_cvtepi16_epi32(quant_shift));
+}
+
+static INLINE void init_qp_fp(const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *dequant_ptr,
+                              int log_scale, __m512i *qp) {
+    __m128i round = _mm_loadu_si128((const __m128i *)round_ptr);
+    if (log_scale) {
+        const __m128i round_scale = _mm_set1_epi16(1 << (15 - log_scale));
+        round                     = _mm_mulhrs_epi16(round, round_scale);
+    }
+    const __m128i quant   = _mm_loadu_si128((const __m128i *)quant_ptr);
+    const __m128i dequant = _mm_loadu_si128((const __m128i *)dequant_ptr);
+
+    qp[0] = init_one_qp_avx512(_mm256_cvtepu16_epi32(round));
+    qp[1] = init_one_qp_avx512(_mm256_cvtepu16_epi32(quant));
+    qp[2] = init_one_qp_avx512(_mm256_cvtepu16_epi32(dequant));
+}
+
+static INLINE void init_qp_qm(const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *dequant_ptr,
+                              int log_scale, __m512i *qp) {
+    __m128i       round   = _mm_loadu_si128((const __m128i *)round_ptr);
+    const __m128i quant   = _mm_loadu_si128((const __m128i *)quant_ptr);
+    const __m128i dequant = _mm_loadu_si128((const __m128i *)dequant_ptr);
+
+    if (log_scale > 0) {
+        const __m128i rnd = _mm_set1_epi16((int16_t)1 << (log_scale - 1));
+        round             = _mm_add_epi16(round, rnd);
+        round             = _mm_srai_epi16(round, log_scale);
+    }
+    qp[0] = init_one_qp_avx512(_mm256_cvtepi16_epi32(round));
+    qp[1] = init_one_qp_avx512(_mm256_cvtepi16_epi32(quant));
+    qp[2] = init_one_qp_avx512(_mm256_cvtepi16_epi32(dequant));
+}
+
+// (x * y) >> shift for 16 int32_t, the product being computed on 64 bits
+static INLINE __m512i mm512_mul_shift_epi32(const __m512i x, const __m512i y, const int shift) {
+    const __m128i count   = _mm_cvtsi32_si128(shift);
+    const __m512i prod_lo = _mm512_srl_epi64(_mm512_mul_epi32(x, y), count);
+    __m512i       prod_hi = _mm512_mul_epi32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(y, 32));
+    prod_hi               = _mm512_slli_epi64(_mm512_srl_epi64(prod_hi, count), 32);
+    return _mm512_mask_blend_epi32(0xAAAA, prod_lo, prod_hi);
+}
+
+// (x * y * wt) >> shift for 16 int32_t, the products being computed on 64 bits
+static INLINE __m512i mm512_mul_wt_shift_epi32(const __m512i x, const __m512i y, const __m512i wt, const int shift) {
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    __m512i       q_lo  = _mm512_mul_epi32(x, y);
+    q_lo                = _mm512_mullo_epi64(q_lo, _mm512_maskz_mov_epi32(0x5555, wt));
+    __m512i q_hi        = _mm512_mul_epi32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(y, 32));
+    q_hi                = _mm512_mullo_epi64(q_hi, _mm512_srli_epi64(wt, 32));
+    q_lo                = _mm512_srl_epi64(q_lo, count);
+    q_hi                = _mm512_slli_epi64(_mm512_srl_epi64(q_hi, count), 32);
+    return _mm512_mask_blend_epi32(0xAAAA, q_lo, q_hi);
+}
+
+static INLINE __m512i load_bytes_to_m512(const QmVal *p) {
+    return _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)p));
+}
+
+// ((dequant * iwt + 16) >> 5) * q
+static INLINE __m512i dequant_qm(const __m512i dequant, const __m512i iwt, const __m512i q) {
+    __m512i dq = _mm512_mullo_epi32(dequant, iwt);
+    dq         = _mm512_add_epi32(dq, _mm512_set1_epi32(1 << (AOM_QM_BITS - 1)));
+    dq         = _mm512_srli_epi32(dq, AOM_QM_BITS);
+    return _mm512_mullo_epi32(dq, q);
+}
+
+// Stores q / dq with the sign of c for the kept coefficients, 0 for the others, and updates eob
+static INLINE void store_quant(__m512i q, __m512i dq, const __m512i c, __mmask16 keep, const int16_t *iscan_ptr,
+                               TranLow *qcoeff, TranLow *dqcoeff, __m512i *eob) {
+    const __m512i   zero = _mm512_setzero_si512();
+    const __mmask16 neg  = _mm512_movepi32_mask(c);
+    keep &= _mm512_test_epi32_mask(c, c);
+    q  = _mm512_maskz_mov_epi32(keep, _mm512_mask_sub_epi32(q, neg, zero, q));
+    dq = _mm512_maskz_mov_epi32(keep, _mm512_mask_sub_epi32(dq, neg, zero, dq));
+
+    _mm512_storeu_si512((__m512i *)qcoeff, q);
+    _mm512_storeu_si512((__m512i *)dqcoeff, dq);
+
+    const __m512i   iscan = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)iscan_ptr));
+    const __mmask16 nz    = _mm512_test_epi32_mask(dq, dq);
+    *eob                  = _mm512_mask_max_epi32(*eob, nz, *eob, _mm512_add_epi32(iscan, _mm512_set1_epi32(1)));
+}
+
+static INLINE void store_zero(TranLow *qcoeff, TranLow *dqcoeff) {
+    _mm512_storeu_si512((__m512i *)qcoeff, _mm512_setzero_si512());
+    _mm512_storeu_si512((__m512i *)dqcoeff, _mm512_setzero_si512());
+}
+
+static INLINE void quantize_b(const __m512i *qp, const __m512i c, const int16_t *iscan_ptr, TranLow *qcoeff,
+                              TranLow *dqcoeff, __m512i *eob, int shift_dq, const int clamp) {
+    const __m512i   abs  = _mm512_abs_epi32(c);
+    const __mmask16 keep = _mm512_cmpge_epi32_mask(abs, qp[0]);
+
+    if (keep) {
+        __m512i q = _mm512_add_epi32(abs, qp[1]);
+        if (clamp)
+            q = _mm512_max_epi32(_mm512_min_epi32(q, _mm512_set1_epi32(INT16_MAX)), _mm512_set1_epi32(INT16_MIN));
+        q          = _mm512_add_epi32(mm512_mul_shift_epi32(q, qp[2], 16), q);
+        q          = mm512_mul_shift_epi32(q, qp[4], 16 - shift_dq);
+        __m512i dq = _mm512_mullo_epi32(q, qp[3]);
+        dq         = _mm512_srl_epi32(dq, _mm_cvtsi32_si128(shift_dq));
+        store_quant(q, dq, c, keep, iscan_ptr, qcoeff, dqcoeff, eob);
+    } else
+        store_zero(qcoeff, dqcoeff);
+}
+
+static INLINE void quantize_b_qm(const __m512i *qp, const __m512i c, const int16_t *iscan_ptr, TranLow *qcoeff,
+                                 TranLow *dqcoeff, __m512i *eob, int shift_dq, const __m512i wt, const __m512i iwt,
+                                 const int clamp) {
+    const __m512i   abs  = _mm512_abs_epi32(c);
+    const __mmask16 keep = _mm512_cmpge_epi32_mask(_mm512_mullo_epi32(abs, wt), qp[0]);
+
+    if (keep) {
+        __m512i q = _mm512_add_epi32(abs, qp[1]);
+        if (clamp)
+            q = _mm512_max_epi32(_mm512_min_epi32(q, _mm512_set1_epi32(INT16_MAX)), _mm512_set1_epi32(INT16_MIN));
+        q          = _mm512_mullo_epi32(q, wt);
+        q          = _mm512_add_epi32(mm512_mul_shift_epi32(q, qp[2], 16), q);
+        q          = mm512_mul_shift_epi32(q, qp[4], 16 - shift_dq + AOM_QM_BITS);
+        __m512i dq = dequant_qm(qp[3], iwt, q);
+        dq         = _mm512_srl_epi32(dq, _mm_cvtsi32_si128(shift_dq));
+        store_quant(q, dq, c, keep, iscan_ptr, qcoeff, dqcoeff, eob);
+    } else
+        store_zero(qcoeff, dqcoeff);
+}
+
+static INLINE void quantize_b_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                     const int16_t *round_ptr, const int16_t *quant_ptr,
+                                     const int16_t *quant_shift_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                     const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *iscan,
+                                     const QmVal *qm_ptr, const QmVal *iqm_ptr, const int32_t log_scale,
+                                     const int clamp) {
+    const uint32_t step = 16;
+
+    __m512i qp[5];
+    init_qp_add_shift(zbin_ptr, round_ptr, quant_ptr, dequant_ptr, quant_shift_ptr, qp, log_scale);
+    if (qm_ptr)
+        qp[0] = _mm512_slli_epi32(qp[0], AOM_QM_BITS);
+
+    __m512i eob = _mm512_setzero_si512();
+    while (1) {
+        const __m512i coeff = _mm512_loadu_si512((const __m512i *)coeff_ptr);
+        if (qm_ptr)
+            quantize_b_qm(qp,
+                          coeff,
+                          iscan,
+                          qcoeff_ptr,
+                          dqcoeff_ptr,
+                          &eob,
+                          log_scale,
+                          load_bytes_to_m512(qm_ptr),
+                          load_bytes_to_m512(iqm_ptr),
+                          clamp);
+        else
+            quantize_b(qp, coeff, iscan, qcoeff_ptr, dqcoeff_ptr, &eob, log_scale, clamp);
+
+        if (n_coeffs <= step)
+            break;
+        update_qp_avx512(qp, 5);
+        coeff_ptr += step;
+        qcoeff_ptr += step;
+        dqcoeff_ptr += step;
+        iscan += step;
+        if (qm_ptr) {
+            qm_ptr += step;
+            iqm_ptr += step;
+        }
+        n_coeffs -= step;
+    }
+    *eob_ptr = (uint16_t)_mm512_reduce_max_epi32(eob);
+}
+
+void svt_aom_highbd_quantize_b_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                      const int16_t *round_ptr, const int16_t *quant_ptr,
+                                      const int16_t *quant_shift_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                      const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+                                      const int16_t *iscan, const QmVal *qm_ptr, const QmVal *iqm_ptr,
+                                      const int32_t log_scale) {
+    (void)scan;
+    (void)qm_ptr;
+    (void)iqm_ptr;
+    quantize_b_avx512(coeff_ptr,
+                      n_coeffs,
+                      zbin_ptr,
+                      round_ptr,
+                      quant_ptr,
+                      quant_shift_ptr,
+                      qcoeff_ptr,
+                      dqcoeff_ptr,
+                      dequant_ptr,
+                      eob_ptr,
+                      iscan,
+                      NULL,
+                      NULL,
+                      log_scale,
+                      0);
+}
+
+void svt_av1_quantize_b_qm_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                  const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+                                  TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr, const int16_t *dequant_ptr,
+                                  uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const QmVal *qm_ptr,
+                                  const QmVal *iqm_ptr, const int32_t log_scale) {
+    (void)scan;
+    quantize_b_avx512(coeff_ptr,
+                      n_coeffs,
+                      zbin_ptr,
+                      round_ptr,
+                      quant_ptr,
+                      quant_shift_ptr,
+                      qcoeff_ptr,
+                      dqcoeff_ptr,
+                      dequant_ptr,
+                      eob_ptr,
+                      iscan,
+                      qm_ptr,
+                      iqm_ptr,
+                      log_scale,
+                      1);
+}
+
+void svt_av1_highbd_quantize_b_qm_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                         const int16_t *round_ptr, const int16_t *quant_ptr,
+                                         const int16_t *quant_shift_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                         const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+                                         const int16_t *iscan, const QmVal *qm_ptr, const QmVal *iqm_ptr,
+                                         const int32_t log_scale) {
+    (void)scan;
+    quantize_b_avx512(coeff_ptr,
+                      n_coeffs,
+                      zbin_ptr,
+                      round_ptr,
+                      quant_ptr,
+                      quant_shift_ptr,
+                      qcoeff_ptr,
+                      dqcoeff_ptr,
+                      dequant_ptr,
+                      eob_ptr,
+                      iscan,
+                      qm_ptr,
+                      iqm_ptr,
+                      log_scale,
+                      0);
+}
+
+static INLINE void quantize_highbd_fp(const __m512i *qp, const __m512i c, const int16_t *iscan_ptr, int log_scale,
+                                      TranLow *qcoeff, TranLow *dqcoeff, __m512i *eob) {
+    const __m512i   abs   = _mm512_abs_epi32(c);
+    const __m512i   abs_s = _mm512_sll_epi32(abs, _mm_cvtsi32_si128(1 + log_scale));
+    const __mmask16 keep  = _mm512_cmpge_epi32_mask(abs_s, qp[2]);
+
+    if (keep) {
+        __m512i q  = mm512_mul_shift_epi32(_mm512_add_epi32(abs, qp[0]), qp[1], 16 - log_scale);
+        __m512i dq = _mm512_mullo_epi32(q, qp[2]);
+        dq         = _mm512_sra_epi32(dq, _mm_cvtsi32_si128(log_scale));
+        store_quant(q, dq, c, keep, iscan_ptr, qcoeff, dqcoeff, eob);
+    } else
+        store_zero(qcoeff, dqcoeff);
+}
+
+void svt_av1_highbd_quantize_fp_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                       const int16_t *round_ptr, const int16_t *quant_ptr,
+                                       const int16_t *quant_shift_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                       const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+                                       const int16_t *iscan, int16_t log_scale) {
+    (void)scan;
+    (void)zbin_ptr;
+    (void)quant_shift_ptr;
+    const unsigned int step = 16;
+    __m512i            qp[3];
+
+    init_qp_fp(round_ptr, quant_ptr, dequant_ptr, log_scale, qp);
+    __m512i eob = _mm512_setzero_si512();
+    quantize_highbd_fp(
+        qp, _mm512_loadu_si512((const __m512i *)coeff_ptr), iscan, log_scale, qcoeff_ptr, dqcoeff_ptr, &eob);
+
+    update_qp_avx512(qp, 3);
+    while (n_coeffs > step) {
+        coeff_ptr += step;
+        qcoeff_ptr += step;
+        dqcoeff_ptr += step;
+        iscan += step;
+        n_coeffs -= step;
+        quantize_highbd_fp(
+            qp, _mm512_loadu_si512((const __m512i *)coeff_ptr), iscan, log_scale, qcoeff_ptr, dqcoeff_ptr, &eob);
+    }
+    *eob_ptr = (uint16_t)_mm512_reduce_max_epi32(eob);
+}
+
+// Shared by the 8-bit and high bit-depth fp quantizers with QM: the 8-bit one clamps the rounded
+// coefficient to int16_t and shifts dqcoeff logically, as its C reference does
+static INLINE void quantize_fp_qm(const __m512i *qp, const __m512i c, const int16_t *iscan_ptr, int log_scale,
+                                  TranLow *qcoeff, TranLow *dqcoeff, __m512i *eob, const __m512i qm,
+                                  const __m512i iqm, const int lowbd) {
+    const __m512i   abs  = _mm512_abs_epi32(c);
+    const __m512i   thr  = _mm512_sll_epi32(qp[2], _mm_cvtsi32_si128(AOM_QM_BITS - (1 + log_scale)));
+    const __mmask16 keep = _mm512_cmpge_epi32_mask(_mm512_mullo_epi32(abs, qm), thr);
+
+    if (keep) {
+        __m512i q = _mm512_add_epi32(abs, qp[0]);
+        __m512i dq;
+        if (lowbd) {
+            q  = _mm512_max_epi32(_mm512_min_epi32(q, _mm512_set1_epi32(INT16_MAX)), _mm512_set1_epi32(INT16_MIN));
+            q  = mm512_mul_shift_epi32(q, _mm512_mullo_epi32(qm, qp[1]), AOM_QM_BITS + 16 - log_scale);
+            dq = _mm512_srl_epi32(dequant_qm(qp[2], iqm, q), _mm_cvtsi32_si128(log_scale));
+        } else {
+            q  = mm512_mul_wt_shift_epi32(q, qp[1], qm, AOM_QM_BITS + 16 - log_scale);
+            dq = _mm512_sra_epi32(dequant_qm(qp[2], iqm, q), _mm_cvtsi32_si128(log_scale));
+        }
+        store_quant(q, dq, c, keep, iscan_ptr, qcoeff, dqcoeff, eob);
+    } else
+        store_zero(qcoeff, dqcoeff);
+}
+
+static INLINE void quantize_fp_qm_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *round_ptr,
+                                         const int16_t *quant_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                         const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *iscan,
+                                         const QmVal *qm_ptr, const QmVal *iqm_ptr, int16_t log_scale,
+                                         const int lowbd) {
+    const unsigned int step = 16;
+    __m512i            qp[3];
+
+    if (lowbd)
+        init_qp_qm(round_ptr, quant_ptr, dequant_ptr, log_scale, qp);
+    else
+        init_qp_fp(round_ptr, quant_ptr, dequant_ptr, log_scale, qp);
+    __m512i eob = _mm512_setzero_si512();
+    quantize_fp_qm(qp,
+                   _mm512_loadu_si512((const __m512i *)coeff_ptr),
+                   iscan,
+                   log_scale,
+                   qcoeff_ptr,
+                   dqcoeff_ptr,
+                   &eob,
+                   load_bytes_to_m512(qm_ptr),
+                   load_bytes_to_m512(iqm_ptr),
+                   lowbd);
+
+    update_qp_avx512(qp, 3);
+    while (n_coeffs > step) {
+        coeff_ptr += step;
+        qcoeff_ptr += step;
+        dqcoeff_ptr += step;
+        iscan += step;
+        qm_ptr += step;
+        iqm_ptr += step;
+        n_coeffs -= step;
+        quantize_fp_qm(qp,
+                       _mm512_loadu_si512((const __m512i *)coeff_ptr),
+                       iscan,
+                       log_scale,
+                       qcoeff_ptr,
+                       dqcoeff_ptr,
+                       &eob,
+                       load_bytes_to_m512(qm_ptr),
+                       load_bytes_to_m512(iqm_ptr),
+                       lowbd);
+    }
+    *eob_ptr = (uint16_t)_mm512_reduce_max_epi32(eob);
+}
+
+void svt_av1_quantize_fp_qm_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                   const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+                                   TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr, const int16_t *dequant_ptr,
+                                   uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const QmVal *qm_ptr,
+                                   const QmVal *iqm_ptr, int16_t log_scale) {
+    (void)scan;
+    (void)zbin_ptr;
+    (void)quant_shift_ptr;
+    quantize_fp_qm_avx512(coeff_ptr,
+                          n_coeffs,
+                          round_ptr,
+                          quant_ptr,
+                          qcoeff_ptr,
+                          dqcoeff_ptr,
+                          dequant_ptr,
+                          eob_ptr,
+                          iscan,
+                          qm_ptr,
+                          iqm_ptr,
+                          log_scale,
+                          1);
+}
+
+void svt_av1_highbd_quantize_fp_qm_avx512(const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+                                          const int16_t *round_ptr, const int16_t *quant_ptr,
+                                          const int16_t *quant_shift_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                                          const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+                                          const int16_t *iscan, const QmVal *qm_ptr, const QmVal *iqm_ptr,
+                                          int16_t log_scale) {
+    (void)scan;
+    (void)zbin_ptr;
+    (void)quant_shift_ptr;
+    quantize_fp_qm_avx512(coeff_ptr,
+                          n_coeffs,
+                          round_ptr,
+                          quant_ptr,
+                          qcoeff_ptr,
+                          dqcoeff_ptr,
+                          dequant_ptr,
+                          eob_ptr,
+                          iscan,
+                          qm_ptr,
+                          iqm_ptr,
+                          log_scale,
+                          0);
+}
+
+#endif // EN_AVX512_SUPPORT
@@ -0,0 +1,221 @@
+/*
+* Copyright(c) 2024 Gianni Rosato
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include "common_dsp_rtcd.h"
+
+/* See psy_rd_avx2.c for the definition of the block energies. */
+
+static INLINE int32_t psy_nrg_8x8(const uint32_t satd, const uint32_t sum) {
+    return (int32_t)((((uint64_t)satd + 2) >> 2) >> 8) - (int32_t)(sum >> 2);
+}
+
+static INLINE int32_t psy_nrg_8x8_hbd(const uint32_t satd, const uint32_t sum) {
+    return (int32_t)(((uint64_t)satd + 2) >> 2) - (int32_t)(sum >> 2);
+}
+
+/* Sums the four 32-bit values of each 128-bit lane of a and b:
+ * returns { sum(a.l), sum(b.l), -, - } for every 128-bit lane l */
+static INLINE __m512i hsum_lanes_epi32x2_avx512(const __m512i a, const __m512i b) {
+    const __m512i lo = _mm512_unpacklo_epi32(a, b); // a0 b0 a1 b1
+    const __m512i hi = _mm512_unpackhi_epi32(a, b); // a2 b2 a3 b3
+    const __m512i s  = _mm512_add_epi32(lo, hi); // a02 b02 a13 b13
+    return _mm512_add_epi32(s, _mm512_shuffle_epi32(s, 0x4e));
+}
+
+/* Transposes the 8x8 16-bit blocks held in each 128-bit lane of in[0..7] */
+static INLINE void transpose_16bit_8x8_x4_avx512(const __m512i *const in, __m512i *const out) {
+    const __m512i a0 = _mm512_unpacklo_epi16(in[0], in[1]);
+    const __m512i a1 = _mm512_unpacklo_epi16(in[2], in[3]);
+    const __m512i a2 = _mm512_unpacklo_epi16(in[4], in[5]);
+    const __m512i a3 = _mm512_unpacklo_epi16(in[6], in[7]);
+    const __m512i a4 = _mm512_unpackhi_epi16(in[0], in[1]);
+    const __m512i a5 = _mm512_unpackhi_epi16(in[2], in[3]);
+    const __m512i a6 = _mm512_unpackhi_epi16(in[4], in[5]);
+    const __m512i a7 = _mm512_unpackhi_epi16(in[6], in[7]);
+
+    const __m512i b0 = _mm512_unpacklo_epi32(a0, a1);
+    const __m512i b1 = _mm512_unpacklo_epi32(a2, a3);
+    const __m512i b2 = _mm512_unpacklo_epi32(a4, a5);
+    const __m512i b3 = _mm512_unpacklo_epi32(a6, a7);
+    const __m512i b4 = _mm512_unpackhi_epi32(a0, a1);
+    const __m512i b5 = _mm512_unpackhi_epi32(a2, a3);
+    const __m512i b6 = _mm512_unpackhi_epi32(a4, a5);
+    const __m512i b7 = _mm512_unpackhi_epi32(a6, a7);
+
+    out[0] = _mm512_unpacklo_epi64(b0, b1);
+    out[1] = _mm512_unpackhi_epi64(b0, b1);
+    out[2] = _mm512_unpacklo_epi64(b4, b5);
+    out[3] = _mm512_unpackhi_epi64(b4, b5);
+    out[4] = _mm512_unpacklo_epi64(b2, b3);
+    out[5] = _mm512_unpackhi_epi64(b2, b3);
+    out[6] = _mm512_unpacklo_epi64(b6, b7);
+    out[7] = _mm512_unpackhi_epi64(b6, b7);
+}
+
+/* Two 4-point Hadamards across the rows held in r[0..3] and r[4..7] */
+static INLINE void hadamard_col4x2_epi16_avx512(__m512i *const r) {
+    const __m512i a0 = _mm512_add_epi16(r[0], r[1]);
+    const __m512i a1 = _mm512_sub_epi16(r[0], r[1]);
+    const __m512i a2 = _mm512_add_epi16(r[2], r[3]);
+    const __m512i a3 = _mm512_sub_epi16(r[2], r[3]);
+    const __m512i a4 = _mm512_add_epi16(r[4], r[5]);
+    const __m512i a5 = _mm512_sub_epi16(r[4], r[5]);
+    const __m512i a6 = _mm512_add_epi16(r[6], r[7]);
+    const __m512i a7 = _mm512_sub_epi16(r[6], r[7]);
+
+    r[0] = _mm512_add_epi16(a0, a2);
+    r[1] = _mm512_add_epi16(a1, a3);
+    r[2] = _mm512_sub_epi16(a0, a2);
+    r[3] = _mm512_sub_epi16(a1, a3);
+    r[4] = _mm512_add_epi16(a4, a6);
+    r[5] = _mm512_add_epi16(a5, a7);
+    r[6] = _mm512_sub_epi16(a4, a6);
+    r[7] = _mm512_sub_epi16(a5, a7);
+}
+
+/* 8-point Hadamard across the rows held in r[0..7]; r[0] ends up holding the column sums */
+static INLINE void hadamard_col8_epi16_avx512(__m512i *const r) {
+    hadamard_col4x2_epi16_avx512(r);
+    const __m512i b0 = r[0], b1 = r[1], b2 = r[2], b3 = r[3];
+
+    r[0] = _mm512_add_epi16(b0, r[4]);
+    r[1] = _mm512_add_epi16(b1, r[5]);
+    r[2] = _mm512_add_epi16(b2, r[6]);
+    r[3] = _mm512_add_epi16(b3, r[7]);
+    r[4] = _mm512_sub_epi16(b0, r[4]);
+    r[5] = _mm512_sub_epi16(b1, r[5]);
+    r[6] = _mm512_sub_epi16(b2, r[6]);
+    r[7] = _mm512_sub_epi16(b3, r[7]);
+}
+
+/* Two horizontally adjacent 8x8 blocks; the 128-bit lanes hold
+ * { input block 0, recon block 0, input block 1, recon block 1 } */
+static INLINE uint32_t psy_diff_16x8_avx512(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                            uint32_t recon_stride) {
+    const __m512i one = _mm512_set1_epi16(1);
+    __m512i       r[8], t[8];
+
+    for (int i = 0; i < 8; i++) {
+        const __m128i in  = _mm_loadu_si128((const __m128i *)(input + i * input_stride));
+        const __m128i rec = _mm_loadu_si128((const __m128i *)(recon + i * recon_stride));
+        const __m256i px  = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_unpacklo_epi64(in, rec)), _mm_unpackhi_epi64(in, rec), 1);
+        r[i] = _mm512_cvtepu8_epi16(px);
+    }
+
+    hadamard_col8_epi16_avx512(r);
+    const __m512i sum = _mm512_madd_epi16(r[0], one);
+    transpose_16bit_8x8_x4_avx512(r, t);
+    hadamard_col8_epi16_avx512(t);
+
+    __m512i satd = _mm512_madd_epi16(_mm512_abs_epi16(t[0]), one);
+    for (int i = 1; i < 8; i++) satd = _mm512_add_epi32(satd, _mm512_madd_epi16(_mm512_abs_epi16(t[i]), one));
+
+    DECLARE_ALIGNED(64, uint32_t, res[16]);
+    _mm512_store_si512((__m512i *)res, hsum_lanes_epi32x2_avx512(satd, sum));
+    return abs(psy_nrg_8x8(res[0], res[1]) - psy_nrg_8x8(res[4], res[5])) +
+        abs(psy_nrg_8x8(res[8], res[9]) - psy_nrg_8x8(res[12], res[13]));
+}
+
+/* Two horizontally adjacent 8x8 high bit-depth blocks; the 128-bit lanes hold
+ * { input block 0, input block 1, recon block 0, recon block 1 } */
+static INLINE uint32_t psy_diff_16x8_hbd_avx512(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                                uint32_t recon_stride) {
+    const __m512i one = _mm512_set1_epi16(1);
+    __m512i       r[8], t[8];
+
+    for (int i = 0; i < 8; i++) {
+        r[i] = _mm512_inserti64x4(
+            _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *)(input + i * input_stride))),
+            _mm256_loadu_si256((const __m256i *)(recon + i * recon_stride)),
+            1);
+    }
+
+    __m512i rows = r[0];
+    for (int i = 1; i < 8; i++) rows = _mm512_add_epi16(rows, r[i]);
+    const __m512i sum = _mm512_madd_epi16(rows, one);
+
+    hadamard_col4x2_epi16_avx512(r);
+    transpose_16bit_8x8_x4_avx512(r, t);
+
+    const __m512i p0   = _mm512_add_epi16(t[0], t[1]);
+    const __m512i p1   = _mm512_add_epi16(t[2], t[3]);
+    const __m512i p2   = _mm512_add_epi16(t[4], t[5]);
+    const __m512i p3   = _mm512_add_epi16(t[6], t[7]);
+    const __m512i q0   = _mm512_add_epi16(p0, p1);
+    const __m512i q1   = _mm512_sub_epi16(p0, p1);
+    const __m512i q2   = _mm512_add_epi16(p2, p3);
+    const __m512i q3   = _mm512_sub_epi16(p2, p3);
+    const __m512i h[4] = {_mm512_add_epi16(q0, q2),
+                          _mm512_add_epi16(q1, q3),
+                          _mm512_sub_epi16(q0, q2),
+                          _mm512_sub_epi16(q1, q3)};
+
+    __m512i satd = _mm512_setzero_si512();
+    for (int i = 0; i < 4; i++) {
+        const __m512i swap = _mm512_shuffle_epi32(h[i], _MM_PERM_BADC);
+        const __m512i term = _mm512_add_epi16(_mm512_max_epu16(_mm512_abs_epi16(h[i]), _mm512_abs_epi16(swap)),
+                                              _mm512_srli_epi16(_mm512_or_si512(h[i], swap), 15));
+        satd               = _mm512_add_epi32(satd, _mm512_madd_epi16(term, one));
+    }
+
+    DECLARE_ALIGNED(64, uint32_t, res[16]);
+    _mm512_store_si512((__m512i *)res, hsum_lanes_epi32x2_avx512(satd, sum));
+    return abs(psy_nrg_8x8_hbd(res[0], res[1]) - psy_nrg_8x8_hbd(res[8], res[9])) +
+        abs(psy_nrg_8x8_hbd(res[4], res[5]) - psy_nrg_8x8_hbd(res[12], res[13]));
+}
+
+uint64_t svt_psy_distortion_avx512(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                   uint32_t recon_stride, uint32_t width, uint32_t height) {
+    if (width < 16 || height < 8)
+        return svt_psy_distortion_avx2(input, input_stride, recon, recon_stride, width, height);
+
+    uint64_t total_nrg = 0;
+    for (uint32_t i = 0; i < height; i += 8) {
+        for (uint32_t j = 0; j + 16 <= width; j += 16) {
+            total_nrg += psy_diff_16x8_avx512(
+                input + i * input_stride + j, input_stride, recon + i * recon_stride + j, recon_stride);
+        }
+    }
+    // the last 8 columns of a width that is an odd multiple of 8
+    const uint32_t tail = width & ~15;
+    if (tail != width)
+        return (total_nrg << 2) +
+            svt_psy_distortion_avx2(input + tail, input_stride, recon + tail, recon_stride, width - tail, height);
+    return total_nrg << 2;
+}
+
+uint64_t svt_psy_distortion_hbd_avx512(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                       uint32_t recon_stride, uint32_t width, uint32_t height) {
+    if (width < 16 || height < 8)
+        return svt_psy_distortion_hbd_avx2(input, input_stride, recon, recon_stride, width, height);
+
+    uint64_t total_nrg = 0;
+    for (uint32_t i = 0; i < height; i += 8) {
+        for (uint32_t j = 0; j + 16 <= width; j += 16) {
+            total_nrg += psy_diff_16x8_hbd_avx512(
+                input + i * input_stride + j, input_stride, recon + i * recon_stride + j, recon_stride);
+        }
+    }
+    // the last 8 columns of a width that is an odd multiple of 8
+    const uint32_t tail = width & ~15;
+    if (tail != width)
+        return (total_nrg << 2) +
+            svt_psy_distortion_hbd_avx2(input + tail, input_stride, recon + tail, recon_stride, width - tail, height);
+    return total_nrg << 2;
+}
+
+#endif // EN_AVX512_SUPPORT
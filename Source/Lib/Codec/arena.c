@@ -0,0 +1,98 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "arena.h"
+
+#define ARENA_ALIGN 64
+#define ARENA_MIN_BLOCK (64 << 10)
+
+typedef struct EbArenaBlock {
+    // older block, the newest block is the head of the list
+    struct EbArenaBlock *next;
+    uint8_t             *data;
+    size_t               size;
+    size_t               used;
+} EbArenaBlock;
+
+static EbArenaBlock *arena_block_new(size_t size, EbArenaBlock *next) {
+    EbArenaBlock *block;
+    EB_NO_THROW_MALLOC(block, sizeof(*block) + size + ARENA_ALIGN - 1);
+    if (!block)
+        return NULL;
+    block->next = next;
+    block->data = (uint8_t *)(((uintptr_t)(block + 1) + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1));
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+static void arena_free_blocks(EbArena *arena) {
+    while (arena->blocks) {
+        EbArenaBlock *next = arena->blocks->next;
+        EB_FREE(arena->blocks);
+        arena->blocks = next;
+    }
+}
+
+static void svt_aom_arena_dctor(EbPtr p) {
+    EbArena *obj = (EbArena *)p;
+    arena_free_blocks(obj);
+}
+
+EbErrorType svt_aom_arena_ctor(EbArena *arena, size_t size) {
+    arena->dctor  = svt_aom_arena_dctor;
+    arena->blocks = NULL;
+    if (size) {
+        arena->blocks = arena_block_new(size, NULL);
+        EB_CHECK_MEM(arena->blocks);
+    }
+    return EB_ErrorNone;
+}
+
+void *svt_aom_arena_alloc(EbArena *arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    EbArenaBlock *block = arena->blocks;
+    if (!block || block->size - block->used < size) {
+        block = arena_block_new(size > ARENA_MIN_BLOCK ? size : ARENA_MIN_BLOCK, arena->blocks);
+        if (!block)
+            return NULL;
+        arena->blocks = block;
+    }
+    void *p = block->data + block->used;
+    block->used += size;
+    return p;
+}
+
+void *svt_aom_arena_calloc(EbArena *arena, size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size)
+        return NULL;
+    void *p = svt_aom_arena_alloc(arena, count * size);
+    if (p)
+        memset(p, 0, count * size);
+    return p;
+}
+
+void svt_aom_arena_reset(EbArena *arena) {
+    if (!arena->blocks)
+        return;
+    if (arena->blocks->next) {
+        // The arena grew during this use: merge the blocks into one so the next use fits
+        size_t size = 0;
+        for (EbArenaBlock *block = arena->blocks; block; block = block->next) size += block->size;
+        arena_free_blocks(arena);
+        // when out of memory the block is allocated again by the next use
+        arena->blocks = arena_block_new(size, NULL);
+        return;
+    }
+    arena->blocks->used = 0;
+}
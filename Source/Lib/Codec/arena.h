@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbArena_h
+#define EbArena_h
+
+#include <stddef.h>
+
+#include "definitions.h"
+#include "object.h"
+#include "svt_malloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct EbArenaBlock;
+
+/*********************************************************************
+     * Arena
+     *   Bump allocator for buffers living as long as one use of a pooled
+     *   object. The buffers are never freed one by one: the whole arena
+     *   is reset when the object goes back to its EbSystemResource, and
+     *   the blocks are merged into one block sized to the largest use so
+     *   far, so in the steady state a use costs no malloc at all.
+     *   An arena is only used by one thread at a time.
+     *********************************************************************/
+typedef struct EbArena {
+    EbDctor              dctor;
+    struct EbArenaBlock *blocks;
+} EbArena;
+
+EbErrorType svt_aom_arena_ctor(EbArena *arena, size_t size);
+// Returns a buffer aligned on 64 bytes, NULL when out of memory
+void *svt_aom_arena_alloc(EbArena *arena, size_t size);
+// Same as svt_aom_arena_alloc() with the buffer set to 0
+void *svt_aom_arena_calloc(EbArena *arena, size_t count, size_t size);
+// Gives back every buffer of the arena, keeping its capacity
+void svt_aom_arena_reset(EbArena *arena);
+
+#define EB_ARENA_ALLOC_ARRAY(arena, pa, count)                    \
+    do {                                                          \
+        pa = svt_aom_arena_alloc(arena, sizeof(*(pa)) * (count)); \
+        EB_CHECK_MEM(pa);                                         \
+    } while (0)
+
+#define EB_ARENA_CALLOC_ARRAY(arena, pa, count)                    \
+    do {                                                           \
+        pa = svt_aom_arena_calloc(arena, count, sizeof(*(pa)));    \
+        EB_CHECK_MEM(pa);                                          \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbArena_h
@@ -376,6 +376,7 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
 
         dlf_results                   = (DlfResults *)dlf_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)dlf_results->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
 
@@ -619,81 +619,76 @@ void svt_aom_loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
     }
 }
 /*************************************************************************************************
+* loop_filter_sb_row
+* Filter the superblocks of one SB row. When above_progress is set the row is filtered as a
+* wavefront: superblock x waits for the row above to be done up to superblock x, which is when
+* the pixels the horizontal edges of superblock x - 1 reach above the row are final
+*************************************************************************************************/
+static void loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs, uint32_t y_sb_index,
+                               int32_t plane_start, int32_t plane_end, CondVar *above_progress,
+                               CondVar *progress) {
+    SequenceControlSet *scs             = pcs->scs;
+    uint8_t             sb_size_log2    = (uint8_t)svt_log2f(scs->sb_size);
+    uint32_t            pic_width_in_sb = (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
+    int32_t             above_done      = 0;
+
+    for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        const uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
+        const uint32_t sb_origin_y     = y_sb_index << sb_size_log2;
+        const Bool     end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? TRUE : FALSE;
+
+        if (above_progress && above_done <= (int32_t)x_sb_index) {
+            svt_yield_worker_token();
+            // the progress only grows during a pass
+            while (above_done <= (int32_t)x_sb_index) svt_wait_cond_var(above_progress, above_done++);
+            svt_resume_worker_token();
+        }
+        svt_aom_loop_filter_sb(
+            frame_buffer, pcs, sb_origin_y >> 2, sb_origin_x >> 2, plane_start, plane_end, end_of_row_flag);
+        if (progress)
+            svt_set_cond_var(progress, (int32_t)x_sb_index + 1);
+    }
+}
+/*************************************************************************************************
 * svt_av1_loop_filter_frame
 * Apply loop filtering to the frame based on the selected loop filter parameters
 *************************************************************************************************/
 void svt_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs, int32_t plane_start,
                                int32_t plane_end) {
-    SequenceControlSet *scs = pcs->scs;
-    //SuperBlock                     *sb_ptr;
-    //uint16_t                                   sb_index;
-    uint8_t  sb_size_log2 = (uint8_t)svt_log2f(scs->sb_size);
-    uint32_t x_sb_index;
-    uint32_t y_sb_index;
-    uint32_t sb_origin_x;
-    uint32_t sb_origin_y;
-    Bool     end_of_row_flag;
-
-    uint32_t pic_width_in_sb      = (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
-    uint32_t picture_height_in_sb = (pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    SequenceControlSet *scs                  = pcs->scs;
+    uint32_t            picture_height_in_sb = (pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
 
     svt_av1_loop_filter_frame_init(&pcs->ppcs->frm_hdr, &pcs->ppcs->lf_info, plane_start, plane_end);
 
-    for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-        for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-            //sb_index        = (uint16_t)(y_sb_index * pic_width_in_sb + x_sb_index);
-            //sb_ptr          = pcs->sb_ptr_array[sb_index];
-            sb_origin_x     = x_sb_index << sb_size_log2;
-            sb_origin_y     = y_sb_index << sb_size_log2;
-            end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? TRUE : FALSE;
-
-            svt_aom_loop_filter_sb(
-                frame_buffer, pcs, sb_origin_y >> 2, sb_origin_x >> 2, plane_start, plane_end, end_of_row_flag);
-        }
-    }
+    for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index)
+        loop_filter_sb_row(frame_buffer, pcs, y_sb_index, plane_start, plane_end, NULL, NULL);
 }
 
-void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, PictureControlSet *pcs,
-                     uint8_t plane) {
-    Bool is_16bit           = pcs->ppcs->scs->is_16bit_pipeline;
-    dstBuffer->org_x        = srcBuffer->org_x;
-    dstBuffer->org_y        = srcBuffer->org_y;
-    dstBuffer->origin_bot_y = srcBuffer->origin_bot_y;
-    dstBuffer->width        = srcBuffer->width;
-    dstBuffer->height       = srcBuffer->height;
-    dstBuffer->max_width    = srcBuffer->max_width;
-    dstBuffer->max_height   = srcBuffer->max_height;
-    dstBuffer->bit_depth    = srcBuffer->bit_depth;
-    dstBuffer->color_format = srcBuffer->color_format;
-    dstBuffer->luma_size    = srcBuffer->luma_size;
-    dstBuffer->chroma_size  = srcBuffer->chroma_size;
-    dstBuffer->packed_flag  = srcBuffer->packed_flag;
-
+/*************************************************************************************************
+* copy_buffer_lines
+* Copy the luma lines [y_start, y_end) of plane, or the matching chroma lines
+*************************************************************************************************/
+static void copy_buffer_lines(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, Bool is_16bit,
+                              uint8_t plane, uint32_t y_start, uint32_t y_end) {
     uint32_t luma_buffer_offset = (srcBuffer->org_x + srcBuffer->org_y * srcBuffer->stride_y) << is_16bit;
     uint16_t luma_width         = ALIGN_POWER_OF_TWO(srcBuffer->width, 3) << is_16bit;
-    uint16_t luma_height        = ALIGN_POWER_OF_TWO(srcBuffer->height, 3);
 
     uint16_t chroma_width = (luma_width >> 1);
     if (plane == 0) {
         uint16_t stride_y = srcBuffer->stride_y << is_16bit;
 
-        dstBuffer->stride_y         = srcBuffer->stride_y;
-        dstBuffer->stride_bit_inc_y = srcBuffer->stride_bit_inc_y;
-
-        for (int32_t input_row_index = 0; input_row_index < luma_height; input_row_index++) {
+        for (uint32_t input_row_index = y_start; input_row_index < y_end; input_row_index++) {
             svt_memcpy((dstBuffer->buffer_y + luma_buffer_offset + stride_y * input_row_index),
                        (srcBuffer->buffer_y + luma_buffer_offset + stride_y * input_row_index),
                        luma_width);
         }
     } else if (plane == 1) {
-        uint16_t stride_cb           = srcBuffer->stride_cb << is_16bit;
-        dstBuffer->stride_cb         = srcBuffer->stride_cb;
-        dstBuffer->stride_bit_inc_cb = srcBuffer->stride_bit_inc_cb;
+        uint16_t stride_cb = srcBuffer->stride_cb << is_16bit;
 
         uint32_t chroma_buffer_offset = (srcBuffer->org_x / 2 + srcBuffer->org_y / 2 * srcBuffer->stride_cb)
             << is_16bit;
 
-        for (int32_t input_row_index = 0; input_row_index < luma_height / 2; input_row_index++) {
+        for (uint32_t input_row_index = y_start / 2; input_row_index < y_end / 2; input_row_index++) {
             svt_memcpy((dstBuffer->buffer_cb + chroma_buffer_offset + stride_cb * input_row_index),
                        (srcBuffer->buffer_cb + chroma_buffer_offset + stride_cb * input_row_index),
                        chroma_width);
@@ -701,35 +696,64 @@ void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuf
     } else if (plane == 2) {
         uint16_t stride_cr = srcBuffer->stride_cr << is_16bit;
 
-        dstBuffer->stride_cr         = srcBuffer->stride_cr;
-        dstBuffer->stride_bit_inc_cr = srcBuffer->stride_bit_inc_cr;
-
         uint32_t chroma_buffer_offset = (srcBuffer->org_x / 2 + srcBuffer->org_y / 2 * srcBuffer->stride_cr)
             << is_16bit;
 
-        for (int32_t input_row_index = 0; input_row_index < luma_height / 2; input_row_index++) {
+        for (uint32_t input_row_index = y_start / 2; input_row_index < y_end / 2; input_row_index++) {
             svt_memcpy((dstBuffer->buffer_cr + chroma_buffer_offset + stride_cr * input_row_index),
                        (srcBuffer->buffer_cr + chroma_buffer_offset + stride_cr * input_row_index),
                        chroma_width);
         }
     }
 }
-static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane)
 
-{
+void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, PictureControlSet *pcs,
+                     uint8_t plane) {
+    Bool is_16bit           = pcs->ppcs->scs->is_16bit_pipeline;
+    dstBuffer->org_x        = srcBuffer->org_x;
+    dstBuffer->org_y        = srcBuffer->org_y;
+    dstBuffer->origin_bot_y = srcBuffer->origin_bot_y;
+    dstBuffer->width        = srcBuffer->width;
+    dstBuffer->height       = srcBuffer->height;
+    dstBuffer->max_width    = srcBuffer->max_width;
+    dstBuffer->max_height   = srcBuffer->max_height;
+    dstBuffer->bit_depth    = srcBuffer->bit_depth;
+    dstBuffer->color_format = srcBuffer->color_format;
+    dstBuffer->luma_size    = srcBuffer->luma_size;
+    dstBuffer->chroma_size  = srcBuffer->chroma_size;
+    dstBuffer->packed_flag  = srcBuffer->packed_flag;
+
+    if (plane == 0) {
+        dstBuffer->stride_y         = srcBuffer->stride_y;
+        dstBuffer->stride_bit_inc_y = srcBuffer->stride_bit_inc_y;
+    } else if (plane == 1) {
+        dstBuffer->stride_cb         = srcBuffer->stride_cb;
+        dstBuffer->stride_bit_inc_cb = srcBuffer->stride_bit_inc_cb;
+    } else if (plane == 2) {
+        dstBuffer->stride_cr         = srcBuffer->stride_cr;
+        dstBuffer->stride_bit_inc_cr = srcBuffer->stride_bit_inc_cr;
+    }
+    copy_buffer_lines(srcBuffer, dstBuffer, is_16bit, plane, 0, ALIGN_POWER_OF_TWO(srcBuffer->height, 3));
+}
+/*************************************************************************************************
+* picture_sse_calculations
+* SSE of plane over the luma lines [y_start, y_end) of the picture, or the matching chroma lines
+*************************************************************************************************/
+static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane,
+                                         uint32_t y_start, uint32_t y_end) {
     SequenceControlSet *scs      = pcs->ppcs->scs;
     Bool                is_16bit = scs->is_16bit_pipeline;
 
     // svt_spatial_full_distortion_kernel note:
     // intrinsic optimization require width and height in 4 pixel aligned.
     // when scaling is enabled the width and height might be not aligned.
-    // here uses aligned_width and aligned_height to avoid wrong sse results.
+    // here uses aligned_width to avoid wrong sse results, and the callers
+    // pass lines aligned on 8.
     // if encoding in non-scaled frame, aligned_width and aligned_height equals
     // frame width and height, it has no effect to original resolution
-    const uint16_t input_align_width  = pcs->ppcs->aligned_width;
-    const uint16_t input_align_height = pcs->ppcs->aligned_height;
-    const uint32_t ss_x               = scs->subsampling_x;
-    const uint32_t ss_y               = scs->subsampling_y;
+    const uint16_t input_align_width = pcs->ppcs->aligned_width;
+    const uint32_t ss_x              = scs->subsampling_x;
+    const uint32_t ss_y              = scs->subsampling_y;
 
     uint8_t *input_buffer;
     uint8_t *recon_coeff_buffer;
@@ -739,9 +763,9 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
 
         if (plane == 0) {
             recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_y)[recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y]);
+                (recon_ptr->buffer_y)[recon_ptr->org_x + (recon_ptr->org_y + y_start) * recon_ptr->stride_y]);
             input_buffer = (uint8_t *)&(
-                (input_pic->buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
+                (input_pic->buffer_y)[input_pic->org_x + (input_pic->org_y + y_start) * input_pic->stride_y]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
                                                       0,
@@ -750,12 +774,14 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                       0,
                                                       recon_ptr->stride_y,
                                                       input_align_width,
-                                                      input_align_height);
+                                                      y_end - y_start);
         } else if (plane == 1) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
+            recon_coeff_buffer = (uint8_t *)&((recon_ptr->buffer_cb)[recon_ptr->org_x / 2 +
+                                                                     (recon_ptr->org_y / 2 + (y_start >> ss_y)) *
+                                                                         recon_ptr->stride_cb]);
+            input_buffer       = (uint8_t *)&((input_pic->buffer_cb)[input_pic->org_x / 2 +
+                                                               (input_pic->org_y / 2 + (y_start >> ss_y)) *
+                                                                   input_pic->stride_cb]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
                                                       0,
@@ -764,12 +790,14 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                       0,
                                                       recon_ptr->stride_cb,
                                                       input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
+                                                      (y_end >> ss_y) - (y_start >> ss_y));
         } else if (plane == 2) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
+            recon_coeff_buffer = (uint8_t *)&((recon_ptr->buffer_cr)[recon_ptr->org_x / 2 +
+                                                                     (recon_ptr->org_y / 2 + (y_start >> ss_y)) *
+                                                                         recon_ptr->stride_cr]);
+            input_buffer       = (uint8_t *)&((input_pic->buffer_cr)[input_pic->org_x / 2 +
+                                                               (input_pic->org_y / 2 + (y_start >> ss_y)) *
+                                                                   input_pic->stride_cr]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
                                                       0,
@@ -778,7 +806,7 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                       0,
                                                       recon_ptr->stride_cr,
                                                       input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
+                                                      (y_end >> ss_y) - (y_start >> ss_y));
         }
         return 0;
     } else {
@@ -786,9 +814,11 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
 
         if (plane == 0) {
             recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_y)[(recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y) << is_16bit]);
+                (recon_ptr->buffer_y)[(recon_ptr->org_x + (recon_ptr->org_y + y_start) * recon_ptr->stride_y)
+                                      << is_16bit]);
             input_buffer = (uint8_t *)&(
-                (input_pic->buffer_y)[(input_pic->org_x + input_pic->org_y * input_pic->stride_y) << is_16bit]);
+                (input_pic->buffer_y)[(input_pic->org_x + (input_pic->org_y + y_start) * input_pic->stride_y)
+                                      << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
                                                      0,
@@ -797,14 +827,16 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                      0,
                                                      recon_ptr->stride_y,
                                                      input_align_width,
-                                                     input_align_height);
+                                                     y_end - y_start);
         } else if (plane == 1) {
             recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_cb)[(recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb) << is_16bit]);
+                (recon_ptr->buffer_cb)[(recon_ptr->org_x / 2 +
+                                        (recon_ptr->org_y / 2 + ((y_start + ss_y) >> ss_y)) * recon_ptr->stride_cb)
+                                       << is_16bit]);
             input_buffer = (uint8_t *)&(
-                (input_pic
-                     ->buffer_cb)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb) << is_16bit]);
+                (input_pic->buffer_cb)[(input_pic->org_x / 2 +
+                                        (input_pic->org_y / 2 + ((y_start + ss_y) >> ss_y)) * input_pic->stride_cb)
+                                       << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
                                                      0,
@@ -813,14 +845,16 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                      0,
                                                      recon_ptr->stride_cb,
                                                      (input_align_width + ss_x) >> ss_x,
-                                                     (input_align_height + ss_y) >> ss_y);
+                                                     ((y_end + ss_y) >> ss_y) - ((y_start + ss_y) >> ss_y));
         } else if (plane == 2) {
             recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_cr)[(recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr) << is_16bit]);
+                (recon_ptr->buffer_cr)[(recon_ptr->org_x / 2 +
+                                        (recon_ptr->org_y / 2 + ((y_start + ss_y) >> ss_y)) * recon_ptr->stride_cr)
+                                       << is_16bit]);
             input_buffer = (uint8_t *)&(
-                (input_pic
-                     ->buffer_cr)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr) << is_16bit]);
+                (input_pic->buffer_cr)[(input_pic->org_x / 2 +
+                                        (input_pic->org_y / 2 + ((y_start + ss_y) >> ss_y)) * input_pic->stride_cr)
+                                       << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
                                                      0,
@@ -829,26 +863,16 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                                                      0,
                                                      recon_ptr->stride_cr,
                                                      (input_align_width + ss_x) >> ss_x,
-                                                     (input_align_height + ss_y) >> ss_y);
+                                                     ((y_end + ss_y) >> ss_y) - ((y_start + ss_y) >> ss_y));
         }
         return 0;
     }
 }
 /*************************************************************************************************
-* try_filter_frame
-* Sett the filter levels, compute the filtering sse, and resett the recon buffer.
-* Returns the filtering SSE
+* set_trial_filter_level
+* Set the filter levels of plane for a trial filtering at filt_level
 *************************************************************************************************/
-static int64_t try_filter_frame(
-    //const Yv12BufferConfig *sd,
-    //Av1Comp *const cpi,
-    const EbPictureBufferDesc *sd, EbPictureBufferDesc *temp_lf_recon_buffer, PictureControlSet *pcs,
-    int32_t filt_level, int32_t partial_frame, int32_t plane, int32_t dir) {
-    (void)sd;
-    (void)partial_frame;
-    (void)sd;
-    int64_t      filt_err;
-    FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
+static void set_trial_filter_level(FrameHeader *frm_hdr, int32_t filt_level, int32_t plane, int32_t dir) {
     assert(plane >= 0 && plane <= 2);
     int32_t filter_level[2] = {filt_level, filt_level};
     if (plane == 0 && dir == 0)
@@ -856,10 +880,6 @@ static int64_t try_filter_frame(
     if (plane == 0 && dir == 1)
         filter_level[0] = frm_hdr->loop_filter_params.filter_level[0];
 
-    Bool                 is_16bit = pcs->ppcs->scs->is_16bit_pipeline;
-    EbPictureBufferDesc *recon_buffer;
-    svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
-
     // set base filters for use of get_filter_level when in DELTA_Q_LF mode
     switch (plane) {
     case 0:
@@ -869,10 +889,31 @@ static int64_t try_filter_frame(
     case 1: frm_hdr->loop_filter_params.filter_level_u = filter_level[0]; break;
     case 2: frm_hdr->loop_filter_params.filter_level_v = filter_level[0]; break;
     }
+}
+/*************************************************************************************************
+* try_filter_frame
+* Sett the filter levels, compute the filtering sse, and resett the recon buffer.
+* Returns the filtering SSE
+*************************************************************************************************/
+static int64_t try_filter_frame(
+    //const Yv12BufferConfig *sd,
+    //Av1Comp *const cpi,
+    const EbPictureBufferDesc *sd, EbPictureBufferDesc *temp_lf_recon_buffer, PictureControlSet *pcs,
+    int32_t filt_level, int32_t partial_frame, int32_t plane, int32_t dir) {
+    (void)sd;
+    (void)partial_frame;
+    (void)sd;
+    int64_t filt_err;
+
+    Bool                 is_16bit = pcs->ppcs->scs->is_16bit_pipeline;
+    EbPictureBufferDesc *recon_buffer;
+    svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+
+    set_trial_filter_level(&pcs->ppcs->frm_hdr, filt_level, plane, dir);
 
     svt_av1_loop_filter_frame(recon_buffer, pcs, plane, plane + 1);
 
-    filt_err = picture_sse_calculations(pcs, recon_buffer, plane);
+    filt_err = picture_sse_calculations(pcs, recon_buffer, plane, 0, pcs->ppcs->aligned_height);
 
     // Re-instate the unfiltered frame
     svt_copy_buffer(
@@ -881,22 +922,11 @@ static int64_t try_filter_frame(
     return filt_err;
 }
 /*************************************************************************************************
-* search_filter_level
-* Perform a search for the best filter level for the picture data plane
+* filter_level_search_start
+* Level the search for the best filter level of the picture data plane starts at
 *************************************************************************************************/
-static int32_t search_filter_level(
-    //const Yv12BufferConfig *sd, Av1Comp *cpi,
-    EbPictureBufferDesc *sd, // source
-    EbPictureBufferDesc *temp_lf_recon_buffer, PictureControlSet *pcs, int32_t partial_frame,
-    const int32_t *last_frame_filter_level, double *best_cost_ret, int32_t plane, int32_t dir) {
-    const int32_t min_filter_level = 0;
-    const int32_t max_filter_level = MAX_LOOP_FILTER; // av1_get_max_filter_level(cpi);
-    int32_t       filt_direction   = 0;
-    int64_t       best_err;
-    int32_t       filt_best;
-    FrameHeader  *frm_hdr = &pcs->ppcs->frm_hdr;
-    //Macroblock *x = &cpi->td.mb;
-
+static int32_t filter_level_search_start(PictureControlSet *pcs, const int32_t *last_frame_filter_level,
+                                         int32_t plane, int32_t dir) {
     // Start the search at the previous frame filter level unless it is now out of
     // range.
     int32_t lvl;
@@ -911,24 +941,32 @@ static int32_t search_filter_level(
     case 2: lvl = last_frame_filter_level[3]; break;
     default: assert(plane >= 0 && plane <= 2); return 0;
     }
-    int32_t filt_mid    = clamp(lvl, min_filter_level, max_filter_level);
-    int32_t filter_step = filt_mid < 16 ? 4 : filt_mid / 4;
-
-    Bool                 is_16bit = pcs->ppcs->scs->is_16bit_pipeline;
-    EbPictureBufferDesc *recon_buffer;
-    svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
-    // Sum squared error at each filter level
-    int64_t ss_err[MAX_LOOP_FILTER + 1];
+    return clamp(lvl, 0, MAX_LOOP_FILTER);
+}
+/*************************************************************************************************
+* next_filter_level_trial
+* Run the search for the best filter level on the filtering SSEs known so far (-1 in ss_err
+* when not known). Returns the level whose filtering SSE the search needs next, or -1 once the
+* search is over with the best level in filt_best_ret. As the search only depends on the SSEs,
+* running it again from filt_start after every trial filtering gives the same levels in the same
+* order as trying them as the search goes.
+*************************************************************************************************/
+static int32_t next_filter_level_trial(PictureControlSet *pcs, int32_t filt_start, const int64_t *ss_err,
+                                       int32_t *filt_best_ret) {
+    const int32_t min_filter_level = 0;
+    const int32_t max_filter_level = MAX_LOOP_FILTER; // av1_get_max_filter_level(cpi);
+    int32_t       filt_direction   = 0;
+    int64_t       best_err;
+    int32_t       filt_best;
+    FrameHeader  *frm_hdr = &pcs->ppcs->frm_hdr;
 
-    // Set each entry to -1
-    memset(ss_err, 0xFF, sizeof(ss_err));
-    // make a copy of recon_buffer
-    svt_copy_buffer(
-        recon_buffer /*cm->frame_to_show*/, temp_lf_recon_buffer /*&cpi->last_frame_uf*/, pcs, (uint8_t)plane);
+    int32_t filt_mid    = filt_start;
+    int32_t filter_step = filt_mid < 16 ? 4 : filt_mid / 4;
 
-    best_err                = try_filter_frame(sd, temp_lf_recon_buffer, pcs, filt_mid, partial_frame, plane, dir);
+    if (ss_err[filt_mid] < 0)
+        return filt_mid;
+    best_err                = ss_err[filt_mid];
     filt_best               = filt_mid;
-    ss_err[filt_mid]        = best_err;
     int32_t tot_convergence = 0;
     while (filter_step > 0) {
         const int32_t filt_high = AOMMIN(filt_mid + filter_step, max_filter_level);
@@ -943,9 +981,8 @@ static int32_t search_filter_level(
 
         if (filt_direction <= 0 && filt_low != filt_mid) {
             // Get Low filter error score
-            if (ss_err[filt_low] < 0) {
-                ss_err[filt_low] = try_filter_frame(sd, temp_lf_recon_buffer, pcs, filt_low, partial_frame, plane, dir);
-            }
+            if (ss_err[filt_low] < 0)
+                return filt_low;
             // If value is close to the best so far then bias towards a lower loop
             // filter value.
             if (ss_err[filt_low] < (best_err + bias)) {
@@ -958,10 +995,8 @@ static int32_t search_filter_level(
 
         // Now look at filt_high
         if (filt_direction >= 0 && filt_high != filt_mid) {
-            if (ss_err[filt_high] < 0) {
-                ss_err[filt_high] = try_filter_frame(
-                    sd, temp_lf_recon_buffer, pcs, filt_high, partial_frame, plane, dir);
-            }
+            if (ss_err[filt_high] < 0)
+                return filt_high;
             // If value is significantly better than previous best, bias added against
             // raising filter value
             if (ss_err[filt_high] < (best_err - bias)) {
@@ -983,11 +1018,39 @@ static int32_t search_filter_level(
             filt_mid       = filt_best;
         }
     }
-    // Update best error
-    best_err = ss_err[filt_best];
+    *filt_best_ret = filt_best;
+    return -1;
+}
+/*************************************************************************************************
+* search_filter_level
+* Perform a search for the best filter level for the picture data plane
+*************************************************************************************************/
+static int32_t search_filter_level(
+    //const Yv12BufferConfig *sd, Av1Comp *cpi,
+    EbPictureBufferDesc *sd, // source
+    EbPictureBufferDesc *temp_lf_recon_buffer, PictureControlSet *pcs, int32_t partial_frame,
+    const int32_t *last_frame_filter_level, double *best_cost_ret, int32_t plane, int32_t dir) {
+    const int32_t filt_start = filter_level_search_start(pcs, last_frame_filter_level, plane, dir);
+    int32_t       filt_best;
+    int32_t       filt_level;
+
+    Bool                 is_16bit = pcs->ppcs->scs->is_16bit_pipeline;
+    EbPictureBufferDesc *recon_buffer;
+    svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+    // Sum squared error at each filter level
+    int64_t ss_err[MAX_LOOP_FILTER + 1];
+
+    // Set each entry to -1
+    memset(ss_err, 0xFF, sizeof(ss_err));
+    // make a copy of recon_buffer
+    svt_copy_buffer(
+        recon_buffer /*cm->frame_to_show*/, temp_lf_recon_buffer /*&cpi->last_frame_uf*/, pcs, (uint8_t)plane);
+
+    while ((filt_level = next_filter_level_trial(pcs, filt_start, ss_err, &filt_best)) >= 0)
+        ss_err[filt_level] = try_filter_frame(sd, temp_lf_recon_buffer, pcs, filt_level, partial_frame, plane, dir);
 
     if (best_cost_ret)
-        *best_cost_ret = (double)best_err; //RDCOST_DBL(x->rdmult, 0, best_err);
+        *best_cost_ret = (double)ss_err[filt_best]; //RDCOST_DBL(x->rdmult, 0, best_err);
     return filt_best;
 }
 EbErrorType qp_based_dlf_param(PictureControlSet *pcs, int32_t *filter_level_y, int32_t *filter_level_uv) {
@@ -1124,24 +1187,103 @@ void svt_av1_pick_filter_level_by_q(PictureControlSet *pcs, uint8_t qindex, int3
         : 0;
 }
 /*************************************************************************************************
-* svt_av1_pick_filter_level
-* Choose the optimal loop filter levels
+* temp_lf_recon_ctor
+* Allocate the copy of the unfiltered recon the trial filterings start from
 *************************************************************************************************/
-EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source input
-                                      PictureControlSet *pcs, LpfPickMethod method) {
+static EbErrorType temp_lf_recon_ctor(PictureControlSet *pcs) {
     SequenceControlSet *scs     = pcs->scs;
-    FrameHeader        *frm_hdr = &pcs->ppcs->frm_hdr;
-    (void)srcBuffer;
-    struct LoopFilter *const lf = &frm_hdr->loop_filter_params;
+    uint16_t            padding = scs->super_block_size + 32;
+    if (scs->static_config.superres_mode > SUPERRES_NONE || scs->static_config.resize_mode > RESIZE_NONE) {
+        padding += scs->super_block_size;
+    }
+    EbPictureBufferDescInitData temp_lf_recon_desc_init_data;
+    temp_lf_recon_desc_init_data.max_width          = (uint16_t)scs->max_input_luma_width;
+    temp_lf_recon_desc_init_data.max_height         = (uint16_t)scs->max_input_luma_height;
+    temp_lf_recon_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+
+    temp_lf_recon_desc_init_data.left_padding  = padding;
+    temp_lf_recon_desc_init_data.right_padding = padding;
+    temp_lf_recon_desc_init_data.top_padding   = padding;
+    temp_lf_recon_desc_init_data.bot_padding   = padding;
+    temp_lf_recon_desc_init_data.split_mode    = FALSE;
+    temp_lf_recon_desc_init_data.color_format  = scs->static_config.encoder_color_format;
+    Bool is_16bit                              = scs->static_config.encoder_bit_depth > 8 ? TRUE : FALSE;
+    if (scs->is_16bit_pipeline || is_16bit) {
+        temp_lf_recon_desc_init_data.bit_depth = EB_SIXTEEN_BIT;
+        EB_NEW(pcs->temp_lf_recon_pic_16bit, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_lf_recon_desc_init_data);
+        if (!is_16bit)
+            pcs->temp_lf_recon_pic_16bit->bit_depth = EB_EIGHT_BIT;
+    } else {
+        temp_lf_recon_desc_init_data.bit_depth = EB_EIGHT_BIT;
+        EB_NEW(pcs->temp_lf_recon_pic, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_lf_recon_desc_init_data);
+    }
+    return EB_ErrorNone;
+}
+/*************************************************************************************************
+* set_sharpness_level
+*************************************************************************************************/
+static void set_sharpness_level(PictureControlSet *pcs) {
+    FrameHeader             *frm_hdr = &pcs->ppcs->frm_hdr;
+    struct LoopFilter *const lf      = &frm_hdr->loop_filter_params;
 
     int32_t sharpness_val = pcs->scs->static_config.sharpness;
-    uint8_t tune = pcs->scs->static_config.tune;
+    uint8_t tune          = pcs->scs->static_config.tune;
     //On KFs, we want slightly less blurry frames. Not sure if post-process with bitstream filter or in-encoder
     if (frm_hdr->frame_type == KEY_FRAME && tune == 3) {
         lf->sharpness_level = MIN(7, sharpness_val + 2);
     } else {
         lf->sharpness_level = sharpness_val > 0 ? sharpness_val : 0;
     }
+}
+/*************************************************************************************************
+* set_avg_ref_filter_level
+* Start the filter level search at the average level of the references
+*************************************************************************************************/
+static void set_avg_ref_filter_level(PictureControlSet *pcs) {
+    struct LoopFilter *const lf = &pcs->ppcs->frm_hdr.loop_filter_params;
+
+    int32_t tot_ref_filter_level[2] = {0, 0};
+    int32_t tot_ref_filter_level_u  = 0;
+    int32_t tot_ref_filter_level_v  = 0;
+
+    int32_t tot_refs = 0;
+
+    for (uint32_t ref_it = 0; ref_it < pcs->ppcs->tot_ref_frame_types; ++ref_it) {
+        MvReferenceFrame ref_pair = pcs->ppcs->ref_frame_type_arr[ref_it];
+        MvReferenceFrame rf[2];
+        av1_set_ref_frame(rf, ref_pair);
+
+        if (rf[1] == NONE_FRAME) {
+            uint8_t            list_idx = get_list_idx(rf[0]);
+            uint8_t            ref_idx  = get_ref_frame_idx(rf[0]);
+            EbReferenceObject *ref_obj  = pcs->ref_pic_ptr_array[list_idx][ref_idx]->object_ptr;
+
+            tot_ref_filter_level[0] += ref_obj->filter_level[0];
+            tot_ref_filter_level[1] += ref_obj->filter_level[1];
+            tot_ref_filter_level_u += ref_obj->filter_level_u;
+            tot_ref_filter_level_v += ref_obj->filter_level_v;
+
+            tot_refs++;
+        }
+    }
+
+    lf->filter_level[0] = tot_ref_filter_level[0] / tot_refs;
+    lf->filter_level[1] = tot_ref_filter_level[1] / tot_refs;
+    lf->filter_level_u  = tot_ref_filter_level_u / tot_refs;
+    lf->filter_level_v  = tot_ref_filter_level_v / tot_refs;
+}
+/*************************************************************************************************
+* svt_av1_pick_filter_level
+* Choose the optimal loop filter levels
+*************************************************************************************************/
+EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source input
+                                      PictureControlSet *pcs, LpfPickMethod method) {
+    SequenceControlSet *scs     = pcs->scs;
+    FrameHeader        *frm_hdr = &pcs->ppcs->frm_hdr;
+    (void)srcBuffer;
+    struct LoopFilter *const lf = &frm_hdr->loop_filter_params;
+
+    set_sharpness_level(pcs);
 
     if (method == LPF_PICK_MINIMAL_LPF)
         lf->filter_level[0] = lf->filter_level[1] = 0;
@@ -1153,64 +1295,12 @@ EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source
         lf->filter_level_u  = filter_level[2];
         lf->filter_level_v  = filter_level[3];
     } else {
-        uint16_t padding = scs->super_block_size + 32;
-        if (scs->static_config.superres_mode > SUPERRES_NONE || scs->static_config.resize_mode > RESIZE_NONE) {
-            padding += scs->super_block_size;
-        }
-        EbPictureBufferDescInitData temp_lf_recon_desc_init_data;
-        temp_lf_recon_desc_init_data.max_width          = (uint16_t)scs->max_input_luma_width;
-        temp_lf_recon_desc_init_data.max_height         = (uint16_t)scs->max_input_luma_height;
-        temp_lf_recon_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
-
-        temp_lf_recon_desc_init_data.left_padding  = padding;
-        temp_lf_recon_desc_init_data.right_padding = padding;
-        temp_lf_recon_desc_init_data.top_padding   = padding;
-        temp_lf_recon_desc_init_data.bot_padding   = padding;
-        temp_lf_recon_desc_init_data.split_mode    = FALSE;
-        temp_lf_recon_desc_init_data.color_format  = scs->static_config.encoder_color_format;
-        Bool is_16bit                              = scs->static_config.encoder_bit_depth > 8 ? TRUE : FALSE;
-        if (scs->is_16bit_pipeline || is_16bit) {
-            temp_lf_recon_desc_init_data.bit_depth = EB_SIXTEEN_BIT;
-            EB_NEW(
-                pcs->temp_lf_recon_pic_16bit, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_lf_recon_desc_init_data);
-            if (!is_16bit)
-                pcs->temp_lf_recon_pic_16bit->bit_depth = EB_EIGHT_BIT;
-        } else {
-            temp_lf_recon_desc_init_data.bit_depth = EB_EIGHT_BIT;
-            EB_NEW(pcs->temp_lf_recon_pic, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_lf_recon_desc_init_data);
-        }
-
-        if (pcs->ppcs->dlf_ctrls.dlf_avg && pcs->ppcs->tot_ref_frame_types > 0) {
-            int32_t tot_ref_filter_level[2] = {0, 0};
-            int32_t tot_ref_filter_level_u  = 0;
-            int32_t tot_ref_filter_level_v  = 0;
-
-            int32_t tot_refs = 0;
-
-            for (uint32_t ref_it = 0; ref_it < pcs->ppcs->tot_ref_frame_types; ++ref_it) {
-                MvReferenceFrame ref_pair = pcs->ppcs->ref_frame_type_arr[ref_it];
-                MvReferenceFrame rf[2];
-                av1_set_ref_frame(rf, ref_pair);
+        EbErrorType return_error = temp_lf_recon_ctor(pcs);
+        if (return_error != EB_ErrorNone)
+            return return_error;
 
-                if (rf[1] == NONE_FRAME) {
-                    uint8_t            list_idx = get_list_idx(rf[0]);
-                    uint8_t            ref_idx  = get_ref_frame_idx(rf[0]);
-                    EbReferenceObject *ref_obj  = pcs->ref_pic_ptr_array[list_idx][ref_idx]->object_ptr;
-
-                    tot_ref_filter_level[0] += ref_obj->filter_level[0];
-                    tot_ref_filter_level[1] += ref_obj->filter_level[1];
-                    tot_ref_filter_level_u += ref_obj->filter_level_u;
-                    tot_ref_filter_level_v += ref_obj->filter_level_v;
-
-                    tot_refs++;
-                }
-            }
-
-            lf->filter_level[0] = tot_ref_filter_level[0] / tot_refs;
-            lf->filter_level[1] = tot_ref_filter_level[1] / tot_refs;
-            lf->filter_level_u  = tot_ref_filter_level_u / tot_refs;
-            lf->filter_level_v  = tot_ref_filter_level_v / tot_refs;
-        }
+        if (pcs->ppcs->dlf_ctrls.dlf_avg && pcs->ppcs->tot_ref_frame_types > 0)
+            set_avg_ref_filter_level(pcs);
 
         const int32_t last_frame_filter_level[4] = {
             lf->filter_level[0], lf->filter_level[1], lf->filter_level_u, lf->filter_level_v};
@@ -1259,3 +1349,146 @@ EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source
 
     return EB_ErrorNone;
 }
+/*************************************************************************************************
+* dlf_search_next_pass
+* Set up the next pass of the segmented deblocking: the next trial filtering of the search,
+* or the final filtering once the levels of every plane are picked
+*************************************************************************************************/
+static void dlf_search_next_pass(PictureControlSet *pcs) {
+    DlfSearch               *search   = &pcs->dlf_search;
+    FrameHeader             *frm_hdr  = &pcs->ppcs->frm_hdr;
+    struct LoopFilter *const lf       = &frm_hdr->loop_filter_params;
+    Bool                     is_16bit = pcs->scs->is_16bit_pipeline;
+
+    while (search->plane < 3) {
+        const int32_t dir = search->plane == 0 ? 2 : 0;
+        int32_t       filt_best;
+        int32_t       filt_level = next_filter_level_trial(pcs, search->filt_start, search->ss_err, &filt_best);
+        if (filt_level >= 0) {
+            search->level = filt_level;
+            set_trial_filter_level(frm_hdr, filt_level, search->plane, dir);
+            svt_av1_loop_filter_frame_init(frm_hdr, &pcs->ppcs->lf_info, search->plane, search->plane + 1);
+            return;
+        }
+        // The search of the plane is over
+        switch (search->plane) {
+        case 0: lf->filter_level[0] = lf->filter_level[1] = filt_best; break;
+        case 1: lf->filter_level_u = filt_best; break;
+        default: lf->filter_level_v = filt_best; break;
+        }
+        if (search->plane == 0 && pcs->ppcs->dlf_ctrls.dlf_avg_uv && pcs->temporal_layer_index > 0) {
+            //use avg-ref for chroma
+            lf->filter_level_u = search->last_frame_filter_level[2];
+            lf->filter_level_v = search->last_frame_filter_level[3];
+            search->plane      = 3;
+        } else
+            search->plane++;
+
+        if (search->plane < 3) {
+            EbPictureBufferDesc *recon_buffer;
+            svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+            search->filt_start = filter_level_search_start(
+                pcs, search->last_frame_filter_level, search->plane, search->plane == 0 ? 2 : 0);
+            memset(search->ss_err, 0xFF, sizeof(search->ss_err));
+            svt_copy_buffer(recon_buffer,
+                            is_16bit ? pcs->temp_lf_recon_pic_16bit : pcs->temp_lf_recon_pic,
+                            pcs,
+                            (uint8_t)search->plane);
+        }
+    }
+    EB_DELETE(pcs->temp_lf_recon_pic);
+    EB_DELETE(pcs->temp_lf_recon_pic_16bit);
+    svt_av1_loop_filter_frame_init(frm_hdr, &pcs->ppcs->lf_info, 0, 3);
+}
+/*************************************************************************************************
+* svt_av1_pick_filter_level_segments_start
+* Start the search of svt_av1_pick_filter_level(LPF_PICK_FROM_FULL_IMAGE) with the trial
+* filterings split in SB-row segments, and set up the first pass
+*************************************************************************************************/
+EbErrorType svt_av1_pick_filter_level_segments_start(PictureControlSet *pcs) {
+    DlfSearch               *search   = &pcs->dlf_search;
+    struct LoopFilter *const lf       = &pcs->ppcs->frm_hdr.loop_filter_params;
+    Bool                     is_16bit = pcs->scs->is_16bit_pipeline;
+
+    set_sharpness_level(pcs);
+    EbErrorType return_error = temp_lf_recon_ctor(pcs);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    if (pcs->ppcs->dlf_ctrls.dlf_avg && pcs->ppcs->tot_ref_frame_types > 0)
+        set_avg_ref_filter_level(pcs);
+
+    search->last_frame_filter_level[0] = lf->filter_level[0];
+    search->last_frame_filter_level[1] = lf->filter_level[1];
+    search->last_frame_filter_level[2] = lf->filter_level_u;
+    search->last_frame_filter_level[3] = lf->filter_level_v;
+
+    EbPictureBufferDesc *recon_buffer;
+    svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+    search->plane      = 0;
+    search->filt_start = filter_level_search_start(pcs, search->last_frame_filter_level, 0, 2);
+    memset(search->ss_err, 0xFF, sizeof(search->ss_err));
+    svt_copy_buffer(recon_buffer, is_16bit ? pcs->temp_lf_recon_pic_16bit : pcs->temp_lf_recon_pic, pcs, 0);
+
+    dlf_search_next_pass(pcs);
+    return EB_ErrorNone;
+}
+/*************************************************************************************************
+* svt_av1_pick_filter_level_segments_next
+* Called once every segment of the pass is done, with the SSE of the pass. Set up the next pass,
+* returns FALSE once the final filtering of the picture is over
+*************************************************************************************************/
+Bool svt_av1_pick_filter_level_segments_next(PictureControlSet *pcs, uint64_t pass_sse) {
+    DlfSearch *search = &pcs->dlf_search;
+
+    if (search->plane == 3)
+        return FALSE;
+    search->ss_err[search->level] = (int64_t)pass_sse;
+    dlf_search_next_pass(pcs);
+    return TRUE;
+}
+/*************************************************************************************************
+* svt_av1_loop_filter_segment
+* Filter the SB row segment_index in the current pass, a wavefront behind the row above. For a
+* trial filtering, returns the SSE of the lines the segment leaves final and puts them back
+* unfiltered: the lines from 8 above the row, as the horizontal edges on the top of the row
+* change at most 6 lines above, to 8 above the next row
+*************************************************************************************************/
+uint64_t svt_av1_loop_filter_segment(EbPictureBufferDesc *recon_buffer, PictureControlSet *pcs,
+                                     uint32_t segment_index) {
+    DlfSearch     *search      = &pcs->dlf_search;
+    const uint32_t sb_size     = pcs->scs->sb_size;
+    const int32_t  plane_start = search->plane == 3 ? 0 : search->plane;
+    const int32_t  plane_end   = search->plane == 3 ? 3 : search->plane + 1;
+
+    loop_filter_sb_row(recon_buffer,
+                       pcs,
+                       segment_index,
+                       plane_start,
+                       plane_end,
+                       segment_index ? &pcs->dlf_row_progress[segment_index - 1] : NULL,
+                       &pcs->dlf_row_progress[segment_index]);
+    if (search->plane == 3)
+        return 0;
+
+    Bool                 is_16bit    = pcs->scs->is_16bit_pipeline;
+    EbPictureBufferDesc *temp_buffer = is_16bit ? pcs->temp_lf_recon_pic_16bit : pcs->temp_lf_recon_pic;
+    const Bool           last_row    = segment_index == (uint32_t)pcs->dlf_segments_total_count - 1;
+    const uint32_t       y_start     = segment_index ? segment_index * sb_size - 8 : 0;
+    const uint32_t       y_end       = (segment_index + 1) * sb_size - 8;
+
+    const uint32_t sse_height  = pcs->ppcs->aligned_height;
+    const uint32_t copy_height = ALIGN_POWER_OF_TWO(temp_buffer->height, 3);
+    const uint64_t sse         = picture_sse_calculations(pcs,
+                                                  recon_buffer,
+                                                  search->plane,
+                                                  AOMMIN(y_start, sse_height),
+                                                  last_row ? sse_height : AOMMIN(y_end, sse_height));
+    // Re-instate the unfiltered lines
+    copy_buffer_lines(temp_buffer,
+                      recon_buffer,
+                      is_16bit,
+                      (uint8_t)search->plane,
+                      AOMMIN(y_start, copy_height),
+                      last_row ? copy_height : AOMMIN(y_end, copy_height));
+    return sse;
+}
@@ -55,6 +55,15 @@ EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source
                                       PictureControlSet *pcs, LpfPickMethod method);
 void        svt_av1_pick_filter_level_by_q(PictureControlSet *pcs, uint8_t qindex, int32_t *filter_level);
 
+/* svt_av1_pick_filter_level(LPF_PICK_FROM_FULL_IMAGE) and svt_av1_loop_filter_frame() split in
+   SB-row segments filtered by several threads, with the same output. The picture is filtered in
+   passes, every segment of a pass calls svt_av1_loop_filter_segment() and once they are all done
+   svt_av1_pick_filter_level_segments_next() sets up the next pass. */
+EbErrorType svt_av1_pick_filter_level_segments_start(PictureControlSet *pcs);
+Bool        svt_av1_pick_filter_level_segments_next(PictureControlSet *pcs, uint64_t pass_sse);
+uint64_t    svt_av1_loop_filter_segment(EbPictureBufferDesc *recon_buffer, PictureControlSet *pcs,
+                                        uint32_t segment_index);
+
 void svt_av1_filter_block_plane_vert(const PictureControlSet *const pcs, const int32_t plane,
                                      const MacroblockdPlane *const plane_ptr, const uint32_t mi_row,
                                      const uint32_t mi_col);
@@ -38,6 +38,7 @@ extern "C" {
 #define TASK_TFME 1
 #define TASK_SUPERRES_RE_ME 3
 #define TASK_DG_DETECTOR_HME 4
+#define TASK_GM 5
 #define MAX_TPL_GROUP_SIZE 512 //enough to cover 6L gop
 
 #define MAX_TPL_EXT_GROUP_SIZE MAX_TPL_GROUP_SIZE
@@ -2272,8 +2273,8 @@ typedef struct EbMemoryMapEntry
 #define EB_DESTROY_SEMAPHORE(pointer) \
     do { \
         if (pointer) { \
+            EB_REMOVE_MEM(pointer, EB_SEMAPHORE); \
             svt_destroy_semaphore(pointer); \
-            EB_REMOVE_MEM_ENTRY(pointer, EB_SEMAPHORE); \
             pointer = NULL; \
         } \
     }while (0)
@@ -2287,8 +2288,8 @@ typedef struct EbMemoryMapEntry
 #define EB_DESTROY_MUTEX(pointer) \
     do { \
         if (pointer) { \
+            EB_REMOVE_MEM(pointer, EB_MUTEX); \
             svt_destroy_mutex(pointer); \
-            EB_REMOVE_MEM_ENTRY(pointer, EB_MUTEX); \
             pointer = NULL; \
         } \
     } while (0)
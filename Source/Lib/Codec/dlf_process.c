@@ -35,7 +35,8 @@ static void dlf_context_dctor(EbPtr p) {
 /******************************************************
  * Dlf Context Constructor
  ******************************************************/
-EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index) {
+EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index,
+                                     int feedback_index) {
     DlfContext *context_ptr;
     EB_CALLOC_ARRAY(context_ptr, 1);
     thread_ctx->priv  = context_ptr;
@@ -46,9 +47,92 @@ EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHan
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     context_ptr->dlf_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->dlf_results_resource_ptr,
                                                                              index);
+    context_ptr->dlf_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->enc_dec_results_resource_ptr, feedback_index);
     return EB_ErrorNone;
 }
 
+/******************************************************
+ * post_dlf_segments
+ * Post one task per SB row for the next pass of the picture
+ ******************************************************/
+static void post_dlf_segments(DlfContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper) {
+    pcs->tot_seg_filtered_dlf = 0;
+    pcs->dlf_pass_sse         = 0;
+    for (uint32_t segment_index = 0; segment_index < pcs->dlf_segments_total_count; ++segment_index)
+        svt_set_cond_var(&pcs->dlf_row_progress[segment_index], 0);
+
+    for (uint32_t segment_index = 0; segment_index < pcs->dlf_segments_total_count; ++segment_index) {
+        EbObjectWrapper *segment_wrapper;
+        svt_get_empty_object(context_ptr->dlf_feedback_fifo_ptr, &segment_wrapper);
+        EncDecResults *segment_task = (EncDecResults *)segment_wrapper->object_ptr;
+        segment_task->pcs_wrapper   = pcs_wrapper;
+        segment_task->input_type    = DLF_TASKS_DLF_INPUT;
+        segment_task->segment_index = segment_index;
+        svt_post_full_object(segment_wrapper);
+    }
+}
+
+/******************************************************
+ * post_cdef_segments
+ * Prepare the deblocked picture for CDEF and post the CDEF segments
+ ******************************************************/
+static void post_cdef_segments(DlfContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper) {
+    PictureParentControlSet *ppcs     = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->scs;
+    Bool                     is_16bit = scs->is_16bit_pipeline;
+
+    //// Output
+    EbObjectWrapper   *dlf_results_wrapper;
+    struct DlfResults *dlf_results;
+
+    //pre-cdef prep
+    {
+        EbPictureBufferDesc *recon_pic;
+        svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
+
+        Av1Common *cm = pcs->ppcs->av1_cm;
+        if (ppcs->enable_restoration) {
+            svt_aom_link_eb_to_aom_buffer_desc(
+                recon_pic, cm->frame_to_show, scs->max_input_pad_right, scs->max_input_pad_bottom, is_16bit);
+            svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+        }
+
+        if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
+            const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
+            pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
+            const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
+            pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
+            const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
+            pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
+
+            EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
+            const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
+            pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
+            const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
+            pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
+            const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
+            pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
+        }
+    }
+
+    pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
+    pcs->cdef_segments_row_count    = scs->cdef_segment_row_count;
+    pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
+    pcs->tot_seg_searched_cdef      = 0;
+    uint32_t segment_index;
+
+    for (segment_index = 0; segment_index < pcs->cdef_segments_total_count; ++segment_index) {
+        // Get Empty DLF Results to Cdef
+        svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
+        dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
+        dlf_results->pcs_wrapper   = pcs_wrapper;
+        dlf_results->segment_index = segment_index;
+        // Post DLF Results
+        svt_post_full_object(dlf_results_wrapper);
+    }
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
@@ -63,21 +147,39 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
     EbObjectWrapper *enc_dec_results_wrapper;
     EncDecResults   *enc_dec_results;
 
-    //// Output
-    EbObjectWrapper   *dlf_results_wrapper;
-    struct DlfResults *dlf_results;
-
     // SB Loop variables
     for (;;) {
         // Get EncDec Results
         EB_GET_FULL_OBJECT(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper);
 
-        enc_dec_results               = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-        pcs                           = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
-        PictureParentControlSet *ppcs = pcs->ppcs;
-        scs                           = pcs->scs;
+        enc_dec_results = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
+        pcs             = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
+        scs = pcs->scs;
 
         Bool is_16bit = scs->is_16bit_pipeline;
+        if (enc_dec_results->input_type == DLF_TASKS_DLF_INPUT) {
+            // SB-row segment of a pass
+            EbPictureBufferDesc *recon_buffer;
+            svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+            const uint64_t sse = svt_av1_loop_filter_segment(recon_buffer, pcs, enc_dec_results->segment_index);
+
+            svt_block_on_mutex(pcs->dlf_segment_mutex);
+            pcs->dlf_pass_sse += sse;
+            const Bool last_segment = ++pcs->tot_seg_filtered_dlf == pcs->dlf_segments_total_count;
+            svt_release_mutex(pcs->dlf_segment_mutex);
+
+            if (last_segment) {
+                if (svt_av1_pick_filter_level_segments_next(pcs, pcs->dlf_pass_sse))
+                    post_dlf_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper);
+                else
+                    post_cdef_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper);
+            }
+            // Release EncDec Results
+            svt_release_object(enc_dec_results_wrapper);
+            continue;
+        }
+
         if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
             svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
                                           pcs->input_frame16bit,
@@ -101,56 +203,25 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
             EbPictureBufferDesc *recon_buffer;
             svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
             svt_av1_loop_filter_init(pcs);
-            svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
-
-            svt_av1_loop_filter_frame(recon_buffer, pcs, 0, 3);
-        }
-
-        //pre-cdef prep
-        {
-            EbPictureBufferDesc *recon_pic;
-            svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
 
-            Av1Common *cm = pcs->ppcs->av1_cm;
-            if (ppcs->enable_restoration) {
-                svt_aom_link_eb_to_aom_buffer_desc(
-                    recon_pic, cm->frame_to_show, scs->max_input_pad_right, scs->max_input_pad_bottom, is_16bit);
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+            // Split the picture in SB rows when there is more than one DLF thread to filter them
+            pcs->dlf_segments_total_count = scs->dlf_process_init_count > 1
+                ? (uint16_t)((pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size)
+                : 1;
+            if (pcs->dlf_segments_total_count > 1) {
+                EbErrorType err = svt_av1_pick_filter_level_segments_start(pcs);
+                svt_aom_assert_err(err == EB_ErrorNone, "Couldn't start the segmented DLF level search");
+                post_dlf_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper);
+                // Release EncDec Results
+                svt_release_object(enc_dec_results_wrapper);
+                continue;
             }
+            svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
 
-            if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
-                const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
-                pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
-                const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
-                pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
-                const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
-                pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
-
-                EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
-                const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
-                pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
-                const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
-                pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
-                const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
-                pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
-            }
+            svt_av1_loop_filter_frame(recon_buffer, pcs, 0, 3);
         }
 
-        pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
-        pcs->cdef_segments_row_count    = scs->cdef_segment_row_count;
-        pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
-        pcs->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < pcs->cdef_segments_total_count; ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
-            dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
-            dlf_results->pcs_wrapper   = enc_dec_results->pcs_wrapper;
-            dlf_results->segment_index = segment_index;
-            // Post DLF Results
-            svt_post_full_object(dlf_results_wrapper);
-        }
+        post_cdef_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper);
 
         // Release EncDec Results
         svt_release_object(enc_dec_results_wrapper);
@@ -23,12 +23,15 @@
 typedef struct DlfContext {
     EbFifo *dlf_input_fifo_ptr;
     EbFifo *dlf_output_fifo_ptr;
+    // Posts the SB-row segments of a picture back to the DLF input
+    EbFifo *dlf_feedback_fifo_ptr;
 } DlfContext;
 
 /**************************************
  * Extern Function Declarations
  **************************************/
-extern EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index);
+extern EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index,
+                                            int feedback_index);
 
 extern void *svt_aom_dlf_kernel(void *input_ptr);
 
@@ -45,8 +45,7 @@ EbErrorType svt_aom_entropy_coding_context_ctor(EbThreadContext *thread_ctx, con
     // Input/Output System Resource Manager FIFOs
     context_ptr->enc_dec_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
         enc_handle_ptr->rest_results_resource_ptr, index);
-    context_ptr->entropy_coding_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->entropy_coding_results_resource_ptr, index);
+    context_ptr->entropy_coding_results_port = index;
     context_ptr->rate_control_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->rate_control_tasks_resource_ptr, rate_control_index);
 
@@ -223,6 +222,7 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
 
         RestResults        *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
         PictureControlSet  *pcs          = (PictureControlSet *)rest_results->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet *scs          = pcs->scs;
         // SB Constants
 
@@ -302,16 +302,18 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
                     }
                 }
 
-                //free palette data
-                if (pcs->tile_tok[0][0])
-                    EB_FREE_ARRAY(pcs->tile_tok[0][0]);
+                // the palette data is in the pcs arena, given back when the pcs is released
+                pcs->tile_tok[0][0] = NULL;
             }
             frame_entropy_done = TRUE;
         }
 
         if (frame_entropy_done) {
             // Get Empty Entropy Coding Results
-            svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
+            svt_get_empty_object(
+                svt_system_resource_get_producer_fifo(scs->enc_ctx->entropy_coding_results_resource_ptr,
+                                                      context_ptr->entropy_coding_results_port),
+                &entropy_coding_results_wrapper_ptr);
             entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
             entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
 
@@ -28,7 +28,7 @@
 typedef struct EntropyCodingContext {
     EbDctor  dctor;
     EbFifo  *enc_dec_input_fifo_ptr;
-    EbFifo  *entropy_coding_output_fifo_ptr; // to packetization
+    uint32_t entropy_coding_results_port; // to packetization, the queue is the one of the picture stream
     EbFifo  *rate_control_output_fifo_ptr; // feedback to rate control
     uint32_t sb_total_count;
     // Coding Unit Workspace---------------------------
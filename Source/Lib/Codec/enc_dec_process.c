@@ -20,6 +20,8 @@
 #include "utility.h"
 //To fix warning C4013: 'svt_convert_16bit_to_8bit' undefined; assuming extern returning int
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
+#include "pic_operators.h"
 #include "rd_cost.h"
 #include "pd_process.h"
 #include "firstpass.h"
@@ -29,8 +31,6 @@
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
-void svt_c_unpack_compressed_10bit(const uint8_t *inn_bit_buffer, uint32_t inn_stride, uint8_t *in_compn_bit_buffer,
-                                   uint32_t out_stride, uint32_t height);
 
 static void enc_dec_context_dctor(EbPtr p) {
     EbThreadContext *thread_ctx = (EbThreadContext *)p;
@@ -474,14 +474,60 @@ static void svt_av1_add_film_grain(EbPictureBufferDesc *src, EbPictureBufferDesc
     return;
 }
 void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
-    EncodeContext *enc_ctx = scs->enc_ctx;
+    EncodeContext       *enc_ctx                 = scs->enc_ctx;
+    Bool                 is_16bit                = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
+    EbPictureBufferDesc *recon_ptr               = NULL;
+    EbPictureBufferDesc *intermediate_buffer_ptr = NULL;
+
+    if (!pcs->ppcs->is_alt_ref) {
+        svt_aom_get_recon_pic(pcs, &recon_ptr, is_16bit);
+        // FGN: Create a buffer if needed, copy the reconstructed picture and run the film grain synthesis algorithm.
+        // The synthesis only depends on the picture, so it is done before the protected section to not serialize
+        // the pictures on it
+        if (scs->seq_header.film_grain_params_present && pcs->ppcs->frm_hdr.film_grain_params.apply_grain) {
+            AomFilmGrain *film_grain_ptr;
+
+            uint16_t                    padding = scs->super_block_size + 32;
+            EbPictureBufferDescInitData temp_recon_desc_init_data;
+            temp_recon_desc_init_data.max_width          = (uint16_t)scs->max_input_luma_width;
+            temp_recon_desc_init_data.max_height         = (uint16_t)scs->max_input_luma_height;
+            temp_recon_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+
+            temp_recon_desc_init_data.left_padding  = padding;
+            temp_recon_desc_init_data.right_padding = padding;
+            temp_recon_desc_init_data.top_padding   = padding;
+            temp_recon_desc_init_data.bot_padding   = padding;
+            temp_recon_desc_init_data.split_mode    = FALSE;
+            temp_recon_desc_init_data.color_format  = scs->static_config.encoder_color_format;
+
+            if (is_16bit) {
+                temp_recon_desc_init_data.bit_depth = EB_SIXTEEN_BIT;
+            } else {
+                temp_recon_desc_init_data.bit_depth = EB_EIGHT_BIT;
+            }
+
+            EB_NO_THROW_NEW(
+                intermediate_buffer_ptr, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_recon_desc_init_data);
+
+            if (pcs->ppcs->is_ref == TRUE)
+                film_grain_ptr = &((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->film_grain_params;
+            else
+                film_grain_ptr = &pcs->ppcs->frm_hdr.film_grain_params;
+
+            if (intermediate_buffer_ptr) {
+                svt_av1_add_film_grain(recon_ptr, intermediate_buffer_ptr, film_grain_ptr);
+                recon_ptr = intermediate_buffer_ptr;
+            }
+        }
+        // End running the film grain
+    }
+
     // The totalNumberOfReconFrames counter has to be write/read protected as
     //   it is used to determine the end of the stream.  If it is not protected
     //   the encoder might not properly terminate.
     svt_block_on_mutex(enc_ctx->total_number_of_recon_frame_mutex);
 
     if (!pcs->ppcs->is_alt_ref) {
-        Bool             is_16bit = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
         EbObjectWrapper *output_recon_wrapper_ptr;
         // Get Recon Buffer
         svt_get_empty_object(scs->enc_ctx->recon_output_fifo_ptr, &output_recon_wrapper_ptr);
@@ -503,50 +549,9 @@ void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
             uint8_t *recon_read_ptr;
             uint8_t *recon_write_ptr;
 
-            EbPictureBufferDesc *recon_ptr;
-            EbPictureBufferDesc *intermediate_buffer_ptr = NULL;
-            svt_aom_get_recon_pic(pcs, &recon_ptr, is_16bit);
-
             const uint32_t color_format = recon_ptr->color_format;
             const uint16_t ss_x         = (color_format == EB_YUV444 ? 1 : 2) - 1;
             const uint16_t ss_y         = (color_format >= EB_YUV422 ? 1 : 2) - 1;
-            // FGN: Create a buffer if needed, copy the reconstructed picture and run the film grain synthesis algorithm
-            if (scs->seq_header.film_grain_params_present && pcs->ppcs->frm_hdr.film_grain_params.apply_grain) {
-                AomFilmGrain *film_grain_ptr;
-
-                uint16_t                    padding = scs->super_block_size + 32;
-                EbPictureBufferDescInitData temp_recon_desc_init_data;
-                temp_recon_desc_init_data.max_width          = (uint16_t)scs->max_input_luma_width;
-                temp_recon_desc_init_data.max_height         = (uint16_t)scs->max_input_luma_height;
-                temp_recon_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
-
-                temp_recon_desc_init_data.left_padding  = padding;
-                temp_recon_desc_init_data.right_padding = padding;
-                temp_recon_desc_init_data.top_padding   = padding;
-                temp_recon_desc_init_data.bot_padding   = padding;
-                temp_recon_desc_init_data.split_mode    = FALSE;
-                temp_recon_desc_init_data.color_format  = scs->static_config.encoder_color_format;
-
-                if (is_16bit) {
-                    temp_recon_desc_init_data.bit_depth = EB_SIXTEEN_BIT;
-                } else {
-                    temp_recon_desc_init_data.bit_depth = EB_EIGHT_BIT;
-                }
-
-                EB_NO_THROW_NEW(
-                    intermediate_buffer_ptr, svt_recon_picture_buffer_desc_ctor, (EbPtr)&temp_recon_desc_init_data);
-
-                if (pcs->ppcs->is_ref == TRUE)
-                    film_grain_ptr = &((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->film_grain_params;
-                else
-                    film_grain_ptr = &pcs->ppcs->frm_hdr.film_grain_params;
-
-                if (intermediate_buffer_ptr) {
-                    svt_av1_add_film_grain(recon_ptr, intermediate_buffer_ptr, film_grain_ptr);
-                    recon_ptr = intermediate_buffer_ptr;
-                }
-            }
-            // End running the film grain
 
             // set output recon frame size to original size when enable resize feature
             // easy to display in tool and analysis
@@ -668,37 +673,6 @@ void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
 // Calculate Frame SSIM
 /************************************/
 
-static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
-                                     uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
-    int i, j;
-    for (i = 0; i < 8; i++, s += sp, r += rp) {
-        for (j = 0; j < 8; j++) {
-            *sum_s += s[j];
-            *sum_r += r[j];
-            *sum_sq_s += s[j] * s[j];
-            *sum_sq_r += r[j] * r[j];
-            *sum_sxr += s[j] * r[j];
-        }
-    }
-}
-
-static void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
-                                            int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
-                                            uint32_t *sum_sq_r, uint32_t *sum_sxr) {
-    int      i, j;
-    uint32_t ss;
-    for (i = 0; i < 8; i++, s += sp, sinc += spinc, r += rp) {
-        for (j = 0; j < 8; j++) {
-            ss = (int64_t)(s[j] << 2) + ((sinc[j] >> 6) & 0x3);
-            *sum_s += ss;
-            *sum_r += r[j];
-            *sum_sq_s += ss * ss;
-            *sum_sq_r += r[j] * r[j];
-            *sum_sxr += ss * r[j];
-        }
-    }
-}
-
 static const int64_t cc1    = 26634; // (64^2*(.01*255)^2
 static const int64_t cc2    = 239708; // (64^2*(.03*255)^2
 static const int64_t cc1_10 = 428658; // (64^2*(.01*1023)^2
@@ -734,25 +708,6 @@ double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t su
     return ssim_n / ssim_d;
 }
 
-static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
-    uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_ssim_parms_8x8_c(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
-    return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
-}
-
-static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp,
-                              uint32_t bd, uint32_t shift) {
-    uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_highbd_ssim_parms_8x8_c(s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
-    return similarity(sum_s >> shift,
-                      sum_r >> shift,
-                      sum_sq_s >> (2 * shift),
-                      sum_sq_r >> (2 * shift),
-                      sum_sxr >> (2 * shift),
-                      64,
-                      bd);
-}
-
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
@@ -770,7 +725,7 @@ static double aom_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img
     // sample point start with each 4x4 location
     for (i = 0; i <= height - 8; i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
         for (j = 0; j <= width - 8; j += 4) {
-            double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
+            double v = svt_ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
             ssim_total += v;
             samples++;
         }
@@ -780,9 +735,9 @@ static double aom_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img
     return ssim_total;
 }
 
-static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img1inc, int stride_img1inc,
-                               const uint16_t *img2, int stride_img2, int width, int height, uint32_t bd,
-                               uint32_t shift) {
+// Both the source and the recon are 10 bit here, so svt_ssim_8x8_hbd() is used as is
+static double aom_highbd_ssim2(const uint16_t *img1, int stride_img1, const uint16_t *img2, int stride_img2,
+                               int width, int height) {
     int    i, j;
     int    samples    = 0;
     double ssim_total = 0;
@@ -793,11 +748,9 @@ static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8
     }
 
     // sample point start with each 4x4 location
-    for (i = 0; i <= height - 8;
-         i += 4, img1 += stride_img1 * 4, img1inc += stride_img1inc * 4, img2 += stride_img2 * 4) {
+    for (i = 0; i <= height - 8; i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
         for (j = 0; j <= width - 8; j += 4) {
-            double v = highbd_ssim_8x8(
-                (img1 + j), stride_img1, (img1inc + j), stride_img1inc, (img2 + j), stride_img2, bd, shift);
+            double v = svt_ssim_8x8_hbd(img1 + j, stride_img1, img2 + j, stride_img2);
             ssim_total += v;
             samples++;
         }
@@ -807,6 +760,107 @@ static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8
     return ssim_total;
 }
 
+#define STAT_SSE_STRIP_HEIGHT 64
+
+// Sum of squared errors of a plane. The distortion kernels take widths in multiples of 4 and the narrow ones take
+// the rows in pairs, so the last columns and row of odd sized planes are summed here.
+static uint64_t plane_sse(uint8_t *src, uint32_t src_stride, uint8_t *rec, uint32_t rec_stride, uint32_t width,
+                          uint32_t height) {
+    const uint32_t width_4  = width & ~3u;
+    const uint32_t height_2 = height & ~1u;
+    uint64_t       sse      = 0;
+
+    for (uint32_t y = 0; width_4 && y < height_2; y += STAT_SSE_STRIP_HEIGHT)
+        sse += svt_spatial_full_distortion_kernel(src,
+                                                  y * src_stride,
+                                                  src_stride,
+                                                  rec,
+                                                  y * rec_stride,
+                                                  rec_stride,
+                                                  width_4,
+                                                  MIN(STAT_SSE_STRIP_HEIGHT, height_2 - y));
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = y < height_2 ? width_4 : 0; x < width; ++x)
+            sse += (int64_t)SQR((int64_t)src[y * src_stride + x] - rec[y * rec_stride + x]);
+    return sse;
+}
+
+static uint64_t highbd_plane_sse(uint16_t *src, uint32_t src_stride, uint16_t *rec, uint32_t rec_stride,
+                                 uint32_t width, uint32_t height) {
+    const uint32_t width_4  = width & ~3u;
+    const uint32_t height_2 = height & ~1u;
+    uint64_t       sse      = 0;
+
+    for (uint32_t y = 0; width_4 && y < height_2; y += STAT_SSE_STRIP_HEIGHT)
+        sse += svt_full_distortion_kernel16_bits((uint8_t *)src,
+                                                 y * src_stride,
+                                                 src_stride,
+                                                 (uint8_t *)rec,
+                                                 y * rec_stride,
+                                                 rec_stride,
+                                                 width_4,
+                                                 MIN(STAT_SSE_STRIP_HEIGHT, height_2 - y));
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = y < height_2 ? width_4 : 0; x < width; ++x)
+            sse += (int64_t)SQR((int64_t)src[y * src_stride + x] - rec[y * rec_stride + x]);
+    return sse;
+}
+
+// Packs the 10 bit source planes, or their copy saved before temporal filtering, into 16 bit planes of the padded
+// picture size (the plane width being the stride)
+static EbErrorType pack_source_planes_16bit(PictureControlSet *pcs, SequenceControlSet *scs, uint16_t *src16[3]) {
+    EbPictureBufferDesc *input_pic = pcs->ppcs->enhanced_unscaled_pic;
+    uint8_t             *buffer[3] = {input_pic->buffer_y, input_pic->buffer_cb, input_pic->buffer_cr};
+    uint8_t *buffer_bit_inc[3]     = {input_pic->buffer_bit_inc_y, input_pic->buffer_bit_inc_cb, input_pic->buffer_bit_inc_cr};
+    const uint32_t stride[3]       = {input_pic->stride_y, input_pic->stride_cb, input_pic->stride_cr};
+    const uint32_t stride_bit_inc[3] = {
+        input_pic->stride_bit_inc_y, input_pic->stride_bit_inc_cb, input_pic->stride_bit_inc_cr};
+
+    for (int plane = 0; plane < 3; plane++) {
+        const uint32_t ss_x   = plane ? scs->subsampling_x : 0;
+        const uint32_t ss_y   = plane ? scs->subsampling_y : 0;
+        const uint32_t org_x  = input_pic->org_x >> ss_x;
+        const uint32_t org_y  = input_pic->org_y >> ss_y;
+        const uint32_t width  = input_pic->width >> ss_x;
+        const uint32_t height = input_pic->height >> ss_y;
+
+        EB_MALLOC_ARRAY(src16[plane], width * height);
+        if (pcs->ppcs->do_tf == TRUE) {
+            assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
+                   pcs->ppcs->save_source_picture_height == input_pic->height);
+            // the saved bit inc planes are unpacked, one byte per sample
+            svt_aom_pack2d_src(pcs->ppcs->save_source_picture_ptr[plane] + org_x + org_y * stride[plane],
+                               stride[plane],
+                               pcs->ppcs->save_source_picture_bit_inc_ptr[plane] + org_x +
+                                   org_y * stride_bit_inc[plane],
+                               stride_bit_inc[plane],
+                               src16[plane],
+                               width,
+                               width,
+                               height);
+        } else {
+            // the bit inc planes of the source are compressed, four samples per byte
+            svt_aom_compressed_pack_sb(buffer[plane] + org_x + org_y * stride[plane],
+                                       stride[plane],
+                                       buffer_bit_inc[plane] + org_x / 4 + org_y * (stride_bit_inc[plane] / 4),
+                                       stride_bit_inc[plane] / 4,
+                                       src16[plane],
+                                       width,
+                                       width,
+                                       height);
+        }
+    }
+    return EB_ErrorNone;
+}
+
+// The compressed 10 bit format SSIM only keeps the 8 most significant bits of the source, see
+// svt_aom_ssim_calculations()
+static void msb_to_16bit(const uint8_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width,
+                         uint32_t height) {
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x) dst[y * dst_stride + x] = src[y * src_stride + x] << 2;
+}
+
 void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *scs) {
     // save_source_picture_ptr will be allocated only if do_tf is true in svt_av1_init_temporal_filtering().
     if (!pcs->ppcs->do_tf) {
@@ -911,11 +965,8 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
         pcs->ppcs->cb_ssim   = cb_ssim;
         pcs->ppcs->cr_ssim   = cr_ssim;
 
-        if (free_memory && pcs->ppcs->do_tf == TRUE) {
-            EB_FREE_ARRAY(buffer_y);
-            EB_FREE_ARRAY(buffer_cb);
-            EB_FREE_ARRAY(buffer_cr);
-        }
+        if (free_memory && pcs->ppcs->do_tf == TRUE)
+            free_temporal_filtering_buffer(pcs, scs);
     } else {
         EbByte    input_buffer;
         uint16_t *recon_coeff_buffer;
@@ -939,35 +990,26 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             const uint32_t pic_width_in_sb  = (luma_width + 64 - 1) / 64;
             const uint32_t pic_height_in_sb = (luma_height + 64 - 1) / 64;
             const uint32_t chroma_height    = luma_height >> ss_y;
-            uint32_t       sb_num_in_height, sb_num_in_width, bd, shift;
-            uint8_t        zero_buffer[64 * 64];
-
-            bd    = 10;
-            shift = 0; // both input and output are 10 bit (bitdepth - input_bd)
-            memset(&zero_buffer[0], 0, sizeof(uint8_t) * 64 * 64);
+            uint32_t       sb_num_in_height, sb_num_in_width;
+            uint16_t       input_sb[64 * 64];
 
             EbByte input_buffer_org = &(
                 (input_pic->buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
             uint16_t *recon_buffer_org = (uint16_t *)(&(
                 (recon_ptr->buffer_y)[(recon_ptr->org_x << is_16bit) +
                                       (recon_ptr->org_y << is_16bit) * recon_ptr->stride_y]));
-            ;
 
             EbByte input_buffer_org_u = &(
                 (input_pic->buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-            ;
-            uint16_t *recon_buffer_org_u = recon_coeff_buffer = (uint16_t *)(&(
+            uint16_t *recon_buffer_org_u = (uint16_t *)(&(
                 (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cb]));
-            ;
 
             EbByte input_buffer_org_v = &(
                 (input_pic->buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-            ;
-            uint16_t *recon_buffer_org_v = recon_coeff_buffer = (uint16_t *)(&(
+            uint16_t *recon_buffer_org_v = (uint16_t *)(&(
                 (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cr]));
-            ;
 
             for (sb_num_in_height = 0; sb_num_in_height < pic_height_in_sb; ++sb_num_in_height) {
                 for (sb_num_in_width = 0; sb_num_in_width < pic_width_in_sb; ++sb_num_in_width) {
@@ -979,16 +1021,9 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
                     input_buffer       = input_buffer_org + tb_origin_y * input_pic->stride_y + tb_origin_x;
                     recon_coeff_buffer = recon_buffer_org + tb_origin_y * recon_ptr->stride_y + tb_origin_x;
 
-                    luma_ssim += aom_highbd_ssim2(input_buffer,
-                                                  input_pic->stride_y,
-                                                  &zero_buffer[0],
-                                                  64,
-                                                  recon_coeff_buffer,
-                                                  recon_ptr->stride_y,
-                                                  sb_width,
-                                                  sb_height,
-                                                  bd,
-                                                  shift);
+                    msb_to_16bit(input_buffer, input_pic->stride_y, input_sb, 64, sb_width, sb_height);
+                    luma_ssim += aom_highbd_ssim2(
+                        input_sb, 64, recon_coeff_buffer, recon_ptr->stride_y, sb_width, sb_height);
 
                     //U+V
                     tb_origin_x = sb_num_in_width * 32;
@@ -999,30 +1034,16 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
                     input_buffer       = input_buffer_org_u + tb_origin_y * input_pic->stride_cb + tb_origin_x;
                     recon_coeff_buffer = recon_buffer_org_u + tb_origin_y * recon_ptr->stride_cb + tb_origin_x;
 
-                    cb_ssim += aom_highbd_ssim2(input_buffer,
-                                                input_pic->stride_cb,
-                                                &zero_buffer[0],
-                                                64,
-                                                recon_coeff_buffer,
-                                                recon_ptr->stride_cb,
-                                                sb_width,
-                                                sb_height,
-                                                bd,
-                                                shift);
+                    msb_to_16bit(input_buffer, input_pic->stride_cb, input_sb, 64, sb_width, sb_height);
+                    cb_ssim += aom_highbd_ssim2(
+                        input_sb, 64, recon_coeff_buffer, recon_ptr->stride_cb, sb_width, sb_height);
 
                     input_buffer       = input_buffer_org_v + tb_origin_y * input_pic->stride_cr + tb_origin_x;
                     recon_coeff_buffer = recon_buffer_org_v + tb_origin_y * recon_ptr->stride_cr + tb_origin_x;
 
-                    cr_ssim += aom_highbd_ssim2(input_buffer,
-                                                input_pic->stride_cr,
-                                                &zero_buffer[0],
-                                                64,
-                                                recon_coeff_buffer,
-                                                recon_ptr->stride_cr,
-                                                sb_width,
-                                                sb_height,
-                                                bd,
-                                                shift);
+                    msb_to_16bit(input_buffer, input_pic->stride_cr, input_sb, 64, sb_width, sb_height);
+                    cr_ssim += aom_highbd_ssim2(
+                        input_sb, 64, recon_coeff_buffer, recon_ptr->stride_cr, sb_width, sb_height);
                 }
             }
 
@@ -1034,130 +1055,48 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             pcs->ppcs->cb_ssim   = cb_ssim;
             pcs->ppcs->cr_ssim   = cr_ssim;
         } else {
+            uint16_t   *input_16bit[3];
+            EbErrorType return_error = pack_source_planes_16bit(pcs, scs, input_16bit);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+
             recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_y)[(recon_ptr->org_x << is_16bit) +
                                       (recon_ptr->org_y << is_16bit) * recon_ptr->stride_y]));
-
-            // if current source picture was temporally filtered, use an alternative buffer which stores
-            // the original source picture
-            EbByte buffer_y, buffer_bit_inc_y;
-            EbByte buffer_cb, buffer_bit_inc_cb;
-            EbByte buffer_cr, buffer_bit_inc_cr;
-            int    bd, shift;
-
-            if (pcs->ppcs->do_tf == TRUE) {
-                assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
-                       pcs->ppcs->save_source_picture_height == input_pic->height);
-                buffer_y          = pcs->ppcs->save_source_picture_ptr[0];
-                buffer_bit_inc_y  = pcs->ppcs->save_source_picture_bit_inc_ptr[0];
-                buffer_cb         = pcs->ppcs->save_source_picture_ptr[1];
-                buffer_bit_inc_cb = pcs->ppcs->save_source_picture_bit_inc_ptr[1];
-                buffer_cr         = pcs->ppcs->save_source_picture_ptr[2];
-                buffer_bit_inc_cr = pcs->ppcs->save_source_picture_bit_inc_ptr[2];
-            } else {
-                uint32_t height_y  = (uint32_t)(input_pic->height + input_pic->org_y + input_pic->origin_bot_y);
-                uint32_t height_uv = (uint32_t)((input_pic->height + input_pic->org_y + input_pic->origin_bot_y) >>
-                                                ss_y);
-
-                uint8_t *uncompressed_pics[3];
-                EB_MALLOC_ARRAY(uncompressed_pics[0], pcs->ppcs->enhanced_unscaled_pic->luma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[1], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[2], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_y,
-                                              input_pic->stride_bit_inc_y / 4,
-                                              uncompressed_pics[0],
-                                              input_pic->stride_bit_inc_y,
-                                              height_y);
-                // U
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cb,
-                                              input_pic->stride_bit_inc_cb / 4,
-                                              uncompressed_pics[1],
-                                              input_pic->stride_bit_inc_cb,
-                                              height_uv);
-                // V
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cr,
-                                              input_pic->stride_bit_inc_cr / 4,
-                                              uncompressed_pics[2],
-                                              input_pic->stride_bit_inc_cr,
-                                              height_uv);
-
-                buffer_y          = input_pic->buffer_y;
-                buffer_bit_inc_y  = uncompressed_pics[0];
-                buffer_cb         = input_pic->buffer_cb;
-                buffer_bit_inc_cb = uncompressed_pics[1];
-                buffer_cr         = input_pic->buffer_cr;
-                buffer_bit_inc_cr = uncompressed_pics[2];
-            }
-
-            bd    = 10;
-            shift = 0; // both input and output are 10 bit (bitdepth - input_bd)
-
-            input_buffer                = &((buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-            EbByte input_buffer_bit_inc = &(
-                (buffer_bit_inc_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_bit_inc_y]);
-            luma_ssim = aom_highbd_ssim2(input_buffer,
-                                         input_pic->stride_y,
-                                         input_buffer_bit_inc,
-                                         input_pic->stride_bit_inc_y,
+            luma_ssim          = aom_highbd_ssim2(input_16bit[0],
+                                         input_pic->width,
                                          recon_coeff_buffer,
                                          recon_ptr->stride_y,
                                          scs->max_input_luma_width,
-                                         scs->max_input_luma_height,
-                                         bd,
-                                         shift);
+                                         scs->max_input_luma_height);
 
-            recon_coeff_buffer   = (uint16_t *)(&(
+            recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cb]));
-            input_buffer         = &((buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cb]);
-            cb_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cb,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cb,
+            cb_ssim            = aom_highbd_ssim2(input_16bit[1],
+                                       input_pic->width >> ss_x,
                                        recon_coeff_buffer,
                                        recon_ptr->stride_cb,
                                        scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
+                                       scs->chroma_height);
 
-            recon_coeff_buffer   = (uint16_t *)(&(
+            recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cr]));
-            input_buffer         = &((buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cr]);
-            cr_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cr,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cr,
+            cr_ssim            = aom_highbd_ssim2(input_16bit[2],
+                                       input_pic->width >> ss_x,
                                        recon_coeff_buffer,
                                        recon_ptr->stride_cr,
                                        scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
+                                       scs->chroma_height);
 
             pcs->ppcs->luma_ssim = luma_ssim;
             pcs->ppcs->cb_ssim   = cb_ssim;
             pcs->ppcs->cr_ssim   = cr_ssim;
 
-            if (free_memory && pcs->ppcs->do_tf == TRUE) {
-                EB_FREE_ARRAY(buffer_y);
-                EB_FREE_ARRAY(buffer_cb);
-                EB_FREE_ARRAY(buffer_cr);
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
-            if (pcs->ppcs->do_tf == FALSE) {
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
+            if (free_memory && pcs->ppcs->do_tf == TRUE)
+                free_temporal_filtering_buffer(pcs, scs);
+            for (int plane = 0; plane < 3; plane++) EB_FREE_ARRAY(input_16bit[plane]);
         }
     }
     EB_DELETE(upscaled_recon);
@@ -1193,8 +1132,7 @@ EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, B
     }
 
     if (!is_16bit) {
-        uint64_t sse_total[3]        = {0};
-        uint64_t residual_distortion = 0;
+        uint64_t sse_total[3] = {0};
         EbByte   input_buffer;
         EbByte   recon_coeff_buffer;
 
@@ -1216,67 +1154,40 @@ EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, B
             buffer_cr = input_pic->buffer_cr;
         }
 
+        const uint32_t luma_width  = input_pic->width - scs->max_input_pad_right;
+        const uint32_t luma_height = input_pic->height - scs->max_input_pad_bottom;
+
         recon_coeff_buffer = &((recon_ptr->buffer_y)[recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y]);
         input_buffer       = &(buffer_y[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-
-        residual_distortion = 0;
-
-        for (int row_index = 0; row_index < input_pic->height - scs->max_input_pad_bottom; ++row_index) {
-            for (int column_index = 0; column_index < input_pic->width - scs->max_input_pad_right; ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
-
-            input_buffer += input_pic->stride_y;
-            recon_coeff_buffer += recon_ptr->stride_y;
-        }
-
-        sse_total[0] = residual_distortion;
+        sse_total[0]       = plane_sse(
+            input_buffer, input_pic->stride_y, recon_coeff_buffer, recon_ptr->stride_y, luma_width, luma_height);
 
         recon_coeff_buffer = &(
             (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
         input_buffer = &(buffer_cb[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-
-        residual_distortion = 0;
-        for (int row_index = 0; row_index < (input_pic->height - scs->max_input_pad_bottom) >> ss_y; ++row_index) {
-            for (int column_index = 0; column_index < (input_pic->width - scs->max_input_pad_right) >> ss_x;
-                 ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
-
-            input_buffer += input_pic->stride_cb;
-            recon_coeff_buffer += recon_ptr->stride_cb;
-        }
-
-        sse_total[1] = residual_distortion;
+        sse_total[1] = plane_sse(input_buffer,
+                                 input_pic->stride_cb,
+                                 recon_coeff_buffer,
+                                 recon_ptr->stride_cb,
+                                 luma_width >> ss_x,
+                                 luma_height >> ss_y);
 
         recon_coeff_buffer = &(
             (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
-        input_buffer        = &(buffer_cr[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-        residual_distortion = 0;
-
-        for (int row_index = 0; row_index < (input_pic->height - scs->max_input_pad_bottom) >> ss_y; ++row_index) {
-            for (int column_index = 0; column_index < (input_pic->width - scs->max_input_pad_right) >> ss_x;
-                 ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
-
-            input_buffer += input_pic->stride_cr;
-            recon_coeff_buffer += recon_ptr->stride_cr;
-        }
+        input_buffer = &(buffer_cr[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
+        sse_total[2] = plane_sse(input_buffer,
+                                 input_pic->stride_cr,
+                                 recon_coeff_buffer,
+                                 recon_ptr->stride_cr,
+                                 luma_width >> ss_x,
+                                 luma_height >> ss_y);
 
-        sse_total[2]        = residual_distortion;
         pcs->ppcs->luma_sse = sse_total[0];
         pcs->ppcs->cb_sse   = sse_total[1];
         pcs->ppcs->cr_sse   = sse_total[2];
 
-        if (free_memory && pcs->ppcs->do_tf == TRUE) {
-            EB_FREE_ARRAY(buffer_y);
-            EB_FREE_ARRAY(buffer_cb);
-            EB_FREE_ARRAY(buffer_cr);
-        }
+        if (free_memory && pcs->ppcs->do_tf == TRUE)
+            free_temporal_filtering_buffer(pcs, scs);
     } else {
         uint64_t  sse_total[3]        = {0};
         uint64_t  residual_distortion = 0;
@@ -1457,141 +1368,42 @@ EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, B
             sse_total[1] = residual_distortion_u;
             sse_total[2] = residual_distortion_v;
         } else {
+            const uint32_t luma_width  = input_pic->width - scs->max_input_pad_right;
+            const uint32_t luma_height = input_pic->height - scs->max_input_pad_bottom;
+            uint16_t      *input_16bit[3];
+            EbErrorType    return_error = pack_source_planes_16bit(pcs, scs, input_16bit);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+
             recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_y)[(recon_ptr->org_x << is_16bit) +
                                       (recon_ptr->org_y << is_16bit) * recon_ptr->stride_y]));
+            sse_total[0]       = highbd_plane_sse(
+                input_16bit[0], input_pic->width, recon_coeff_buffer, recon_ptr->stride_y, luma_width, luma_height);
 
-            // if current source picture was temporally filtered, use an alternative buffer which stores
-            // the original source picture
-            EbByte buffer_y, buffer_bit_inc_y;
-            EbByte buffer_cb, buffer_bit_inc_cb;
-            EbByte buffer_cr, buffer_bit_inc_cr;
-
-            if (pcs->ppcs->do_tf == TRUE) {
-                assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
-                       pcs->ppcs->save_source_picture_height == input_pic->height);
-                buffer_y          = pcs->ppcs->save_source_picture_ptr[0];
-                buffer_bit_inc_y  = pcs->ppcs->save_source_picture_bit_inc_ptr[0];
-                buffer_cb         = pcs->ppcs->save_source_picture_ptr[1];
-                buffer_bit_inc_cb = pcs->ppcs->save_source_picture_bit_inc_ptr[1];
-                buffer_cr         = pcs->ppcs->save_source_picture_ptr[2];
-                buffer_bit_inc_cr = pcs->ppcs->save_source_picture_bit_inc_ptr[2];
-            } else {
-                uint32_t height_y  = (uint32_t)(input_pic->height + input_pic->org_y + input_pic->origin_bot_y);
-                uint32_t height_uv = (uint32_t)((input_pic->height + input_pic->org_y + input_pic->origin_bot_y) >>
-                                                ss_y);
-
-                uint8_t *uncompressed_pics[3];
-                EB_MALLOC_ARRAY(uncompressed_pics[0], pcs->ppcs->enhanced_unscaled_pic->luma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[1], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[2], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_y,
-                                              input_pic->stride_bit_inc_y / 4,
-                                              uncompressed_pics[0],
-                                              input_pic->stride_bit_inc_y,
-                                              height_y);
-                // U
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cb,
-                                              input_pic->stride_bit_inc_cb / 4,
-                                              uncompressed_pics[1],
-                                              input_pic->stride_bit_inc_cb,
-                                              height_uv);
-                // V
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cr,
-                                              input_pic->stride_bit_inc_cr / 4,
-                                              uncompressed_pics[2],
-                                              input_pic->stride_bit_inc_cr,
-                                              height_uv);
-
-                buffer_y          = input_pic->buffer_y;
-                buffer_bit_inc_y  = uncompressed_pics[0];
-                buffer_cb         = input_pic->buffer_cb;
-                buffer_bit_inc_cb = uncompressed_pics[1];
-                buffer_cr         = input_pic->buffer_cr;
-                buffer_bit_inc_cr = uncompressed_pics[2];
-            }
-
-            input_buffer         = &((buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_bit_inc_y]);
-
-            residual_distortion = 0;
-
-            for (int row_index = 0; row_index < input_pic->height - scs->max_input_pad_bottom; ++row_index) {
-                for (int column_index = 0; column_index < input_pic->width - scs->max_input_pad_right; ++column_index) {
-                    residual_distortion += (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                                   ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                                        (recon_coeff_buffer[column_index]));
-                }
-
-                input_buffer += input_pic->stride_y;
-                input_buffer_bit_inc += input_pic->stride_bit_inc_y;
-                recon_coeff_buffer += recon_ptr->stride_y;
-            }
-
-            sse_total[0] = residual_distortion;
-
-            recon_coeff_buffer   = (uint16_t *)(&(
+            recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cb]));
-            input_buffer         = &((buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cb]);
-
-            residual_distortion = 0;
-            for (int row_index = 0; row_index < (input_pic->height - scs->max_input_pad_bottom) >> ss_y; ++row_index) {
-                for (int column_index = 0; column_index < (input_pic->width - scs->max_input_pad_right) >> ss_x;
-                     ++column_index) {
-                    residual_distortion += (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                                   ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                                        (recon_coeff_buffer[column_index]));
-                }
+            sse_total[1]       = highbd_plane_sse(input_16bit[1],
+                                            input_pic->width >> ss_x,
+                                            recon_coeff_buffer,
+                                            recon_ptr->stride_cb,
+                                            luma_width >> ss_x,
+                                            luma_height >> ss_y);
 
-                input_buffer += input_pic->stride_cb;
-                input_buffer_bit_inc += input_pic->stride_bit_inc_cb;
-                recon_coeff_buffer += recon_ptr->stride_cb;
-            }
-
-            sse_total[1] = residual_distortion;
-
-            recon_coeff_buffer   = (uint16_t *)(&(
+            recon_coeff_buffer = (uint16_t *)(&(
                 (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
                                        (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cr]));
-            input_buffer         = &((buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cr]);
-
-            residual_distortion = 0;
-
-            for (int row_index = 0; row_index < (input_pic->height - scs->max_input_pad_bottom) >> ss_y; ++row_index) {
-                for (int column_index = 0; column_index < (input_pic->width - scs->max_input_pad_right) >> ss_x;
-                     ++column_index) {
-                    residual_distortion += (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                                   ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                                        (recon_coeff_buffer[column_index]));
-                }
-
-                input_buffer += input_pic->stride_cr;
-                input_buffer_bit_inc += input_pic->stride_bit_inc_cr;
-                recon_coeff_buffer += recon_ptr->stride_cr;
-            }
-
-            sse_total[2] = residual_distortion;
-
-            if (free_memory && pcs->ppcs->do_tf == TRUE) {
-                EB_FREE_ARRAY(buffer_y);
-                EB_FREE_ARRAY(buffer_cb);
-                EB_FREE_ARRAY(buffer_cr);
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
-            if (pcs->ppcs->do_tf == FALSE) {
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
+            sse_total[2]       = highbd_plane_sse(input_16bit[2],
+                                            input_pic->width >> ss_x,
+                                            recon_coeff_buffer,
+                                            recon_ptr->stride_cr,
+                                            luma_width >> ss_x,
+                                            luma_height >> ss_y);
+
+            if (free_memory && pcs->ppcs->do_tf == TRUE)
+                free_temporal_filtering_buffer(pcs, scs);
+            for (int plane = 0; plane < 3; plane++) EB_FREE_ARRAY(input_16bit[plane]);
         }
         pcs->ppcs->luma_sse = sse_total[0];
         pcs->ppcs->cb_sse   = sse_total[1];
@@ -3237,6 +3049,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
 
         EncDecTasks                    *enc_dec_tasks = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
         PictureControlSet              *pcs           = (PictureControlSet *)enc_dec_tasks->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet             *scs           = pcs->scs;
         ModeDecisionContext            *md_ctx        = ed_ctx->md_ctx;
         struct PictureParentControlSet *ppcs          = pcs->ppcs;
@@ -3263,6 +3076,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
             enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
             enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
+            enc_dec_results->input_type  = DLF_TASKS_ENCDEC_INPUT;
 
             // Post EncDec Results
             svt_post_full_object(enc_dec_results_wrapper);
@@ -3295,6 +3109,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 continue;
             }
 
+            // The rate groups that are not updated per SB only depend on the picture CDF, so take them from the
+            // picture level table built in MDC instead of re-estimating them in every EncDec task
             if (pcs->cdf_ctrl.enabled) {
                 if (!pcs->cdf_ctrl.update_mv)
                     copy_mv_rate(pcs, ed_ctx->md_ctx->rate_est_table);
@@ -3308,7 +3124,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                                                  pcs->ppcs->frm_hdr.allow_intrabc,
                                                  &pcs->md_frame_context);
                 if (!pcs->cdf_ctrl.update_coef)
-                    svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table, &pcs->md_frame_context);
+                    svt_aom_copy_coefficients_rate(ed_ctx->md_ctx->rate_est_table, pcs->md_rate_est_ctx);
             }
             // Segment-loop
             while (assign_enc_dec_segments(
@@ -3654,6 +3470,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
                     enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
                     enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
+                    enc_dec_results->input_type  = DLF_TASKS_ENCDEC_INPUT;
 
                     // Post EncDec Results
                     svt_post_full_object(enc_dec_results_wrapper);
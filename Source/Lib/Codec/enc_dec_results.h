@@ -18,12 +18,19 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define DLF_TASKS_ENCDEC_INPUT 0
+#define DLF_TASKS_DLF_INPUT 1
+
 /**************************************
  * Process Results
  **************************************/
 typedef struct EncDecResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    // DLF_TASKS_ENCDEC_INPUT for a picture out of EncDec, DLF_TASKS_DLF_INPUT for
+    // the SB-row segment segment_index of a picture being deblocked
+    uint8_t  input_type;
+    uint32_t segment_index;
 } EncDecResults;
 
 typedef struct DlfResults {
@@ -44,6 +51,11 @@ typedef struct RestResults {
     uint16_t         tile_index;
 } RestResults;
 
+typedef struct StatReportTasks {
+    EbDctor          dctor;
+    EbObjectWrapper *pcs_wrapper;
+} StatReportTasks;
+
 typedef struct EncDecResultsInitData {
     uint32_t junk;
 } EncDecResultsInitData;
@@ -121,6 +121,14 @@ bool svt_aom_need_gm_ref_info(EncMode enc_mode, bool super_res_off) {
     return pcs_tmp.gm_ctrls.use_ref_info;
 }
 
+/*
+ * Number of sub-pel planes each reference may keep for the MD sub-pel search (0: no cache). The presets refining the
+ * ME MVs with SUBPEL_TREE interpolate the same reference areas for every block size; three planes hold the half-pel
+ * phases of the filter they use, quarter and eighth-pel positions are still interpolated per block. The memory budget
+ * may lower the count, see scs->subpel_cache_planes.
+ */
+uint8_t svt_aom_get_subpel_cache_planes(EncMode enc_mode) { return enc_mode <= ENC_M5 ? 3 : 0; }
+
 uint8_t svt_aom_derive_gm_level(PictureParentControlSet *pcs, bool super_res_off) {
     uint8_t       gm_level  = 0;
     const EncMode enc_mode  = pcs->enc_mode;
@@ -41,6 +41,7 @@ void svt_aom_sig_deriv_me(SequenceControlSet *scs, PictureParentControlSet *pcs,
 
 void    svt_aom_sig_deriv_enc_dec(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx);
 bool    svt_aom_need_gm_ref_info(EncMode enc_mode, bool super_res_off);
+uint8_t svt_aom_get_subpel_cache_planes(EncMode enc_mode);
 uint8_t svt_aom_derive_gm_level(PictureParentControlSet *pcs, bool super_res_off);
 
 void    svt_aom_set_gm_controls(PictureParentControlSet *pcs, uint8_t gm_level);
@@ -10,6 +10,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "encode_context.h"
 #include "EbSvtAv1ErrorCodes.h"
@@ -51,6 +52,11 @@ static void destroy_stats_buffer(STATS_BUFFER_CTX *stats_buf_context, FIRSTPASS_
     EB_FREE_ARRAY(frame_stats_buffer);
     EB_DESTROY_MUTEX(stats_buf_context->stats_in_write_mutex);
 }
+typedef struct EncodeContextStart {
+    EncodeContext                   enc_ctx;
+    RateControlIntervalParamContext rc_param_queue[PARALLEL_GOP_MAX_NUMBER];
+} EncodeContextStart;
+
 static void encode_context_dctor(EbPtr p) {
     EncodeContext *obj = (EncodeContext *)p;
     EB_DESTROY_MUTEX(obj->total_number_of_recon_frame_mutex);
@@ -75,6 +81,7 @@ static void encode_context_dctor(EbPtr p) {
     EB_DELETE_PTR_ARRAY(obj->initial_rate_control_reorder_queue, INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->stats_out.stat);
+    EB_FREE(obj->stats_out.new_buf);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
 
@@ -82,6 +89,7 @@ static void encode_context_dctor(EbPtr p) {
         EB_FREE_2D(obj->rc_param_queue);
     EB_DESTROY_MUTEX(obj->rc_param_queue_mutex);
     EB_DESTROY_MUTEX(obj->rc.rc_mutex);
+    EB_FREE(obj->stream_start);
 }
 
 EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr) {
@@ -185,3 +193,87 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->roi_map_evt = NULL;
     return EB_ErrorNone;
 }
+
+/*
+ * Saves the state of the context once the encoder is initialized, before the first picture.
+ */
+EbErrorType svt_aom_encode_context_save_start(EncodeContext *enc_ctx) {
+    if (!enc_ctx->stream_start)
+        EB_MALLOC(enc_ctx->stream_start, sizeof(*enc_ctx->stream_start));
+    EncodeContextStart *start = enc_ctx->stream_start;
+    start->enc_ctx            = *enc_ctx;
+    for (int interval_index = 0; interval_index < PARALLEL_GOP_MAX_NUMBER; interval_index++)
+        start->rc_param_queue[interval_index] = *enc_ctx->rc_param_queue[interval_index];
+    return EB_ErrorNone;
+}
+
+/*
+ * Brings the context back to its saved state for a new stream, keeping the buffers and the
+ * mutexes. The pipeline must be idle and every picture released.
+ */
+void svt_aom_encode_context_reset(EncodeContext *enc_ctx) {
+    EncodeContextStart *start     = enc_ctx->stream_start;
+    FirstPassStatsOut   stats_out = enc_ctx->stats_out;
+    uint32_t            picture_index;
+
+    *enc_ctx                      = start->enc_ctx;
+    enc_ctx->stats_out.stat           = stats_out.stat;
+    enc_ctx->stats_out.size           = 0;
+    enc_ctx->stats_out.capability     = stats_out.capability;
+    enc_ctx->stats_out.ready          = 0;
+    enc_ctx->stats_out.flushed        = 0;
+    enc_ctx->stats_out.header_out     = 0;
+    enc_ctx->stats_out.new_buf        = stats_out.new_buf;
+    enc_ctx->stats_out.new_capability = stats_out.new_capability;
+    if (stats_out.stat)
+        memset(stats_out.stat, 0, stats_out.capability * sizeof(*stats_out.stat));
+    for (int interval_index = 0; interval_index < PARALLEL_GOP_MAX_NUMBER; interval_index++)
+        *enc_ctx->rc_param_queue[interval_index] = start->rc_param_queue[interval_index];
+    svt_av1_twopass_zero_stats(enc_ctx->stats_buf_context.total_left_stats);
+    svt_av1_twopass_zero_stats(enc_ctx->stats_buf_context.total_stats);
+
+    for (picture_index = 0; picture_index < PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH; ++picture_index) {
+        PictureDecisionReorderEntry *entry = enc_ctx->picture_decision_reorder_queue[picture_index];
+        entry->picture_number              = picture_index;
+        entry->ppcs_wrapper                = NULL;
+    }
+    for (picture_index = 0; picture_index < INPUT_QUEUE_MAX_DEPTH; ++picture_index) {
+        InputQueueEntry *entry = enc_ctx->input_picture_queue[picture_index];
+        const EbDctor    dctor = entry->dctor;
+        memset(entry, 0, sizeof(*entry));
+        entry->dctor = dctor;
+    }
+    for (picture_index = 0; picture_index < REF_FRAMES; ++picture_index) {
+        PaReferenceEntry *entry = enc_ctx->pd_dpb[picture_index];
+        const EbDctor     dctor = entry->dctor;
+        memset(entry, 0, sizeof(*entry));
+        entry->dctor = dctor;
+    }
+    for (picture_index = 0; picture_index < enc_ctx->ref_pic_list_length; ++picture_index) {
+        ReferenceQueueEntry *entry = enc_ctx->ref_pic_list[picture_index];
+        const EbDctor        dctor = entry->dctor;
+        memset(entry, 0, sizeof(*entry));
+        entry->dctor          = dctor;
+        entry->picture_number = ~0u;
+    }
+    for (picture_index = 0; picture_index < INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH; ++picture_index) {
+        InitialRateControlReorderEntry *entry = enc_ctx->initial_rate_control_reorder_queue[picture_index];
+        entry->picture_number                 = picture_index;
+        entry->ppcs_wrapper                   = NULL;
+    }
+    for (picture_index = 0; picture_index < PACKETIZATION_REORDER_QUEUE_MAX_DEPTH; ++picture_index) {
+        PacketizationReorderEntry *entry         = enc_ctx->packetization_reorder_queue[picture_index];
+        const EbDctor              dctor         = entry->dctor;
+        Bitstream *const           bitstream_ptr = entry->bitstream_ptr;
+        memset(entry, 0, sizeof(*entry));
+        entry->dctor          = dctor;
+        entry->picture_number = picture_index;
+        entry->bitstream_ptr  = bitstream_ptr;
+    }
+    for (picture_index = 0; picture_index < CODED_FRAMES_STAT_QUEUE_MAX_DEPTH; ++picture_index) {
+        coded_frames_stats_entry *entry = enc_ctx->rc.coded_frames_stat_queue[picture_index];
+        entry->picture_number           = picture_index;
+        entry->frame_total_bit_actual   = -1;
+        entry->end_of_sequence_flag     = FALSE;
+    }
+}
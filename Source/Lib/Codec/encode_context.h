@@ -50,6 +50,14 @@ typedef struct FirstPassStatsOut {
     FIRSTPASS_STATS *stat;
     size_t           size;
     size_t           capability;
+    // entries written without a gap from the first, count is 0 in the entries not written yet
+    size_t           ready;
+    // entries handed out by SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW, copied to new_buf after the
+    // SvtAv1StatsHeader the first time
+    size_t           flushed;
+    uint8_t          header_out;
+    uint8_t         *new_buf;
+    size_t           new_capability;
 } FirstPassStatsOut;
 
 typedef struct RateControlIntervalParamContext {
@@ -98,6 +106,13 @@ typedef struct EncodeContext {
     EbFifo *pa_reference_picture_pool_fifo_ptr;
     EbFifo *tpl_reference_picture_pool_fifo_ptr;
 
+    // Queues of the sequential kernels of the stream. The kernels coding several pictures at
+    // once may be shared by the streams of parallel segments, they post to the picture stream.
+    EbSystemResource *picture_analysis_results_resource_ptr;
+    EbSystemResource *motion_estimation_results_resource_ptr;
+    EbSystemResource *picture_demux_results_resource_ptr;
+    EbSystemResource *entropy_coding_results_resource_ptr;
+
     // Picture Decision Reorder Queue
     PictureDecisionReorderEntry **picture_decision_reorder_queue;
     uint32_t                      picture_decision_reorder_queue_head_index;
@@ -204,6 +219,8 @@ typedef struct EncodeContext {
     Dequants         deq_bd; // follows input bit depth
     Quants           quants_8bit; // 8bit
     Dequants         deq_8bit; // 8bit
+    // State before the first picture of the stream, restored by svt_aom_encode_context_reset()
+    struct EncodeContextStart *stream_start;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -214,4 +231,6 @@ typedef struct EncodeContextInitData {
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr);
+extern EbErrorType svt_aom_encode_context_save_start(EncodeContext *enc_ctx);
+extern void        svt_aom_encode_context_reset(EncodeContext *enc_ctx);
 #endif // EbEncodeContext_h
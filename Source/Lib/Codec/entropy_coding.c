@@ -3767,6 +3767,38 @@ EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetadataArra
     return return_error;
 }
 
+uint32_t svt_aom_frame_tile_data_size(const PictureControlSet *pcs) {
+    const Av1Common *const cm       = pcs->ppcs->av1_cm;
+    const int              tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    uint32_t               size     = 0;
+    for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+        size += pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+        // Every tile but the last one is preceded by its size
+        if (tile_idx != tile_cnt - 1)
+            size += pcs->tile_size_bytes_minus_1 + 1;
+    }
+    return size;
+}
+
+uint32_t svt_aom_write_frame_tile_data(const PictureControlSet *pcs, uint8_t *data) {
+    const Av1Common *const cm             = pcs->ppcs->av1_cm;
+    const int              tile_cnt       = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    uint32_t               curr_data_size = 0;
+    for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+        const int32_t tile_size = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+        if (tile_idx != tile_cnt - 1) {
+            const uint8_t tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
+            mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
+            curr_data_size += tile_size_bytes;
+        }
+        const OutputBitstreamUnit *ec_output_bitstream_ptr =
+            (const OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
+        svt_memcpy(data + curr_data_size, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+        curr_data_size += tile_size;
+    }
+    return curr_data_size;
+}
+
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -3775,8 +3807,6 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     EbErrorType              return_error         = EB_ErrorNone;
     OutputBitstreamUnit     *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
     PictureParentControlSet *ppcs                 = pcs->ppcs;
-    Av1Common *const         cm                   = ppcs->av1_cm;
-    uint16_t                 tile_cnt             = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
     uint8_t                 *data                 = output_bitstream_ptr->buffer_av1;
     uint32_t                 obu_header_size      = 0;
 
@@ -3799,34 +3829,13 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     curr_data_size += write_tile_group_header(
         data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
 
-    if (!show_existing) {
-        // Add data from EC stream to Picture Stream.
-        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-            const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
-            uint8_t       tile_size_bytes = 0;
-            // tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
-            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
-                tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
-                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
-            }
-            OutputBitstreamUnit *ec_output_bitstream_ptr =
-                (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
-            assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
-            // Size of the buffer needed to store all data; if buffer is too small, increase buffer
-            // size
-            uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
-                (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
-            if (output_bitstream_ptr->size < data_size) {
-                svt_realloc_output_bitstream_unit(output_bitstream_ptr,
-                                                  data_size + 1); // plus one for good measure
-                data = output_bitstream_ptr->buffer_av1;
-            }
-            svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
-            curr_data_size += (tile_size + tile_size_bytes);
-        }
-    }
-    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
-    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    // The tile data is not copied here, only accounted in the OBU size: the caller writes it
+    // right after the header with svt_aom_write_frame_tile_data(), so only the header is moved
+    // to make room for the length field.
+    const uint32_t tile_data_size    = show_existing ? 0 : svt_aom_frame_tile_data_size(pcs);
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size + tile_data_size;
+    const size_t   length_field_size = svt_aom_uleb_size_in_bytes(obu_payload_size);
+    memmove(data + obu_header_size + length_field_size, data + obu_header_size, curr_data_size - obu_header_size);
     if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
         assert(0);
     }
@@ -182,6 +182,10 @@ extern EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetad
                                               const EbAv1MetadataType type);
 extern EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
                                                   PictureControlSet *pcs, uint8_t show_existing);
+// Size of the tile data following the frame header of pcs, tile size fields included
+extern uint32_t svt_aom_frame_tile_data_size(const PictureControlSet *pcs);
+// Writes the tiles of pcs from the entropy coder buffers to data, returns the bytes written
+extern uint32_t svt_aom_write_frame_tile_data(const PictureControlSet *pcs, uint8_t *data);
 extern EbErrorType svt_aom_encode_td_av1(uint8_t *bitstream_ptr);
 extern EbErrorType svt_aom_encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs);
 
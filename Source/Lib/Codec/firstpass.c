@@ -76,6 +76,8 @@ static EbErrorType realloc_stats_out(SequenceControlSet *scs, FirstPassStatsOut
         } else {
             EB_REALLOC_ARRAY(out->stat, capability);
         }
+        // the entries not written yet have count 0, see output_stats()
+        memset(out->stat + out->capability, 0, (capability - out->capability) * sizeof(*out->stat));
         out->capability = capability;
     }
     out->size = frame_number + 1;
@@ -90,6 +92,9 @@ static AOM_INLINE void output_stats(SequenceControlSet *scs, const FIRSTPASS_STA
         SVT_ERROR("realloc_stats_out request %d entries failed failed\n", frame_number);
     } else {
         stats_out->stat[frame_number] = *stats;
+        // the entries of a frame and of the totals count at least one frame
+        while (stats_out->ready < stats_out->size && stats_out->stat[stats_out->ready].count != 0)
+            stats_out->ready++;
     }
 
     // TEMP debug code
@@ -131,6 +136,63 @@ static AOM_INLINE void output_stats(SequenceControlSet *scs, const FIRSTPASS_STA
 #endif
     svt_release_mutex(scs->enc_ctx->stat_file_mutex);
 }
+static EbErrorType realloc_new_stats(FirstPassStatsOut *out, size_t bytes) {
+    if (bytes <= out->new_capability)
+        return EB_ErrorNone;
+    EB_REALLOC_ARRAY(out->new_buf, bytes);
+    out->new_capability = bytes;
+    return EB_ErrorNone;
+}
+
+/* Hands out the entries completed since the previous call, see SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW,
+ * after the header the first time. They are copied as output_stats() may move the entries while the
+ * caller writes them. */
+EbErrorType svt_av1_first_pass_stats_new(EncodeContext *enc_ctx, SvtAv1FixedBuf *new_stats) {
+    FirstPassStatsOut *out = &enc_ctx->stats_out;
+    svt_block_on_mutex(enc_ctx->stat_file_mutex);
+    const size_t header_size = out->header_out ? 0 : sizeof(SvtAv1StatsHeader);
+    const size_t entries_sz  = (out->ready - out->flushed) * sizeof(*out->stat);
+    EbErrorType  ret         = realloc_new_stats(out, header_size + entries_sz);
+    if (ret == EB_ErrorNone) {
+        if (header_size) {
+            SvtAv1StatsHeader *header = (SvtAv1StatsHeader *)out->new_buf;
+            memset(header, 0, sizeof(*header));
+            memcpy(header->magic, SVT_AV1_STATS_MAGIC, sizeof(header->magic));
+            header->version     = SVT_AV1_STATS_VERSION;
+            header->entry_size  = sizeof(*out->stat);
+            header->header_size = sizeof(*header);
+        }
+        if (entries_sz)
+            memcpy(out->new_buf + header_size, out->stat + out->flushed, entries_sz);
+        out->header_out = 1;
+        out->flushed    = out->ready;
+        new_stats->buf  = out->new_buf;
+        new_stats->sz   = header_size + entries_sz;
+    }
+    svt_release_mutex(enc_ctx->stat_file_mutex);
+    return ret;
+}
+
+/* Finds the entries of the multi-pass stats, after the SvtAv1StatsHeader when they start with one */
+EbErrorType svt_av1_stats_entries(const SvtAv1FixedBuf *stats, SvtAv1FixedBuf *entries) {
+    const SvtAv1StatsHeader *header = (const SvtAv1StatsHeader *)stats->buf;
+    *entries                        = *stats;
+    if (stats->sz < sizeof(*header) || memcmp(header->magic, SVT_AV1_STATS_MAGIC, sizeof(header->magic)))
+        return EB_ErrorNone;
+    if (header->version > SVT_AV1_STATS_VERSION || header->entry_size != sizeof(FIRSTPASS_STATS) ||
+        header->header_size < sizeof(*header) || header->header_size % 64 || header->header_size > stats->sz)
+        return EB_ErrorBadParameter;
+    uint64_t count = (stats->sz - header->header_size) / sizeof(FIRSTPASS_STATS);
+    if (header->entry_count) {
+        if (header->entry_count > count)
+            return EB_ErrorBadParameter;
+        count = header->entry_count;
+    }
+    entries->buf = (uint8_t *)stats->buf + header->header_size;
+    entries->sz  = count * sizeof(FIRSTPASS_STATS);
+    return EB_ErrorNone;
+}
+
 void svt_av1_twopass_zero_stats(FIRSTPASS_STATS *section) {
     section->frame              = 0.0;
     section->coded_error        = 0.0;
@@ -103,6 +103,9 @@ struct TileDataEnc;
 
 void svt_av1_twopass_zero_stats(FIRSTPASS_STATS *section);
 void svt_av1_accumulate_stats(FIRSTPASS_STATS *section, const FIRSTPASS_STATS *frame);
+struct EncodeContext;
+EbErrorType svt_av1_first_pass_stats_new(struct EncodeContext *enc_ctx, SvtAv1FixedBuf *new_stats);
+EbErrorType svt_av1_stats_entries(const SvtAv1FixedBuf *stats, SvtAv1FixedBuf *entries);
 /*!\endcond */
 
 #ifdef __cplusplus
@@ -123,22 +123,32 @@ void svt_aom_gm_pre_processor(PictureParentControlSet *pcs, PictureParentControl
         }
     }
 }
-void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic) {
-    // Get downsampled pictures with a downsampling factor of 2 in each dimension
-    EbPaReferenceObject *pa_reference_object;
-    EbPictureBufferDesc *quarter_ref_pic_ptr;
-    EbPictureBufferDesc *quarter_picture_ptr;
-    EbPictureBufferDesc *sixteenth_ref_pic_ptr;
-    EbPictureBufferDesc *sixteenth_picture_ptr;
-    pa_reference_object   = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
-    quarter_picture_ptr   = (EbPictureBufferDesc *)pa_reference_object->quarter_downsampled_picture_ptr;
-    sixteenth_picture_ptr = (EbPictureBufferDesc *)pa_reference_object->sixteenth_downsampled_picture_ptr;
-    PictureControlSet *cpcs;
-    cpcs = pcs->child_pcs;
+// Source pictures the corners are detected on and the motion is refined on, at the GM downsampling level
+static void gm_get_input_pictures(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic,
+                                  EbPictureBufferDesc **input_detection, EbPictureBufferDesc **input_refinement) {
+    EbPaReferenceObject *pa_reference_object = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
+    EbPictureBufferDesc *quarter_picture_ptr = pa_reference_object->quarter_downsampled_picture_ptr;
+    EbPictureBufferDesc *sixteenth_picture_ptr = pa_reference_object->sixteenth_downsampled_picture_ptr;
     if (pcs->gm_ctrls.use_ref_info) {
         quarter_picture_ptr   = pcs->quarter_src_pic;
         sixteenth_picture_ptr = pcs->sixteenth_src_pic;
     }
+    if (pcs->gm_downsample_level == GM_DOWN16) {
+        *input_detection  = sixteenth_picture_ptr;
+        *input_refinement = sixteenth_picture_ptr;
+    } else if (pcs->gm_downsample_level == GM_DOWN) {
+        *input_detection  = quarter_picture_ptr;
+        *input_refinement = quarter_picture_ptr;
+    } else {
+        *input_detection  = input_pic;
+        *input_refinement = input_pic;
+    }
+}
+
+uint32_t svt_aom_gm_setup(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic, int *frm_corners,
+                          int *num_frm_corners, uint8_t *num_refs_to_search) {
+    PictureControlSet *cpcs = pcs->child_pcs;
+
     uint32_t num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 /*List 0 only*/ : 2 /*List 0 + 1*/;
     // Initilize global motion to be OFF for all references frames.
     memset(pcs->is_global_motion, FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
@@ -224,145 +234,87 @@ void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBuf
                 global_motion_estimation_level = 0;
         }
     }
-    if (global_motion_estimation_level) {
-        EbPictureBufferDesc *input_detection, *input_refinement;
-        if (pcs->gm_downsample_level == GM_DOWN16) {
-            input_detection  = sixteenth_picture_ptr;
-            input_refinement = sixteenth_picture_ptr;
-        } else if (pcs->gm_downsample_level == GM_DOWN) {
-            input_detection  = quarter_picture_ptr;
-            input_refinement = quarter_picture_ptr;
-        } else {
-            input_detection  = input_pic;
-            input_refinement = input_pic;
-        }
-
-        int frm_corners[2 * MAX_CORNERS];
-        int num_frm_corners = svt_av1_fast_corner_detect(
-            input_detection->buffer_y + input_detection->org_x + input_detection->org_y * input_detection->stride_y,
-            input_detection->width,
-            input_detection->height,
-            input_detection->stride_y,
-            frm_corners,
-            MAX_CORNERS);
-        for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
-            uint32_t num_of_ref_pic_to_search;
-            num_of_ref_pic_to_search = pcs->slice_type == P_SLICE ? pcs->ref_list0_count_try
-                : list_index == REF_LIST_0                        ? pcs->ref_list0_count_try
-                                                                  : pcs->ref_list1_count_try;
-            if (global_motion_estimation_level == 1)
-                num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
-            else if (global_motion_estimation_level == 2)
-                num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 2);
-
-            if (pcs->temporal_layer_index > 0 && pcs->gm_ctrls.ref_idx0_only)
-                num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
-
-            // Ref Picture Loop
-            for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search; ++ref_pic_index) {
-                EbPaReferenceObject *ref_object;
-                EbPictureBufferDesc *ref_picture_ptr;
-                ref_object = (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
-
-                uint8_t              detect_refine_scale_factor;
-                EbPictureBufferDesc *ref_detection, *ref_refinement;
-                uint8_t              chess_refn;
-                if (pcs->gm_ctrls.use_ref_info) {
-                    cpcs = pcs->child_pcs;
-                    EbReferenceObject *ref_obj =
-                        (EbReferenceObject *)cpcs->ref_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
-
-                    ref_picture_ptr       = ref_obj->input_picture;
-                    quarter_ref_pic_ptr   = ref_obj->quarter_reference_picture;
-                    sixteenth_ref_pic_ptr = ref_obj->sixteenth_reference_picture;
-
-                    if (pcs->gm_downsample_level == GM_DOWN16) {
-                        input_detection = sixteenth_picture_ptr;
-                        ref_detection   = sixteenth_ref_pic_ptr;
-
-                        input_refinement = sixteenth_picture_ptr;
-                        ref_refinement   = sixteenth_ref_pic_ptr;
-
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = 0;
-                    } else if (pcs->gm_downsample_level == GM_DOWN) {
-                        input_detection = quarter_picture_ptr;
-                        ref_detection   = quarter_ref_pic_ptr;
-
-                        input_refinement = quarter_picture_ptr;
-                        ref_refinement   = quarter_ref_pic_ptr;
-
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = GM_ADAPT_1 ? pcs->gm_ctrls.chess_rfn : 0;
-                    } else {
-                        input_detection = input_pic;
-                        ref_detection   = ref_picture_ptr;
-
-                        input_refinement = input_pic;
-                        ref_refinement   = ref_picture_ptr;
-
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = pcs->gm_ctrls.chess_rfn;
-                    }
-
-                } else {
-                    ref_picture_ptr       = ref_object->input_padded_pic;
-                    quarter_ref_pic_ptr   = ref_object->quarter_downsampled_picture_ptr;
-                    sixteenth_ref_pic_ptr = ref_object->sixteenth_downsampled_picture_ptr;
-
-                    if (pcs->gm_downsample_level == GM_DOWN16) {
-                        input_detection = sixteenth_picture_ptr;
-                        ref_detection   = sixteenth_ref_pic_ptr;
+    if (!global_motion_estimation_level)
+        return 0;
 
-                        input_refinement = sixteenth_picture_ptr;
-                        ref_refinement   = sixteenth_ref_pic_ptr;
-
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = 0;
-                    } else if (pcs->gm_downsample_level == GM_DOWN) {
-                        input_detection = quarter_picture_ptr;
-                        ref_detection   = quarter_ref_pic_ptr;
-
-                        input_refinement = quarter_picture_ptr;
-                        ref_refinement   = quarter_ref_pic_ptr;
+    EbPictureBufferDesc *input_detection, *input_refinement;
+    gm_get_input_pictures(pcs, input_pic, &input_detection, &input_refinement);
+    *num_frm_corners = svt_av1_fast_corner_detect(
+        input_detection->buffer_y + input_detection->org_x + input_detection->org_y * input_detection->stride_y,
+        input_detection->width,
+        input_detection->height,
+        input_detection->stride_y,
+        frm_corners,
+        MAX_CORNERS);
+    for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
+        uint32_t num_of_ref_pic_to_search;
+        num_of_ref_pic_to_search = pcs->slice_type == P_SLICE ? pcs->ref_list0_count_try
+            : list_index == REF_LIST_0                        ? pcs->ref_list0_count_try
+                                                              : pcs->ref_list1_count_try;
+        if (global_motion_estimation_level == 1)
+            num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
+        else if (global_motion_estimation_level == 2)
+            num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 2);
+
+        if (pcs->temporal_layer_index > 0 && pcs->gm_ctrls.ref_idx0_only)
+            num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
+        num_refs_to_search[list_index] = (uint8_t)num_of_ref_pic_to_search;
+    }
+    return num_of_list_to_search;
+}
 
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = GM_ADAPT_1 ? pcs->gm_ctrls.chess_rfn : 0;
-                    } else {
-                        input_detection = input_pic;
-                        ref_detection   = ref_picture_ptr;
+void svt_aom_gm_search_ref(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic, int *frm_corners,
+                           int num_frm_corners, uint32_t list_index, uint32_t ref_pic_index) {
+    EbPictureBufferDesc *input_detection, *input_refinement;
+    EbPictureBufferDesc *ref_picture_ptr, *quarter_ref_pic_ptr, *sixteenth_ref_pic_ptr;
+    gm_get_input_pictures(pcs, input_pic, &input_detection, &input_refinement);
+    if (pcs->gm_ctrls.use_ref_info) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)pcs->child_pcs->ref_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
 
-                        input_refinement = input_pic;
-                        ref_refinement   = ref_picture_ptr;
+        ref_picture_ptr       = ref_obj->input_picture;
+        quarter_ref_pic_ptr   = ref_obj->quarter_reference_picture;
+        sixteenth_ref_pic_ptr = ref_obj->sixteenth_reference_picture;
+    } else {
+        EbPaReferenceObject *ref_object =
+            (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
 
-                        detect_refine_scale_factor = 1;
-                        chess_refn                 = pcs->gm_ctrls.chess_rfn;
-                    }
-                }
-                compute_global_motion(pcs,
-                                      frm_corners,
-                                      num_frm_corners,
-                                      input_detection,
-                                      ref_detection,
-                                      input_refinement,
-                                      ref_refinement,
-                                      detect_refine_scale_factor,
-                                      chess_refn,
-                                      &pcs->svt_aom_global_motion_estimation[list_index][ref_pic_index],
-                                      pcs->frm_hdr.allow_high_precision_mv);
-            }
+        ref_picture_ptr       = ref_object->input_padded_pic;
+        quarter_ref_pic_ptr   = ref_object->quarter_downsampled_picture_ptr;
+        sixteenth_ref_pic_ptr = ref_object->sixteenth_downsampled_picture_ptr;
+    }
 
-            if (pcs->gm_ctrls.identiy_exit) {
-                if (list_index == 0) {
-                    if (pcs->svt_aom_global_motion_estimation[0][0].wmtype == IDENTITY) {
-                        break;
-                    }
-                }
-            }
-        }
+    EbPictureBufferDesc *ref_detection, *ref_refinement;
+    uint8_t              chess_refn;
+    if (pcs->gm_downsample_level == GM_DOWN16) {
+        ref_detection  = sixteenth_ref_pic_ptr;
+        ref_refinement = sixteenth_ref_pic_ptr;
+        chess_refn     = 0;
+    } else if (pcs->gm_downsample_level == GM_DOWN) {
+        ref_detection  = quarter_ref_pic_ptr;
+        ref_refinement = quarter_ref_pic_ptr;
+        chess_refn     = GM_ADAPT_1 ? pcs->gm_ctrls.chess_rfn : 0;
+    } else {
+        ref_detection  = ref_picture_ptr;
+        ref_refinement = ref_picture_ptr;
+        chess_refn     = pcs->gm_ctrls.chess_rfn;
     }
+    compute_global_motion(pcs,
+                          frm_corners,
+                          num_frm_corners,
+                          input_detection,
+                          ref_detection,
+                          input_refinement,
+                          ref_refinement,
+                          1,
+                          chess_refn,
+                          &pcs->svt_aom_global_motion_estimation[list_index][ref_pic_index],
+                          pcs->frm_hdr.allow_high_precision_mv);
+}
 
-    pcs->is_gm_on = 0;
+void svt_aom_gm_set_flags(PictureParentControlSet *pcs) {
+    uint32_t num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 /*List 0 only*/ : 2 /*List 0 + 1*/;
+    pcs->is_gm_on                  = 0;
     for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
         uint32_t num_of_ref_pic_to_search = pcs->slice_type == P_SLICE ? pcs->ref_list0_count
             : list_index == REF_LIST_0                                 ? pcs->ref_list0_count
@@ -380,6 +332,28 @@ void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBuf
     }
 }
 
+void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic) {
+    int      frm_corners[2 * MAX_CORNERS];
+    int      num_frm_corners;
+    uint8_t  num_refs_to_search[MAX_NUM_OF_REF_PIC_LIST];
+    uint32_t num_of_list_to_search = svt_aom_gm_setup(
+        pcs, input_pic, frm_corners, &num_frm_corners, num_refs_to_search);
+    for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
+        // Ref Picture Loop
+        for (uint32_t ref_pic_index = 0; ref_pic_index < num_refs_to_search[list_index]; ++ref_pic_index)
+            svt_aom_gm_search_ref(pcs, input_pic, frm_corners, num_frm_corners, list_index, ref_pic_index);
+
+        if (pcs->gm_ctrls.identiy_exit) {
+            if (list_index == 0) {
+                if (pcs->svt_aom_global_motion_estimation[0][0].wmtype == IDENTITY) {
+                    break;
+                }
+            }
+        }
+    }
+    svt_aom_gm_set_flags(pcs);
+}
+
 void svt_aom_upscale_wm_params(EbWarpedMotionParams *wm_params, uint8_t scale_factor) {
     // Upscale the translation parameters by 2 or 4,
     // because the search is done on a down-sampled
@@ -17,6 +17,15 @@
 #include "me_context.h"
 
 void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic);
+/* The steps of svt_aom_global_motion_estimation(), for searching the references concurrently.
+ * svt_aom_gm_setup() derives the GM level of the picture and detects the corners of its source,
+ * it returns the number of lists to search, 0 when GM is skipped, and the number of references to
+ * search in each of them. The search of a reference only writes the motion of that reference. */
+uint32_t svt_aom_gm_setup(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic, int *frm_corners,
+                          int *num_frm_corners, uint8_t *num_refs_to_search);
+void     svt_aom_gm_search_ref(PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic, int *frm_corners,
+                               int num_frm_corners, uint32_t list_index, uint32_t ref_pic_index);
+void     svt_aom_gm_set_flags(PictureParentControlSet *pcs);
 
 void compute_global_motion(PictureParentControlSet *pcs, int *frm_corners, int num_frm_corners,
                            EbPictureBufferDesc *det_input_pic, //src frame for detection
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "grainSynthesis.h"
 #include "svt_log.h"
+#include "aom_dsp_rtcd.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
 // with zero mean and standard deviation of about 512.
@@ -155,11 +156,8 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
-
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
+static const int32_t luma_subblock_size_y = 32;
+static const int32_t luma_subblock_size_x = 32;
 
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
@@ -167,15 +165,15 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
-
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
-
-static uint16_t random_register = 0; // random number generator register
+// State of the grain synthesis of one picture, so that pictures can get their grain concurrently
+typedef struct GrainSynthesis {
+    int32_t  scaling_lut_y[256];
+    int32_t  scaling_lut_cb[256];
+    int32_t  scaling_lut_cr[256];
+    int32_t  grain_min;
+    int32_t  grain_max;
+    uint16_t random_register; // random number generator register
+} GrainSynthesis;
 
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
@@ -240,14 +238,16 @@ void svt_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride, int32_t ***pred_pos_luma_p,
-                        int32_t ***pred_pos_chroma_p, int32_t **luma_grain_block, int32_t **cb_grain_block,
-                        int32_t **cr_grain_block, int32_t **y_line_buf, int32_t **cb_line_buf, int32_t **cr_line_buf,
-                        int32_t **y_col_buf, int32_t **cb_col_buf, int32_t **cr_col_buf, int32_t luma_grain_samples,
-                        int32_t chroma_grain_samples, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
+static void init_arrays(GrainSynthesis *gs, AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride,
+                        int32_t ***pred_pos_luma_p, int32_t ***pred_pos_chroma_p, int32_t **luma_grain_block,
+                        int32_t **cb_grain_block, int32_t **cr_grain_block, int32_t **y_line_buf,
+                        int32_t **cb_line_buf, int32_t **cr_line_buf, int32_t **y_col_buf, int32_t **cb_col_buf,
+                        int32_t **cr_col_buf, int32_t luma_grain_samples, int32_t chroma_grain_samples,
+                        int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    memset(gs->scaling_lut_y, 0, sizeof(gs->scaling_lut_y));
+    memset(gs->scaling_lut_cb, 0, sizeof(gs->scaling_lut_cb));
+    memset(gs->scaling_lut_cr, 0, sizeof(gs->scaling_lut_cr));
+    const int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
 
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
@@ -357,31 +357,35 @@ static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma, int32
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(GrainSynthesis *gs, int32_t bits) {
+    uint16_t random_register = gs->random_register;
     uint16_t bit;
     bit = ((random_register >> 0) ^ (random_register >> 1) ^ (random_register >> 3) ^ (random_register >> 12)) & 1;
-    random_register = (random_register >> 1) | (bit << 15);
+    random_register     = (random_register >> 1) | (bit << 15);
+    gs->random_register = random_register;
     return (random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+static void init_random_generator(GrainSynthesis *gs, int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    uint16_t random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
     random_register ^= ((luma_num * 37 + 178) & 255) << 8;
     random_register ^= ((luma_num * 173 + 105) & 255);
+    gs->random_register = random_register;
 }
 
-static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block,
-                                      int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride,
-                                      int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad) {
+static void generate_luma_grain_block(GrainSynthesis *gs, AomFilmGrain *params, int32_t **pred_pos_luma,
+                                      int32_t *luma_grain_block, int32_t luma_block_size_y, int32_t luma_block_size_x,
+                                      int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad,
+                                      int32_t bottom_pad) {
     if (params->num_y_points == 0)
         return;
 
@@ -393,7 +397,7 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
 
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
-            luma_grain_block[i * luma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
+            luma_grain_block[i * luma_grain_stride + j] = (gaussian_sequence[get_random_number(gs, gauss_bits)] +
                                                            ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
 
@@ -407,12 +411,12 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
             }
             luma_grain_block[i * luma_grain_stride + j] = clamp(
                 luma_grain_block[i * luma_grain_stride + j] + ((wsum + rounding_offset) >> params->ar_coeff_shift),
-                grain_min,
-                grain_max);
+                gs->grain_min,
+                gs->grain_max);
         }
 }
 
-static void generate_chroma_grain_blocks(AomFilmGrain *params,
+static void generate_chroma_grain_blocks(GrainSynthesis *gs, AomFilmGrain *params,
                                          //                                  int32_t** pred_pos_luma,
                                          int32_t **pred_pos_chroma, int32_t *luma_grain_block, int32_t *cb_grain_block,
                                          int32_t *cr_grain_block, int32_t luma_grain_stride,
@@ -431,22 +435,22 @@ static void generate_chroma_grain_blocks(AomFilmGrain *params,
     int chroma_grain_block_size = chroma_block_size_y * chroma_grain_stride;
 
     if (params->num_cb_points || params->chroma_scaling_from_luma) {
-        init_random_generator(7 << 5, params->random_seed);
+        init_random_generator(gs, 7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
-                cb_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
+                cb_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gs, gauss_bits)] +
                                                                ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
         memset(cb_grain_block, 0, sizeof(*cb_grain_block) * chroma_grain_block_size);
     }
     if (params->num_cr_points || params->chroma_scaling_from_luma) {
-        init_random_generator(11 << 5, params->random_seed);
+        init_random_generator(gs, 11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
-                cr_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
+                cr_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gs, gauss_bits)] +
                                                                ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
@@ -492,14 +496,14 @@ static void generate_chroma_grain_blocks(AomFilmGrain *params,
                 cb_grain_block[i * chroma_grain_stride + j] = clamp(
                     cb_grain_block[i * chroma_grain_stride + j] +
                         ((wsum_cb + rounding_offset) >> params->ar_coeff_shift),
-                    grain_min,
-                    grain_max);
+                    gs->grain_min,
+                    gs->grain_max);
             if (params->num_cr_points || params->chroma_scaling_from_luma)
                 cr_grain_block[i * chroma_grain_stride + j] = clamp(
                     cr_grain_block[i * chroma_grain_stride + j] +
                         ((wsum_cr + rounding_offset) >> params->ar_coeff_shift),
-                    grain_min,
-                    grain_max);
+                    gs->grain_min,
+                    gs->grain_max);
         }
 }
 
@@ -526,7 +530,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a lut (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static int32_t scale_lut(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -538,11 +542,115 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
              (bit_depth - 8));
 }
 
-static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t luma_stride,
-                               int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
-                               int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height,
-                               int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
-                               int32_t chroma_subsamp_x) {
+void svt_av1_add_noise_luma_c(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                              int32_t grain_stride, int32_t width, int32_t height, int32_t scaling_shift,
+                              int32_t min_luma, int32_t max_luma) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
+                                                  ((scale_lut(scaling_lut, luma[i * luma_stride + j], 8) *
+                                                        grain[i * grain_stride + j] +
+                                                    rounding_offset) >>
+                                                   scaling_shift),
+                                              min_luma,
+                                              max_luma);
+        }
+    }
+}
+
+void svt_av1_add_noise_luma_hbd_c(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride,
+                                  const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height,
+                                  int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(
+                luma[i * luma_stride + j] +
+                    ((scale_lut(scaling_lut, luma[i * luma_stride + j], bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_luma,
+                max_luma);
+        }
+    }
+}
+
+/* Adds the grain to a chroma block of width x height, scaled from the chroma and the co-located luma
+ * before the luma gets its grain */
+void svt_av1_add_noise_chroma_c(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride,
+                                const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                int32_t width, int32_t height, int32_t luma_mult, int32_t mult, int32_t offset,
+                                int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                                int32_t chroma_subsamp_x, int32_t chroma_subsamp_y) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling_lut,
+                                clamp(((average_luma * luma_mult + mult * chroma[i * chroma_stride + j]) >> 6) + offset,
+                                      0,
+                                      255),
+                                8) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_chroma,
+                max_chroma);
+        }
+    }
+}
+
+void svt_av1_add_noise_chroma_hbd_c(const int32_t *scaling_lut, uint16_t *chroma, int32_t chroma_stride,
+                                    const uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                    int32_t grain_stride, int32_t width, int32_t height, int32_t luma_mult,
+                                    int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                                    int32_t max_chroma, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                    int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling_lut,
+                                clamp(((average_luma * luma_mult + mult * chroma[i * chroma_stride + j]) >> 6) + offset,
+                                      0,
+                                      (256 << (bit_depth - 8)) - 1),
+                                bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_chroma,
+                max_chroma);
+        }
+    }
+}
+
+static void add_noise_to_block(const GrainSynthesis *gs, AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
+                               uint8_t *cr, int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
+                               int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+                               int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width,
+                               int32_t bit_depth, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     int32_t cb_offset    = params->cb_offset - 256;
@@ -551,12 +659,11 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
     int32_t cr_offset    = params->cr_offset - 256;
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = (params->num_cb_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
     int32_t apply_cr = (params->num_cr_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
 
+    (void)bit_depth;
     if (params->chroma_scaling_from_luma) {
         cb_mult      = 0; // fixed scale
         cb_luma_mult = 64; // fixed scale
@@ -580,69 +687,63 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         max_luma = max_chroma = 255;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
-    }
-
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
-        }
-    }
+    const int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    const int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    // the chroma is scaled from the luma without grain
+    if (apply_cb)
+        svt_av1_add_noise_chroma(gs->scaling_lut_cb,
+                                 cb,
+                                 chroma_stride,
+                                 luma,
+                                 luma_stride,
+                                 cb_grain,
+                                 chroma_grain_stride,
+                                 chroma_width,
+                                 chroma_height,
+                                 cb_luma_mult,
+                                 cb_mult,
+                                 cb_offset,
+                                 params->scaling_shift,
+                                 min_chroma,
+                                 max_chroma,
+                                 chroma_subsamp_x,
+                                 chroma_subsamp_y);
+    if (apply_cr)
+        svt_av1_add_noise_chroma(gs->scaling_lut_cr,
+                                 cr,
+                                 chroma_stride,
+                                 luma,
+                                 luma_stride,
+                                 cr_grain,
+                                 chroma_grain_stride,
+                                 chroma_width,
+                                 chroma_height,
+                                 cr_luma_mult,
+                                 cr_mult,
+                                 cr_offset,
+                                 params->scaling_shift,
+                                 min_chroma,
+                                 max_chroma,
+                                 chroma_subsamp_x,
+                                 chroma_subsamp_y);
+    if (apply_y)
+        svt_av1_add_noise_luma(gs->scaling_lut_y,
+                               luma,
+                               luma_stride,
+                               luma_grain,
+                               luma_grain_stride,
+                               half_luma_width << 1,
+                               half_luma_height << 1,
+                               params->scaling_shift,
+                               min_luma,
+                               max_luma);
 }
 
-static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-                                   int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain,
-                                   int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride,
-                                   int32_t half_luma_height, int32_t half_luma_width, int32_t bit_depth,
-                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+static void add_noise_to_block_hbd(const GrainSynthesis *gs, AomFilmGrain *params, uint16_t *luma, uint16_t *cb,
+                                   uint16_t *cr, int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
+                                   int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+                                   int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width,
+                                   int32_t bit_depth, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     // offset value depends on the bit depth
@@ -653,8 +754,6 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -682,61 +781,59 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
-    }
-
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
-        }
-    }
+    const int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    const int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    // the chroma is scaled from the luma without grain
+    if (apply_cb)
+        svt_av1_add_noise_chroma_hbd(gs->scaling_lut_cb,
+                                     cb,
+                                     chroma_stride,
+                                     luma,
+                                     luma_stride,
+                                     cb_grain,
+                                     chroma_grain_stride,
+                                     chroma_width,
+                                     chroma_height,
+                                     cb_luma_mult,
+                                     cb_mult,
+                                     cb_offset,
+                                     params->scaling_shift,
+                                     min_chroma,
+                                     max_chroma,
+                                     chroma_subsamp_x,
+                                     chroma_subsamp_y,
+                                     bit_depth);
+    if (apply_cr)
+        svt_av1_add_noise_chroma_hbd(gs->scaling_lut_cr,
+                                     cr,
+                                     chroma_stride,
+                                     luma,
+                                     luma_stride,
+                                     cr_grain,
+                                     chroma_grain_stride,
+                                     chroma_width,
+                                     chroma_height,
+                                     cr_luma_mult,
+                                     cr_mult,
+                                     cr_offset,
+                                     params->scaling_shift,
+                                     min_chroma,
+                                     max_chroma,
+                                     chroma_subsamp_x,
+                                     chroma_subsamp_y,
+                                     bit_depth);
+    if (apply_y)
+        svt_av1_add_noise_luma_hbd(gs->scaling_lut_y,
+                                   luma,
+                                   luma_stride,
+                                   luma_grain,
+                                   luma_grain_stride,
+                                   half_luma_width << 1,
+                                   half_luma_height << 1,
+                                   params->scaling_shift,
+                                   min_luma,
+                                   max_luma,
+                                   bit_depth);
 }
 
 int32_t svt_aom_film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b) {
@@ -826,11 +923,12 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
     return;
 }
 
-static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32_t *right_block, int32_t right_stride,
-                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height) {
+static void ver_boundary_overlap(const GrainSynthesis *gs, int32_t *left_block, int32_t left_stride,
+                                 int32_t *right_block, int32_t right_stride, int32_t *dst_block, int32_t dst_stride,
+                                 int32_t width, int32_t height) {
     if (width == 1) {
         while (height) {
-            *dst_block = clamp((*left_block * 23 + *right_block * 22 + 16) >> 5, grain_min, grain_max);
+            *dst_block = clamp((*left_block * 23 + *right_block * 22 + 16) >> 5, gs->grain_min, gs->grain_max);
             left_block += left_stride;
             right_block += right_stride;
             dst_block += dst_stride;
@@ -839,8 +937,8 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
         return;
     } else if (width == 2) {
         while (height) {
-            dst_block[0] = clamp((27 * left_block[0] + 17 * right_block[0] + 16) >> 5, grain_min, grain_max);
-            dst_block[1] = clamp((17 * left_block[1] + 27 * right_block[1] + 16) >> 5, grain_min, grain_max);
+            dst_block[0] = clamp((27 * left_block[0] + 17 * right_block[0] + 16) >> 5, gs->grain_min, gs->grain_max);
+            dst_block[1] = clamp((17 * left_block[1] + 27 * right_block[1] + 16) >> 5, gs->grain_min, gs->grain_max);
             left_block += left_stride;
             right_block += right_stride;
             dst_block += dst_stride;
@@ -850,11 +948,12 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
     }
 }
 
-static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block, int32_t bottom_stride,
-                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height) {
+static void hor_boundary_overlap(const GrainSynthesis *gs, int32_t *top_block, int32_t top_stride,
+                                 int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
+                                 int32_t width, int32_t height) {
     if (height == 1) {
         while (width) {
-            *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5, grain_min, grain_max);
+            *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5, gs->grain_min, gs->grain_max);
             ++top_block;
             ++bottom_block;
             ++dst_block;
@@ -863,9 +962,9 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
         return;
     } else if (height == 2) {
         while (width) {
-            dst_block[0]          = clamp((27 * top_block[0] + 17 * bottom_block[0] + 16) >> 5, grain_min, grain_max);
+            dst_block[0]          = clamp((27 * top_block[0] + 17 * bottom_block[0] + 16) >> 5, gs->grain_min, gs->grain_max);
             dst_block[dst_stride] = clamp(
-                (17 * top_block[top_stride] + 27 * bottom_block[bottom_stride] + 16) >> 5, grain_min, grain_max);
+                (17 * top_block[top_stride] + 27 * bottom_block[bottom_stride] + 16) >> 5, gs->grain_min, gs->grain_max);
             ++top_block;
             ++bottom_block;
             ++dst_block;
@@ -892,7 +991,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
     int32_t *cb_col_buf;
     int32_t *cr_col_buf;
 
-    random_register = params->random_seed;
+    GrainSynthesis gs;
+    gs.random_register = params->random_seed;
 
     int32_t left_pad   = 3;
     int32_t right_pad  = 3; // padding to offset for AR coefficients
@@ -901,11 +1001,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
 
     int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
 
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
-
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+    const int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    const int32_t chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
 
     // Initial padding is only needed for generation of
     // film grain templates (to stabilize the AR process)
@@ -926,11 +1023,13 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
     int32_t overlap   = params->overlap_flag;
     int32_t bit_depth = params->bit_depth;
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min    = 0 - grain_center;
-    grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
+    const int32_t grain_center = 128 << (bit_depth - 8);
+    gs.grain_min               = 0 - grain_center;
+    gs.grain_max               = (256 << (bit_depth - 8)) - 1 - grain_center;
 
-    init_arrays(params,
+    init_arrays(
+                &gs,
+                params,
                 luma_stride,
                 chroma_stride,
                 &pred_pos_luma,
@@ -949,7 +1048,9 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                 chroma_subsamp_y,
                 chroma_subsamp_x);
 
-    generate_luma_grain_block(params,
+    generate_luma_grain_block(
+                              &gs,
+                              params,
                               pred_pos_luma,
                               luma_grain_block,
                               luma_block_size_y,
@@ -960,7 +1061,9 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                               right_pad,
                               bottom_pad);
 
-    generate_chroma_grain_blocks(params,
+    generate_chroma_grain_blocks(
+                                 &gs,
+                                 params,
                                  //                               pred_pos_luma,
                                  pred_pos_chroma,
                                  luma_grain_block,
@@ -977,20 +1080,20 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                  chroma_subsamp_y,
                                  chroma_subsamp_x);
 
-    init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
+    init_scaling_function(params->scaling_points_y, params->num_y_points, gs.scaling_lut_y);
 
     if (params->chroma_scaling_from_luma) {
-        svt_memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        svt_memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+        svt_memcpy(gs.scaling_lut_cb, gs.scaling_lut_y, sizeof(*gs.scaling_lut_y) * 256);
+        svt_memcpy(gs.scaling_lut_cr, gs.scaling_lut_y, sizeof(*gs.scaling_lut_y) * 256);
     } else {
-        init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
-        init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
+        init_scaling_function(params->scaling_points_cb, params->num_cb_points, gs.scaling_lut_cb);
+        init_scaling_function(params->scaling_points_cr, params->num_cr_points, gs.scaling_lut_cr);
     }
     for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
+        init_random_generator(&gs, y * 2, params->random_seed);
 
         for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
+            int32_t offset_y = get_random_number(&gs, 8);
             int32_t offset_x = (offset_y >> 4) & 15;
             offset_y &= 15;
 
@@ -1003,7 +1106,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                 offset_x * (2 >> chroma_subsamp_x);
 
             if (overlap && x) {
-                ver_boundary_overlap(y_col_buf,
+                ver_boundary_overlap(&gs,
+                                     y_col_buf,
                                      2,
                                      luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
                                      luma_grain_stride,
@@ -1013,6 +1117,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                      AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
 
                 ver_boundary_overlap(
+                    &gs,
                     cb_col_buf,
                     2 >> chroma_subsamp_x,
                     cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
@@ -1023,6 +1128,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                     AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
 
                 ver_boundary_overlap(
+                    &gs,
                     cr_col_buf,
                     2 >> chroma_subsamp_x,
                     cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
@@ -1035,7 +1141,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                 int32_t i = y ? 1 : 0;
 
                 if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(params,
+                    add_noise_to_block_hbd(&gs,
+                                           params,
                                            (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
                                            (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
                                                (x << (1 - chroma_subsamp_x)),
@@ -1055,6 +1162,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                            chroma_subsamp_x);
                 } else {
                     add_noise_to_block(
+                        &gs,
                         params,
                         luma + ((y + i) << 1) * luma_stride + (x << 1),
                         cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x)),
@@ -1077,10 +1185,18 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
             if (overlap && y) {
                 if (x) {
                     ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(
-                        y_line_buf + (x << 1), luma_stride, y_col_buf, 2, y_line_buf + (x << 1), luma_stride, 2, 2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
+                    hor_boundary_overlap(&gs,
+                                         y_line_buf + (x << 1),
+                                         luma_stride,
+                                         y_col_buf,
+                                         2,
+                                         y_line_buf + (x << 1),
+                                         luma_stride,
+                                         2,
+                                         2);
+
+                    hor_boundary_overlap(&gs,
+                                         cb_line_buf + x * (2 >> chroma_subsamp_x),
                                          chroma_stride,
                                          cb_col_buf,
                                          2 >> chroma_subsamp_x,
@@ -1089,7 +1205,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                          2 >> chroma_subsamp_x,
                                          2 >> chroma_subsamp_y);
 
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
+                    hor_boundary_overlap(&gs,
+                                         cr_line_buf + x * (2 >> chroma_subsamp_x),
                                          chroma_stride,
                                          cr_col_buf,
                                          2 >> chroma_subsamp_x,
@@ -1099,7 +1216,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                          2 >> chroma_subsamp_y);
                 }
 
-                hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+                hor_boundary_overlap(&gs,
+                                     y_line_buf + ((x ? x + 1 : 0) << 1),
                                      luma_stride,
                                      luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x + (x ? 2 : 0),
                                      luma_grain_stride,
@@ -1108,7 +1226,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                      AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1), width - ((x ? x + 1 : 0) << 1)),
                                      2);
 
-                hor_boundary_overlap(cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                hor_boundary_overlap(&gs,
+                                     cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
                                      chroma_stride,
                                      cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
                                          ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
@@ -1119,7 +1238,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                             (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
                                      2 >> chroma_subsamp_y);
 
-                hor_boundary_overlap(cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                hor_boundary_overlap(&gs,
+                                     cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
                                      chroma_stride,
                                      cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
                                          ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
@@ -1131,7 +1251,8 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                      2 >> chroma_subsamp_y);
 
                 if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(params,
+                    add_noise_to_block_hbd(&gs,
+                                           params,
                                            (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
                                            (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
                                                (x << ((1 - chroma_subsamp_x))),
@@ -1151,6 +1272,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                                            chroma_subsamp_x);
                 } else {
                     add_noise_to_block(
+                        &gs,
                         params,
                         luma + (y << 1) * luma_stride + (x << 1),
                         cb + (y << (1 - chroma_subsamp_y)) * chroma_stride + (x << ((1 - chroma_subsamp_x))),
@@ -1175,6 +1297,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
 
             if (use_high_bit_depth) {
                 add_noise_to_block_hbd(
+                    &gs,
                     params,
                     (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
                     (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1197,6 +1320,7 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
                     chroma_subsamp_x);
             } else {
                 add_noise_to_block(
+                    &gs,
                     params,
                     luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
                     cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + ((x + j) << (1 - chroma_subsamp_x)),
@@ -73,8 +73,8 @@ EbErrorType svt_aom_initial_rate_control_context_ctor(EbThreadContext *thread_ct
 
     context_ptr->motion_estimation_results_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
         enc_handle_ptr->motion_estimation_results_resource_ptr, 0);
-    context_ptr->initialrate_control_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->initial_rate_control_results_resource_ptr, 0);
+    context_ptr->initialrate_control_results_output_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->initial_rate_control_results_resource_ptr, 0);
 
     EB_MALLOC(context_ptr->lad_queue, sizeof(LadQueue));
 
@@ -82,12 +82,25 @@ EbErrorType svt_aom_initial_rate_control_context_ctor(EbThreadContext *thread_ct
     for (uint32_t picture_index = 0; picture_index < REFERENCE_QUEUE_MAX_DEPTH; ++picture_index) {
         EB_NEW(context_ptr->lad_queue->cir_buf[picture_index], lad_queue_entry_ctor);
     }
-    context_ptr->lad_queue->head = 0;
-    context_ptr->lad_queue->tail = 0;
+    svt_aom_initial_rate_control_reset(thread_ctx);
 
     return EB_ErrorNone;
 }
 
+/************************************************
+ * Initial Rate Control Reset
+ *   empties the look ahead queue, the kernel must
+ *   be idle
+ ************************************************/
+void svt_aom_initial_rate_control_reset(EbThreadContext *thread_ctx) {
+    InitialRateControlContext *context_ptr = (InitialRateControlContext *)thread_ctx->priv;
+
+    for (uint32_t picture_index = 0; picture_index < REFERENCE_QUEUE_MAX_DEPTH; ++picture_index)
+        context_ptr->lad_queue->cir_buf[picture_index]->pcs = NULL;
+    context_ptr->lad_queue->head = 0;
+    context_ptr->lad_queue->tail = 0;
+}
+
 void svt_av1_build_quantizer(EbBitDepth bit_depth, int32_t y_dc_delta_q, int32_t u_dc_delta_q, int32_t u_ac_delta_q,
                              int32_t v_dc_delta_q, int32_t v_ac_delta_q, Quants *const quants, Dequants *const deq, PictureParentControlSet *pcs);
 
@@ -676,6 +689,7 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
 
         MotionEstimationResults *in_results_ptr = (MotionEstimationResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
 
         // Set the segment counter
         pcs->me_segments_completion_count++;
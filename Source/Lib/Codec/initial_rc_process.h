@@ -20,6 +20,7 @@
  * Extern Function Declaration
  ***************************************/
 EbErrorType svt_aom_initial_rate_control_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr);
+void        svt_aom_initial_rate_control_reset(EbThreadContext *thread_ctx);
 
 extern void *svt_aom_initial_rate_control_kernel(void *input_ptr);
 #endif // EbInitialRateControl_h
@@ -19,6 +19,7 @@
 #include "block_structures.h"
 #include "av1me.h"
 #include "aom_dsp_rtcd.h"
+#include "reference_object.h"
 #include "rd_cost.h"
 // ============================================================================
 //  Cost of motion vectors
@@ -121,7 +122,13 @@ static int svt_upsampled_pref_error(MacroBlockD *xd, const struct AV1Common *con
     const int        subpel_y_q3 = svt_get_subpel_part(this_mv->row);
 
     unsigned int besterr;
-    {
+    const uint8_t *cached_pred = var_params->subpel_cache
+        ? svt_aom_subpel_cache_get_block(
+              var_params->subpel_cache, ref, w, h, subpel_x_q3, subpel_y_q3, subpel_search_type)
+        : NULL;
+    if (cached_pred) {
+        besterr = vfp->vf(cached_pred, ref_stride, src, src_stride, sse);
+    } else {
         DECLARE_ALIGNED(16, uint8_t, pred[MAX_SB_SQUARE]);
 
         {
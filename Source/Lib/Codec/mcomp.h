@@ -74,6 +74,8 @@ typedef struct {
 
     // Source and reference buffers
     MSBuffers ms_buffers;
+    // Sub-pel planes of the reference; NULL to always interpolate the predictions
+    struct SubpelPlaneCache *subpel_cache;
 
     int w, h;
 
@@ -678,6 +678,7 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
 
         RateControlResults *rc_results = (RateControlResults *)rc_results_wrapper->object_ptr;
         PictureControlSet  *pcs        = (PictureControlSet *)rc_results->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet *scs        = pcs->scs;
         pcs->min_me_clpx               = 0;
         pcs->max_me_clpx               = 0;
@@ -417,6 +417,15 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
         memcpy(dst_rate->dv_joint_cost, pcs->md_rate_est_ctx->dv_joint_cost, MV_JOINTS * sizeof(int32_t));
     }
 }
+/**************************************************************************
+ * svt_aom_copy_coefficients_rate()
+ * Copy the coefficient rates of a table estimated from the same CDF, rather
+ * than re-deriving them symbol by symbol
+ ***************************************************************************/
+void svt_aom_copy_coefficients_rate(MdRateEstimationContext *dst_rate, const MdRateEstimationContext *src_rate) {
+    memcpy(dst_rate->coeff_fac_bits, src_rate->coeff_fac_bits, sizeof(dst_rate->coeff_fac_bits));
+    memcpy(dst_rate->eob_frac_bits, src_rate->eob_frac_bits, sizeof(dst_rate->eob_frac_bits));
+}
 /**************************************************************************
  * svt_aom_estimate_coefficients_rate()
  * Estimate the rate of the quantised coefficient
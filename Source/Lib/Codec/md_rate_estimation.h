@@ -206,6 +206,13 @@ extern "C" {
         MdRateEstimationContext  *md_rate_est_ctx,
         FRAME_CONTEXT              *fc);
     /**************************************************************************
+    * Copy the rate of the quantised coefficient from an already
+    * estimated table (e.g. the picture level table built in MDC)
+    ***************************************************************************/
+    extern void svt_aom_copy_coefficients_rate(
+        MdRateEstimationContext       *dst_rate,
+        const MdRateEstimationContext *src_rate);
+    /**************************************************************************
     * svt_aom_estimate_mv_rate()
     * Estimate the rate of motion vectors
     * based on the frame CDF
@@ -73,7 +73,7 @@ static void motion_estimation_context_dctor(EbPtr p) {
  * Motion Analysis Context Constructor
  ************************************************/
 EbErrorType svt_aom_motion_estimation_context_ctor(EbThreadContext *  thread_ctx,
-                                           const EbEncHandle *enc_handle_ptr, int index) {
+                                           const EbEncHandle *enc_handle_ptr, int index, int feedback_index) {
     MotionEstimationContext_t *me_context_ptr;
 
     EB_CALLOC_ARRAY(me_context_ptr, 1);
@@ -81,11 +81,101 @@ EbErrorType svt_aom_motion_estimation_context_ctor(EbThreadContext *  thread_ctx
     thread_ctx->dctor                            = motion_estimation_context_dctor;
     me_context_ptr->picture_decision_results_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
         enc_handle_ptr->picture_decision_results_resource_ptr, index);
-    me_context_ptr->motion_estimation_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->motion_estimation_results_resource_ptr, index);
+    me_context_ptr->motion_estimation_results_port = index;
+    me_context_ptr->me_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->picture_decision_results_resource_ptr, feedback_index);
     EB_NEW(me_context_ptr->me_ctx, svt_aom_me_context_ctor);
     return EB_ErrorNone;
 }
+/************************************************
+ * post_me_results
+ * Post the ME results of a segment of the picture
+ ************************************************/
+static void post_me_results(MotionEstimationContext_t *me_context_ptr, EbObjectWrapper *pcs_wrapper,
+                            uint32_t segment_index, uint8_t task_type) {
+    PictureParentControlSet *pcs = (PictureParentControlSet *)pcs_wrapper->object_ptr;
+    EbObjectWrapper         *out_results_wrapper;
+    svt_get_empty_object(svt_system_resource_get_producer_fifo(pcs->scs->enc_ctx->motion_estimation_results_resource_ptr,
+                                                               me_context_ptr->motion_estimation_results_port),
+                         &out_results_wrapper);
+
+    MotionEstimationResults *out_results = (MotionEstimationResults *)
+                                                   out_results_wrapper->object_ptr;
+    out_results->pcs_wrapper = pcs_wrapper;
+    out_results->segment_index   = segment_index;
+    out_results->task_type       = task_type;
+    svt_post_full_object(out_results_wrapper);
+}
+
+/************************************************
+ * post_gm_tasks
+ * Post one GM task per reference of the lists searched from first_list on. When the
+ * search of list 1 depends on the motion found for the first reference of list 0,
+ * list 0 is searched alone first. Returns FALSE when there is no reference to search.
+ ************************************************/
+static Bool post_gm_tasks(MotionEstimationContext_t *me_context_ptr, PictureParentControlSet *pcs,
+                          EbObjectWrapper *pcs_wrapper, uint32_t first_list) {
+    const uint32_t last_list = pcs->gm_ctrls.identiy_exit && first_list == REF_LIST_0
+        ? REF_LIST_0 : pcs->gm_num_lists_to_search - 1;
+    uint8_t task_count = 0;
+    for (uint32_t list_index = first_list; list_index <= last_list; ++list_index)
+        for (uint8_t ref_pic_index = 0; ref_pic_index < pcs->gm_num_refs_to_search[list_index]; ++ref_pic_index) {
+            pcs->gm_task_list[task_count] = (uint8_t)list_index;
+            pcs->gm_task_ref[task_count]  = ref_pic_index;
+            task_count++;
+        }
+    if (!task_count)
+        return FALSE;
+    pcs->gm_task_count = task_count;
+    pcs->gm_tasks_done = 0;
+    for (uint8_t task_index = 0; task_index < task_count; ++task_index) {
+        EbObjectWrapper *gm_task_wrapper;
+        svt_get_empty_object(me_context_ptr->me_feedback_fifo_ptr, &gm_task_wrapper);
+        PictureDecisionResults *gm_task = (PictureDecisionResults *)gm_task_wrapper->object_ptr;
+        gm_task->pcs_wrapper   = pcs_wrapper;
+        gm_task->segment_index = task_index;
+        gm_task->task_type     = TASK_GM;
+        svt_post_full_object(gm_task_wrapper);
+    }
+    return TRUE;
+}
+
+/************************************************
+ * gm_next_round
+ * Called once the GM tasks of a round are done: post the tasks of list 1 when list 0
+ * was searched alone, or finish the GM of the picture and post the ME results held
+ * back for it
+ ************************************************/
+static void gm_next_round(MotionEstimationContext_t *me_context_ptr, PictureParentControlSet *pcs,
+                          EbObjectWrapper *pcs_wrapper) {
+    const uint32_t next_list = pcs->gm_task_list[pcs->gm_task_count - 1] + 1;
+    if (next_list < pcs->gm_num_lists_to_search &&
+        pcs->svt_aom_global_motion_estimation[0][0].wmtype != IDENTITY &&
+        post_gm_tasks(me_context_ptr, pcs, pcs_wrapper, next_list))
+        return;
+    svt_aom_gm_set_flags(pcs);
+    post_me_results(me_context_ptr, pcs_wrapper, pcs->gm_me_segment_index, pcs->gm_me_task_type);
+}
+
+/************************************************
+ * start_gm_tasks
+ * Set up the GM of the picture and post its tasks, the ME results of the segment that
+ * completed the ME of the picture being posted by the last task. Returns FALSE when GM
+ * is skipped for the picture, the GM results being final.
+ ************************************************/
+static Bool start_gm_tasks(MotionEstimationContext_t *me_context_ptr, PictureParentControlSet *pcs,
+                           PictureDecisionResults *in_results_ptr) {
+    pcs->gm_num_lists_to_search = (uint8_t)svt_aom_gm_setup(
+        pcs, pcs->enhanced_pic, pcs->gm_frm_corners, &pcs->gm_num_frm_corners, pcs->gm_num_refs_to_search);
+    pcs->gm_me_segment_index = in_results_ptr->segment_index;
+    pcs->gm_me_task_type     = in_results_ptr->task_type;
+    if (pcs->gm_num_lists_to_search &&
+        post_gm_tasks(me_context_ptr, pcs, in_results_ptr->pcs_wrapper, REF_LIST_0))
+        return TRUE;
+    svt_aom_gm_set_flags(pcs);
+    return FALSE;
+}
+
 /************************************************
  * Motion Analysis Kernel
  * The Motion Analysis performs  Motion Estimation
@@ -98,7 +188,6 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
     EbThreadContext *          thread_ctx = (EbThreadContext *)input_ptr;
     MotionEstimationContext_t *me_context_ptr = (MotionEstimationContext_t *)thread_ctx->priv;
     EbObjectWrapper *          in_results_wrapper_ptr;
-    EbObjectWrapper *          out_results_wrapper;
     for (;;) {
         // Get Input Full Object
         EB_GET_FULL_OBJECT(me_context_ptr->picture_decision_results_input_fifo_ptr,
@@ -107,6 +196,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                                                      in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs = (PictureParentControlSet *)
                                                in_results_ptr->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet *scs = pcs->scs;
         if (in_results_ptr->task_type == TASK_TFME)
             me_context_ptr->me_ctx->me_type = ME_MCTF;
@@ -157,6 +247,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
             uint32_t y_b64_end_index = SEGMENT_END_IDX(y_segment_index, picture_height_in_b64, pcs->me_segments_row_count);
 
             Bool skip_me = FALSE;
+            Bool gm_tasks = FALSE;
             if (svt_aom_is_pic_skipped(pcs))
                 skip_me = TRUE;
             // skip me for the first pass. ME is already performed
@@ -277,7 +368,11 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                                 if (pcs->me_processed_b64_count == pcs->b64_total_count) {
 
                                     if (pcs->gm_ctrls.enabled && (!pcs->gm_ctrls.pp_enabled || pcs->gm_pp_detected)){
-                                        svt_aom_global_motion_estimation(pcs, input_pic);
+                                        // With several ME processes the references are searched by GM tasks
+                                        if (pcs->gm_frm_corners)
+                                            gm_tasks = TRUE;
+                                        else
+                                            svt_aom_global_motion_estimation(pcs, input_pic);
                                     } else {
                                         // Initilize global motion to be OFF when GM is OFF
                                         memset(pcs->is_global_motion, FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
@@ -297,20 +392,27 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                             svt_aom_open_loop_intra_search_mb(pcs, b64_index, input_pic);
                         }
             }
-            // Get Empty Results Object
-            svt_get_empty_object(me_context_ptr->motion_estimation_results_output_fifo_ptr,
-                                 &out_results_wrapper);
-
-            MotionEstimationResults *out_results = (MotionEstimationResults *)
-                                                           out_results_wrapper->object_ptr;
-            out_results->pcs_wrapper = in_results_ptr->pcs_wrapper;
-            out_results->segment_index   = segment_index;
-            out_results->task_type       = in_results_ptr->task_type;
+            // The results of the segment completing the ME of the picture wait for its GM tasks
+            if (!(gm_tasks && start_gm_tasks(me_context_ptr, pcs, in_results_ptr)))
+                post_me_results(me_context_ptr, in_results_ptr->pcs_wrapper, segment_index, in_results_ptr->task_type);
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
+        } else if (in_results_ptr->task_type == TASK_GM) {
+            const uint32_t task_index = in_results_ptr->segment_index;
+            svt_aom_gm_search_ref(pcs,
+                                  pcs->enhanced_pic,
+                                  pcs->gm_frm_corners,
+                                  pcs->gm_num_frm_corners,
+                                  pcs->gm_task_list[task_index],
+                                  pcs->gm_task_ref[task_index]);
+            svt_block_on_mutex(pcs->me_processed_b64_mutex);
+            const Bool last_task = ++pcs->gm_tasks_done == pcs->gm_task_count;
+            svt_release_mutex(pcs->me_processed_b64_mutex);
+            if (last_task)
+                gm_next_round(me_context_ptr, pcs, in_results_ptr->pcs_wrapper);
 
-            // Post the Full Results Object
-            svt_post_full_object(out_results_wrapper);
+            // Release the Input Results
+            svt_release_object(in_results_wrapper_ptr);
         } else if (in_results_ptr->task_type == TASK_TFME) {
             //gm pre-processing for only base B
             if (pcs->gm_ctrls.pp_enabled && pcs->gm_pp_enabled && in_results_ptr->segment_index==0)
@@ -320,7 +422,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
             // temporal filtering start
             me_context_ptr->me_ctx->me_type = ME_MCTF;
             svt_av1_init_temporal_filtering(
-                pcs->temp_filt_pcs_list, pcs, me_context_ptr, in_results_ptr->segment_index);
+                pcs->temp_filt_pcs_list, pcs, me_context_ptr);
 
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
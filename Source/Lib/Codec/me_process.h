@@ -21,7 +21,9 @@
  **************************************/
 typedef struct MotionEstimationContext {
     EbFifo    *picture_decision_results_input_fifo_ptr;
-    EbFifo    *motion_estimation_results_output_fifo_ptr;
+    // Producer port of the motion estimation results, the queue is the one of the picture stream
+    uint32_t   motion_estimation_results_port;
+    EbFifo    *me_feedback_fifo_ptr;
     MeContext *me_ctx;
 
     uint8_t *index_table0;
@@ -41,7 +43,7 @@ typedef struct InLoopMeContext {
  * Extern Function Declaration
  ***************************************/
 EbErrorType svt_aom_motion_estimation_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
-                                                   int index);
+                                                   int index, int feedback_index);
 
 extern void *svt_aom_motion_estimation_kernel(void *input_ptr);
 
@@ -16,6 +16,7 @@
 #include "noise_util.h"
 #include "mathutils.h"
 #include "svt_log.h"
+#include "svt_threads.h"
 #include "aom_dsp_rtcd.h"
 
 static const int32_t k_max_lag = 4;
@@ -1964,63 +1965,44 @@ void svt_av1_apply_window_function_to_plane_c(int32_t y_size, int32_t x_size, fl
     }
 }
 
-int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
-                                  int32_t stride[3], int32_t chroma_sub[2], float noise_psd[3], int32_t block_size,
-                                  int32_t bit_depth, int32_t use_highbd) {
-    const float *window_full = NULL, *window_chroma = NULL;
-    float       *plane = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double                *block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
-    const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
-    const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
-    const int32_t          result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float                 *result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
-    const float            k_block_normalization = (float)((1 << bit_depth) - 1);
-    if (chroma_sub[0] != chroma_sub[1]) {
-        SVT_ERROR(
-            "svt_aom_wiener_denoise_2d doesn't handle different chroma "
-            "subsampling");
-        return 0;
-    }
-    init_success &= svt_aom_flat_block_finder_init(&block_finder_full, block_size, bit_depth, use_highbd);
-    result      = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane       = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block       = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d     = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d     = (double *)malloc(block_size * block_size * sizeof(*plane_d));
-    window_full = get_half_cos_window(block_size);
-    tx_full     = svt_aom_noise_tx_malloc(block_size);
-
-    if (chroma_sub[0] != 0) {
-        init_success &= svt_aom_flat_block_finder_init(
-            &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
-        window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
-    } else {
-        window_chroma = window_full;
-        tx_chroma     = tx_full;
-    }
-
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) && (plane_d != NULL) &&
-                              (block != NULL) && (block_d != NULL) && (window_full != NULL) &&
-                              (window_chroma != NULL) && (result != NULL));
-    for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        const float           *window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder    *block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
-        if (!data[c] || !denoised[c])
-            continue;
-        if (c > 0 && chroma_sub[0] != 0)
-            block_finder = &block_finder_chroma;
+// Wiener denoising of one plane, with its own buffers so that the planes can be denoised concurrently
+typedef struct WienerDenoisePlane {
+    const uint8_t *data;
+    uint8_t       *denoised;
+    int32_t        w;
+    int32_t        h;
+    int32_t        stride;
+    int32_t        chroma_sub_w;
+    int32_t        chroma_sub_h;
+    float          noise_psd;
+    int32_t        block_size;
+    int32_t        bit_depth;
+    int32_t        use_highbd;
+} WienerDenoisePlane;
+
+static int32_t wiener_denoise_plane(const WienerDenoisePlane *p) {
+    const int32_t          block_size            = p->block_size;
+    const int32_t          chroma_sub_w          = p->chroma_sub_w;
+    const int32_t          chroma_sub_h          = p->chroma_sub_h;
+    const int32_t          num_blocks_w          = (p->w + block_size - 1) / block_size;
+    const int32_t          num_blocks_h          = (p->h + block_size - 1) / block_size;
+    const int32_t          result_stride         = (num_blocks_w + 2) * block_size;
+    const int32_t          result_height         = (num_blocks_h + 2) * block_size;
+    const float            k_block_normalization = (float)((1 << p->bit_depth) - 1);
+    const float           *window_function       = get_half_cos_window(block_size >> chroma_sub_w);
+    AomFlatBlockFinder     block_finder;
+    float                 *result  = (float *)malloc(result_height * result_stride * sizeof(*result));
+    float                 *plane   = (float *)malloc(block_size * block_size * sizeof(*plane));
+    float                 *block   = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
+    double                *block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
+    double                *plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
+    struct aom_noise_tx_t *tx      = svt_aom_noise_tx_malloc(block_size >> chroma_sub_w);
+    int32_t                success = svt_aom_flat_block_finder_init(
+        &block_finder, block_size >> chroma_sub_w, p->bit_depth, p->use_highbd);
+
+    success &= (int32_t)((tx != NULL) && (plane != NULL) && (plane_d != NULL) && (block != NULL) &&
+                           (block_d != NULL) && (window_function != NULL) && (result != NULL));
+    if (success) {
         memset(result, 0, sizeof(*result) * result_stride * result_height);
         // Do overlapped block processing (half overlapped). The block rows can
         // easily be done in parallel
@@ -2030,18 +2012,19 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
                 for (int32_t by = -1; by < num_blocks_h; ++by) {
                     for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
                         const int32_t pixels_per_block = (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        svt_aom_flat_block_finder_extract_block(block_finder,
-                                                                data[c],
-                                                                w >> chroma_sub_w,
-                                                                h >> chroma_sub_h,
-                                                                stride[c],
+                        svt_aom_flat_block_finder_extract_block(&block_finder,
+                                                                p->data,
+                                                                p->w >> chroma_sub_w,
+                                                                p->h >> chroma_sub_h,
+                                                                p->stride,
                                                                 bx * (block_size >> chroma_sub_w) + offsx,
                                                                 by * (block_size >> chroma_sub_h) + offsy,
                                                                 plane_d,
                                                                 block_d);
-                        svt_av1_pointwise_multiply(window_function, plane, block, plane_d, block_d, pixels_per_block);
+                        svt_av1_pointwise_multiply(
+                            window_function, plane, block, plane_d, block_d, pixels_per_block);
                         svt_aom_noise_tx_forward(tx, block);
-                        svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, noise_psd[c]);
+                        svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, p->noise_psd);
                         svt_aom_noise_tx_inverse(tx, block);
 
                         // Apply window function to the plane approximation (we will apply
@@ -2057,13 +2040,13 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
                 }
             }
         }
-        if (use_highbd) {
+        if (p->use_highbd) {
             dither_and_quantize_highbd(result,
                                        result_stride,
-                                       (uint16_t *)denoised[c],
-                                       w,
-                                       h,
-                                       stride[c],
+                                       (uint16_t *)p->denoised,
+                                       p->w,
+                                       p->h,
+                                       p->stride,
                                        chroma_sub_w,
                                        chroma_sub_h,
                                        block_size,
@@ -2071,10 +2054,10 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
         } else {
             dither_and_quantize_lowbd(result,
                                       result_stride,
-                                      denoised[c],
-                                      w,
-                                      h,
-                                      stride[c],
+                                      p->denoised,
+                                      p->w,
+                                      p->h,
+                                      p->stride,
                                       chroma_sub_w,
                                       chroma_sub_h,
                                       block_size,
@@ -2086,15 +2069,47 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
     svt_aom_free(block);
     free(plane_d);
     free(block_d);
+    svt_aom_noise_tx_free(tx);
+    svt_aom_flat_block_finder_free(&block_finder);
+    return success;
+}
 
-    svt_aom_noise_tx_free(tx_full);
+static void wiener_denoise_plane_setup(WienerDenoisePlane *p, int32_t c, const uint8_t *const data[3],
+                                       uint8_t *denoised[3], int32_t w, int32_t h, int32_t stride[3],
+                                       int32_t chroma_sub[2], float noise_psd[3], int32_t block_size,
+                                       int32_t bit_depth, int32_t use_highbd) {
+    p->data         = data[c];
+    p->denoised     = denoised[c];
+    p->w            = w;
+    p->h            = h;
+    p->stride       = stride[c];
+    p->chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+    p->chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+    p->noise_psd    = noise_psd[c];
+    p->block_size   = block_size;
+    p->bit_depth    = bit_depth;
+    p->use_highbd   = use_highbd;
+}
 
-    svt_aom_flat_block_finder_free(&block_finder_full);
-    if (chroma_sub[0] != 0) {
-        svt_aom_flat_block_finder_free(&block_finder_chroma);
-        svt_aom_noise_tx_free(tx_chroma);
+int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
+                                  int32_t stride[3], int32_t chroma_sub[2], float noise_psd[3], int32_t block_size,
+                                  int32_t bit_depth, int32_t use_highbd) {
+    int32_t success = 1;
+    if (chroma_sub[0] != chroma_sub[1]) {
+        SVT_ERROR(
+            "svt_aom_wiener_denoise_2d doesn't handle different chroma "
+            "subsampling");
+        return 0;
     }
-    return init_success;
+    for (int32_t c = 0; c < 3; ++c) {
+        if (!data[c] || !denoised[c])
+            continue;
+        WienerDenoisePlane p;
+        wiener_denoise_plane_setup(
+            &p, c, data, denoised, w, h, stride, chroma_sub, noise_psd, block_size, bit_depth, use_highbd);
+        success &= wiener_denoise_plane(&p);
+    }
+    return success;
 }
 
 EbErrorType svt_aom_denoise_and_model_alloc(AomDenoiseAndModel *ctx, int32_t bit_depth, int32_t block_size,
@@ -2280,12 +2295,10 @@ static void unpack_2d_pic(uint8_t *packed[3], EbPictureBufferDesc *outputPicture
                               chroma_height);
 }
 
-int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd, AomFilmGrain *film_grain,
-                                      int32_t use_highbd) {
-    const int32_t block_size = ctx->block_size;
-    uint8_t      *raw_data[3];
-    int32_t       chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
-    int32_t       strides[3]         = {sd->stride_y, sd->stride_cb, sd->stride_cr};
+int32_t svt_aom_denoise_and_model_start(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd,
+                                        int32_t use_highbd) {
+    uint8_t *raw_data[3];
+    int32_t  chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
 
     if (!denoise_and_model_realloc_if_necessary(ctx, sd, use_highbd)) {
         SVT_ERROR("Unable to realloc buffers\n");
@@ -2305,22 +2318,50 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
         raw_data[1] = (uint8_t *)(ctx->packed[1]);
         raw_data[2] = (uint8_t *)(ctx->packed[2]);
     }
-
-    const uint8_t *const data[3] = {raw_data[0], raw_data[1], raw_data[2]};
+    for (int32_t c = 0; c < 3; ++c) {
+        ctx->data[c]          = raw_data[c];
+        ctx->plane_success[c] = 0;
+    }
+    ctx->strides[0]   = sd->stride_y;
+    ctx->strides[1]   = sd->stride_cb;
+    ctx->strides[2]   = sd->stride_cr;
+    ctx->frame_width  = sd->width;
+    ctx->frame_height = sd->height;
+    ctx->use_highbd   = use_highbd;
 
     svt_aom_flat_block_finder_run(
-        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks);
-
-    if (!svt_aom_wiener_denoise_2d(data,
-                                   ctx->denoised,
-                                   sd->width,
-                                   sd->height,
-                                   strides,
-                                   chroma_sub_log2,
-                                   ctx->noise_psd,
-                                   block_size,
-                                   ctx->bit_depth,
-                                   use_highbd)) {
+        &ctx->flat_block_finder, ctx->data[0], sd->width, sd->height, ctx->strides[0], ctx->flat_blocks);
+    return 1;
+}
+
+int32_t svt_aom_denoise_and_model_plane(struct AomDenoiseAndModel *ctx, int32_t plane) {
+    int32_t            chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
+    WienerDenoisePlane p;
+    wiener_denoise_plane_setup(&p,
+                               plane,
+                               (const uint8_t *const *)ctx->data,
+                               ctx->denoised,
+                               ctx->frame_width,
+                               ctx->frame_height,
+                               ctx->strides,
+                               chroma_sub_log2,
+                               ctx->noise_psd,
+                               ctx->block_size,
+                               ctx->bit_depth,
+                               ctx->use_highbd);
+    ctx->plane_success[plane] = wiener_denoise_plane(&p);
+    return ctx->plane_success[plane];
+}
+
+int32_t svt_aom_denoise_and_model_finish(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd,
+                                         AomFilmGrain *film_grain, int32_t use_highbd) {
+    const int32_t        block_size         = ctx->block_size;
+    uint8_t **const      raw_data           = ctx->data;
+    int32_t              chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
+    int32_t             *strides            = ctx->strides;
+    const uint8_t *const data[3]            = {raw_data[0], raw_data[1], raw_data[2]};
+
+    if (!(ctx->plane_success[0] && ctx->plane_success[1] && ctx->plane_success[2])) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -2375,3 +2416,11 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
 
     return 1;
 }
+
+int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd, AomFilmGrain *film_grain,
+                                      int32_t use_highbd) {
+    if (!svt_aom_denoise_and_model_start(ctx, sd, use_highbd))
+        return 0;
+    for (int32_t c = 0; c < 3; ++c) svt_aom_denoise_and_model_plane(ctx, c);
+    return svt_aom_denoise_and_model_finish(ctx, sd, film_grain, use_highbd);
+}
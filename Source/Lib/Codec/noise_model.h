@@ -237,6 +237,14 @@ typedef struct AomDenoiseAndModel {
     AomFlatBlockFinder flat_block_finder;
     AomNoiseModel      noise_model;
     uint8_t            denoise_apply;
+
+    // Planes of the picture being denoised, set by svt_aom_denoise_and_model_start()
+    uint8_t *data[3];
+    int32_t  strides[3];
+    int32_t  frame_width;
+    int32_t  frame_height;
+    int32_t  use_highbd;
+    int32_t  plane_success[3];
 } AomDenoiseAndModel;
 
 /************************************
@@ -332,6 +340,19 @@ struct AomDenoiseAndModel;
 int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd, AomFilmGrain *film_grain,
                                       int32_t use_highbd);
 
+/*!\brief The steps of svt_aom_denoise_and_model_run(), so that the planes can be
+     * denoised by different threads.
+     *
+     * svt_aom_denoise_and_model_start() finds the flat blocks of the buffer,
+     * svt_aom_denoise_and_model_plane() then denoises each of the 3 planes, in any
+     * order and concurrently, and svt_aom_denoise_and_model_finish() models the
+     * noise once all the planes are done. Each returns false on error.
+     */
+int32_t svt_aom_denoise_and_model_start(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd, int32_t use_highbd);
+int32_t svt_aom_denoise_and_model_plane(struct AomDenoiseAndModel *ctx, int32_t plane);
+int32_t svt_aom_denoise_and_model_finish(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd,
+                                         AomFilmGrain *film_grain, int32_t use_highbd);
+
 /*!\brief Allocates a context that can be used for denoising and noise modeling.
      *
      * \param[in]  bit_depth   Bit depth of buffers this will be run on.
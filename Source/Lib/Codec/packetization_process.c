@@ -26,6 +26,7 @@
 #include "restoration.h" // RDCOST_DBL
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "stat_report_process.h"
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -90,12 +91,27 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
         enc_handle_ptr->rate_control_tasks_resource_ptr, rate_control_index);
     context_ptr->picture_demux_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
-    context_ptr->picture_decision_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
+    context_ptr->picture_decision_results_output_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
     EB_MALLOC_ARRAY(context_ptr->pps_config, 1);
+    svt_aom_packetization_reset(thread_ctx);
 
     return EB_ErrorNone;
 }
+
+/************************************************
+ * Packetization Reset
+ *   clears the frame counts and the DPB of the
+ *   stream, the kernel must be idle
+ ************************************************/
+void svt_aom_packetization_reset(EbThreadContext *thread_ctx) {
+    PacketizationContext *context_ptr = (PacketizationContext *)thread_ctx->priv;
+
+    memset(context_ptr->dpb_disp_order, 0, sizeof(context_ptr->dpb_disp_order));
+    memset(context_ptr->dpb_dec_order, 0, sizeof(context_ptr->dpb_dec_order));
+    context_ptr->tot_shown_frames            = 0;
+    context_ptr->disp_order_continuity_count = 0;
+}
 static inline int get_reorder_queue_pos(const EncodeContext *enc_ctx, int delta) {
     return (enc_ctx->packetization_reorder_queue_head_index + delta) % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
 }
@@ -478,9 +494,6 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
     EbObjectWrapper *rate_control_tasks_wrapper_ptr;
     EbObjectWrapper *picture_manager_results_wrapper_ptr;
 
-    context_ptr->tot_shown_frames            = 0;
-    context_ptr->disp_order_continuity_count = 0;
-
     for (;;) {
         // Get EntropyCoding Results
         EB_GET_FULL_OBJECT(context_ptr->entropy_coding_input_fifo_ptr, &entropy_coding_results_wrapper_ptr);
@@ -488,6 +501,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         EntropyCodingResults *entropy_coding_results_ptr = (EntropyCodingResults *)
                                                                entropy_coding_results_wrapper_ptr->object_ptr;
         PictureControlSet       *pcs      = (PictureControlSet *)entropy_coding_results_ptr->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet      *scs      = pcs->scs;
         EncodeContext           *enc_ctx  = scs->enc_ctx;
         FrameHeader             *frm_hdr  = &pcs->ppcs->frm_hdr;
@@ -499,7 +513,9 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             // Reset the Bitstream before writing to it
             svt_aom_bitstream_reset(pcs->bitstream_ptr);
             svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
-            int64_t bits = (int64_t)svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) << 3;
+            int64_t bits = (int64_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) +
+                                     svt_aom_frame_tile_data_size(pcs))
+                << 3;
             int64_t rate = bits << 5; // To match scale.
             svt_aom_bitstream_reset(pcs->bitstream_ptr);
             int64_t sse       = ppcs->luma_sse;
@@ -682,9 +698,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     }
                 }
 
-                //free palette data
-                if (pcs->tile_tok[0][0])
-                    EB_FREE_ARRAY(pcs->tile_tok[0][0]);
+                // the palette data is in the pcs arena, given back when the pcs is released
+                pcs->tile_tok[0][0] = NULL;
             }
         } else if (!scs->static_config.stat_report)
             free_temporal_filtering_buffer(pcs, scs);
@@ -731,6 +746,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         output_stream_ptr->qp            = pcs->ppcs->picture_qp;
 
         if (scs->static_config.stat_report) {
+            svt_aom_wait_stat_report_metrics(pcs);
             output_stream_ptr->luma_sse  = pcs->ppcs->luma_sse;
             output_stream_ptr->cr_sse    = pcs->ppcs->cr_sse;
             output_stream_ptr->cb_sse    = pcs->ppcs->cb_sse;
@@ -806,13 +822,17 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
         svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
 
-        output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
-                                                    metadata_sz);
+        const uint32_t tile_data_size  = svt_aom_frame_tile_data_size(pcs);
+        output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) +
+                                                    tile_data_size + TD_SIZE + metadata_sz);
         malloc_p_buffer(output_stream_ptr);
 
         assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
 
         copy_data_from_bitstream(enc_ctx, pcs->bitstream_ptr, output_stream_ptr);
+        // The tiles go from the entropy coder of each tile straight to the output buffer
+        output_stream_ptr->n_filled_len += svt_aom_write_frame_tile_data(
+            pcs, output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len);
 
         if (pcs->ppcs->has_show_existing) {
             uint64_t                   next_picture_number = pcs->picture_number + 1;
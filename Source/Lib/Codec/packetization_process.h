@@ -22,6 +22,7 @@ extern "C" {
  **************************************/
 EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                int rate_control_index, int demux_index, int me_port_index);
+void        svt_aom_packetization_reset(EbThreadContext *thread_ctx);
 
 extern void *svt_aom_packetization_kernel(void *input_ptr);
 #if OPT_LD_LATENCY2
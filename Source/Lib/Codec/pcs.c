@@ -20,6 +20,7 @@
 #include "resource_coordination_process.h"
 #include "md_config_process.h"
 #include "enc_mode_config.h"
+#include "global_motion.h"
 
 void svt_aom_set_tile_info(PictureParentControlSet *pcs);
 
@@ -63,12 +64,6 @@ static void segmentation_map_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->data);
 }
 
-static void svt_pcs_sb_structs_dctor(EbPtr p) {
-    PictureParentControlSet *obj = (PictureParentControlSet *)p;
-    EB_FREE_ARRAY(obj->b64_geom);
-    EB_FREE_ARRAY(obj->sb_geom);
-}
-
 EbErrorType segmentation_map_ctor(SegmentationNeighborMap *seg_neighbor_map, uint16_t pic_width, uint16_t pic_height) {
     uint32_t num_elements = (pic_width >> MI_SIZE_LOG2) * (pic_height >> MI_SIZE_LOG2);
 
@@ -133,6 +128,7 @@ static void picture_control_set_dctor(EbPtr p) {
     uint8_t            depth;
     svt_av1_hash_table_destroy(&obj->hash_table);
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
+    EB_DELETE(obj->arena);
     EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, tile_cnt);
     EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_na, tile_cnt);
     EB_DELETE_PTR_ARRAY(obj->ep_cb_recon_na, tile_cnt);
@@ -211,6 +207,9 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
+    EB_DESTROY_SEMAPHORE(obj->stat_report_done_semaphore);
+    EB_DESTROY_MUTEX(obj->dlf_segment_mutex);
+    EB_FREE_ARRAY(obj->dlf_row_progress);
 }
 
 typedef struct InitData {
@@ -1035,6 +1034,11 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
 
+    EB_CREATE_MUTEX(object_ptr->dlf_segment_mutex);
+    EB_MALLOC_ARRAY(object_ptr->dlf_row_progress, picture_sb_height);
+    for (uint16_t sb_row = 0; sb_row < picture_sb_height; sb_row++)
+        svt_create_cond_var(&object_ptr->dlf_row_progress[sb_row]);
+
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     // object_ptr->mse_seg[1] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->mse_seg[0], picture_sb_width * picture_sb_height);
@@ -1042,6 +1046,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     EB_MALLOC_ARRAY(object_ptr->skip_cdef_seg, picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->cdef_dir_data, picture_sb_width * picture_sb_height);
     EB_CREATE_MUTEX(object_ptr->rest_search_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->stat_report_done_semaphore, 0, 1);
 
     //the granularity is 4x4
     EB_MALLOC_ARRAY(object_ptr->mi_grid_base,
@@ -1097,6 +1102,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
         EB_CALLOC_ALIGNED_ARRAY(object_ptr->tpl_mvs, mem_size);
     }
+    EB_NEW(object_ptr->arena, svt_aom_arena_ctor, 0);
 
     return EB_ErrorNone;
 }
@@ -1120,6 +1126,18 @@ EbErrorType svt_aom_picture_control_set_creator(EbPtr *object_dbl_ptr, EbPtr obj
     return EB_ErrorNone;
 }
 
+/*
+  Release hook of the pcs pool: the picture lifetime buffers go back to the arena.
+  The entropy contexts are freed after MD, free them here if MD did not complete.
+*/
+void svt_aom_picture_control_set_release(EbPtr object_ptr, EbPtr release_data) {
+    PictureControlSet *pcs = (PictureControlSet *)object_ptr;
+    (void)release_data;
+    EB_FREE_ARRAY(pcs->ec_ctx_array);
+    pcs->tile_tok[0][0] = NULL;
+    svt_aom_arena_reset(pcs->arena);
+}
+
 static void picture_parent_control_set_dctor(EbPtr ptr) {
     PictureParentControlSet *obj = (PictureParentControlSet *)ptr;
 
@@ -1153,6 +1171,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_FREE_ARRAY(obj->me_8x8_distortion);
 
     EB_FREE_ARRAY(obj->me_8x8_cost_variance);
+    EB_FREE_ARRAY(obj->gm_frm_corners);
     if (obj->av1_cm) {
         EB_FREE_ARRAY(obj->av1_cm->frame_to_show);
         if (obj->av1_cm->rst_frame.buffer_alloc_sz) {
@@ -1168,8 +1187,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_DESTROY_MUTEX(obj->debug_mutex);
     EB_FREE_ARRAY(obj->tile_group_info);
     EB_DESTROY_MUTEX(obj->pa_me_done.mutex);
-    if (obj->is_pcs_sb_params)
-        svt_pcs_sb_structs_dctor(obj);
+    EB_DELETE(obj->arena);
     if (obj->frame_superres_enabled || obj->frame_resize_enabled) {
         EB_DELETE(obj->enhanced_downscaled_pic);
     }
@@ -1299,6 +1317,7 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
     object_ptr->last_idr_picture     = 0;
     object_ptr->b64_total_count      = picture_sb_width * picture_sb_height;
     object_ptr->is_pcs_sb_params     = FALSE;
+    EB_NEW(object_ptr->arena, svt_aom_arena_ctor, 0);
 
     object_ptr->data_ll_head_ptr         = (EbLinkedListNode *)NULL;
     object_ptr->app_out_data_ll_head_ptr = (EbLinkedListNode *)NULL;
@@ -1339,6 +1358,8 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
     EB_MALLOC_ARRAY(object_ptr->me_8x8_distortion, object_ptr->b64_total_count);
 
     EB_MALLOC_ARRAY(object_ptr->me_8x8_cost_variance, object_ptr->b64_total_count);
+    if (init_data_ptr->gm_tasks)
+        EB_MALLOC_ARRAY(object_ptr->gm_frm_corners, 2 * MAX_CORNERS);
     // SB noise variance array
     EB_CREATE_MUTEX(object_ptr->me_processed_b64_mutex);
     EB_CREATE_SEMAPHORE(object_ptr->temp_filt_done_semaphore, 0, 1);
@@ -1560,8 +1581,7 @@ EbErrorType b64_geom_init_pcs(SequenceControlSet *scs, PictureParentControlSet *
     uint8_t picture_b64_width  = (uint8_t)((encoding_width + b64_size - 1) / b64_size);
     uint8_t picture_b64_height = (uint8_t)((encoding_height + b64_size - 1) / b64_size);
 
-    EB_FREE_ARRAY(pcs->b64_geom);
-    EB_MALLOC_ARRAY(pcs->b64_geom, picture_b64_width * picture_b64_height);
+    EB_ARENA_ALLOC_ARRAY(pcs->arena, pcs->b64_geom, picture_b64_width * picture_b64_height);
 
     for (b64_idx = 0; b64_idx < picture_b64_width * picture_b64_height; ++b64_idx) {
         B64Geom *b64_geom          = &pcs->b64_geom[b64_idx];
@@ -1618,8 +1638,7 @@ EbErrorType sb_geom_init_pcs(SequenceControlSet *scs, PictureParentControlSet *p
     uint16_t picture_sb_width  = (encoding_width + scs->sb_size - 1) / scs->sb_size;
     uint16_t picture_sb_height = (encoding_height + scs->sb_size - 1) / scs->sb_size;
 
-    EB_FREE_ARRAY(pcs->sb_geom);
-    EB_MALLOC_ARRAY(pcs->sb_geom, picture_sb_width * picture_sb_height);
+    EB_ARENA_ALLOC_ARRAY(pcs->arena, pcs->sb_geom, picture_sb_width * picture_sb_height);
 
     for (sb_index = 0; sb_index < picture_sb_width * picture_sb_height; ++sb_index) {
         pcs->sb_geom[sb_index].horizontal_index = sb_index % picture_sb_width;
@@ -1689,6 +1708,21 @@ EbErrorType svt_aom_picture_parent_control_set_creator(EbPtr *object_dbl_ptr, Eb
 
     return EB_ErrorNone;
 }
+
+/*
+  Release hook of the ppcs pool: the picture lifetime buffers go back to the arena.
+  The saved TF source planes are on the heap, as their size varies with the TF role of
+  the picture; they are normally freed once the picture is coded, free any left over.
+*/
+void svt_aom_picture_parent_control_set_release(EbPtr object_ptr, EbPtr release_data) {
+    PictureParentControlSet *ppcs = (PictureParentControlSet *)object_ptr;
+    (void)release_data;
+    for (int plane = 0; plane < 3; plane++) {
+        EB_FREE_ARRAY(ppcs->save_source_picture_ptr[plane]);
+        EB_FREE_ARRAY(ppcs->save_source_picture_bit_inc_ptr[plane]);
+    }
+    svt_aom_arena_reset(ppcs->arena);
+}
 EbErrorType svt_aom_me_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
     MotionEstimationData *obj;
 
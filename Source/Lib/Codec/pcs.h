@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "hash_motion.h"
 #include "firstpass.h"
+#include "arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -221,6 +222,19 @@ typedef struct PicVqCtrls {
     uint8_t detect_high_freq_lvl;
 } PicVqCtrls;
 
+// Filter level search of the deblocking filter when it is split in SB-row segments:
+// every pass filters the picture once, a trial filtering of one plane or the final filtering
+typedef struct DlfSearch {
+    // Plane of the trial filterings, 3 for the final filtering of every plane
+    int32_t plane;
+    // Level of the trial filtering in flight, and level the search of the plane started at
+    int32_t level;
+    int32_t filt_start;
+    int32_t last_frame_filter_level[4];
+    // SSE of each level tried so far, -1 when not tried
+    int64_t ss_err[MAX_LOOP_FILTER + 1];
+} DlfSearch;
+
 typedef struct PictureControlSet {
     /*!< Pointer to the dtor of the struct*/
     EbDctor                    dctor;
@@ -264,6 +278,15 @@ typedef struct PictureControlSet {
     uint8_t  cdef_segments_column_count;
     uint8_t  cdef_segments_row_count;
 
+    // Deblocking by SB-row segments, 1 segment when the picture is filtered by one DLF thread
+    uint16_t  dlf_segments_total_count;
+    uint16_t  tot_seg_filtered_dlf;
+    uint64_t  dlf_pass_sse;
+    EbHandle  dlf_segment_mutex;
+    // Number of superblocks of each SB row filtered so far in the current pass
+    CondVar  *dlf_row_progress;
+    DlfSearch dlf_search;
+
     uint64_t (*mse_seg[2])[TOTAL_STRENGTHS];
     uint8_t     *skip_cdef_seg;
     CdefDirData *cdef_dir_data;
@@ -271,6 +294,9 @@ typedef struct PictureControlSet {
     EbByte       cdef_input_source[3]; // Input video
     uint32_t     tot_seg_searched_rest;
     EbHandle     rest_search_mutex;
+    // posted by the stat report kernel once the metrics of a picture it was given are computed
+    EbHandle     stat_report_done_semaphore;
+    Bool         stat_report_pending;
     uint16_t     rest_segments_total_count;
     uint8_t      rest_segments_column_count;
     uint8_t      rest_segments_row_count;
@@ -409,6 +435,8 @@ typedef struct PictureControlSet {
     TPL_MV_REF                     *tpl_mvs;
     uint8_t                         pic_filter_intra_level;
     TOKENEXTRA                     *tile_tok[64][64];
+    // Picture lifetime buffers (tile_tok), reset when the pcs is released
+    EbArena *arena;
     // Put it here for deinit, don't need to go pcs->ppcs->av1_cm which may already be released
     uint16_t tile_row_count;
     uint16_t tile_column_count;
@@ -849,6 +877,20 @@ typedef struct PictureParentControlSet {
     int8_t               is_gm_on; //-1 invalid, 1: gm on in one of the ref frames,  0:gm off for all ref frames
     uint16_t             me_processed_b64_count;
     EbHandle             me_processed_b64_mutex;
+    // Global motion search split in one ME task per reference, when there are several ME processes
+    int     *gm_frm_corners;
+    int      gm_num_frm_corners;
+    uint8_t  gm_num_lists_to_search;
+    uint8_t  gm_num_refs_to_search[MAX_NUM_OF_REF_PIC_LIST];
+    uint8_t  gm_task_list[MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH];
+    uint8_t  gm_task_ref[MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH];
+    uint8_t  gm_task_count; // tasks of the current round
+    uint8_t  gm_tasks_done;
+    uint32_t gm_me_segment_index; // ME segment whose results are posted once GM is done
+    uint8_t  gm_me_task_type;
+    // Film grain denoise of the picture split in plane tasks of the picture analysis kernels
+    AomDenoiseAndModel *denoise_and_model;
+    volatile int32_t    denoise_tasks_done;
     double               ts_duration;
     double               r0;
     // track pictures that are processd in two different TPL groups
@@ -985,6 +1027,9 @@ typedef struct PictureParentControlSet {
     EbByte                          save_source_picture_bit_inc_ptr[3];
     uint16_t                        save_source_picture_width;
     uint16_t                        save_source_picture_height;
+    // Picture lifetime buffers (b64_geom and sb_geom when scaled),
+    // reset when the ppcs is released
+    EbArena *arena;
     EbHandle                        temp_filt_done_semaphore;
     EbHandle                        temp_filt_mutex;
     EbHandle                        debug_mutex;
@@ -997,8 +1042,7 @@ typedef struct PictureParentControlSet {
     CondVar      me_ready;
 
     int16_t     tf_segments_total_count;
-    uint8_t     tf_segments_column_count;
-    uint8_t     tf_segments_row_count;
+    volatile int32_t tf_next_blk; // next 64x64 block to filter, claimed by the TF tasks in raster order
     uint8_t     past_altref_nframes;
     uint8_t     future_altref_nframes;
     Bool        do_tf;
@@ -1205,6 +1249,7 @@ typedef struct PictureControlSetInitData {
     uint8_t    enable_tpl_la;
     uint8_t    tpl_synth_size;
     uint8_t    in_loop_ois;
+    Bool       gm_tasks; // global motion searched in one ME task per reference
     uint32_t   rate_control_mode;
     Av1Common *av1_cm;
     uint16_t   init_max_block_cnt;
@@ -1248,6 +1293,9 @@ uint32_t svt_aom_get_out_buffer_size(uint32_t picture_width, uint32_t picture_he
 EbErrorType svt_aom_picture_control_set_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 EbErrorType svt_aom_recon_coef_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 EbErrorType svt_aom_picture_parent_control_set_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
+// release_cb of the pcs / ppcs pools, resetting the picture arena
+void svt_aom_picture_control_set_release(EbPtr object_ptr, EbPtr release_data);
+void svt_aom_picture_parent_control_set_release(EbPtr object_ptr, EbPtr release_data);
 EbErrorType svt_aom_me_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, PictureControlSetInitData *init_data_ptr);
 EbErrorType ppcs_update_param(PictureParentControlSet *ppcs);
@@ -211,6 +211,10 @@ static void picture_decision_context_dctor(EbPtr p)
     EB_FREE_2D(obj->ahd_running_avg);
     EB_FREE_2D(obj->ahd_running_avg_cr);
     EB_FREE_2D(obj->ahd_running_avg_cb);
+    if (obj->tf_me_context) {
+        EB_DELETE(obj->tf_me_context->me_ctx);
+        EB_FREE_ARRAY(obj->tf_me_context);
+    }
     EB_FREE_ARRAY(obj);
 }
 
@@ -232,7 +236,7 @@ EbErrorType svt_aom_picture_decision_context_ctor(
     pd_ctx->picture_analysis_results_input_fifo_ptr =
         svt_system_resource_get_consumer_fifo(enc_handle_ptr->picture_analysis_results_resource_ptr, 0);
     pd_ctx->picture_decision_results_output_fifo_ptr =
-        svt_system_resource_get_producer_fifo(enc_handle_ptr->picture_decision_results_resource_ptr, 0);
+        svt_aom_stream_producer_fifo(enc_handle_ptr, enc_handle_ptr->picture_decision_results_resource_ptr, 0);
     if (calc_hist) {
         EB_ALLOC_PTR_ARRAY(pd_ctx->prev_picture_histogram, MAX_NUMBER_OF_REGIONS_IN_WIDTH);
         for (uint32_t region_in_picture_width_index = 0; region_in_picture_width_index < MAX_NUMBER_OF_REGIONS_IN_WIDTH; region_in_picture_width_index++) { // loop over horizontal regions
@@ -244,19 +248,48 @@ EbErrorType svt_aom_picture_decision_context_ctor(
 
         EB_CALLOC_2D(pd_ctx->ahd_running_avg, MAX_NUMBER_OF_REGIONS_IN_WIDTH * sizeof(uint32_t), MAX_NUMBER_OF_REGIONS_IN_HEIGHT * sizeof(uint32_t));
     }
-    pd_ctx->reset_running_avg = TRUE;
     pd_ctx->me_fifo_ptr = svt_system_resource_get_producer_fifo(
             enc_handle_ptr->me_pool_ptr_array[0], 0);
+    EB_CALLOC_ARRAY(pd_ctx->tf_me_context, 1);
+    EB_NEW(pd_ctx->tf_me_context->me_ctx, svt_aom_me_context_ctor);
 
+    svt_aom_picture_decision_reset(thread_ctx);
+    return EB_ErrorNone;
+}
 
-    pd_ctx->mg_progress_id = 0;
-    pd_ctx->last_i_noise_levels_log1p_fp16[0] = 0;
+/************************************************
+ * Picture Decision Reset
+ *   brings the context back to its state at
+ *   construction, keeping the fifos and buffers;
+ *   the kernel must be idle
+ ************************************************/
+void svt_aom_picture_decision_reset(EbThreadContext *thread_ctx) {
+    PictureDecisionContext *pd_ctx = (PictureDecisionContext *)thread_ctx->priv;
+    PictureDecisionContext  kept   = *pd_ctx;
+
+    memset(pd_ctx, 0, sizeof(*pd_ctx));
+    pd_ctx->dctor                                    = kept.dctor;
+    pd_ctx->picture_analysis_results_input_fifo_ptr  = kept.picture_analysis_results_input_fifo_ptr;
+    pd_ctx->picture_decision_results_output_fifo_ptr = kept.picture_decision_results_output_fifo_ptr;
+    pd_ctx->me_fifo_ptr                              = kept.me_fifo_ptr;
+    pd_ctx->prev_picture_histogram                   = kept.prev_picture_histogram;
+    pd_ctx->ahd_running_avg                          = kept.ahd_running_avg;
+    pd_ctx->ahd_running_avg_cb                       = kept.ahd_running_avg_cb;
+    pd_ctx->ahd_running_avg_cr                       = kept.ahd_running_avg_cr;
+    pd_ctx->tf_me_context                            = kept.tf_me_context;
+    if (pd_ctx->prev_picture_histogram) {
+        for (uint32_t i = 0; i < MAX_NUMBER_OF_REGIONS_IN_WIDTH; i++)
+            for (uint32_t j = 0; j < MAX_NUMBER_OF_REGIONS_IN_HEIGHT; j++)
+                memset(pd_ctx->prev_picture_histogram[i][j], 0, HISTOGRAM_NUMBER_OF_BINS * sizeof(uint32_t));
+    }
+    if (pd_ctx->ahd_running_avg) {
+        for (uint32_t i = 0; i < MAX_NUMBER_OF_REGIONS_IN_WIDTH; i++)
+            memset(pd_ctx->ahd_running_avg[i], 0, MAX_NUMBER_OF_REGIONS_IN_HEIGHT * sizeof(uint32_t));
+    }
+
+    pd_ctx->reset_running_avg   = TRUE;
     pd_ctx->transition_detected = -1;
-    pd_ctx->sframe_poc = 0;
-    pd_ctx->sframe_due = 0;
-    pd_ctx->last_long_base_pic = 0;
-    pd_ctx->enable_startup_mg = false;
-    return EB_ErrorNone;
+    pd_ctx->current_input_poc   = -1;
 }
 static Bool scene_transition_detector(
     PictureDecisionContext* pd_ctx,
@@ -620,7 +653,9 @@ static void early_hme(
     }
 
     // wait for all segments to complete before the frame based calculations can be performed using the dg metrics
+    svt_yield_worker_token();
     svt_block_on_semaphore(src_pcs->dg_detector->frame_done_sem);
+    svt_resume_worker_token();
 
     // 64x64 Block Loop
     uint32_t pic_width_in_b64 = (src_pcs->aligned_width + 63) / 64;
@@ -3396,13 +3431,13 @@ static void mctf_frame(
         // Start Filtering in ME processes
         {
             int16_t seg_idx;
+            const int16_t me_tasks = (int16_t)(scs->tf_segment_column_count * scs->tf_segment_row_count);
 
-            // Initialize Segments
-            pcs->tf_segments_column_count = scs->tf_segment_column_count;
-            pcs->tf_segments_row_count = scs->tf_segment_row_count;
-            pcs->tf_segments_total_count = (uint16_t)(pcs->tf_segments_column_count  * pcs->tf_segments_row_count);
+            // The ME tasks and the PD thread claim the 64x64 blocks of the picture dynamically
+            pcs->tf_segments_total_count = me_tasks + 1;
             pcs->temp_filt_seg_acc = 0;
-            for (seg_idx = 0; seg_idx < pcs->tf_segments_total_count; ++seg_idx) {
+            pcs->tf_next_blk = 0;
+            for (seg_idx = 0; seg_idx < me_tasks; ++seg_idx) {
 
                 EbObjectWrapper               *out_results_wrapper;
                 PictureDecisionResults        *out_results;
@@ -3417,7 +3452,16 @@ static void mctf_frame(
                 svt_post_full_object(out_results_wrapper);
             }
 
+            // Filter alongside the ME tasks instead of idling until the picture is done, so the
+            // filtering keeps progressing while the ME workers are still busy with the previous mini-GOP
+            MeContext *me_ctx = pd_ctx->tf_me_context->me_ctx;
+            me_ctx->me_type   = ME_MCTF;
+            svt_aom_sig_deriv_me_tf(pcs, me_ctx);
+            svt_av1_init_temporal_filtering(pcs->temp_filt_pcs_list, pcs, pd_ctx->tf_me_context);
+
+            svt_yield_worker_token();
             svt_block_on_semaphore(pcs->temp_filt_done_semaphore);
+            svt_resume_worker_token();
         }
 
         if (pcs->tf_tot_horz_blks > pcs->tf_tot_vert_blks * 6 / 4){
@@ -3531,8 +3575,11 @@ static void send_picture_out(
 
     // NB: overlay frames should be non-ref
     // Before sending pics out to pic mgr, ensure that pic mgr can handle them
-    if (pcs->is_ref)
+    if (pcs->is_ref) {
+        svt_yield_worker_token();
         svt_block_on_semaphore(scs->ref_buffer_available_semaphore);
+        svt_resume_worker_token();
+    }
 
     for (uint32_t segment_index = 0; segment_index < pcs->me_segments_total_count; ++segment_index) {
         // Get Empty Results Object
@@ -4537,7 +4584,6 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
     PictureDecisionReorderEntry   *queue_entry_ptr;
 
     unsigned int pic_idx;
-    int64_t                            current_input_poc = -1;
 
     for (;;) {
         // Get Input Full Object
@@ -4549,6 +4595,7 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
         pcs = (PictureParentControlSet*)in_results_ptr->pcs_wrapper->object_ptr;
         scs = pcs->scs;
         enc_ctx = (EncodeContext*)scs->enc_ctx;
+        svt_aom_profile_picture(pcs->picture_number);
 
         // Input Picture Analysis Results into the Picture Decision Reordering Queue
         // Since the prior Picture Analysis processes stage is multithreaded, inputs to the Picture Decision Process
@@ -4599,7 +4646,7 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
             enc_ctx->pre_assignment_buffer[enc_ctx->pre_assignment_buffer_count] = queue_entry_ptr->ppcs_wrapper;
 
             // Set the POC Number
-            pcs->picture_number = ++current_input_poc;
+            pcs->picture_number = ++ctx->current_input_poc;
             pcs->pred_structure = scs->static_config.pred_structure;
             pcs->hierarchical_layers_diff = 0;
             pcs->init_pred_struct_position_flag = FALSE;
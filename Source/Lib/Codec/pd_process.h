@@ -16,12 +16,14 @@
 #include "pcs.h"
 #include "sequence_control_set.h"
 #include "utility.h"
+#include "me_process.h"
 
 /***************************************
  * Extern Function Declaration
  ***************************************/
 EbErrorType  svt_aom_picture_decision_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                    uint8_t calc_hist);
+void         svt_aom_picture_decision_reset(EbThreadContext *thread_ctx);
 extern void *svt_aom_picture_decision_kernel(void *input_ptr);
 
 void svt_aom_pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlSet  *scs,
@@ -102,6 +104,7 @@ typedef struct PictureDecisionContext {
     uint8_t                  tf_level;
     uint32_t                 tf_pic_arr_cnt;
     PictureParentControlSet *tf_pic_array[1 << MAX_TEMPORAL_LAYERS];
+    MotionEstimationContext_t *tf_me_context; // used by the PD thread to filter alongside the ME tasks
     PictureParentControlSet *mg_pictures_array[1 << MAX_TEMPORAL_LAYERS];
     PictureParentControlSet *prev_delayed_intra; //Key frame or I of LDP short MG
     uint32_t                 mg_size; //number of active pictures in above array
@@ -126,6 +129,7 @@ typedef struct PictureDecisionContext {
     bool     enable_startup_mg;
     uint32_t filt_to_unfilt_diff;
     bool     list0_only;
+    int64_t  current_input_poc; // of the last picture placed in the pre-assignment buffer
 } PictureDecisionContext;
 
 #endif // EbPictureDecision_h
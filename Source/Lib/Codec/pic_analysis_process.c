@@ -38,7 +38,10 @@
 typedef struct PictureAnalysisContext {
     EB_ALIGN(64) uint8_t local_cache[64];
     EbFifo *resource_coordination_results_input_fifo_ptr;
-    EbFifo *picture_analysis_results_output_fifo_ptr;
+    // Producer port of the picture analysis results, the queue is the one of the picture stream
+    uint32_t picture_analysis_results_port;
+    // Posts the film grain denoise plane tasks to the picture analysis kernels
+    EbFifo *denoise_task_fifo_ptr;
 } PictureAnalysisContext;
 
 static void picture_analysis_context_dctor(EbPtr p) {
@@ -50,7 +53,7 @@ static void picture_analysis_context_dctor(EbPtr p) {
  * Picture Analysis Context Constructor
  ************************************************/
 EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
-                                                  int index) {
+                                                  int index, int feedback_index) {
     PictureAnalysisContext *pa_ctx;
     EB_CALLOC_ARRAY(pa_ctx, 1);
     thread_ctx->priv  = pa_ctx;
@@ -58,8 +61,9 @@ EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, c
 
     pa_ctx->resource_coordination_results_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
         enc_handle_ptr->resource_coordination_results_resource_ptr, index);
-    pa_ctx->picture_analysis_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_analysis_results_resource_ptr, index);
+    pa_ctx->picture_analysis_results_port = index;
+    pa_ctx->denoise_task_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->resource_coordination_results_resource_ptr, feedback_index);
     return EB_ErrorNone;
 }
 void svt_aom_down_sample_chroma(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *outputPicturePtr) {
@@ -1380,8 +1384,7 @@ static EbErrorType compute_block_mean_compute_variance(
     return return_error;
 }
 
-static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet *pcs,
-                                EbPictureBufferDesc *inputPicturePointer) {
+static AomDenoiseAndModel *denoise_and_model_new(SequenceControlSet *scs, PictureParentControlSet *pcs) {
     AomDenoiseAndModel     *denoise_and_model;
     DenoiseAndModelInitData fg_init_data;
     fg_init_data.encoder_bit_depth    = pcs->enhanced_pic->bit_depth;
@@ -1394,7 +1397,15 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet
     fg_init_data.stride_cr            = pcs->enhanced_pic->stride_cr;
     fg_init_data.denoise_apply        = scs->static_config.film_grain_denoise_apply;
     fg_init_data.adaptive_film_grain  = scs->static_config.adaptive_film_grain;
-    EB_NEW(denoise_and_model, svt_aom_denoise_and_model_ctor, (EbPtr)&fg_init_data);
+    EB_NO_THROW_NEW(denoise_and_model, svt_aom_denoise_and_model_ctor, (EbPtr)&fg_init_data);
+    return denoise_and_model;
+}
+
+static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet *pcs,
+                                EbPictureBufferDesc *inputPicturePointer) {
+    AomDenoiseAndModel *denoise_and_model = denoise_and_model_new(scs, pcs);
+    if (!denoise_and_model)
+        return -1;
 
     if (svt_aom_denoise_and_model_run(denoise_and_model,
                                       inputPicturePointer,
@@ -2257,6 +2268,140 @@ void svt_aom_pad_input_pictures(SequenceControlSet *scs, EbPictureBufferDesc *in
     }
 }
 
+/************************************************
+ * picture_analysis_finish
+ * Analysis of the picture once its pre-processing is done, then post the picture to
+ * picture decision
+ ************************************************/
+static void picture_analysis_finish(PictureAnalysisContext *pa_ctx, PictureParentControlSet *pcs,
+                                    EbObjectWrapper *pcs_wrapper) {
+    SequenceControlSet *scs = pcs->scs;
+    // There is no need to do processing for overlay picture. Overlay and AltRef share the same
+    // results.
+    if (!pcs->is_overlay) {
+        EbPictureBufferDesc *input_pic = pcs->enhanced_pic;
+        EbPictureBufferDesc *input_padded_pic;
+        EbPaReferenceObject *pa_ref_obj_;
+        {
+            if (input_pic->color_format >= EB_YUV422) {
+                // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
+                //       Reuse the Y, only add cb/cr in the newly created buffer desc
+                //       NOTE: since denoise may change the src, so this part is after svt_aom_picture_pre_processing_operations()
+                pcs->chroma_downsampled_pic->buffer_y = input_pic->buffer_y;
+                svt_aom_down_sample_chroma(input_pic, pcs->chroma_downsampled_pic);
+            } else
+                pcs->chroma_downsampled_pic = input_pic;
+
+            //not passing through the DS pool, so 1/4 and 1/16 are not used
+            pcs->ds_pics.picture_ptr           = input_pic;
+            pcs->ds_pics.quarter_picture_ptr   = NULL;
+            pcs->ds_pics.sixteenth_picture_ptr = NULL;
+            pcs->ds_pics.picture_number        = pcs->picture_number;
+
+            // Original path
+            // Get PA ref, copy 8bit luma to pa_ref->input_padded_pic
+            pa_ref_obj_                 = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
+            pa_ref_obj_->picture_number = pcs->picture_number;
+            input_padded_pic            = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
+
+            // 1/4 & 1/16 input picture downsampling through filtering
+            svt_aom_downsample_filtering_input_picture(
+                pcs,
+                input_padded_pic,
+                (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
+                (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+
+            pcs->ds_pics.quarter_picture_ptr   = pa_ref_obj_->quarter_downsampled_picture_ptr;
+            pcs->ds_pics.sixteenth_picture_ptr = pa_ref_obj_->sixteenth_downsampled_picture_ptr;
+        }
+        // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
+        {
+            svt_aom_gathering_picture_statistics(
+                scs, pcs, input_padded_pic, (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+
+            pa_ref_obj_->avg_luma = pcs->avg_luma;
+        }
+        // If running multi-threaded mode, perform SC detection in svt_aom_picture_analysis_kernel, else in svt_aom_picture_decision_kernel
+#if CLN_LP_LVLS
+        if (scs->static_config.level_of_parallelism != 1) {
+#else
+        if (scs->static_config.logical_processors != 1) {
+#endif
+            if (scs->static_config.screen_content_mode == 2) { // auto detect
+                if (scs->static_config.tune == 4)
+                    svt_aom_is_screen_content_psy(pcs);
+                // SC Detection is OFF for 4K and higher
+                else if (scs->input_resolution <= INPUT_SIZE_1080p_RANGE)
+                    svt_aom_is_screen_content(pcs);
+                else
+                    pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = pcs->sc_class3 = 0;
+
+            } else // off / on
+                pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = pcs->sc_class3 =
+                    scs->static_config.screen_content_mode;
+        }
+    }
+    // Get Empty Results Object
+    EbObjectWrapper *out_results_wrapper;
+    svt_get_empty_object(svt_system_resource_get_producer_fifo(scs->enc_ctx->picture_analysis_results_resource_ptr,
+                                                               pa_ctx->picture_analysis_results_port),
+                         &out_results_wrapper);
+
+    PictureAnalysisResults *out_results = (PictureAnalysisResults *)out_results_wrapper->object_ptr;
+    out_results->pcs_wrapper            = pcs_wrapper;
+
+    // Post the Full Results Object
+    svt_post_full_object(out_results_wrapper);
+}
+
+/************************************************
+ * start_denoise_tasks
+ * Start the film grain denoise of the picture and post the denoise of the chroma planes to
+ * the picture analysis kernels, the luma being left to the calling kernel. The analysis of
+ * the picture is completed by the kernel denoising the last plane. Returns FALSE when the
+ * denoise could not be started, the picture then having no film grain.
+ ************************************************/
+static Bool start_denoise_tasks(PictureAnalysisContext *pa_ctx, SequenceControlSet *scs, PictureParentControlSet *pcs,
+                                EbObjectWrapper *pcs_wrapper) {
+    pcs->frm_hdr.film_grain_params.apply_grain = 0;
+    pcs->denoise_and_model                     = denoise_and_model_new(scs, pcs);
+    if (!pcs->denoise_and_model)
+        return FALSE;
+    if (!svt_aom_denoise_and_model_start(
+            pcs->denoise_and_model, pcs->enhanced_pic, scs->static_config.encoder_bit_depth > EB_EIGHT_BIT)) {
+        EB_DELETE(pcs->denoise_and_model);
+        return FALSE;
+    }
+    pcs->denoise_tasks_done = 0;
+    for (uint8_t plane = 1; plane < 3; ++plane) {
+        EbObjectWrapper *task_wrapper;
+        svt_get_empty_object(pa_ctx->denoise_task_fifo_ptr, &task_wrapper);
+        ResourceCoordinationResults *task = (ResourceCoordinationResults *)task_wrapper->object_ptr;
+        task->pcs_wrapper                 = pcs_wrapper;
+        task->task_type                   = TASK_PA_DENOISE;
+        task->plane                       = plane;
+        svt_post_full_object(task_wrapper);
+    }
+    return TRUE;
+}
+
+/************************************************
+ * run_denoise_task
+ * Denoise one plane of the picture, the kernel denoising the last plane models the noise.
+ * Returns TRUE for the last plane.
+ ************************************************/
+static Bool run_denoise_task(SequenceControlSet *scs, PictureParentControlSet *pcs, uint8_t plane) {
+    svt_aom_denoise_and_model_plane(pcs->denoise_and_model, plane);
+    if (svt_atomic_fetch_add_i32(&pcs->denoise_tasks_done, 1) + 1 < 3)
+        return FALSE;
+    svt_aom_denoise_and_model_finish(pcs->denoise_and_model,
+                                     pcs->enhanced_pic,
+                                     &pcs->frm_hdr.film_grain_params,
+                                     scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
+    EB_DELETE(pcs->denoise_and_model);
+    return TRUE;
+}
+
 /* Picture Analysis Kernel */
 
 /*********************************************************************************
@@ -2291,104 +2436,50 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
 
     EbObjectWrapper             *in_results_wrapper_ptr;
     ResourceCoordinationResults *in_results_ptr;
-    EbObjectWrapper             *out_results_wrapper;
-    EbPaReferenceObject         *pa_ref_obj_;
-
-    EbPictureBufferDesc *input_padded_pic;
-    EbPictureBufferDesc *input_pic;
 
     for (;;) {
         // Get Input Full Object
         EB_GET_FULL_OBJECT(pa_ctx->resource_coordination_results_input_fifo_ptr, &in_results_wrapper_ptr);
 
-        in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
-        pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
-        scs            = pcs->scs;
+        in_results_ptr                   = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
+        EbObjectWrapper *pcs_wrapper     = in_results_ptr->pcs_wrapper;
+        pcs                              = (PictureParentControlSet *)pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
+        scs                              = pcs->scs;
+
+        if (in_results_ptr->task_type == TASK_PA_DENOISE) {
+            const uint8_t plane = in_results_ptr->plane;
+            // Release the Input Results
+            svt_release_object(in_results_wrapper_ptr);
+            if (run_denoise_task(scs, pcs, plane))
+                picture_analysis_finish(pa_ctx, pcs, pcs_wrapper);
+            continue;
+        }
 
         // Mariana : save enhanced picture ptr, move this from here
         pcs->enhanced_unscaled_pic                    = pcs->enhanced_pic;
         pcs->enhanced_unscaled_pic->is_16bit_pipeline = scs->is_16bit_pipeline;
 
-        // There is no need to do processing for overlay picture. Overlay and AltRef share the same
-        // results.
-        if (!pcs->is_overlay) {
-            input_pic = pcs->enhanced_pic;
-            {
-                // Padding for input pictures
-                svt_aom_pad_input_pictures(scs, input_pic);
-
-                // Pre processing operations performed on the input picture
-                svt_aom_picture_pre_processing_operations(pcs, scs);
-
-                if (input_pic->color_format >= EB_YUV422) {
-                    // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
-                    //       Reuse the Y, only add cb/cr in the newly created buffer desc
-                    //       NOTE: since denoise may change the src, so this part is after svt_aom_picture_pre_processing_operations()
-                    pcs->chroma_downsampled_pic->buffer_y = input_pic->buffer_y;
-                    svt_aom_down_sample_chroma(input_pic, pcs->chroma_downsampled_pic);
-                } else
-                    pcs->chroma_downsampled_pic = input_pic;
-
-                //not passing through the DS pool, so 1/4 and 1/16 are not used
-                pcs->ds_pics.picture_ptr           = input_pic;
-                pcs->ds_pics.quarter_picture_ptr   = NULL;
-                pcs->ds_pics.sixteenth_picture_ptr = NULL;
-                pcs->ds_pics.picture_number        = pcs->picture_number;
-
-                // Original path
-                // Get PA ref, copy 8bit luma to pa_ref->input_padded_pic
-                pa_ref_obj_                 = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
-                pa_ref_obj_->picture_number = pcs->picture_number;
-                input_padded_pic            = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
-
-                // 1/4 & 1/16 input picture downsampling through filtering
-                svt_aom_downsample_filtering_input_picture(
-                    pcs,
-                    input_padded_pic,
-                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-
-                pcs->ds_pics.quarter_picture_ptr   = pa_ref_obj_->quarter_downsampled_picture_ptr;
-                pcs->ds_pics.sixteenth_picture_ptr = pa_ref_obj_->sixteenth_downsampled_picture_ptr;
-            }
-            // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
-            {
-                svt_aom_gathering_picture_statistics(
-                    scs, pcs, input_padded_pic, (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-
-                pa_ref_obj_->avg_luma = pcs->avg_luma;
-            }
-            // If running multi-threaded mode, perform SC detection in svt_aom_picture_analysis_kernel, else in svt_aom_picture_decision_kernel
-#if CLN_LP_LVLS
-            if (scs->static_config.level_of_parallelism != 1) {
-#else
-            if (scs->static_config.logical_processors != 1) {
-#endif
-                if (scs->static_config.screen_content_mode == 2) { // auto detect
-                    if (scs->static_config.tune == 4)
-                        svt_aom_is_screen_content_psy(pcs);
-                    // SC Detection is OFF for 4K and higher
-                    else if (scs->input_resolution <= INPUT_SIZE_1080p_RANGE)
-                        svt_aom_is_screen_content(pcs);
-                    else
-                        pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = pcs->sc_class3 = 0;
-
-                } else // off / on
-                    pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = pcs->sc_class3 =
-                        scs->static_config.screen_content_mode;
-            }
-        }
-        // Get Empty Results Object
-        svt_get_empty_object(pa_ctx->picture_analysis_results_output_fifo_ptr, &out_results_wrapper);
-
-        PictureAnalysisResults *out_results = (PictureAnalysisResults *)out_results_wrapper->object_ptr;
-        out_results->pcs_wrapper            = in_results_ptr->pcs_wrapper;
-
         // Release the Input Results
         svt_release_object(in_results_wrapper_ptr);
 
-        // Post the Full Results Object
-        svt_post_full_object(out_results_wrapper);
+        if (!pcs->is_overlay) {
+            // Padding for input pictures
+            svt_aom_pad_input_pictures(scs, pcs->enhanced_pic);
+
+            // Pre processing operations performed on the input picture. With several picture
+            // analysis kernels the chroma planes of the film grain denoise are tasks of their own.
+            if (!scs->static_config.fgs_table && scs->static_config.film_grain_denoise_strength &&
+                scs->picture_analysis_process_init_count > 1) {
+                if (start_denoise_tasks(pa_ctx, scs, pcs, pcs_wrapper)) {
+                    if (run_denoise_task(scs, pcs, 0))
+                        picture_analysis_finish(pa_ctx, pcs, pcs_wrapper);
+                    continue;
+                }
+            } else
+                svt_aom_picture_pre_processing_operations(pcs, scs);
+        }
+        picture_analysis_finish(pa_ctx, pcs, pcs_wrapper);
     }
     return NULL;
 }
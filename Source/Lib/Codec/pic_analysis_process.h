@@ -21,7 +21,7 @@
  * Extern Function Declaration
  ***************************************/
 EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
-                                                  int index);
+                                                  int index, int feedback_index);
 
 extern void *svt_aom_picture_analysis_kernel(void *input_ptr);
 
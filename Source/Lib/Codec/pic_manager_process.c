@@ -48,7 +48,7 @@ static EbErrorType rtime_alloc_palette_tokens(SequenceControlSet *scs, PictureCo
             uint32_t     mb_cols = (mi_cols + 2) >> 2;
             uint32_t     mb_rows = (mi_rows + 2) >> 2;
             unsigned int tokens  = get_token_alloc(mb_rows, mb_cols, MAX_SB_SIZE_LOG2, 2);
-            EB_CALLOC_ARRAY(child_pcs->tile_tok[0][0], tokens);
+            EB_ARENA_CALLOC_ARRAY(child_pcs->arena, child_pcs->tile_tok[0][0], tokens);
         } else
             child_pcs->tile_tok[0][0] = NULL;
     }
@@ -78,16 +78,29 @@ EbErrorType svt_aom_picture_manager_context_ctor(EbThreadContext *thread_ctx, co
         enc_handle_ptr->picture_demux_results_resource_ptr, 0);
     context_ptr->picture_manager_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->rate_control_tasks_resource_ptr, rate_control_index);
-    context_ptr->picture_control_set_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_control_set_pool_ptr_array[0], 0); //The Child PCS Pool here
-    context_ptr->recon_coef_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->enc_dec_pool_ptr_array[0],
-                                                                             0); //The Child PCS Pool here
+    context_ptr->picture_control_set_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->picture_control_set_pool_ptr_array[0], 0); //The Child PCS Pool here
+    context_ptr->recon_coef_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->enc_dec_pool_ptr_array[0], 0); //The Child PCS Pool here
 
+    svt_aom_picture_manager_reset(thread_ctx);
+
+    return EB_ErrorNone;
+}
+
+/************************************************
+ * Picture Manager Reset
+ *   restarts the decode order for a new stream,
+ *   the kernel must be idle
+ ************************************************/
+void svt_aom_picture_manager_reset(EbThreadContext *thread_ctx) {
+    PictureManagerContext *context_ptr = (PictureManagerContext *)thread_ctx->priv;
+
+    context_ptr->decode_order                    = 0;
+    context_ptr->pmgr_dec_order                  = 0;
     context_ptr->consecutive_dec_order           = 0;
     context_ptr->started_pics_dec_order_head_idx = 0;
     context_ptr->started_pics_dec_order_tail_idx = 0;
-
-    return EB_ErrorNone;
 }
 
 void svt_aom_copy_buffer_info(EbPictureBufferDesc *src_ptr, EbPictureBufferDesc *dst_ptr) {
@@ -329,7 +342,6 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
     // Initialization
     uint16_t pic_width_in_sb;
     uint16_t picture_height_in_sb;
-    uint64_t decode_order = 0;
 
     for (;;) {
         // Get Input Full Object
@@ -343,6 +355,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         switch (input_pic_demux->picture_type) {
         case EB_PIC_SUPERRES_INPUT: {
             pcs = (PictureParentControlSet *)input_pic_demux->pcs_wrapper->object_ptr;
+            svt_aom_profile_picture(pcs->picture_number);
             scs = pcs->scs;
 
             assert(scs->static_config.superres_mode == SUPERRES_QTHRESH ||
@@ -367,6 +380,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         case EB_PIC_INPUT:
 
             pcs     = (PictureParentControlSet *)input_pic_demux->pcs_wrapper->object_ptr;
+            svt_aom_profile_picture(pcs->picture_number);
             scs     = pcs->scs;
             enc_ctx = scs->enc_ctx;
 
@@ -428,6 +442,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         case EB_PIC_REFERENCE:
 
             scs     = input_pic_demux->scs;
+            svt_aom_profile_picture(input_pic_demux->picture_number);
             enc_ctx = scs->enc_ctx;
             ((EbReferenceObject *)input_pic_demux->ref_pic_wrapper->object_ptr)->ds_pics.picture_number =
                 input_pic_demux->picture_number;
@@ -457,6 +472,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
             break;
         case EB_PIC_FEEDBACK:
             scs     = input_pic_demux->scs;
+            svt_aom_profile_picture(input_pic_demux->picture_number);
             enc_ctx = scs->enc_ctx;
 
             // Find the Reference in the Reference Queue
@@ -478,8 +494,8 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
             svt_release_mutex(enc_ctx->ref_pic_list_mutex);
 #endif
             // Update the last decode order
-            if (input_pic_demux->decode_order == decode_order)
-                decode_order++;
+            if (input_pic_demux->decode_order == context_ptr->decode_order)
+                context_ptr->decode_order++;
             break;
         default:
             scs     = input_pic_demux->scs;
@@ -508,7 +524,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                     entry_ppcs        = (PictureParentControlSet *)input_entry->input_object_ptr->object_ptr;
                     entry_scs_ptr     = entry_ppcs->scs;
                     availability_flag = TRUE;
-                    if (entry_ppcs->decode_order != decode_order && (scs->enable_dec_order))
+                    if (entry_ppcs->decode_order != context_ptr->decode_order && (scs->enable_dec_order))
                         availability_flag = FALSE;
 
                     // pic mgr starts pictures in dec order (no need to wait for feedback)
@@ -28,6 +28,7 @@ typedef struct PictureManagerContext {
     EbFifo  *picture_manager_output_fifo_ptr;
     EbFifo  *picture_control_set_fifo_ptr;
     EbFifo  *recon_coef_fifo_ptr;
+    uint64_t decode_order; // of the next input picture
     uint64_t pmgr_dec_order;
     uint64_t consecutive_dec_order;
     uint64_t started_pics_dec_order[REFERENCE_QUEUE_MAX_DEPTH]; // TODO: shorten this
@@ -39,6 +40,7 @@ typedef struct PictureManagerContext {
  ***************************************/
 EbErrorType svt_aom_picture_manager_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                  int rate_control_index);
+void        svt_aom_picture_manager_reset(EbThreadContext *thread_ctx);
 
 extern void *svt_aom_picture_manager_kernel(void *input_ptr);
 
@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "pipeline_profile.h"
+#include "svt_malloc.h"
+#include "svt_threads.h"
+#include "svt_time.h"
+
+#define PROFILE_UNKNOWN_PICTURE ((uint64_t)~0ull)
+
+// Profile of the task the calling kernel thread is running, NULL when not profiled
+static SVT_THREAD_LOCAL EbThreadProfile *running_profile = NULL;
+
+static uint64_t profile_time_us(const EbPipelineProfile *profile) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return seconds * 1000000 + useconds - profile->start_us;
+}
+
+static void svt_aom_pipeline_profile_dctor(EbPtr p) {
+    EbPipelineProfile *obj = (EbPipelineProfile *)p;
+    EB_FREE_ARRAY(obj->threads);
+    EB_FREE_ARRAY(obj->events);
+    EB_FREE_ARRAY(obj->threads_out);
+    EB_FREE_ARRAY(obj->events_out);
+    EB_DESTROY_MUTEX(obj->event_mutex);
+}
+
+EbErrorType svt_aom_pipeline_profile_ctor(EbPipelineProfile *profile, uint32_t thread_total_count) {
+    uint64_t seconds, useconds;
+
+    profile->dctor = svt_aom_pipeline_profile_dctor;
+    svt_av1_get_time(&seconds, &useconds);
+    profile->start_us           = seconds * 1000000 + useconds;
+    profile->thread_total_count = thread_total_count;
+    EB_CALLOC_ARRAY(profile->threads, thread_total_count);
+    EB_CREATE_MUTEX(profile->event_mutex);
+    EB_MALLOC_ARRAY(profile->events, PROFILE_EVENT_CAPACITY);
+    return EB_ErrorNone;
+}
+
+EbThreadProfile *svt_aom_pipeline_profile_add_stage(EbPipelineProfile *profile, const char *stage,
+                                                    uint32_t thread_count) {
+    assert(profile->thread_count + thread_count <= profile->thread_total_count);
+    EbThreadProfile *first = profile->threads + profile->thread_count;
+    for (uint32_t i = 0; i < thread_count; i++) {
+        first[i].pipeline       = profile;
+        first[i].stage          = stage;
+        first[i].thread_index   = i;
+        first[i].picture_number = PROFILE_UNKNOWN_PICTURE;
+    }
+    profile->thread_count += thread_count;
+    return first;
+}
+
+/*
+* Closes the task in progress if any and appends it to the trace
+*/
+void svt_aom_profile_wait(EbThreadProfile *thread_profile) {
+    running_profile = NULL;
+    if (!thread_profile)
+        return;
+    EbPipelineProfile *profile = thread_profile->pipeline;
+    const uint64_t     now     = profile_time_us(profile);
+
+    if (thread_profile->task_running) {
+        thread_profile->task_running = FALSE;
+        svt_atomic_fetch_add_u64(&thread_profile->busy_us, now - thread_profile->task_start_us);
+        svt_atomic_fetch_add_u64(&thread_profile->task_count, 1);
+
+        // Overwrite the oldest event once the ring is full
+        svt_block_on_mutex(profile->event_mutex);
+        SvtAv1PipelineEvent *event = &profile->events[profile->event_count++ % PROFILE_EVENT_CAPACITY];
+        event->thread              = (uint32_t)(thread_profile - profile->threads);
+        event->picture_number      = thread_profile->picture_number;
+        event->start_us            = thread_profile->task_start_us;
+        event->end_us              = now;
+        svt_release_mutex(profile->event_mutex);
+    }
+    thread_profile->wait_start_us = now;
+}
+
+void svt_aom_profile_run(EbThreadProfile *thread_profile) {
+    if (!thread_profile)
+        return;
+    const uint64_t now = profile_time_us(thread_profile->pipeline);
+
+    svt_atomic_fetch_add_u64(&thread_profile->wait_us, now - thread_profile->wait_start_us);
+    thread_profile->task_start_us  = now;
+    thread_profile->task_running   = TRUE;
+    thread_profile->picture_number = PROFILE_UNKNOWN_PICTURE;
+    running_profile                = thread_profile;
+}
+
+void svt_aom_profile_picture(uint64_t picture_number) {
+    if (running_profile)
+        running_profile->picture_number = picture_number;
+}
+
+EbErrorType svt_aom_pipeline_profile_get(EbPipelineProfile *profile, SvtAv1PipelineProfile *out) {
+    EB_FREE_ARRAY(profile->threads_out);
+    EB_FREE_ARRAY(profile->events_out);
+    memset(out, 0, sizeof(*out));
+
+    EB_MALLOC_ARRAY(profile->threads_out, profile->thread_count);
+    for (uint32_t i = 0; i < profile->thread_count; i++) {
+        EbThreadProfile       *thread_profile = &profile->threads[i];
+        SvtAv1ThreadProfile   *thread_out     = &profile->threads_out[i];
+        thread_out->stage                     = thread_profile->stage;
+        thread_out->thread_index              = thread_profile->thread_index;
+        thread_out->task_count                = svt_atomic_load_u64(&thread_profile->task_count);
+        thread_out->busy_us                   = svt_atomic_load_u64(&thread_profile->busy_us);
+        thread_out->wait_us                   = svt_atomic_load_u64(&thread_profile->wait_us);
+    }
+
+    // Unroll the ring, oldest event first
+    EB_NO_THROW_MALLOC(profile->events_out, PROFILE_EVENT_CAPACITY * sizeof(*profile->events_out));
+    if (!profile->events_out)
+        return EB_ErrorInsufficientResources;
+    svt_block_on_mutex(profile->event_mutex);
+    const uint64_t event_count = AOMMIN(profile->event_count, PROFILE_EVENT_CAPACITY);
+    const uint64_t first       = (profile->event_count - event_count) % PROFILE_EVENT_CAPACITY;
+    const uint64_t first_run   = AOMMIN(event_count, PROFILE_EVENT_CAPACITY - first);
+    memcpy(profile->events_out, profile->events + first, first_run * sizeof(*profile->events_out));
+    memcpy(profile->events_out + first_run, profile->events, (event_count - first_run) * sizeof(*profile->events_out));
+    svt_release_mutex(profile->event_mutex);
+
+    out->thread_count = profile->thread_count;
+    out->threads      = profile->threads_out;
+    out->event_count  = event_count;
+    out->events       = profile->events_out;
+    return EB_ErrorNone;
+}
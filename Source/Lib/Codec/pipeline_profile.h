@@ -0,0 +1,88 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbPipelineProfile_h
+#define EbPipelineProfile_h
+
+#include "EbSvtAv1Enc.h"
+#include "definitions.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of tasks kept in the trace (2 MB of events), the older tasks are overwritten
+#define PROFILE_EVENT_CAPACITY (1 << 16)
+
+/*********************************************************************
+     * ThreadProfile
+     *   Counters of one kernel thread, only written by that thread and
+     *   updated atomically as they are read by the profile queries.
+     *   The consumer EbFifo of the thread points to it, so the thread
+     *   is timed from within svt_get_full_object.
+     *********************************************************************/
+typedef struct EbThreadProfile {
+    struct EbPipelineProfile *pipeline;
+    const char               *stage;
+    uint32_t                  thread_index;
+    volatile uint64_t         task_count;
+    volatile uint64_t         busy_us;
+    volatile uint64_t         wait_us;
+    // task_start_us / wait_start_us - start of the task / wait in progress
+    uint64_t task_start_us;
+    uint64_t wait_start_us;
+    Bool     task_running;
+    uint64_t picture_number;
+} EbThreadProfile;
+
+/*********************************************************************
+     * PipelineProfile
+     *   Profile of all the kernel threads of an encoder, plus the trace
+     *   of the tasks they processed.
+     *********************************************************************/
+typedef struct EbPipelineProfile {
+    EbDctor dctor;
+    // start_us - time origin of the trace (svt_av1_enc_init)
+    uint64_t         start_us;
+    uint32_t         thread_count;
+    uint32_t         thread_total_count;
+    EbThreadProfile *threads;
+    // events - ring of the last PROFILE_EVENT_CAPACITY finished tasks, written under event_mutex,
+    // event_count tasks were recorded since svt_av1_enc_init, the oldest being overwritten
+    EbHandle             event_mutex;
+    SvtAv1PipelineEvent *events;
+    uint64_t             event_count;
+    // Snapshot handed out by svt_aom_pipeline_profile_get
+    SvtAv1ThreadProfile *threads_out;
+    SvtAv1PipelineEvent *events_out;
+} EbPipelineProfile;
+
+EbErrorType svt_aom_pipeline_profile_ctor(EbPipelineProfile *profile, uint32_t thread_total_count);
+
+/* Reserves the profiles of the thread_count threads of stage, returns the first one */
+EbThreadProfile *svt_aom_pipeline_profile_add_stage(EbPipelineProfile *profile, const char *stage,
+                                                    uint32_t thread_count);
+
+/* Fills out with a snapshot of the profile */
+EbErrorType svt_aom_pipeline_profile_get(EbPipelineProfile *profile, SvtAv1PipelineProfile *out);
+
+/* Called by svt_get_full_object before / after the thread waits for its next input */
+void svt_aom_profile_wait(EbThreadProfile *thread_profile);
+void svt_aom_profile_run(EbThreadProfile *thread_profile);
+
+/* Tags the task of the calling kernel thread with its picture, no-op when not profiled */
+void svt_aom_profile_picture(uint64_t picture_number);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPipelineProfile_h
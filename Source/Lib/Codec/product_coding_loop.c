@@ -2667,6 +2667,8 @@ static int md_subpel_search(SUBPEL_STAGE       search_stage, //ME or PME
     ref_struct.height = ref_pic->height;
     ref_struct.stride = ref_pic->stride_y;
     ms_buffers->ref   = &ref_struct;
+    // The cached planes are those of the unscaled reference
+    ms_params->var_params.subpel_cache = ref_pic == ref_obj->reference_picture ? &ref_obj->subpel_cache : NULL;
     // Src buffer
     uint32_t input_origin_index = (ctx->blk_org_y + input_pic->org_y) * input_pic->stride_y +
         (ctx->blk_org_x + input_pic->org_x);
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "psy_rd.h"
+#include "common_dsp_rtcd.h"
 
 // 8-bit
 #define BITS_PER_SUM (8 * sizeof(sum_t))
@@ -131,9 +132,9 @@ static uint64_t svt_psy_sad_nxn(const uint8_t bw, const uint8_t bh, const uint8_
     return sum;
 }
 
-uint64_t svt_psy_distortion(const uint8_t* input, uint32_t input_stride,
-                            const uint8_t* recon, uint32_t recon_stride,
-                            uint32_t width, uint32_t height) {
+uint64_t svt_psy_distortion_c(const uint8_t* input, uint32_t input_stride,
+                              const uint8_t* recon, uint32_t recon_stride,
+                              uint32_t width, uint32_t height) {
 
     static uint8_t zero_buffer[8] = { 0 };
     uint64_t total_nrg = 0;
@@ -235,9 +236,9 @@ static uint64_t svt_psy_sad_nxn_hbd(const uint8_t bw, const uint8_t bh, const ui
     return sum;
 }
 
-uint64_t svt_psy_distortion_hbd(const uint16_t* input, uint32_t input_stride,
-                                const uint16_t* recon, uint32_t recon_stride,
-                                uint32_t width, uint32_t height) {
+uint64_t svt_psy_distortion_hbd_c(const uint16_t* input, uint32_t input_stride,
+                                  const uint16_t* recon, uint32_t recon_stride,
+                                  uint32_t width, uint32_t height) {
 
     static uint16_t zero_buffer[8] = { 0 };
 
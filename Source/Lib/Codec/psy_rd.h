@@ -20,12 +20,6 @@ typedef uint32_t sum2_t;
 typedef uint32_t sum_hbd_t;
 typedef uint64_t sum2_hbd_t;
 
-uint64_t svt_psy_distortion(const uint8_t* input, uint32_t input_stride,
-                            const uint8_t* recon, uint32_t recon_stride,
-                            uint32_t width, uint32_t height);
-uint64_t svt_psy_distortion_hbd(const uint16_t* input, uint32_t input_stride,
-                                const uint16_t* recon, uint32_t recon_stride,
-                                uint32_t width, uint32_t height);
 uint64_t get_svt_psy_full_dist(const void* s, uint32_t so, uint32_t sp,
                                const void* r, uint32_t ro, uint32_t rp,
                                uint32_t w, uint32_t h, uint8_t is_hbd,
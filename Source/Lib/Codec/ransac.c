@@ -17,56 +17,63 @@
 #include "mathutils.h"
 #include "random.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #include "utility.h"
 
 #define MAX_MINPTS 4
 #define MAX_DEGENERATE_ITER 10
 #define MINPTS_MULTIPLIER 5
 
-#define INLIER_THRESHOLD_POW2 1.5625 /*(1.25 * 1.25)*/
 #define MIN_TRIALS 20
 
 ////////////////////////////////////////////////////////////////////////////////
 // ransac
 typedef int (*IsDegenerateFunc)(double *p);
 typedef int (*FindTransformationFunc)(int points, double *points1, double *points2, double *params);
-typedef void (*ProjectPointsDoubleFunc)(double *mat, double *points, double *proj, int n, int stride_points,
-                                        int stride_proj);
-
-static void project_points_double_translation(double *mat, double *points, double *proj, int n, int stride_points,
-                                              int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = x + mat[0];
-        *(proj++) = y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
-    }
+// Writes the parameters of a model as those of the affine model {m0, m1, m2, m3, m4, m5} projecting
+// (x, y) to (m2 * x + m3 * y + m0, m4 * x + m5 * y + m1)
+typedef void (*GetAffineParamsFunc)(const double *params, double *mat);
+
+static void get_affine_params_translation(const double *params, double *mat) {
+    mat[0] = params[0];
+    mat[1] = params[1];
+    mat[2] = 1;
+    mat[3] = 0;
+    mat[4] = 0;
+    mat[5] = 1;
 }
 
-static void project_points_double_rotzoom(double *mat, double *points, double *proj, int n, int stride_points,
-                                          int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = -mat[3] * x + mat[2] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
-    }
+static void get_affine_params_rotzoom(const double *params, double *mat) {
+    mat[0] = params[0];
+    mat[1] = params[1];
+    mat[2] = params[2];
+    mat[3] = params[3];
+    mat[4] = -params[3];
+    mat[5] = params[2];
 }
 
-static void project_points_double_affine(double *mat, double *points, double *proj, int n, int stride_points,
-                                         int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = mat[4] * x + mat[5] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
+static void get_affine_params_affine(const double *params, double *mat) {
+    for (int i = 0; i < 6; ++i) mat[i] = params[i];
+}
+
+int svt_av1_ransac_find_inliers_c(const double *mat, const double *corners1, const double *corners2, int npoints,
+                                  int *inlier_indices, double *sum_distance, double *sum_distance_squared) {
+    int num_inliers = 0;
+    *sum_distance = *sum_distance_squared = 0;
+    for (int i = 0; i < npoints; ++i) {
+        const double x             = corners1[i * 2];
+        const double y             = corners1[i * 2 + 1];
+        const double dx            = mat[2] * x + mat[3] * y + mat[0] - corners2[i * 2];
+        const double dy            = mat[4] * x + mat[5] * y + mat[1] - corners2[i * 2 + 1];
+        const double distance_pow2 = dx * dx + dy * dy;
+
+        if (distance_pow2 < INLIER_THRESHOLD_POW2) {
+            inlier_indices[num_inliers++] = i;
+            *sum_distance += sqrt(distance_pow2);
+            *sum_distance_squared += distance_pow2;
+        }
     }
+    return num_inliers;
 }
 
 static void normalize_homography(double *pts, int n, double *T) {
@@ -359,7 +366,7 @@ static void clear_motion(RANSAC_MOTION *motion, int num_points) {
 
 static int ransac(const int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
                   int num_desired_motions, int minpts, IsDegenerateFunc is_degenerate,
-                  FindTransformationFunc find_transformation, ProjectPointsDoubleFunc projectpoints) {
+                  FindTransformationFunc find_transformation, GetAffineParamsFunc get_affine_params) {
     int trial_count = 0;
     int ret_val     = 0;
 
@@ -369,7 +376,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     double *points1, *points2;
     double *corners1, *corners2;
-    double *image1_coord;
 
     // Store information for the num_desired_motions best transformations found
     // and the worst motion among them, as well as the motion currently under
@@ -380,6 +386,7 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     // Store the parameters and the indices of the inlier points for the motion
     // currently under consideration.
     double params_this_motion[MAX_PARAMDIM];
+    double affine_params[6];
 
     double *cnp1, *cnp2;
 
@@ -392,7 +399,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     points2      = (double *)malloc(sizeof(*points2) * npoints * 2);
     corners1     = (double *)malloc(sizeof(*corners1) * npoints * 2);
     corners2     = (double *)malloc(sizeof(*corners2) * npoints * 2);
-    image1_coord = (double *)malloc(sizeof(*image1_coord) * npoints * 2);
 
     motions = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
     assert(motions != NULL);
@@ -405,7 +411,7 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     worst_kept_motion = motions;
 
-    if (!(points1 && points2 && corners1 && corners2 && image1_coord && motions && current_motion.inlier_indices)) {
+    if (!(points1 && points2 && corners1 && corners2 && motions && current_motion.inlier_indices)) {
         ret_val = 1;
         goto finish_ransac;
     }
@@ -420,8 +426,8 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     }
 
     while (MIN_TRIALS > trial_count) {
-        double sum_distance         = 0.0;
-        double sum_distance_squared = 0.0;
+        double sum_distance;
+        double sum_distance_squared;
 
         clear_motion(&current_motion, npoints);
 
@@ -450,19 +456,14 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             continue;
         }
 
-        projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
-
-        for (int i = 0; i < npoints; ++i) {
-            double dx            = image1_coord[i * 2] - corners2[i * 2];
-            double dy            = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
-            double distance_pow2 = dx * dx + dy * dy;
-
-            if (distance_pow2 < INLIER_THRESHOLD_POW2) {
-                current_motion.inlier_indices[current_motion.num_inliers++] = i;
-                sum_distance += sqrt(distance_pow2);
-                sum_distance_squared += distance_pow2;
-            }
-        }
+        get_affine_params(params_this_motion, affine_params);
+        current_motion.num_inliers = svt_av1_ransac_find_inliers(affine_params,
+                                                                 corners1,
+                                                                 corners2,
+                                                                 npoints,
+                                                                 current_motion.inlier_indices,
+                                                                 &sum_distance,
+                                                                 &sum_distance_squared);
 
         if (current_motion.num_inliers >= worst_kept_motion->num_inliers && current_motion.num_inliers > 1) {
             double mean_distance;
@@ -525,7 +526,6 @@ finish_ransac:
     free(points2);
     free(corners1);
     free(corners2);
-    free(image1_coord);
     free(current_motion.inlier_indices);
     if (motions) {
         for (int i = 0; i < num_desired_motions; ++i) free(motions[i].inlier_indices);
@@ -557,7 +557,7 @@ static int ransac_translation(int *matched_points, int npoints, int *num_inliers
                   3,
                   is_degenerate_translation,
                   find_translation,
-                  project_points_double_translation);
+                  get_affine_params_translation);
 }
 
 static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
@@ -570,7 +570,7 @@ static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_
                   3,
                   is_degenerate_affine,
                   find_rotzoom,
-                  project_points_double_rotzoom);
+                  get_affine_params_rotzoom);
 }
 
 static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
@@ -583,7 +583,7 @@ static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_m
                   3,
                   is_degenerate_affine,
                   find_affine,
-                  project_points_double_affine);
+                  get_affine_params_affine);
 }
 
 RansacFunc svt_av1_get_ransac_type(TransformationType type) {
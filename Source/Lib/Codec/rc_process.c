@@ -163,10 +163,10 @@ EbErrorType svt_aom_rate_control_context_ctor(EbThreadContext *thread_ctx, const
 
     context_ptr->rate_control_input_tasks_fifo_ptr = svt_system_resource_get_consumer_fifo(
         enc_handle_ptr->rate_control_tasks_resource_ptr, 0);
-    context_ptr->rate_control_output_results_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->rate_control_results_resource_ptr, 0);
-    context_ptr->picture_decision_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
+    context_ptr->rate_control_output_results_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->rate_control_results_resource_ptr, 0);
+    context_ptr->picture_decision_results_output_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
 
     return EB_ErrorNone;
 }
@@ -3302,6 +3302,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
             // intentionally reuse code in RC_INPUT
         case RC_INPUT:
             pcs = (PictureControlSet *)rc_tasks->pcs_wrapper->object_ptr;
+            svt_aom_profile_picture(pcs->picture_number);
             scs = pcs->scs;
             // Get r0
             if (pcs->ppcs->r0_based_qps_qpm) {
@@ -3694,6 +3695,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
 
             ppcs = (PictureParentControlSet *)rc_tasks->pcs_wrapper->object_ptr;
             scs  = ppcs->scs;
+            svt_aom_profile_picture(ppcs->picture_number);
             // Prevent double counting fames with overlay to so we don't
             // increase processed_frame_number twice per frame
             if (!ppcs->is_overlay) {
@@ -3742,6 +3744,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
 
         default:
             pcs = (PictureControlSet *)rc_tasks->pcs_wrapper->object_ptr;
+            svt_aom_profile_picture(pcs->picture_number);
             scs = pcs->scs;
 
             break;
@@ -17,6 +17,8 @@
 #include "pic_buffer_desc.h"
 #include "utility.h"
 #include "enc_mode_config.h"
+#include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 
 void initialize_samples_neighboring_reference_picture_8bit(EbByte recon_samples_buffer_ptr, uint16_t stride,
                                                            uint16_t recon_width, uint16_t recon_height,
@@ -68,6 +70,152 @@ static void initialize_samples_neighboring_reference_picture(
     }
 }
 
+static void subpel_cache_free_planes(SubpelPlaneCache *cache) {
+    for (int i = 0; i < SUBPEL_CACHE_PHASES; i++) {
+        if (cache->plane[i])
+            EB_FREE_ALIGNED_ARRAY(cache->plane[i]);
+        if (cache->tile_state[i])
+            EB_FREE_ARRAY(cache->tile_state[i]);
+    }
+    cache->num_planes    = 0;
+    cache->mapped_planes = 0;
+}
+
+/*
+ * Drops the phases cached for the previous picture held by the reference object. The planes are kept for the next
+ * picture unless the reference was resized.
+ */
+static void subpel_cache_reset(SubpelPlaneCache *cache) {
+    if (cache->num_planes &&
+        (cache->plane_size != cache->pic->luma_size || cache->plane_stride != cache->pic->stride_y))
+        subpel_cache_free_planes(cache);
+    for (int i = 0; i < cache->num_planes; i++)
+        memset(cache->tile_state[i], 0, sizeof(*cache->tile_state[i]) * cache->tile_cols * cache->tile_rows);
+    memset(cache->plane_idx, 0, sizeof(cache->plane_idx));
+    cache->mapped_planes = 0;
+}
+
+static EbErrorType subpel_cache_alloc_plane(SubpelPlaneCache *cache) {
+    const EbPictureBufferDesc *pic = cache->pic;
+    if (!cache->num_planes) {
+        cache->plane_size   = pic->luma_size;
+        cache->plane_stride = pic->stride_y;
+        cache->tile_cols    = (pic->stride_y + (1 << SUBPEL_CACHE_TILE_LOG2) - 1) >> SUBPEL_CACHE_TILE_LOG2;
+        cache->tile_rows    = (pic->luma_size / pic->stride_y + (1 << SUBPEL_CACHE_TILE_LOG2) - 1) >>
+            SUBPEL_CACHE_TILE_LOG2;
+    }
+    const uint8_t i = cache->num_planes;
+    EB_MALLOC_ALIGNED_ARRAY(cache->plane[i], cache->plane_size);
+    EB_CALLOC_ARRAY(cache->tile_state[i], cache->tile_cols * cache->tile_rows);
+    cache->num_planes++;
+    return EB_ErrorNone;
+}
+
+// Gives a plane to the (filter, phase) if the budget allows it; the phases get the planes in the order the searches
+// reach them, so the half-pel ones are served first
+static uint32_t subpel_cache_map_plane(SubpelPlaneCache *cache, int filter, int phase) {
+    svt_block_on_mutex(cache->mutex);
+    uint32_t idx = cache->plane_idx[filter][phase];
+    if (!idx) {
+        if (cache->mapped_planes == cache->num_planes && cache->num_planes < cache->max_planes &&
+            subpel_cache_alloc_plane(cache) != EB_ErrorNone)
+            cache->max_planes = cache->num_planes;
+        idx = cache->mapped_planes < cache->num_planes ? ++cache->mapped_planes : SUBPEL_CACHE_NO_PLANE;
+        svt_atomic_store_u32(&cache->plane_idx[filter][phase], idx);
+    }
+    svt_release_mutex(cache->mutex);
+    return idx;
+}
+
+/*
+ * Interpolates the part of a tile inside the cacheable area with the kernel of the sub-pel search itself, so the
+ * cached samples are the ones the search would compute. The tile is split in the power-of-two block sizes the kernel
+ * is used with in MD.
+ */
+static void subpel_cache_fill_tile(SubpelPlaneCache *cache, uint8_t *plane, int tile_x, int tile_y, int x_limit,
+                                   int y_limit, int subpel_x_q3, int subpel_y_q3, int subpel_search_type) {
+    DECLARE_ALIGNED(16, uint8_t, pred[1 << (2 * SUBPEL_CACHE_TILE_LOG2)]);
+    const EbPictureBufferDesc *pic     = cache->pic;
+    const int                  stride  = pic->stride_y;
+    const int                  x_start = AOMMAX(tile_x << SUBPEL_CACHE_TILE_LOG2, SUBPEL_CACHE_BORDER);
+    const int                  y_start = AOMMAX(tile_y << SUBPEL_CACHE_TILE_LOG2, SUBPEL_CACHE_BORDER);
+    const int                  x_end   = AOMMIN((tile_x + 1) << SUBPEL_CACHE_TILE_LOG2, x_limit);
+    const int                  y_end   = AOMMIN((tile_y + 1) << SUBPEL_CACHE_TILE_LOG2, y_limit);
+    int                        bh;
+    for (int y = y_start; y < y_end; y += bh) {
+        bh = 1 << SUBPEL_CACHE_TILE_LOG2;
+        while (bh > y_end - y) bh >>= 1;
+        int bw;
+        for (int x = x_start; x < x_end; x += bw) {
+            bw = 1 << SUBPEL_CACHE_TILE_LOG2;
+            while (bw > x_end - x) bw >>= 1;
+            svt_aom_upsampled_pred(NULL,
+                                   NULL,
+                                   0,
+                                   0,
+                                   NULL,
+                                   pred,
+                                   bw,
+                                   bh,
+                                   subpel_x_q3,
+                                   subpel_y_q3,
+                                   pic->buffer_y + y * stride + x,
+                                   stride,
+                                   subpel_search_type);
+            for (int r = 0; r < bh; r++) svt_memcpy(plane + (y + r) * stride + x, pred + r * bw, bw);
+        }
+    }
+}
+
+/*
+ * svt_aom_subpel_cache_get_block
+ * Returns the w x h block at ref (a position in the reference luma plane) interpolated at the given phase, with the
+ * stride of the reference, filling the tiles it covers on first use. Returns NULL when the phase is not cached, the
+ * block is too close to the edge of the padded plane or a tile it covers is being filled by another thread; the caller
+ * then interpolates the block itself.
+ */
+const uint8_t *svt_aom_subpel_cache_get_block(SubpelPlaneCache *cache, const uint8_t *ref, int w, int h,
+                                              int subpel_x_q3, int subpel_y_q3, int subpel_search_type) {
+    if (!cache->max_planes || !(subpel_x_q3 | subpel_y_q3) || ((subpel_x_q3 | subpel_y_q3) & 1) ||
+        subpel_search_type < USE_2_TAPS)
+        return NULL;
+    const EbPictureBufferDesc *pic    = cache->pic;
+    const int                  stride = pic->stride_y;
+    const ptrdiff_t            offset = ref - pic->buffer_y;
+    if (offset < 0)
+        return NULL;
+    // keep the cached area a multiple of 8 rows high, as the blocks it is interpolated in
+    const int x_limit = stride - SUBPEL_CACHE_BORDER;
+    const int y_limit = SUBPEL_CACHE_BORDER + (((int)(pic->luma_size / stride) - 2 * SUBPEL_CACHE_BORDER) & ~7);
+    const int x       = (int)(offset % stride);
+    const int y       = (int)(offset / stride);
+    if (x < SUBPEL_CACHE_BORDER || y < SUBPEL_CACHE_BORDER || x + w > x_limit || y + h > y_limit)
+        return NULL;
+
+    const int filter = subpel_search_type - USE_2_TAPS;
+    const int phase  = (subpel_y_q3 >> 1) * 4 + (subpel_x_q3 >> 1) - 1;
+    uint32_t  idx    = svt_atomic_load_u32(&cache->plane_idx[filter][phase]);
+    if (!idx)
+        idx = subpel_cache_map_plane(cache, filter, phase);
+    if (idx == SUBPEL_CACHE_NO_PLANE)
+        return NULL;
+    uint8_t  *plane = cache->plane[idx - 1];
+    uint32_t *state = cache->tile_state[idx - 1];
+    for (int ty = y >> SUBPEL_CACHE_TILE_LOG2; ty <= (y + h - 1) >> SUBPEL_CACHE_TILE_LOG2; ty++) {
+        for (int tx = x >> SUBPEL_CACHE_TILE_LOG2; tx <= (x + w - 1) >> SUBPEL_CACHE_TILE_LOG2; tx++) {
+            uint32_t *tile_state = &state[ty * cache->tile_cols + tx];
+            if (svt_atomic_load_u32(tile_state) == SUBPEL_TILE_READY)
+                continue;
+            // another thread is filling the tile, interpolate the block rather than wait
+            if (!svt_atomic_cas_u32(tile_state, SUBPEL_TILE_EMPTY, SUBPEL_TILE_FILLING))
+                return NULL;
+            subpel_cache_fill_tile(cache, plane, tx, ty, x_limit, y_limit, subpel_x_q3, subpel_y_q3, subpel_search_type);
+            svt_atomic_store_u32(tile_state, SUBPEL_TILE_READY);
+        }
+    }
+    return plane + offset;
+}
+
 static void svt_reference_object_dctor(EbPtr p) {
     EbReferenceObject *obj = (EbReferenceObject *)p;
 
@@ -79,6 +227,8 @@ static void svt_reference_object_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->sb_64x64_mvp);
     EB_FREE_ARRAY(obj->sb_me_64x64_dist);
     EB_FREE_ARRAY(obj->sb_me_8x8_cost_var);
+    subpel_cache_free_planes(&obj->subpel_cache);
+    EB_DESTROY_MUTEX(obj->subpel_cache.mutex);
     for (uint8_t sr_denom_idx = 0; sr_denom_idx < NUM_SR_SCALES + 1; sr_denom_idx++) {
         for (uint8_t resize_denom_idx = 0; resize_denom_idx < NUM_RESIZE_SCALES + 1; resize_denom_idx++) {
             if (obj->downscaled_reference_picture[sr_denom_idx][resize_denom_idx] != NULL) {
@@ -138,6 +288,11 @@ EbErrorType svt_reference_param_update(EbReferenceObject *ref_object, SequenceCo
         initialize_samples_neighboring_reference_picture(
             ref_object, &picture_buffer_desc_init_data_ptr, picture_buffer_desc_init_data_ptr.bit_depth);
     }
+    // the cached sub-pel planes have the layout of the previous size, and the budget changes with the size
+    subpel_cache_free_planes(&ref_object->subpel_cache);
+    if (scs->subpel_cache_planes && !ref_object->subpel_cache.mutex)
+        EB_CREATE_MUTEX(ref_object->subpel_cache.mutex);
+    ref_object->subpel_cache.max_planes = scs->subpel_cache_planes;
     const bool gm_ref_info = svt_aom_need_gm_ref_info(scs->static_config.enc_mode,
                                                       scs->static_config.resize_mode == RESIZE_NONE);
     if (gm_ref_info)
@@ -270,6 +425,10 @@ EbErrorType svt_reference_object_ctor(EbReferenceObject *ref_object, EbPtr objec
     EB_MALLOC_ARRAY(ref_object->sb_64x64_mvp, picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(ref_object->sb_me_64x64_dist, picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(ref_object->sb_me_8x8_cost_var, picture_buffer_desc_init_data_ptr->sb_total_count);
+    ref_object->subpel_cache.pic        = ref_object->reference_picture;
+    ref_object->subpel_cache.max_planes = ref_init_ptr->subpel_cache_planes;
+    if (ref_object->subpel_cache.max_planes)
+        EB_CREATE_MUTEX(ref_object->subpel_cache.mutex);
     return EB_ErrorNone;
 }
 
@@ -286,6 +445,7 @@ EbErrorType svt_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_ini
 EbErrorType svt_reference_object_reset(EbReferenceObject *ref_object, SequenceControlSet *scs) {
     ref_object->mi_rows = scs->max_input_luma_height >> MI_SIZE_LOG2;
     ref_object->mi_cols = scs->max_input_luma_width >> MI_SIZE_LOG2;
+    subpel_cache_reset(&ref_object->subpel_cache);
 
     return EB_ErrorNone;
 }
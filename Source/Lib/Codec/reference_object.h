@@ -18,6 +18,40 @@
 #include "coding_unit.h"
 #include "sequence_control_set.h"
 
+#define SUBPEL_CACHE_FILTERS 3 // USE_2_TAPS, USE_4_TAPS and USE_8_TAPS
+#define SUBPEL_CACHE_PHASES 15 // half/quarter-pel (x, y) phases, the full-pel one excluded
+#define SUBPEL_CACHE_TILE_LOG2 6
+#define SUBPEL_CACHE_BORDER 16 // margin of the padded plane left to the interpolation filter taps
+#define SUBPEL_CACHE_NO_PLANE ((uint32_t)~0)
+// states of a tile of a cached plane
+#define SUBPEL_TILE_EMPTY 0
+#define SUBPEL_TILE_FILLING 1 // claimed by the thread interpolating it
+#define SUBPEL_TILE_READY 2
+
+/*
+ * Luma planes of a reference interpolated at a sub-pel phase, shared by the MD sub-pel searches of all the pictures
+ * referencing it. The planes have the layout of the reference luma plane and are filled in 64x64 tiles on first use.
+ * At most max_planes planes are allocated per reference; phases beyond the budget are interpolated by the caller.
+ * The mutex only serializes the mapping of the phases to the planes, a tile is claimed by the first thread reaching
+ * it and the others interpolate their block themselves until it is ready.
+ */
+typedef struct SubpelPlaneCache {
+    EbHandle             mutex;
+    EbPictureBufferDesc *pic;
+    uint8_t              max_planes;
+    uint8_t              num_planes; // planes allocated so far
+    uint8_t              mapped_planes; // planes holding a phase of the current picture
+    uint32_t             plane_size;
+    uint16_t             plane_stride;
+    uint16_t             tile_cols;
+    uint16_t             tile_rows;
+    uint8_t             *plane[SUBPEL_CACHE_PHASES];
+    uint32_t            *tile_state[SUBPEL_CACHE_PHASES]; // SUBPEL_TILE_*
+    // 1 + index of the plane holding each (filter, phase) of the current picture, 0 when not mapped yet and
+    // SUBPEL_CACHE_NO_PLANE when over the budget
+    uint32_t plane_idx[SUBPEL_CACHE_FILTERS][SUBPEL_CACHE_PHASES];
+} SubpelPlaneCache;
+
 typedef struct EbReferenceObject {
     EbDctor                     dctor;
     EbPictureBufferDesc        *reference_picture;
@@ -62,12 +96,14 @@ typedef struct EbReferenceObject {
     int32_t              mi_cols;
     int32_t              mi_rows;
     WienerUnitInfo     **unit_info; // per plane, per rest. unit; used for fwding wiener info to future frames
+    SubpelPlaneCache     subpel_cache;
 } EbReferenceObject;
 
 typedef struct EbReferenceObjectDescInitData {
     EbPictureBufferDescInitData reference_picture_desc_init_data;
     int8_t                      hbd_md;
     EbSvtAv1EncConfiguration   *static_config;
+    uint8_t                     subpel_cache_planes;
 } EbReferenceObjectDescInitData;
 
 typedef struct EbPaReferenceObject {
@@ -115,5 +151,7 @@ void               svt_aom_release_pa_reference_objects(SequenceControlSet *scs,
 extern EbErrorType svt_pa_reference_param_update(EbPaReferenceObject *pa_ref_obj_, SequenceControlSet *scs);
 extern EbErrorType svt_tpl_reference_param_update(EbTplReferenceObject *tpl_ref_obj, SequenceControlSet *scs);
 extern EbErrorType svt_reference_param_update(EbReferenceObject *ref_object, SequenceControlSet *scs);
+const uint8_t     *svt_aom_subpel_cache_get_block(SubpelPlaneCache *cache, const uint8_t *ref, int w, int h,
+                                                  int subpel_x_q3, int subpel_y_q3, int subpel_search_type);
 
 #endif //EbReferenceObject_h
@@ -71,6 +71,9 @@ typedef struct ResourceCoordinationContext {
     Bool seq_param_change;
     Bool video_res_change;
 
+    // End of sequence received, the last picture is held until the stream is reset
+    Bool             end_of_sequence_flag;
+    EbObjectWrapper *prev_pcs_wrapper_ptr;
 } ResourceCoordinationContext;
 
 static void resource_coordination_context_dctor(EbPtr p) {
@@ -85,6 +88,8 @@ static void resource_coordination_context_dctor(EbPtr p) {
     }
 }
 
+static void resource_coordination_stream_init(ResourceCoordinationContext *context_ptr);
+
 /************************************************
  * Resource Coordination Context Constructor
  ************************************************/
@@ -102,8 +107,8 @@ EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext *thread_c
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[i], 0);
     }
     context_ptr->input_cmd_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->input_cmd_resource_ptr, 0);
-    context_ptr->resource_coordination_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->resource_coordination_results_resource_ptr, 0);
+    context_ptr->resource_coordination_results_output_fifo_ptr = svt_aom_stream_producer_fifo(
+        enc_handle_ptr, enc_handle_ptr->resource_coordination_results_resource_ptr, 0);
     context_ptr->scs_instance_array = enc_handle_ptr->scs_instance_array;
     // Allocate scs_active_array
     EB_MALLOC_ARRAY(context_ptr->scs_active_array, enc_handle_ptr->encode_instance_total_count);
@@ -121,6 +126,18 @@ EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext *thread_c
 
     EB_CALLOC_ARRAY(context_ptr->picture_number_array, context_ptr->encode_instances_total_count);
 
+    resource_coordination_stream_init(context_ptr);
+    return EB_ErrorNone;
+}
+
+/************************************************
+ * Resource Coordination Stream Init
+ *   picture numbering and speed control state
+ *   of a new stream
+ ************************************************/
+static void resource_coordination_stream_init(ResourceCoordinationContext *context_ptr) {
+    for (uint32_t i = 0; i < context_ptr->encode_instances_total_count; i++) context_ptr->picture_number_array[i] = 0;
+
     context_ptr->average_enc_mod                    = 0;
     context_ptr->prev_enc_mod                       = 0;
     context_ptr->prev_enc_mode_delta                = 0;
@@ -142,7 +159,33 @@ EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext *thread_c
 
     context_ptr->seq_param_change = 0;
     context_ptr->video_res_change = 0;
-    return EB_ErrorNone;
+
+    context_ptr->end_of_sequence_flag = FALSE;
+    context_ptr->prev_pcs_wrapper_ptr = NULL;
+}
+
+/************************************************
+ * Resource Coordination Reset
+ *   releases the picture of the end of sequence,
+ *   which is not sent down the pipeline, and
+ *   starts a new stream. The kernel must be idle.
+ ************************************************/
+void svt_aom_resource_coordination_reset(EbThreadContext *thread_contxt_ptr) {
+    ResourceCoordinationContext *context_ptr = (ResourceCoordinationContext *)thread_contxt_ptr->priv;
+
+    if (context_ptr->prev_pcs_wrapper_ptr) {
+        PictureParentControlSet *pcs = (PictureParentControlSet *)context_ptr->prev_pcs_wrapper_ptr->object_ptr;
+        // y8b is released with the PA reference and with the input, as for an encoded picture
+        svt_release_object(pcs->pa_ref_pic_wrapper);
+        if (pcs->y8b_wrapper) {
+            svt_release_object(pcs->y8b_wrapper);
+            svt_release_object(pcs->y8b_wrapper);
+        }
+        svt_release_object(pcs->input_pic_wrapper);
+        svt_release_object(pcs->scs_wrapper);
+        svt_release_object(context_ptr->prev_pcs_wrapper_ptr);
+    }
+    resource_coordination_stream_init(context_ptr);
 }
 
 //******************************************************************************//
@@ -539,7 +582,8 @@ static void copy_input_buffer_overlay(SequenceControlSet *sequenceControlSet, Eb
 void svt_aom_read_stat(SequenceControlSet *scs) {
     EncodeContext *enc_ctx = scs->enc_ctx;
 
-    enc_ctx->rc_stats_buffer = scs->static_config.rc_stats_buffer;
+    // the entries are used in place, after the header if there is one (checked with the settings)
+    svt_av1_stats_entries(&scs->static_config.rc_stats_buffer, &enc_ctx->rc_stats_buffer);
 }
 void svt_aom_setup_two_pass(SequenceControlSet *scs) {
     EncodeContext *enc_ctx     = scs->enc_ctx;
@@ -568,11 +612,9 @@ void svt_aom_setup_two_pass(SequenceControlSet *scs) {
 }
 
 static EbErrorType realloc_sb_param(SequenceControlSet *scs, PictureParentControlSet *pcs) {
-    EB_FREE_ARRAY(pcs->b64_geom);
-    EB_MALLOC_ARRAY(pcs->b64_geom, scs->b64_total_count);
+    EB_ARENA_ALLOC_ARRAY(pcs->arena, pcs->b64_geom, scs->b64_total_count);
     memcpy(pcs->b64_geom, scs->b64_geom, sizeof(B64Geom) * scs->b64_total_count);
-    EB_FREE_ARRAY(pcs->sb_geom);
-    EB_MALLOC_ARRAY(pcs->sb_geom, scs->sb_total_count);
+    EB_ARENA_ALLOC_ARRAY(pcs->arena, pcs->sb_geom, scs->sb_total_count);
     memcpy(pcs->sb_geom, scs->sb_geom, sizeof(SbGeom) * scs->sb_total_count);
     pcs->is_pcs_sb_params = TRUE;
     return EB_ErrorNone;
@@ -841,9 +883,6 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
     EbObjectWrapper             *input_pic_wrapper;
     EbObjectWrapper             *ref_pic_wrapper;
 
-    Bool             end_of_sequence_flag = FALSE;
-    EbObjectWrapper *prev_pcs_wrapper_ptr = 0;
-
     for (;;) {
         // Tie instance_index to zero for now...
         uint32_t instance_index = 0;
@@ -944,7 +983,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                                context_ptr->scs_instance_array[instance_index]->enc_ctx->initial_picture)
             ? 0
             : 1;
-        for (uint8_t loop_index = 0; loop_index <= has_overlay && !end_of_sequence_flag; loop_index++) {
+        for (uint8_t loop_index = 0; loop_index <= has_overlay && !context_ptr->end_of_sequence_flag; loop_index++) {
             // Get a New ParentPCS where we will hold the new input_picture
             svt_get_empty_object(context_ptr->picture_control_set_fifo_ptr_array[instance_index], &pcs_wrapper);
 
@@ -1021,7 +1060,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             // make pcs input buffer access the luma8bit part from the Luma8bit Pool
             pcs->enhanced_pic->buffer_y = buff_y8b;
             pcs->input_ptr              = eb_input_ptr;
-            end_of_sequence_flag        = (pcs->input_ptr->flags & EB_BUFFERFLAG_EOS) ? TRUE : FALSE;
+            context_ptr->end_of_sequence_flag = (pcs->input_ptr->flags & EB_BUFFERFLAG_EOS) ? TRUE : FALSE;
             // Check whether super-res is previously enabled in this recycled parent pcs and restore
             // to non-scale-down default if so.
             if (pcs->frame_superres_enabled || pcs->frame_resize_enabled)
@@ -1039,7 +1078,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             pcs->input_pic_wrapper        = input_pic_wrapper;
             //store the y8b warapper to be used for release later
             pcs->y8b_wrapper          = y8b_wrapper;
-            pcs->end_of_sequence_flag = end_of_sequence_flag;
+            pcs->end_of_sequence_flag = context_ptr->end_of_sequence_flag;
             pcs->rc_reset_flag        = FALSE;
             update_frame_event(pcs, context_ptr->picture_number_array[instance_index]);
             pcs->is_not_scaled = (scs->static_config.superres_mode == SUPERRES_NONE) &&
@@ -1089,11 +1128,11 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             // Rate Control
 
             // Picture Stats
-            if (loop_index == has_overlay || end_of_sequence_flag)
+            if (loop_index == has_overlay || context_ptr->end_of_sequence_flag)
                 pcs->picture_number = context_ptr->picture_number_array[instance_index]++;
             else
                 pcs->picture_number = context_ptr->picture_number_array[instance_index];
-            if (scs->passes == 2 && !end_of_sequence_flag && scs->static_config.pass == ENC_SECOND_PASS &&
+            if (scs->passes == 2 && !context_ptr->end_of_sequence_flag && scs->static_config.pass == ENC_SECOND_PASS &&
                 scs->static_config.rate_control_mode) {
                 pcs->stat_struct = (scs->twopass.stats_buf_ctx->stats_in_start + pcs->picture_number)->stat_struct;
                 if (pcs->stat_struct.poc != pcs->picture_number)
@@ -1171,9 +1210,9 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             if (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) {
                 PictureParentControlSet *ppcs_out = pcs;
 
-                ppcs_out->end_of_sequence_flag = end_of_sequence_flag;
+                ppcs_out->end_of_sequence_flag = context_ptr->end_of_sequence_flag;
                 // since overlay frame has the end of sequence set properly, set the end of sequence to true in the alt ref picture
-                if (ppcs_out->is_overlay && end_of_sequence_flag)
+                if (ppcs_out->is_overlay && context_ptr->end_of_sequence_flag)
                     ppcs_out->alt_ref_ppcs_ptr->end_of_sequence_flag = TRUE;
 
                 reset_pcs_av1(ppcs_out);
@@ -1188,6 +1227,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                     }
 
                     out_results->pcs_wrapper = pcs_wrapper;
+                    out_results->task_type   = TASK_PA;
                     // Post the finished Results Object
                     svt_post_full_object(output_wrapper_ptr);
                 } else {
@@ -1198,12 +1238,13 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 }
             } else {
                 // Get Empty Output Results Object
-                if (pcs->picture_number > 0 && (prev_pcs_wrapper_ptr != NULL)) {
-                    PictureParentControlSet *ppcs_out = (PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr;
+                if (pcs->picture_number > 0 && (context_ptr->prev_pcs_wrapper_ptr != NULL)) {
+                    PictureParentControlSet *ppcs_out =
+                        (PictureParentControlSet *)context_ptr->prev_pcs_wrapper_ptr->object_ptr;
 
-                    ppcs_out->end_of_sequence_flag = end_of_sequence_flag;
+                    ppcs_out->end_of_sequence_flag = context_ptr->end_of_sequence_flag;
                     // since overlay frame has the end of sequence set properly, set the end of sequence to true in the alt ref picture
-                    if (ppcs_out->is_overlay && end_of_sequence_flag)
+                    if (ppcs_out->is_overlay && context_ptr->end_of_sequence_flag)
                         ppcs_out->alt_ref_ppcs_ptr->end_of_sequence_flag = TRUE;
 
                     reset_pcs_av1(ppcs_out);
@@ -1214,32 +1255,34 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
 
                     if (scs->static_config.enable_overlays == TRUE) {
                         // ppcs live_count + 1 for PictureAnalysis & PictureDecision, will svt_release_object(ppcs) at the end of svt_aom_picture_decision_kernel.
-                        svt_object_inc_live_count(prev_pcs_wrapper_ptr, 1);
+                        svt_object_inc_live_count(context_ptr->prev_pcs_wrapper_ptr, 1);
                         svt_object_inc_live_count(
-                            ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)->scs_wrapper, 1);
+                            ((PictureParentControlSet *)context_ptr->prev_pcs_wrapper_ptr->object_ptr)->scs_wrapper, 1);
                     }
 
-                    out_results->pcs_wrapper = prev_pcs_wrapper_ptr;
+                    out_results->pcs_wrapper = context_ptr->prev_pcs_wrapper_ptr;
+                    out_results->task_type   = TASK_PA;
                     // Post the finished Results Object
                     svt_post_full_object(output_wrapper_ptr);
                 }
-                if (end_of_sequence_flag) {
+                if (context_ptr->end_of_sequence_flag) {
                     // When the end of sequence recieved, there is no need to inject a new PCS.
                     // terminating_picture_number and terminating_sequence_flag_received are set. When all
                     // the pictures in the packetiztion queue are processed, EOS is signalled to the application.
                     set_eos_terminating_signals(pcs);
                 }
             }
-            prev_pcs_wrapper_ptr = pcs_wrapper;
+            context_ptr->prev_pcs_wrapper_ptr = pcs_wrapper;
 
 #else
             // Get Empty Output Results Object
-            if (pcs->picture_number > 0 && (prev_pcs_wrapper_ptr != NULL)) {
-                PictureParentControlSet *ppcs_out = (PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr;
+            if (pcs->picture_number > 0 && (context_ptr->prev_pcs_wrapper_ptr != NULL)) {
+                PictureParentControlSet *ppcs_out =
+                    (PictureParentControlSet *)context_ptr->prev_pcs_wrapper_ptr->object_ptr;
 
-                ppcs_out->end_of_sequence_flag = end_of_sequence_flag;
+                ppcs_out->end_of_sequence_flag = context_ptr->end_of_sequence_flag;
                 // since overlay frame has the end of sequence set properly, set the end of sequence to true in the alt ref picture
-                if (ppcs_out->is_overlay && end_of_sequence_flag)
+                if (ppcs_out->is_overlay && context_ptr->end_of_sequence_flag)
                     ppcs_out->alt_ref_ppcs_ptr->end_of_sequence_flag = TRUE;
 
                 reset_pcs_av1(ppcs_out);
@@ -1249,16 +1292,17 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
 
                 if (scs->static_config.enable_overlays == TRUE) {
                     // ppcs live_count + 1 for PictureAnalysis & PictureDecision, will svt_release_object(ppcs) at the end of svt_aom_picture_decision_kernel.
-                    svt_object_inc_live_count(prev_pcs_wrapper_ptr, 1);
+                    svt_object_inc_live_count(context_ptr->prev_pcs_wrapper_ptr, 1);
                     svt_object_inc_live_count(
-                        ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)->scs_wrapper, 1);
+                        ((PictureParentControlSet *)context_ptr->prev_pcs_wrapper_ptr->object_ptr)->scs_wrapper, 1);
                 }
 
-                out_results->pcs_wrapper = prev_pcs_wrapper_ptr;
+                out_results->pcs_wrapper = context_ptr->prev_pcs_wrapper_ptr;
+                out_results->task_type   = TASK_PA;
                 // Post the finished Results Object
                 svt_post_full_object(output_wrapper_ptr);
             }
-            prev_pcs_wrapper_ptr = pcs_wrapper;
+            context_ptr->prev_pcs_wrapper_ptr = pcs_wrapper;
 #endif
         }
         // Release the Input Command
@@ -20,6 +20,7 @@ extern "C" {
  * Extern Function Declaration
  ***************************************/
 EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext* thread_ctx, EbEncHandle* enc_handle_ptr);
+void        svt_aom_resource_coordination_reset(EbThreadContext* thread_ctx);
 extern bool buffer_update_needed(EbBufferHeaderType* input_buffer, struct SequenceControlSet* scs);
 
 extern void* svt_aom_resource_coordination_kernel(void* input_ptr);
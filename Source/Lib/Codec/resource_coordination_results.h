@@ -25,12 +25,18 @@ typedef struct InputCommand {
     EbObjectWrapper *y8b_wrapper;
 } InputCommand;
 
+// Tasks of the picture analysis kernels
+#define TASK_PA 0 // analysis of a picture
+#define TASK_PA_DENOISE 1 // film grain denoise of a plane, posted by the picture analysis kernels
+
 /**************************************
  * Process Results
  **************************************/
 typedef struct ResourceCoordinationResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    uint8_t          task_type;
+    uint8_t          plane; // plane denoised by a TASK_PA_DENOISE task
 } ResourceCoordinationResults;
 
 typedef struct ResourceCoordinationResultInitData {
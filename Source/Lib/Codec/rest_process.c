@@ -14,6 +14,7 @@
 
 #include "enc_handle.h"
 #include "rest_process.h"
+#include "stat_report_process.h"
 #include "enc_dec_results.h"
 #include "svt_threads.h"
 #include "pic_demux_results.h"
@@ -30,7 +31,9 @@ typedef struct RestContext {
     EbDctor dctor;
     EbFifo *rest_input_fifo_ptr;
     EbFifo *rest_output_fifo_ptr;
-    EbFifo *picture_demux_fifo_ptr;
+    EbFifo *stat_report_output_fifo_ptr;
+    // Producer port of the picture demux results, the queue is the one of the picture stream
+    uint32_t picture_demux_port;
 
     EbPictureBufferDesc *trial_frame_rst;
 
@@ -93,8 +96,10 @@ EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHa
                                                                              index);
     context_ptr->rest_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->rest_results_resource_ptr,
                                                                               index);
-    context_ptr->picture_demux_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
+    context_ptr->picture_demux_port = demux_index;
+    if (enc_handle_ptr->stat_report_tasks_resource_ptr)
+        context_ptr->stat_report_output_fifo_ptr = svt_system_resource_get_producer_fifo(
+            enc_handle_ptr->stat_report_tasks_resource_ptr, index);
 
     Bool is_16bit = scs->is_16bit_pipeline;
     if (svt_aom_get_enable_restoration(init_data_ptr->enc_mode,
@@ -545,6 +550,7 @@ void *svt_aom_rest_kernel(void *input_ptr) {
 
         cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
         FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
@@ -709,19 +715,8 @@ void *svt_aom_rest_kernel(void *input_ptr) {
                                        "calculations");
                 }
             } else if (scs->static_config.stat_report) {
-                // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
-                EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-                return_error = svt_aom_ssim_calculations(pcs, scs, TRUE /* free memory here */);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
-                                       "calculations");
-                }
+                svt_aom_start_stat_report_metrics(context_ptr->stat_report_output_fifo_ptr,
+                                                  cdef_results->pcs_wrapper);
             }
 
             if (!superres_recode) {
@@ -731,7 +726,10 @@ void *svt_aom_rest_kernel(void *input_ptr) {
                 // post reference picture task in packetization process if it's superres_recode
                 if (pcs->ppcs->is_ref) {
                     // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+                    svt_get_empty_object(
+                        svt_system_resource_get_producer_fifo(scs->enc_ctx->picture_demux_results_resource_ptr,
+                                                              context_ptr->picture_demux_port),
+                        &picture_demux_results_wrapper_ptr);
 
                     picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
                     picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
@@ -134,6 +134,7 @@ static void svt_sequence_control_set_instance_dctor(EbPtr p) {
     EbSequenceControlSetInstance *obj = (EbSequenceControlSetInstance *)p;
     EB_DELETE(obj->enc_ctx);
     EB_DESTROY_SEMAPHORE(obj->scs->ref_buffer_available_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->scs->worker_tokens);
     EB_DESTROY_MUTEX(obj->config_mutex);
     EB_DELETE(obj->scs);
 }
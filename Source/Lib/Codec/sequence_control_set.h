@@ -192,6 +192,10 @@ typedef struct SequenceControlSet {
     sent to PM will have an available ref buffer. If ref buffers are
     not available in PM, it will result in a deadlock.*/
     EbHandle ref_buffer_available_semaphore;
+    /* worker_tokens is shared by all kernels when adaptive threading is on:
+    one token per core, held by a kernel thread while it runs (NULL when off).*/
+    EbHandle worker_tokens;
+    uint32_t worker_token_count;
     uint32_t reference_picture_buffer_init_count;
     uint32_t input_buffer_fifo_init_count;
     uint32_t overlay_input_picture_buffer_init_count;
@@ -226,6 +230,8 @@ typedef struct SequenceControlSet {
     uint32_t     cdef_process_init_count;
     uint32_t     rest_process_init_count;
     uint32_t     tpl_disp_process_init_count;
+    uint32_t     stat_report_process_init_count; // 0 unless stat_report is set
+    uint8_t      subpel_cache_planes; // sub-pel planes each reference may cache, within the memory budget
     uint32_t     total_process_init_count;
     int32_t      lap_rc;
     TWO_PASS     twopass;
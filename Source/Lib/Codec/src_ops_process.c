@@ -40,7 +40,8 @@
 typedef struct SourceBasedOperationsContext {
     EbDctor  dctor;
     EbFifo  *initial_rate_control_results_input_fifo_ptr;
-    EbFifo  *picture_demux_results_output_fifo_ptr;
+    // Producer port of the picture demux results, the queue is the one of the picture stream
+    uint32_t picture_demux_results_port;
     EbFifo  *sbo_output_fifo_ptr;
     uint8_t *y_mean_ptr;
     uint8_t *cr_mean_ptr;
@@ -74,9 +75,7 @@ EbErrorType svt_aom_source_based_operations_context_ctor(EbThreadContext *thread
         enc_handle_ptr->initial_rate_control_results_resource_ptr, index);
     context_ptr->sbo_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->tpl_disp_res_srm,
                                                                              tpl_index);
-
-    context_ptr->picture_demux_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
-        enc_handle_ptr->picture_demux_results_resource_ptr, index);
+    context_ptr->picture_demux_results_port = index;
 
     return EB_ErrorNone;
 }
@@ -498,6 +497,7 @@ static void tpl_subpel_search(SequenceControlSet *scs, PictureParentControlSet *
     ms_params->round_dev_th                     = MAX_SIGNED_VALUE;
     ms_params->skip_diag_refinement             = pcs->tpl_ctrls.subpel_diag_refinement;
     ms_params->var_params.bias_fp               = 0;
+    ms_params->var_params.subpel_cache          = NULL;
     uint8_t early_exit                          = 0;
     subpel_search_method(NULL,
                          xd,
@@ -1394,7 +1394,9 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
 
             svt_post_full_object(out_results_wrapper);
 
+            svt_yield_worker_token();
             svt_block_on_semaphore(pcs->tpl_disp_done_semaphore); // we can do all in // ?
+            svt_resume_worker_token();
         }
     }
 
@@ -1795,7 +1797,9 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
         picture_height_in_mb = (pcs->enhanced_pic->height + 31) / 32;
     }
     // wait for PA ME to be done.
+    svt_yield_worker_token();
     for (uint32_t i = 1; i < pcs->tpl_group_size; i++) { svt_wait_cond_var(&pcs->tpl_group[i]->me_ready, 0); }
+    svt_resume_worker_token();
     pcs->tpl_is_valid = 0;
     init_tpl_buffers(enc_ctx);
 
@@ -1973,6 +1977,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
         in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
 
         PictureParentControlSet *pcs = in_results_ptr->pcs;
+        svt_aom_profile_picture(pcs->picture_number);
 
         SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
 
@@ -2088,7 +2093,9 @@ static void sbo_send_picture_out(SourceBasedOperationsContext *context_ptr, Pict
     EbObjectWrapper *out_results_wrapper;
 
     // Get Empty Results Object
-    svt_get_empty_object(context_ptr->picture_demux_results_output_fifo_ptr, &out_results_wrapper);
+    svt_get_empty_object(svt_system_resource_get_producer_fifo(pcs->scs->enc_ctx->picture_demux_results_resource_ptr,
+                                                               context_ptr->picture_demux_results_port),
+                         &out_results_wrapper);
 
     PictureDemuxResults *out_results = (PictureDemuxResults *)out_results_wrapper->object_ptr;
     out_results->pcs_wrapper         = pcs->p_pcs_wrapper_ptr;
@@ -2301,6 +2308,7 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
 
         InitialRateControlResults *in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet   *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        svt_aom_profile_picture(pcs->picture_number);
         SequenceControlSet        *scs            = pcs->scs;
         if (in_results_ptr->superres_recode) {
             sbo_send_picture_out(context_ptr, pcs, TRUE);
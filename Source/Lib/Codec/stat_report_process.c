@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include "enc_handle.h"
+#include "stat_report_process.h"
+#include "enc_dec_results.h"
+#include "svt_threads.h"
+#include "pcs.h"
+
+EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
+EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
+
+/**************************************
+ * Stat Report Context
+ **************************************/
+typedef struct StatReportContext {
+    EbFifo *stat_report_input_fifo_ptr;
+} StatReportContext;
+
+static void stat_report_context_dctor(EbPtr p) {
+    EbThreadContext   *thread_ctx = (EbThreadContext *)p;
+    StatReportContext *obj        = (StatReportContext *)thread_ctx->priv;
+    EB_FREE_ARRAY(obj);
+}
+
+/******************************************************
+ * Stat Report Context Constructor
+ ******************************************************/
+EbErrorType svt_aom_stat_report_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
+                                             int index) {
+    StatReportContext *context_ptr;
+    EB_CALLOC_ARRAY(context_ptr, 1);
+    thread_ctx->priv  = context_ptr;
+    thread_ctx->dctor = stat_report_context_dctor;
+
+    // Input System Resource Manager FIFO, the results go back through the picture control set
+    context_ptr->stat_report_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
+        enc_handle_ptr->stat_report_tasks_resource_ptr, index);
+
+    return EB_ErrorNone;
+}
+
+/************************************************************************************************
+ * svt_aom_start_stat_report_metrics
+ * The stat report PSNR/SSIM only feed the output packet, so Rest hands them to the stat report
+ * kernel and the picture goes on to entropy coding; svt_aom_wait_stat_report_metrics() waits
+ * for them in packetization.
+ ************************************************************************************************/
+void svt_aom_start_stat_report_metrics(EbFifo *stat_report_fifo_ptr, EbObjectWrapper *pcs_wrapper) {
+    PictureControlSet *pcs = (PictureControlSet *)pcs_wrapper->object_ptr;
+    EbObjectWrapper   *task_wrapper;
+    assert(!pcs->stat_report_pending);
+    pcs->stat_report_pending = TRUE;
+    svt_get_empty_object(stat_report_fifo_ptr, &task_wrapper);
+    StatReportTasks *task = (StatReportTasks *)task_wrapper->object_ptr;
+    task->pcs_wrapper     = pcs_wrapper;
+    svt_post_full_object(task_wrapper);
+}
+
+void svt_aom_wait_stat_report_metrics(PictureControlSet *pcs) {
+    if (pcs->stat_report_pending) {
+        // Let another kernel run while this one is blocked
+        svt_yield_worker_token();
+        svt_block_on_semaphore(pcs->stat_report_done_semaphore);
+        svt_resume_worker_token();
+        pcs->stat_report_pending = FALSE;
+    }
+}
+
+/******************************************************
+ * Stat Report Kernel
+ * Computes the PSNR and SSIM of a picture for the stat report
+ ******************************************************/
+void *svt_aom_stat_report_kernel(void *input_ptr) {
+    EbThreadContext   *thread_ctx  = (EbThreadContext *)input_ptr;
+    StatReportContext *context_ptr = (StatReportContext *)thread_ctx->priv;
+    EbObjectWrapper   *task_wrapper;
+
+    for (;;) {
+        EB_GET_FULL_OBJECT(context_ptr->stat_report_input_fifo_ptr, &task_wrapper);
+
+        StatReportTasks    *task = (StatReportTasks *)task_wrapper->object_ptr;
+        PictureControlSet  *pcs  = (PictureControlSet *)task->pcs_wrapper->object_ptr;
+        SequenceControlSet *scs  = pcs->scs;
+        svt_aom_profile_picture(pcs->picture_number);
+
+        // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
+        EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                               "calculations");
+        }
+        return_error = svt_aom_ssim_calculations(pcs, scs, TRUE /* free memory here */);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
+                               "calculations");
+        }
+
+        svt_release_object(task_wrapper);
+        svt_post_semaphore(pcs->stat_report_done_semaphore);
+    }
+    return NULL;
+}
@@ -0,0 +1,30 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbStatReportProcess_h
+#define EbStatReportProcess_h
+
+#include "sys_resource_manager.h"
+#include "object.h"
+#include "pcs.h"
+
+/**************************************
+ * Extern Function Declarations
+ **************************************/
+extern EbErrorType svt_aom_stat_report_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
+                                                    int index);
+
+extern void *svt_aom_stat_report_kernel(void *input_ptr);
+
+extern void svt_aom_start_stat_report_metrics(EbFifo *stat_report_fifo_ptr, EbObjectWrapper *pcs_wrapper);
+extern void svt_aom_wait_stat_report_metrics(PictureControlSet *pcs);
+
+#endif
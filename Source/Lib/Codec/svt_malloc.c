@@ -10,6 +10,15 @@
 */
 #include <stdint.h>
 #include <limits.h>
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#endif
 
 #include "svt_malloc.h"
 #include "svt_threads.h"
@@ -20,6 +29,212 @@ void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+// Account of the encoder the calling thread allocates for, NULL when not accounted
+static SVT_THREAD_LOCAL EbMemoryAccount* running_account = NULL;
+
+EbMemoryAccount* svt_memory_account_set(EbMemoryAccount* account) {
+    EbMemoryAccount* previous = running_account;
+    running_account           = account;
+    return previous;
+}
+
+EbMemoryAccount* svt_memory_account_get(void) { return running_account; }
+
+/* Live allocations charged to an account, keyed on the pointer so the free path refunds the recorded size and type
+ * whatever thread frees it. The pointers are spread on shards with a lock each, a shard is an open addressing table
+ * with linear probing. */
+typedef struct AccountEntry {
+    void*            ptr;
+    EbMemoryAccount* account;
+    size_t           count;
+    EbPtrType        type;
+} AccountEntry;
+
+typedef struct AccountShard {
+    EbHandle      mutex;
+    AccountEntry* entry;
+    size_t        size; // power of 2, 0 until the first allocation
+    size_t        used;
+} AccountShard;
+
+#define ACCOUNT_SHARD_LOG2 4
+#define ACCOUNT_SHARD_MIN_SIZE 1024
+
+static AccountShard g_account_shard[1 << ACCOUNT_SHARD_LOG2];
+// Entries in all the shards, lets the free path skip the lookup while nothing is accounted
+static volatile uint64_t g_account_entries;
+
+static void create_account_mutexes(void) {
+    for (int i = 0; i < 1 << ACCOUNT_SHARD_LOG2; i++) g_account_shard[i].mutex = svt_create_mutex();
+}
+
+#ifdef _WIN32
+static INIT_ONCE g_account_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_account_mutexes_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID* lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_account_mutexes();
+    return TRUE;
+}
+#else
+static pthread_once_t g_account_once = PTHREAD_ONCE_INIT;
+#endif
+
+// Fibonacci hashing, the shard comes from the top bits and the slot from the middle ones: the low bits of the
+// product keep the alignment of the pointer
+static inline uint64_t account_hash(const void* p) { return (uint64_t)(uintptr_t)p * 0x9E3779B97F4A7C15ull; }
+#define ACCOUNT_SLOT(h, mask) ((size_t)((h) >> 24) & (mask))
+
+static AccountShard* account_shard(uint64_t h) {
+#ifdef _WIN32
+    InitOnceExecuteOnce(&g_account_once, create_account_mutexes_wrapper, NULL, NULL);
+#else
+    pthread_once(&g_account_once, create_account_mutexes);
+#endif
+    return &g_account_shard[h >> (64 - ACCOUNT_SHARD_LOG2)];
+}
+
+static void account_charge(EbMemoryAccount* account, EbPtrType type, size_t count, int sign) {
+    svt_atomic_fetch_add_u64(&account->amount[type], (uint64_t)sign * count);
+}
+
+// Slot of p, or the empty slot ending its probe sequence
+static size_t account_find(const AccountShard* shard, uint64_t h, const void* p) {
+    const size_t mask = shard->size - 1;
+    size_t       i    = ACCOUNT_SLOT(h, mask);
+    while (shard->entry[i].ptr && shard->entry[i].ptr != p) i = (i + 1) & mask;
+    return i;
+}
+
+// Empties slot i, moving back the following entries of the cluster that probed past it
+static void account_erase(AccountShard* shard, size_t i) {
+    const size_t mask = shard->size - 1;
+    size_t       j    = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!shard->entry[j].ptr)
+            break;
+        const size_t home = ACCOUNT_SLOT(account_hash(shard->entry[j].ptr), mask);
+        // keep the entry when its home lies cyclically in (i, j]
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        shard->entry[i] = shard->entry[j];
+        i               = j;
+    }
+    shard->entry[i].ptr = NULL;
+    shard->used--;
+    svt_atomic_fetch_add_u64(&g_account_entries, (uint64_t)-1);
+}
+
+static Bool account_grow(AccountShard* shard) {
+    const size_t  size  = shard->size ? shard->size * 2 : ACCOUNT_SHARD_MIN_SIZE;
+    AccountEntry* entry = calloc(size, sizeof(*entry));
+    if (!entry)
+        return FALSE;
+    AccountShard grown = {shard->mutex, entry, size, shard->used};
+    for (size_t i = 0; i < shard->size; i++)
+        if (shard->entry[i].ptr)
+            grown.entry[account_find(&grown, account_hash(shard->entry[i].ptr), shard->entry[i].ptr)] =
+                shard->entry[i];
+    free(shard->entry);
+    *shard = grown;
+    return TRUE;
+}
+
+void svt_memory_account_add(void* p, EbPtrType type, size_t count) {
+    EbMemoryAccount* account = running_account;
+    // an address freed outside of the macros may still be recorded, drop it when the address comes back
+    if (!account && !svt_atomic_load_u64(&g_account_entries))
+        return;
+    const uint64_t h     = account_hash(p);
+    AccountShard*  shard = account_shard(h);
+    svt_block_on_mutex(shard->mutex);
+    if (shard->used) {
+        const size_t i = account_find(shard, h, p);
+        if (shard->entry[i].ptr) {
+            account_charge(shard->entry[i].account, shard->entry[i].type, shard->entry[i].count, -1);
+            account_erase(shard, i);
+        }
+    }
+    if (account && ((shard->used + 1) * 2 <= shard->size || account_grow(shard))) {
+        shard->entry[account_find(shard, h, p)] = (AccountEntry){p, account, count, type};
+        shard->used++;
+        svt_atomic_fetch_add_u64(&g_account_entries, 1);
+        account_charge(account, type, count, 1);
+    }
+    svt_release_mutex(shard->mutex);
+}
+
+void svt_memory_account_remove(void* p) {
+    if (!p || !svt_atomic_load_u64(&g_account_entries))
+        return;
+    const uint64_t h     = account_hash(p);
+    AccountShard*  shard = account_shard(h);
+    svt_block_on_mutex(shard->mutex);
+    if (shard->used) {
+        const size_t i = account_find(shard, h, p);
+        if (shard->entry[i].ptr) {
+            account_charge(shard->entry[i].account, shard->entry[i].type, shard->entry[i].count, -1);
+            account_erase(shard, i);
+        }
+    }
+    svt_release_mutex(shard->mutex);
+}
+
+void svt_memory_account_read(const EbMemoryAccount* account, EbMemoryAccount* amounts) {
+    for (int type = 0; type < EB_PTR_TYPE_TOTAL; type++)
+        amounts->amount[type] = svt_atomic_load_u64((volatile uint64_t*)&account->amount[type]);
+}
+
+void svt_memory_account_close(EbMemoryAccount* account) {
+    if (!svt_atomic_load_u64(&g_account_entries))
+        return;
+    for (int s = 0; s < 1 << ACCOUNT_SHARD_LOG2; s++) {
+        AccountShard* shard = account_shard((uint64_t)s << (64 - ACCOUNT_SHARD_LOG2));
+        svt_block_on_mutex(shard->mutex);
+        // erasing moves entries back, so recheck the slot before advancing
+        for (size_t i = 0; i < shard->size;) {
+            if (shard->entry[i].ptr && shard->entry[i].account == account)
+                account_erase(shard, i);
+            else
+                i++;
+        }
+        svt_release_mutex(shard->mutex);
+    }
+}
+
+#define HUGE_PAGE_SIZE (2 << 20)
+
+// Huge pages setting of the encoder the calling thread allocates for
+static SVT_THREAD_LOCAL Bool running_huge_pages = FALSE;
+
+Bool svt_huge_pages_set(Bool huge_pages) {
+    Bool previous      = running_huge_pages;
+    running_huge_pages = huge_pages;
+    return previous;
+}
+
+void* svt_picture_buffer_malloc(size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, ALVALUE);
+#else
+    void* p = NULL;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Transparent huge pages: the kernel backs every 2 MB aligned range of the buffer with
+    // one page once madvised, only the tail of the buffer stays on small pages
+    if (running_huge_pages && size >= HUGE_PAGE_SIZE && posix_memalign(&p, HUGE_PAGE_SIZE, size) == 0) {
+        madvise(p, size, MADV_HUGEPAGE);
+        return p;
+    }
+#endif
+    if (posix_memalign(&p, ALVALUE, size) != 0)
+        return NULL;
+    return p;
+#endif
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
@@ -62,12 +62,42 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #endif //DEBUG_MEMORY_USAGE
 
+/* Memory held by one encoder, bytes for the memory types and object counts
+ * for the mutexes, semaphores and threads: what was charged to the account
+ * and not freed yet */
+typedef struct EbMemoryAccount {
+    uint64_t amount[EB_PTR_TYPE_TOTAL];
+} EbMemoryAccount;
+
+// Charges the allocations of the calling thread to account (NULL to stop), returns the previous account.
+// The threads created meanwhile charge theirs to the same account.
+EbMemoryAccount* svt_memory_account_set(EbMemoryAccount* account);
+// Account the calling thread allocates for, NULL when not accounted
+EbMemoryAccount* svt_memory_account_get(void);
+// Charges the allocation at p to the account of the calling thread, recording its size and type
+void svt_memory_account_add(void* p, EbPtrType type, size_t count);
+// Refunds the allocation at p to the account it was charged to, whichever thread frees it
+void svt_memory_account_remove(void* p);
+// Copies the amounts held by account
+void svt_memory_account_read(const EbMemoryAccount* account, EbMemoryAccount* amounts);
+// Forgets the allocations still charged to account before it goes away
+void svt_memory_account_close(EbMemoryAccount* account);
+
 #define EB_NO_THROW_ADD_MEM(p, size, type)            \
     do {                                              \
         if (!p)                                       \
             svt_print_alloc_fail(__FILE__, __LINE__); \
-        else                                          \
+        else {                                        \
             EB_ADD_MEM_ENTRY(p, type, size);          \
+            svt_memory_account_add(p, type, size);    \
+        }                                             \
+    } while (0)
+
+// Removed before the memory is released, the address may be handed out again right after
+#define EB_REMOVE_MEM(p, type)        \
+    do {                              \
+        EB_REMOVE_MEM_ENTRY(p, type); \
+        svt_memory_account_remove(p); \
     } while (0)
 
 #define EB_CHECK_MEM(p)                           \
@@ -109,7 +139,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE(pointer)                        \
     do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_N_PTR); \
+        EB_REMOVE_MEM(pointer, EB_N_PTR);       \
         free(pointer);                          \
         pointer = NULL;                         \
     } while (0)
@@ -120,10 +150,8 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 #define EB_REALLOC_ARRAY(pa, count)            \
     do {                                       \
         size_t size = sizeof(*(pa)) * (count); \
-        void*  p    = realloc(pa, size);       \
-        if (p) {                               \
-            EB_REMOVE_MEM_ENTRY(pa, EB_N_PTR); \
-        }                                      \
+        EB_REMOVE_MEM(pa, EB_N_PTR);           \
+        void* p = realloc(pa, size);           \
         EB_ADD_MEM(p, size, EB_N_PTR);         \
         pa = p;                                \
     } while (0)
@@ -174,7 +202,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED(pointer)                \
     do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
+        EB_REMOVE_MEM(pointer, EB_A_PTR);       \
         _aligned_free(pointer);                 \
         pointer = NULL;                         \
     } while (0)
@@ -188,7 +216,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED(pointer)                \
     do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
+        EB_REMOVE_MEM(pointer, EB_A_PTR);       \
         free(pointer);                          \
         pointer = NULL;                         \
     } while (0)
@@ -204,4 +232,21 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED_ARRAY(pa) EB_FREE_ALIGNED(pa)
 
+// Backs the picture buffers allocated by the calling thread with huge pages, returns the previous setting
+Bool svt_huge_pages_set(Bool huge_pages);
+// Aligned allocation for the planes of a picture buffer, freed with EB_FREE_ALIGNED
+void* svt_picture_buffer_malloc(size_t size);
+
+#define EB_MALLOC_PICTURE_ARRAY(pa, count)                       \
+    do {                                                         \
+        pa = svt_picture_buffer_malloc(sizeof(*(pa)) * (count)); \
+        EB_ADD_MEM(pa, sizeof(*(pa)) * (count), EB_A_PTR);       \
+    } while (0)
+
+#define EB_CALLOC_PICTURE_ARRAY(pa, count)      \
+    do {                                        \
+        EB_MALLOC_PICTURE_ARRAY(pa, count);     \
+        memset(pa, 0, sizeof(*(pa)) * (count)); \
+    } while (0)
+
 #endif //EbMalloc_h
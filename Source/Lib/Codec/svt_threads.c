@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "svt_threads.h"
+#include "svt_malloc.h"
 #include "svt_log.h"
 /****************************************
   * Win32 Includes
@@ -114,31 +115,67 @@ end:
 }
 #endif
 
+// Start of a thread created while the creator allocates for an encoder, the thread charges the same account
+typedef struct AccountedThreadStart {
+    void *(*function)(void *);
+    void            *context;
+    EbMemoryAccount *account;
+} AccountedThreadStart;
+
+static void *accounted_thread_start(void *start_ptr) {
+    AccountedThreadStart start = *(AccountedThreadStart *)start_ptr;
+    free(start_ptr);
+    svt_memory_account_set(start.account);
+    return start.function(start.context);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI accounted_thread_start_win32(LPVOID start_ptr) {
+    accounted_thread_start(start_ptr);
+    return 0;
+}
+#endif
+
 /****************************************
  * svt_create_thread
  ****************************************/
 EbHandle svt_create_thread(void *thread_function(void *), void *thread_context) {
     EbHandle thread_handle = NULL;
 
+    AccountedThreadStart *start = NULL;
+    if (svt_memory_account_get()) {
+        start = malloc(sizeof(*start));
+        if (start == NULL) {
+            SVT_ERROR("Failed to allocate thread start\n");
+            return NULL;
+        }
+        *start = (AccountedThreadStart){thread_function, thread_context, svt_memory_account_get()};
+    }
+
 #ifdef _WIN32
 
     thread_handle = (EbHandle)CreateThread(
         NULL, // default security attributes
         0, // default stack size
-        (LPTHREAD_START_ROUTINE)thread_function, // function to be tied to the new thread
-        thread_context, // context to be tied to the new thread
+        start ? accounted_thread_start_win32
+              : (LPTHREAD_START_ROUTINE)thread_function, // function to be tied to the new thread
+        start ? (LPVOID)start : thread_context, // context to be tied to the new thread
         0, // thread active when created
         NULL); // new thread ID
+    if (!thread_handle)
+        free(start);
 
 #else
     if (pthread_once(&checked_once, check_set_prio)) {
         SVT_ERROR("Failed to run pthread_once to check if we can set priority\n");
+        free(start);
         return NULL;
     }
 
     pthread_attr_t attr;
     if (pthread_attr_init(&attr)) {
         SVT_ERROR("Failed to initalize thread attributes\n");
+        free(start);
         return NULL;
     }
 
@@ -159,13 +196,16 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
     if (th == NULL) {
         SVT_ERROR("Failed to allocate thread handle\n");
         pthread_attr_destroy(&attr);
+        free(start);
         return NULL;
     }
 
     int ret;
-    if ((ret = pthread_create(th, &attr, thread_function, thread_context))) {
+    if ((ret = start ? pthread_create(th, &attr, accounted_thread_start, start)
+                     : pthread_create(th, &attr, thread_function, thread_context))) {
         SVT_ERROR("Failed to create thread: %s\n", strerror(ret));
         free(th);
+        free(start);
         pthread_attr_destroy(&attr);
         return NULL;
     }
@@ -331,6 +371,85 @@ EbErrorType svt_destroy_semaphore(EbHandle semaphore_handle) {
 
     return return_error;
 }
+/***************************************
+ * svt_atomic_load_u32
+ ***************************************/
+uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) {
+#ifdef _WIN32
+    return (uint32_t)InterlockedOr((volatile LONG *)ptr, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_atomic_store_u32
+ ***************************************/
+void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t value) {
+#ifdef _WIN32
+    InterlockedExchange((volatile LONG *)ptr, (LONG)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_atomic_cas_u32
+ ***************************************/
+Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+#ifdef _WIN32
+    return (uint32_t)InterlockedCompareExchange((volatile LONG *)ptr, (LONG)desired, (LONG)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_atomic_fetch_add_i32
+ ***************************************/
+int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t value) {
+#ifdef _WIN32
+    return InterlockedExchangeAdd((volatile LONG *)ptr, value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_atomic_load_u64
+ ***************************************/
+uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) {
+#ifdef _WIN32
+    return (uint64_t)InterlockedOr64((volatile LONG64 *)ptr, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_atomic_fetch_add_u64
+ ***************************************/
+uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value) {
+#ifdef _WIN32
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)ptr, (LONG64)value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/***************************************
+ * svt_cpu_pause
+ ***************************************/
+void svt_cpu_pause(void) {
+#ifdef _WIN32
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 /***************************************
  * svt_create_mutex
  ***************************************/
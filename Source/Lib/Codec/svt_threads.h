@@ -25,6 +25,15 @@ extern "C" {
 // semaphores, mutex, etc. These wrappers also hide
 // platform specific implementations of these objects.
 
+/**************************************
+     * Thread local storage
+     **************************************/
+#ifdef _MSC_VER
+#define SVT_THREAD_LOCAL __declspec(thread)
+#else
+#define SVT_THREAD_LOCAL __thread
+#endif
+
 /**************************************
      * Threads
      **************************************/
@@ -47,6 +56,26 @@ extern EbErrorType svt_block_on_semaphore(EbHandle semaphore_handle);
 
 extern EbErrorType svt_destroy_semaphore(EbHandle semaphore_handle);
 
+/**************************************
+     * Atomics
+     *   Sequentially consistent operations used
+     *   by the lock-free queues, svt_cpu_pause is
+     *   the spin-wait hint of the processor.
+     **************************************/
+extern uint32_t svt_atomic_load_u32(volatile uint32_t *ptr);
+
+extern void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t value);
+
+extern Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired);
+
+extern int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t value);
+
+extern uint64_t svt_atomic_load_u64(volatile uint64_t *ptr);
+
+extern uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value);
+
+extern void svt_cpu_pause(void);
+
 /**************************************
      * Mutex
      **************************************/
@@ -98,8 +127,8 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 #define EB_DESTROY_THREAD(pointer)                   \
     do {                                             \
         if (pointer) {                               \
+            EB_REMOVE_MEM(pointer, EB_THREAD);       \
             svt_destroy_thread(pointer);             \
-            EB_REMOVE_MEM_ENTRY(pointer, EB_THREAD); \
             pointer = NULL;                          \
         }                                            \
     } while (0);
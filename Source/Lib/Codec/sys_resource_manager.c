@@ -15,9 +15,15 @@
 #include "sys_resource_manager.h"
 #include "definitions.h"
 #include "svt_threads.h"
+#include "pipeline_profile.h"
 #if SRM_REPORT
 #include "svt_log.h"
 #endif
+
+// Worker token held by the calling kernel thread, NULL when the thread
+// does not take part in adaptive threading (e.g. the API caller).
+static SVT_THREAD_LOCAL EbHandle held_worker_token = NULL;
+
 static void svt_fifo_dctor(EbPtr p) {
     EbFifo *obj = (EbFifo *)p;
     EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
@@ -46,6 +52,7 @@ static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32
     return EB_ErrorNone;
 }
 
+#if !LOCKFREE_FIFO
 /**************************************
  * svt_fifo_push_back
  **************************************/
@@ -182,6 +189,109 @@ static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, E
 
     return return_error;
 }
+#endif
+
+#if LOCKFREE_FIFO
+// Number of polls of ready_count before a process parks on ready_semaphore
+#define LOCKFREE_FIFO_SPIN_COUNT 1024
+
+/**************************************
+ * svt_lockfree_ring_push
+ *   Bounded MPMC ring push, never fails since
+ *   the ring holds every object of the resource
+ **************************************/
+static void svt_lockfree_ring_push(EbMuxingQueue *queue_ptr, EbObjectWrapper *wrapper_ptr) {
+    uint32_t        pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+    EbLockFreeCell *cell;
+
+    for (;;) {
+        cell               = &queue_ptr->ring[pos & queue_ptr->ring_mask];
+        const int32_t diff = (int32_t)(svt_atomic_load_u32(&cell->sequence) - pos);
+        if (diff == 0 && svt_atomic_cas_u32(&queue_ptr->enqueue_pos, pos, pos + 1))
+            break;
+        assert(diff >= 0);
+        pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+    }
+    cell->wrapper_ptr = wrapper_ptr;
+    // Publish the slot to the consumers
+    svt_atomic_store_u32(&cell->sequence, pos + 1);
+}
+
+/**************************************
+ * svt_lockfree_ring_pop
+ *   Bounded MPMC ring pop, returns NULL
+ *   when no slot is ready yet
+ **************************************/
+static EbObjectWrapper *svt_lockfree_ring_pop(EbMuxingQueue *queue_ptr) {
+    uint32_t        pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+    EbLockFreeCell *cell;
+
+    for (;;) {
+        cell               = &queue_ptr->ring[pos & queue_ptr->ring_mask];
+        const int32_t diff = (int32_t)(svt_atomic_load_u32(&cell->sequence) - (pos + 1));
+        if (diff < 0)
+            return (EbObjectWrapper *)NULL;
+        if (diff == 0 && svt_atomic_cas_u32(&queue_ptr->dequeue_pos, pos, pos + 1))
+            break;
+        pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+    }
+    EbObjectWrapper *wrapper_ptr = cell->wrapper_ptr;
+    // Hand the slot back to the producer of the next lap
+    svt_atomic_store_u32(&cell->sequence, pos + queue_ptr->ring_mask + 1);
+    return wrapper_ptr;
+}
+
+/**************************************
+ * svt_lockfree_post
+ *   Queues an object and wakes a parked process if any
+ **************************************/
+static void svt_lockfree_post(EbMuxingQueue *queue_ptr, EbObjectWrapper *wrapper_ptr) {
+    svt_lockfree_ring_push(queue_ptr, wrapper_ptr);
+    if (svt_atomic_fetch_add_i32(&queue_ptr->ready_count, 1) < 0)
+        svt_post_semaphore(queue_ptr->ready_semaphore);
+}
+
+/**************************************
+ * svt_lockfree_try_wait
+ *   Takes one ready count if available
+ **************************************/
+static Bool svt_lockfree_try_wait(EbMuxingQueue *queue_ptr) {
+    int32_t count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&queue_ptr->ready_count);
+    while (count > 0) {
+        if (svt_atomic_cas_u32((volatile uint32_t *)&queue_ptr->ready_count, (uint32_t)count, (uint32_t)(count - 1)))
+            return TRUE;
+        count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&queue_ptr->ready_count);
+    }
+    return FALSE;
+}
+
+/**************************************
+ * svt_lockfree_wait
+ *   Spins for a ready count then parks on the
+ *   ready_semaphore, so handoffs between busy
+ *   stages do not go through the kernel
+ **************************************/
+static void svt_lockfree_wait(EbMuxingQueue *queue_ptr) {
+    for (uint32_t spin = 0; spin < LOCKFREE_FIFO_SPIN_COUNT; spin++) {
+        if (svt_lockfree_try_wait(queue_ptr))
+            return;
+        svt_cpu_pause();
+    }
+    if (svt_atomic_fetch_add_i32(&queue_ptr->ready_count, -1) <= 0)
+        svt_block_on_semaphore(queue_ptr->ready_semaphore);
+}
+
+/**************************************
+ * svt_lockfree_get
+ *   Dequeues the object reserved by a wait, it
+ *   may still be in flight from its producer
+ **************************************/
+static EbObjectWrapper *svt_lockfree_get(EbMuxingQueue *queue_ptr) {
+    EbObjectWrapper *wrapper_ptr;
+    while ((wrapper_ptr = svt_lockfree_ring_pop(queue_ptr)) == NULL) svt_cpu_pause();
+    return wrapper_ptr;
+}
+#endif
 
 void svt_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
@@ -189,6 +299,10 @@ void svt_muxing_queue_dctor(EbPtr p) {
     EB_DELETE(obj->object_queue);
     EB_DELETE(obj->process_queue);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
+#if LOCKFREE_FIFO
+    EB_FREE_ARRAY(obj->ring);
+    EB_DESTROY_SEMAPHORE(obj->ready_semaphore);
+#endif
 }
 
 /**************************************
@@ -205,10 +319,25 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
 
+#if LOCKFREE_FIFO
+    // Construct the Ring, the cell of position i starts free for the i-th push
+    uint32_t ring_size = 2;
+    while (ring_size < object_total_count) ring_size <<= 1;
+    queue_ptr->ring_mask = ring_size - 1;
+    EB_MALLOC_ARRAY(queue_ptr->ring, ring_size);
+    for (uint32_t cell_index = 0; cell_index < ring_size; ++cell_index) {
+        queue_ptr->ring[cell_index].sequence    = cell_index;
+        queue_ptr->ring[cell_index].wrapper_ptr = (EbObjectWrapper *)NULL;
+    }
+    // The posts are not bounded by the parked processes (shutdown posts, posts racing a wake-up), and on
+    // Windows a post over the maximum fails and loses the wake-up, so the maximum is left unbounded
+    EB_CREATE_SEMAPHORE(queue_ptr->ready_semaphore, 0, INT32_MAX);
+#else
     // Construct Object Circular Buffer
     EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
     // Construct Process Circular Buffer
     EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
+#endif
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
@@ -225,6 +354,7 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
     return return_error;
 }
 
+#if !LOCKFREE_FIFO
 /**************************************
  * svt_muxing_queue_assignation
  **************************************/
@@ -257,6 +387,7 @@ static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
 
     return return_error;
 }
+#endif
 
 /**************************************
  * svt_muxing_queue_object_push_back
@@ -264,9 +395,13 @@ static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
 static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCKFREE_FIFO
+    svt_lockfree_post(queue_ptr, object_ptr);
+#else
     svt_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
 
     svt_muxing_queue_assignation(queue_ptr);
+#endif
 
     return return_error;
 }
@@ -277,9 +412,14 @@ static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, E
 static EbErrorType svt_muxing_queue_object_push_front(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCKFREE_FIFO
+    // The ring has no front, empty objects are interchangeable so queue it last
+    svt_lockfree_post(queue_ptr, object_ptr);
+#else
     svt_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
 
     svt_muxing_queue_assignation(queue_ptr);
+#endif
 
     return return_error;
 }
@@ -496,16 +636,44 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
     return svt_muxing_queue_get_fifo(resource_ptr->full_queue, index);
 }
 
+void svt_system_resource_set_worker_tokens(const EbSystemResource *resource_ptr, EbHandle worker_tokens) {
+    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+        svt_system_resource_get_consumer_fifo(resource_ptr, i)->worker_tokens = worker_tokens;
+}
+
+void svt_system_resource_set_profile(const EbSystemResource *resource_ptr, struct EbThreadProfile *thread_profiles) {
+    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+        svt_system_resource_get_consumer_fifo(resource_ptr, i)->profile = &thread_profiles[i];
+}
+
+void svt_yield_worker_token(void) {
+    if (held_worker_token)
+        svt_post_semaphore(held_worker_token);
+}
+
+void svt_resume_worker_token(void) {
+    if (held_worker_token)
+        svt_block_on_semaphore(held_worker_token);
+}
+
 EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     //not fully constructed
     if (!resource_ptr || !resource_ptr->full_queue)
         return EB_ErrorNone;
 
+#if LOCKFREE_FIFO
+    //notify all consumers we are shutting down, the flag is set before any of them wakes up
+    svt_atomic_store_u32(&resource_ptr->full_queue->quit_signal, TRUE);
+    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+        if (svt_atomic_fetch_add_i32(&resource_ptr->full_queue->ready_count, 1) < 0)
+            svt_post_semaphore(resource_ptr->full_queue->ready_semaphore);
+#else
     //notify all consumers we are shutting down
     for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++) {
         EbFifo *fifo_ptr = svt_system_resource_get_consumer_fifo(resource_ptr, i);
         svt_fifo_shutdown(fifo_ptr);
     }
+#endif
     return EB_ErrorNone;
 }
 
@@ -515,6 +683,10 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
 static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCKFREE_FIFO
+    // Processes are not queued, the ring serves whichever process waits first
+    UNUSED(process_fifo_ptr);
+#else
     svt_block_on_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
 
     svt_circular_buffer_push_front(process_fifo_ptr->queue_ptr->process_queue, process_fifo_ptr);
@@ -522,6 +694,7 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
     svt_muxing_queue_assignation(process_fifo_ptr->queue_ptr);
 
     svt_release_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
+#endif
 
     return return_error;
 }
@@ -543,11 +716,15 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCKFREE_FIFO
+    svt_lockfree_post(object_ptr->system_resource_ptr->full_queue, object_ptr);
+#else
     svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
 
     svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
 
     svt_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+#endif
 
     return return_error;
 }
@@ -577,6 +754,10 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
+        if (object_ptr->system_resource_ptr->release_cb)
+            object_ptr->system_resource_ptr->release_cb(object_ptr->object_ptr,
+                                                        object_ptr->system_resource_ptr->release_data);
+
         svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
 #if SRM_REPORT
         object_ptr->pic_number = 99999999;
@@ -609,6 +790,10 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
+        if (object_ptr->system_resource_ptr->release_cb)
+            object_ptr->system_resource_ptr->release_cb(object_ptr->object_ptr,
+                                                        object_ptr->system_resource_ptr->release_data);
+
         svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
 
 #if SRM_REPORT
@@ -665,13 +850,23 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
     svt_release_process(empty_fifo_ptr);
 
     // Block on the counting Semaphore until an empty buffer is available
+    svt_yield_worker_token();
+#if LOCKFREE_FIFO
+    svt_lockfree_wait(empty_fifo_ptr->queue_ptr);
+#else
     svt_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
+#endif
+    svt_resume_worker_token();
 
     // Acquire lockout Mutex
     svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
 
     // Get the empty object
+#if LOCKFREE_FIFO
+    *wrapper_dbl_ptr = svt_lockfree_get(empty_fifo_ptr->queue_ptr);
+#else
     svt_fifo_pop_front(empty_fifo_ptr, wrapper_dbl_ptr);
+#endif
 
 #if SRM_REPORT
     //decrement the fullness
@@ -716,10 +911,25 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    // The task of the calling kernel ends here
+    svt_aom_profile_wait(full_fifo_ptr->profile);
+
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
 
     // Block on the counting Semaphore until an empty buffer is available
+    svt_yield_worker_token();
+    held_worker_token = NULL;
+#if LOCKFREE_FIFO
+    svt_lockfree_wait(full_fifo_ptr->queue_ptr);
+
+    if (!svt_atomic_load_u32(&full_fifo_ptr->queue_ptr->quit_signal)) {
+        *wrapper_dbl_ptr = svt_lockfree_get(full_fifo_ptr->queue_ptr);
+    } else {
+        *wrapper_dbl_ptr = NULL;
+        return_error     = EB_NoErrorFifoShutdown;
+    }
+#else
     svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
 
     // Acquire lockout Mutex
@@ -734,10 +944,19 @@ EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper
 
     // Release Mutex
     svt_release_mutex(full_fifo_ptr->lockout_mutex);
+#endif
+
+    // Wait for a free core before processing the object
+    if (return_error == EB_ErrorNone) {
+        held_worker_token = full_fifo_ptr->worker_tokens;
+        svt_resume_worker_token();
+        svt_aom_profile_run(full_fifo_ptr->profile);
+    }
 
     return return_error;
 }
 
+#if !LOCKFREE_FIFO
 /**************************************
 * svt_fifo_pop_front
 **************************************/
@@ -748,10 +967,18 @@ static Bool svt_fifo_peak_front(EbFifo *fifoPtr) {
     else
         return FALSE;
 }
+#endif
 
 EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
-    Bool        fifo_empty;
+#if LOCKFREE_FIFO
+    //if the fifo is shutting down, we will not give any buffer to caller
+    if (!svt_atomic_load_u32(&full_fifo_ptr->queue_ptr->quit_signal) && svt_lockfree_try_wait(full_fifo_ptr->queue_ptr))
+        *wrapper_dbl_ptr = svt_lockfree_get(full_fifo_ptr->queue_ptr);
+    else
+        *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
+#else
+    Bool fifo_empty;
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
 
@@ -771,6 +998,7 @@ EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrap
         svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr);
     else
         *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
+#endif
 
     return return_error;
 }
@@ -88,6 +88,16 @@ typedef struct EbFifo {
     // queue_ptr - pointer to MuxingQueue that the EbFifo is
     //   associated with.
     struct EbMuxingQueue *queue_ptr;
+
+    // worker_tokens - optional counting semaphore shared by the kernels
+    //   of an encoder. A kernel thread takes a token when it gets a full
+    //   object from this EbFifo and gives it back while it is blocked, so
+    //   that at most token count threads are running at any time.
+    EbHandle worker_tokens;
+
+    // profile - optional profile of the kernel thread consuming this
+    //   EbFifo, timed from svt_get_full_object.
+    struct EbThreadProfile *profile;
 } EbFifo;
 
 /*********************************************************************
@@ -102,6 +112,19 @@ typedef struct EbCircularBuffer {
     uint32_t current_count;
 } EbCircularBuffer;
 
+#if LOCKFREE_FIFO
+/*********************************************************************
+     * LockFreeCell
+     *   Slot of the bounded MPMC ring used by the MuxingQueue when
+     *   LOCKFREE_FIFO is set. sequence tells whether the slot is free
+     *   for the producer of a position or ready for its consumer.
+     *********************************************************************/
+typedef struct EbLockFreeCell {
+    volatile uint32_t sequence;
+    EbObjectWrapper  *wrapper_ptr;
+} EbLockFreeCell;
+#endif
+
 /*********************************************************************
      * MuxingQueue
      *********************************************************************/
@@ -112,6 +135,19 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo          **process_fifo_ptr_array;
+#if LOCKFREE_FIFO
+    // ring - power of two sized ring shared by all the process fifos,
+    //   objects go to whichever process dequeues first.
+    EbLockFreeCell   *ring;
+    uint32_t          ring_mask;
+    volatile uint32_t enqueue_pos;
+    volatile uint32_t dequeue_pos;
+    // ready_count - objects in the ring minus the processes parked on
+    //   ready_semaphore. A process spins on it before it parks.
+    volatile int32_t  ready_count;
+    EbHandle          ready_semaphore;
+    volatile uint32_t quit_signal;
+#endif
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -142,6 +178,13 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // release_cb - optional hook called with the object and release_data
+    //   when the last live reference to it is released, right before the
+    //   object goes back to the empty FIFO. It runs under the empty FIFO's
+    //   lockout_mutex and must not get or release objects of this resource.
+    void (*release_cb)(EbPtr object_ptr, EbPtr release_data);
+    EbPtr release_data;
 } EbSystemResource;
 
 /*********************************************************************
@@ -326,6 +369,44 @@ extern EbErrorType svt_release_object(EbObjectWrapper *object_ptr);
      *********************************************************************/
 extern EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr);
 
+/*********************************************************************
+     * svt_system_resource_set_worker_tokens
+     *   Makes the consumers of the SystemResource share worker_tokens.
+     *   Only to be used on resources consumed by kernel threads, never
+     *   on the ones read by the API caller.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *
+     *   worker_tokens
+     *      counting semaphore holding one token per core, or NULL.
+     *********************************************************************/
+extern void svt_system_resource_set_worker_tokens(const EbSystemResource *resource_ptr, EbHandle worker_tokens);
+
+/*********************************************************************
+     * svt_system_resource_set_profile
+     *   Makes consumer i of the SystemResource record its busy and
+     *   blocked time in thread_profiles[i].
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *
+     *   thread_profiles
+     *      one profile per consumer process.
+     *********************************************************************/
+extern void svt_system_resource_set_profile(const EbSystemResource *resource_ptr,
+                                            struct EbThreadProfile *thread_profiles);
+
+/*********************************************************************
+     * svt_yield_worker_token / svt_resume_worker_token
+     *   Gives back / takes again the worker token of the calling kernel
+     *   thread, if any. To be wrapped around any wait on a semaphore
+     *   that another kernel posts, so a blocked thread never keeps a
+     *   core from the thread it waits on.
+     *********************************************************************/
+extern void svt_yield_worker_token(void);
+extern void svt_resume_worker_token(void);
+
 #define EB_GET_FULL_OBJECT(full_fifo_ptr, wrapper_dbl_ptr)                     \
     do {                                                                       \
         EbErrorType err = svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr); \
@@ -40,6 +40,7 @@
 
 #include "pd_results.h"
 #include "utility.h"
+#include "svt_threads.h"
 
 static const uint32_t subblock_xy_16x16[N_16X16_BLOCKS][2] = {{0, 0},
                                                               {0, 1},
@@ -2769,14 +2770,27 @@ static void set_hme_search_params_mctf(MeContext *ctx, uint8_t hme_search_level)
     }
 
 }
+/*
+ * Claim the next 64x64 block of the central picture to filter. The tasks of a picture take the
+ * blocks from a shared counter in raster order rather than owning a fixed segment, so a task
+ * running on a busy core or on costly content does not hold back the completion of the picture.
+ */
+static Bool tf_claim_block(PictureParentControlSet *centre_pcs, uint32_t blk_cols, uint32_t blk_rows,
+                           uint32_t *blk_row, uint32_t *blk_col) {
+    const int32_t blk_idx = svt_atomic_fetch_add_i32(&centre_pcs->tf_next_blk, 1);
+    if (blk_idx >= (int32_t)(blk_cols * blk_rows))
+        return FALSE;
+    *blk_row = (uint32_t)blk_idx / blk_cols;
+    *blk_col = (uint32_t)blk_idx % blk_cols;
+    return TRUE;
+}
 // Produce the filtered alt-ref picture
 // - core function
 static EbErrorType produce_temporally_filtered_pic(
     PictureParentControlSet **pcs_list,
     EbPictureBufferDesc **list_input_picture_ptr, uint8_t index_center,
     MotionEstimationContext_t *me_context_ptr,
-    const int32_t *noise_levels_log1p_fp16,
-    int32_t segment_index, Bool is_highbd) {
+    const int32_t *noise_levels_log1p_fp16, Bool is_highbd) {
     DECLARE_ALIGNED(16, uint32_t, accumulator[BLK_PELS * COLOR_CHANNELS]);
     DECLARE_ALIGNED(16, uint16_t, counter[BLK_PELS * COLOR_CHANNELS]);
     uint32_t *accum[COLOR_CHANNELS] = {
@@ -2817,22 +2831,6 @@ static EbErrorType produce_temporally_filtered_pic(
                                        input_picture_ptr_central->stride_cb,
                                        input_picture_ptr_central->stride_cr};
     uint32_t stride_pred[COLOR_CHANNELS] = {BW, blk_width_ch, blk_width_ch};
-    uint32_t x_seg_idx;
-    uint32_t y_seg_idx;
-    uint32_t picture_width_in_b64  = blk_cols;
-    uint32_t picture_height_in_b64 = blk_rows;
-    SEGMENT_CONVERT_IDX_TO_XY(segment_index,
-                              x_seg_idx,
-                              y_seg_idx,
-                              centre_pcs->tf_segments_column_count);
-    uint32_t x_b64_start_idx = SEGMENT_START_IDX(
-        x_seg_idx, picture_width_in_b64, centre_pcs->tf_segments_column_count);
-    uint32_t x_b64_end_idx = SEGMENT_END_IDX(
-        x_seg_idx, picture_width_in_b64, centre_pcs->tf_segments_column_count);
-    uint32_t y_b64_start_idx = SEGMENT_START_IDX(
-        y_seg_idx, picture_height_in_b64, centre_pcs->tf_segments_row_count);
-    uint32_t y_b64_end_idx = SEGMENT_END_IDX(
-        y_seg_idx, picture_height_in_b64, centre_pcs->tf_segments_row_count);
 
     // first position of the frame buffer according to the index center
     EbByte src_center_ptr_start[COLOR_CHANNELS] = {
@@ -2998,276 +2996,294 @@ static EbErrorType produce_temporally_filtered_pic(
                     decay_control[C_V], const_0dot7_fp16, noise_levels_log1p_fp16, tf_shift_factor, ctx->tf_chroma);
             }
         }
-    for (uint32_t blk_row = y_b64_start_idx; blk_row < y_b64_end_idx; blk_row++) {
-        for (uint32_t blk_col = x_b64_start_idx; blk_col < x_b64_end_idx; blk_col++) {
-            int blk_y_src_offset  = (blk_col * BW) + (blk_row * BH) * stride[C_Y];
-            int blk_ch_src_offset = (blk_col * blk_width_ch) +
-                (blk_row * blk_height_ch) * stride[C_U];
-
-            // reset accumulator and count
-            memset(accumulator, 0, BLK_PELS * COLOR_CHANNELS * sizeof(accumulator[0]));
-            memset(counter, 0, BLK_PELS * COLOR_CHANNELS * sizeof(counter[0]));
-
-            EbByte    src_center_ptr[COLOR_CHANNELS]           = {NULL};
-            uint16_t *altref_buffer_highbd_ptr[COLOR_CHANNELS] = {NULL};
-            // Prep 8bit source if 8bit content or using 8bit for subpel
-            if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel) {
-                src_center_ptr[C_Y] = src_center_ptr_start[C_Y] + blk_y_src_offset;
-                if (ctx->tf_chroma) {
-                    src_center_ptr[C_U] = src_center_ptr_start[C_U] + blk_ch_src_offset;
-                    src_center_ptr[C_V] = src_center_ptr_start[C_V] + blk_ch_src_offset;
-                }
+    uint32_t blk_row, blk_col;
+    while (tf_claim_block(centre_pcs, blk_cols, blk_rows, &blk_row, &blk_col)) {
+        int blk_y_src_offset  = (blk_col * BW) + (blk_row * BH) * stride[C_Y];
+        int blk_ch_src_offset = (blk_col * blk_width_ch) +
+            (blk_row * blk_height_ch) * stride[C_U];
+
+        // reset accumulator and count
+        memset(accumulator, 0, BLK_PELS * COLOR_CHANNELS * sizeof(accumulator[0]));
+        memset(counter, 0, BLK_PELS * COLOR_CHANNELS * sizeof(counter[0]));
+
+        EbByte    src_center_ptr[COLOR_CHANNELS]           = {NULL};
+        uint16_t *altref_buffer_highbd_ptr[COLOR_CHANNELS] = {NULL};
+        // Prep 8bit source if 8bit content or using 8bit for subpel
+        if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel) {
+            src_center_ptr[C_Y] = src_center_ptr_start[C_Y] + blk_y_src_offset;
+            if (ctx->tf_chroma) {
+                src_center_ptr[C_U] = src_center_ptr_start[C_U] + blk_ch_src_offset;
+                src_center_ptr[C_V] = src_center_ptr_start[C_V] + blk_ch_src_offset;
             }
+        }
 
-            if (is_highbd) {
-                altref_buffer_highbd_ptr[C_Y] = altref_buffer_highbd_start[C_Y] + blk_y_src_offset;
-                if (ctx->tf_chroma) {
-                    altref_buffer_highbd_ptr[C_U] = altref_buffer_highbd_start[C_U] +
-                        blk_ch_src_offset;
-                    altref_buffer_highbd_ptr[C_V] = altref_buffer_highbd_start[C_V] +
-                        blk_ch_src_offset;
-                }
+        if (is_highbd) {
+            altref_buffer_highbd_ptr[C_Y] = altref_buffer_highbd_start[C_Y] + blk_y_src_offset;
+            if (ctx->tf_chroma) {
+                altref_buffer_highbd_ptr[C_U] = altref_buffer_highbd_start[C_U] +
+                    blk_ch_src_offset;
+                altref_buffer_highbd_ptr[C_V] = altref_buffer_highbd_start[C_V] +
+                    blk_ch_src_offset;
             }
+        }
 
-            if (!is_highbd)
-                apply_filtering_central(ctx,
-                                        input_picture_ptr_central,
-                                        src_center_ptr,
-                                        accum,
-                                        count,
-                                        BW,
-                                        BH,
-                                        ss_x,
-                                        ss_y);
-            else
-                apply_filtering_central_highbd(ctx,
-                                               input_picture_ptr_central,
-                                               altref_buffer_highbd_ptr,
-                                               accum,
-                                               count,
-                                               BW,
-                                               BH,
-                                               ss_x,
-                                               ss_y);
-
-            // 1st segment: past pics - from closest to farthest
-            // 2nd segment: current pic
-            // 3rd segment: future pics - from closest to farthest
-
-            int start_frame_index[3] =
-            { 0,
-              centre_pcs->past_altref_nframes ,
-              centre_pcs->past_altref_nframes + 1 };
-
-            int end_frame_index[3] =
-            { centre_pcs->past_altref_nframes - 1,
-              centre_pcs->past_altref_nframes ,
-              centre_pcs->past_altref_nframes + centre_pcs->future_altref_nframes };
-
-            for (int segment_idx = 0; segment_idx < 3; segment_idx++)
-                for (int frame_index = start_frame_index[segment_idx]; frame_index <= end_frame_index[segment_idx]; frame_index = frame_index+ me_context_ptr->me_ctx->tf_ctrls.ref_frame_factor) {
-                // Use ahd-error to central/avg to identify/skip outlier ref-frame(s)
-                if (frame_index != index_center) {
-                    uint32_t low_ahd_err = centre_pcs->aligned_width * centre_pcs->aligned_height;
-                    uint8_t th = (centre_pcs->slice_type == I_SLICE) ? 20 : 40;
-                    if (pcs_list[frame_index]->tf_ahd_error_to_central > low_ahd_err && // error to central high enough
-                       ((int) (((int) pcs_list[frame_index]->tf_ahd_error_to_central - (int) centre_pcs->tf_avg_ahd_error) * 100)) > (th * (int) centre_pcs->tf_avg_ahd_error)) // ahd_error_to_central higher than tf_avg_ahd_error by x%
-                        continue;
-
-
-                    uint32_t bright_change_region_cnt = 0;
-                    for (uint32_t region_in_picture_width_index = 0;
-                        region_in_picture_width_index < scs->picture_analysis_number_of_regions_per_width;
-                        region_in_picture_width_index++) { // loop over horizontal regions
-                        for (uint32_t region_in_picture_height_index = 0;
-                            region_in_picture_height_index < scs->picture_analysis_number_of_regions_per_height;
-                            region_in_picture_height_index++) { // loop over vertical regions
-
-                            if (ABS((int)pcs_list[frame_index]->average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index] -
-                                (int)centre_pcs->average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index]) > 2 &&
-                                pcs_list[frame_index]->avg_luma != centre_pcs->tf_avg_luma) {
-                                bright_change_region_cnt++;
-                            }
+        if (!is_highbd)
+            apply_filtering_central(ctx,
+                                    input_picture_ptr_central,
+                                    src_center_ptr,
+                                    accum,
+                                    count,
+                                    BW,
+                                    BH,
+                                    ss_x,
+                                    ss_y);
+        else
+            apply_filtering_central_highbd(ctx,
+                                           input_picture_ptr_central,
+                                           altref_buffer_highbd_ptr,
+                                           accum,
+                                           count,
+                                           BW,
+                                           BH,
+                                           ss_x,
+                                           ss_y);
+
+        // 1st segment: past pics - from closest to farthest
+        // 2nd segment: current pic
+        // 3rd segment: future pics - from closest to farthest
+
+        int start_frame_index[3] =
+        { 0,
+          centre_pcs->past_altref_nframes ,
+          centre_pcs->past_altref_nframes + 1 };
+
+        int end_frame_index[3] =
+        { centre_pcs->past_altref_nframes - 1,
+          centre_pcs->past_altref_nframes ,
+          centre_pcs->past_altref_nframes + centre_pcs->future_altref_nframes };
+
+        for (int segment_idx = 0; segment_idx < 3; segment_idx++)
+            for (int frame_index = start_frame_index[segment_idx]; frame_index <= end_frame_index[segment_idx]; frame_index = frame_index+ me_context_ptr->me_ctx->tf_ctrls.ref_frame_factor) {
+            // Use ahd-error to central/avg to identify/skip outlier ref-frame(s)
+            if (frame_index != index_center) {
+                uint32_t low_ahd_err = centre_pcs->aligned_width * centre_pcs->aligned_height;
+                uint8_t th = (centre_pcs->slice_type == I_SLICE) ? 20 : 40;
+                if (pcs_list[frame_index]->tf_ahd_error_to_central > low_ahd_err && // error to central high enough
+                   ((int) (((int) pcs_list[frame_index]->tf_ahd_error_to_central - (int) centre_pcs->tf_avg_ahd_error) * 100)) > (th * (int) centre_pcs->tf_avg_ahd_error)) // ahd_error_to_central higher than tf_avg_ahd_error by x%
+                    continue;
+
+
+                uint32_t bright_change_region_cnt = 0;
+                for (uint32_t region_in_picture_width_index = 0;
+                    region_in_picture_width_index < scs->picture_analysis_number_of_regions_per_width;
+                    region_in_picture_width_index++) { // loop over horizontal regions
+                    for (uint32_t region_in_picture_height_index = 0;
+                        region_in_picture_height_index < scs->picture_analysis_number_of_regions_per_height;
+                        region_in_picture_height_index++) { // loop over vertical regions
+
+                        if (ABS((int)pcs_list[frame_index]->average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index] -
+                            (int)centre_pcs->average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index]) > 2 &&
+                            pcs_list[frame_index]->avg_luma != centre_pcs->tf_avg_luma) {
+                            bright_change_region_cnt++;
                         }
                     }
-                    if (bright_change_region_cnt >= ((14*scs->picture_analysis_number_of_regions_per_width * scs->picture_analysis_number_of_regions_per_height) / 16))
-                        continue;
                 }
-                // ------------
-                // Step 1: motion estimation + compensation
-                // ------------
-                me_context_ptr->me_ctx->tf_frame_index  = frame_index;
-                me_context_ptr->me_ctx->tf_index_center = index_center;
-                if (frame_index != index_center) {
-                    // Initialize ME context
-                    create_me_context_and_picture_control(
-                        me_context_ptr,
+                if (bright_change_region_cnt >= ((14*scs->picture_analysis_number_of_regions_per_width * scs->picture_analysis_number_of_regions_per_height) / 16))
+                    continue;
+            }
+            // ------------
+            // Step 1: motion estimation + compensation
+            // ------------
+            me_context_ptr->me_ctx->tf_frame_index  = frame_index;
+            me_context_ptr->me_ctx->tf_index_center = index_center;
+            if (frame_index != index_center) {
+                // Initialize ME context
+                create_me_context_and_picture_control(
+                    me_context_ptr,
+                    pcs_list[frame_index],
+                    pcs_list[index_center],
+                    input_picture_ptr_central,
+                    blk_row,
+                    blk_col,
+                    ss_x,
+                    ss_y);
+                ctx->num_of_list_to_search = 1;
+                ctx->num_of_ref_pic_to_search[0] = 1;
+                ctx->num_of_ref_pic_to_search[1] = 0;
+                ctx->temporal_layer_index =
+                    centre_pcs->temporal_layer_index;
+                ctx->is_ref =
+                    centre_pcs->is_ref;
+
+                EbPaReferenceObject *ref_object = (EbPaReferenceObject *)
+                                                            ctx->alt_ref_reference_ptr;
+                ctx->me_ds_ref_array[0][0].picture_ptr =
+                    ref_object->input_padded_pic;
+                ctx->me_ds_ref_array[0][0].sixteenth_picture_ptr =
+                    ref_object->sixteenth_downsampled_picture_ptr;
+                ctx->me_ds_ref_array[0][0].quarter_picture_ptr =
+                    ref_object->quarter_downsampled_picture_ptr;
+                ctx->me_ds_ref_array[0][0].picture_number =
+                    ref_object->picture_number;
+                ctx->tf_me_exit_th =
+                    centre_pcs->tf_ctrls.me_exit_th;
+                ;
+                ctx->tf_use_pred_64x64_only_th =
+                    centre_pcs->tf_ctrls.use_pred_64x64_only_th;
+                ctx->tf_subpel_early_exit_th =
+                    centre_pcs->tf_ctrls.subpel_early_exit_th;
+                // Perform ME - context_ptr will store the outputs (MVs, buffers, etc)
+                // Block-based MC using open-loop HME + refinement
+                // set default hme search params
+                set_hme_search_params_mctf(ctx,0);
+                svt_aom_motion_estimation_b64(centre_pcs,
+                    (uint32_t)blk_row * blk_cols + blk_col,
+                    (uint32_t)blk_col * BW, // x block
+                    (uint32_t)blk_row * BH, // y block
+                    ctx,
+                    input_picture_ptr_central); // source picture
+
+
+                if (ctx->tf_use_pred_64x64_only_th &&
+                    (ctx->tf_use_pred_64x64_only_th == (uint8_t)~0 ||
+                     tf_use_64x64_pred(ctx))) {
+                    tf_64x64_sub_pel_search(
+                        centre_pcs,
+                        ctx,
                         pcs_list[frame_index],
-                        pcs_list[index_center],
-                        input_picture_ptr_central,
-                        blk_row,
-                        blk_col,
+                        list_input_picture_ptr[frame_index],
+                        pred,
+                        pred_16bit,
+                        stride_pred,
+                        src_center_ptr,
+                        altref_buffer_highbd_ptr,
+                        stride,
+                        (uint32_t)blk_col * BW,
+                        (uint32_t)blk_row * BH,
                         ss_x,
-                        ss_y);
-                    ctx->num_of_list_to_search = 1;
-                    ctx->num_of_ref_pic_to_search[0] = 1;
-                    ctx->num_of_ref_pic_to_search[1] = 0;
-                    ctx->temporal_layer_index =
-                        centre_pcs->temporal_layer_index;
-                    ctx->is_ref =
-                        centre_pcs->is_ref;
-
-                    EbPaReferenceObject *ref_object = (EbPaReferenceObject *)
-                                                                ctx->alt_ref_reference_ptr;
-                    ctx->me_ds_ref_array[0][0].picture_ptr =
-                        ref_object->input_padded_pic;
-                    ctx->me_ds_ref_array[0][0].sixteenth_picture_ptr =
-                        ref_object->sixteenth_downsampled_picture_ptr;
-                    ctx->me_ds_ref_array[0][0].quarter_picture_ptr =
-                        ref_object->quarter_downsampled_picture_ptr;
-                    ctx->me_ds_ref_array[0][0].picture_number =
-                        ref_object->picture_number;
-                    ctx->tf_me_exit_th =
-                        centre_pcs->tf_ctrls.me_exit_th;
-                    ;
-                    ctx->tf_use_pred_64x64_only_th =
-                        centre_pcs->tf_ctrls.use_pred_64x64_only_th;
-                    ctx->tf_subpel_early_exit_th =
-                        centre_pcs->tf_ctrls.subpel_early_exit_th;
-                    // Perform ME - context_ptr will store the outputs (MVs, buffers, etc)
-                    // Block-based MC using open-loop HME + refinement
-                    // set default hme search params
-                    set_hme_search_params_mctf(ctx,0);
-                    svt_aom_motion_estimation_b64(centre_pcs,
-                        (uint32_t)blk_row * blk_cols + blk_col,
-                        (uint32_t)blk_col * BW, // x block
-                        (uint32_t)blk_row * BH, // y block
-                        ctx,
-                        input_picture_ptr_central); // source picture
-
+                        (ctx->tf_ctrls.use_8bit_subpel) ? EB_EIGHT_BIT : encoder_bit_depth);
 
-                    if (ctx->tf_use_pred_64x64_only_th &&
-                        (ctx->tf_use_pred_64x64_only_th == (uint8_t)~0 ||
-                         tf_use_64x64_pred(ctx))) {
-                        tf_64x64_sub_pel_search(
-                            centre_pcs,
-                            ctx,
-                            pcs_list[frame_index],
-                            list_input_picture_ptr[frame_index],
+                    // Perform MC using the information acquired using the ME step
+                    tf_64x64_inter_prediction(centre_pcs,
+                                              ctx,
+                                              pcs_list[frame_index],
+                                              list_input_picture_ptr[frame_index],
+                                              pred,
+                                              pred_16bit,
+                                              (uint32_t)blk_col * BW,
+                                              (uint32_t)blk_row * BH,
+                                              ss_x,
+                                              encoder_bit_depth);
+                        convert_64x64_info_to_32x32_info(centre_pcs, ctx,
                             pred,
                             pred_16bit,
                             stride_pred,
                             src_center_ptr,
                             altref_buffer_highbd_ptr,
                             stride,
-                            (uint32_t)blk_col * BW,
-                            (uint32_t)blk_row * BH,
-                            ss_x,
-                            (ctx->tf_ctrls.use_8bit_subpel) ? EB_EIGHT_BIT : encoder_bit_depth);
+                            is_highbd);
+                }
+                else {
+                    // 64x64 Sub-Pel search
+                    tf_64x64_sub_pel_search(
+                        centre_pcs,
+                        ctx,
+                        pcs_list[frame_index],
+                        list_input_picture_ptr[frame_index],
+                        pred,
+                        pred_16bit,
+                        stride_pred,
+                        src_center_ptr,
+                        altref_buffer_highbd_ptr,
+                        stride,
+                        (uint32_t)blk_col* BW,
+                        (uint32_t)blk_row* BH,
+                        ss_x,
+                        (ctx->tf_ctrls.use_8bit_subpel) ? EB_EIGHT_BIT : encoder_bit_depth);
 
-                        // Perform MC using the information acquired using the ME step
-                        tf_64x64_inter_prediction(centre_pcs,
-                                                  ctx,
-                                                  pcs_list[frame_index],
-                                                  list_input_picture_ptr[frame_index],
-                                                  pred,
-                                                  pred_16bit,
-                                                  (uint32_t)blk_col * BW,
-                                                  (uint32_t)blk_row * BH,
-                                                  ss_x,
-                                                  encoder_bit_depth);
-                            convert_64x64_info_to_32x32_info(centre_pcs, ctx,
+                    // 32x32 Sub-Pel search
+                    for (int block_row = 0; block_row < 2; block_row++) {
+                        for (int block_col = 0; block_col < 2; block_col++) {
+
+                            ctx->idx_32x32 = block_col + (block_row << 1);
+
+                            tf_32x32_sub_pel_search(centre_pcs,
+                                ctx,
+                                pcs_list[frame_index],
+                                list_input_picture_ptr[frame_index],
                                 pred,
                                 pred_16bit,
                                 stride_pred,
                                 src_center_ptr,
                                 altref_buffer_highbd_ptr,
                                 stride,
-                                is_highbd);
+                                (uint32_t)blk_col * BW,
+                                (uint32_t)blk_row * BH,
+                                ss_x,
+                                (ctx->tf_ctrls.use_8bit_subpel)
+                                ? EB_EIGHT_BIT
+                                : encoder_bit_depth);
+                        }
                     }
-                    else {
-                        // 64x64 Sub-Pel search
-                        tf_64x64_sub_pel_search(
-                            centre_pcs,
+
+
+                    uint64_t sum_32x32_block_error =
+                        ctx->tf_32x32_block_error[0] +
+                        ctx->tf_32x32_block_error[1] +
+                        ctx->tf_32x32_block_error[2] +
+                        ctx->tf_32x32_block_error[3];
+                    if ((ctx->tf_64x64_block_error * 14 < sum_32x32_block_error * 16) &&
+                        ctx->tf_64x64_block_error < (1 << 18)) {
+
+                        tf_64x64_inter_prediction(centre_pcs,
                             ctx,
                             pcs_list[frame_index],
                             list_input_picture_ptr[frame_index],
                             pred,
                             pred_16bit,
-                            stride_pred,
-                            src_center_ptr,
-                            altref_buffer_highbd_ptr,
-                            stride,
-                            (uint32_t)blk_col* BW,
-                            (uint32_t)blk_row* BH,
+                            (uint32_t)blk_col * BW,
+                            (uint32_t)blk_row * BH,
                             ss_x,
-                            (ctx->tf_ctrls.use_8bit_subpel) ? EB_EIGHT_BIT : encoder_bit_depth);
-
-                        // 32x32 Sub-Pel search
+                            encoder_bit_depth);
+                            convert_64x64_info_to_32x32_info(centre_pcs, ctx,
+                                pred,
+                                pred_16bit,
+                                stride_pred,
+                                src_center_ptr,
+                                altref_buffer_highbd_ptr,
+                                stride,
+                                is_highbd);
+                    }
+                    else {
+                        // 16x16 Sub-Pel search, and 32x32 partitioning
                         for (int block_row = 0; block_row < 2; block_row++) {
                             for (int block_col = 0; block_col < 2; block_col++) {
 
                                 ctx->idx_32x32 = block_col + (block_row << 1);
+                                if (ctx->tf_32x32_block_error[ctx->idx_32x32] < centre_pcs->tf_ctrls.pred_error_32x32_th) {
+                                    ctx->tf_32x32_block_split_flag[ctx->idx_32x32] =
+                                        0;
+                                    memset(&ctx->tf_16x16_block_split_flag[ctx->idx_32x32][0], 0, sizeof(ctx->tf_16x16_block_split_flag[ctx->idx_32x32][0]) * 4);
+                                } else {
+                                    tf_16x16_sub_pel_search(centre_pcs,
+                                        ctx,
+                                        pcs_list[frame_index],
+                                        list_input_picture_ptr[frame_index],
+                                        pred,
+                                        pred_16bit,
+                                        stride_pred,
+                                        src_center_ptr,
+                                        altref_buffer_highbd_ptr,
+                                        stride,
+                                        (uint32_t)blk_col * BW,
+                                        (uint32_t)blk_row * BH,
+                                        ss_x,
+                                        (ctx->tf_ctrls.use_8bit_subpel)
+                                        ? EB_EIGHT_BIT
+                                        : encoder_bit_depth);
 
-                                tf_32x32_sub_pel_search(centre_pcs,
-                                    ctx,
-                                    pcs_list[frame_index],
-                                    list_input_picture_ptr[frame_index],
-                                    pred,
-                                    pred_16bit,
-                                    stride_pred,
-                                    src_center_ptr,
-                                    altref_buffer_highbd_ptr,
-                                    stride,
-                                    (uint32_t)blk_col * BW,
-                                    (uint32_t)blk_row * BH,
-                                    ss_x,
-                                    (ctx->tf_ctrls.use_8bit_subpel)
-                                    ? EB_EIGHT_BIT
-                                    : encoder_bit_depth);
-                            }
-                        }
-
-
-                        uint64_t sum_32x32_block_error =
-                            ctx->tf_32x32_block_error[0] +
-                            ctx->tf_32x32_block_error[1] +
-                            ctx->tf_32x32_block_error[2] +
-                            ctx->tf_32x32_block_error[3];
-                        if ((ctx->tf_64x64_block_error * 14 < sum_32x32_block_error * 16) &&
-                            ctx->tf_64x64_block_error < (1 << 18)) {
-
-                            tf_64x64_inter_prediction(centre_pcs,
-                                ctx,
-                                pcs_list[frame_index],
-                                list_input_picture_ptr[frame_index],
-                                pred,
-                                pred_16bit,
-                                (uint32_t)blk_col * BW,
-                                (uint32_t)blk_row * BH,
-                                ss_x,
-                                encoder_bit_depth);
-                                convert_64x64_info_to_32x32_info(centre_pcs, ctx,
-                                    pred,
-                                    pred_16bit,
-                                    stride_pred,
-                                    src_center_ptr,
-                                    altref_buffer_highbd_ptr,
-                                    stride,
-                                    is_highbd);
-                        }
-                        else {
-                            // 16x16 Sub-Pel search, and 32x32 partitioning
-                            for (int block_row = 0; block_row < 2; block_row++) {
-                                for (int block_col = 0; block_col < 2; block_col++) {
-
-                                    ctx->idx_32x32 = block_col + (block_row << 1);
-                                    if (ctx->tf_32x32_block_error[ctx->idx_32x32] < centre_pcs->tf_ctrls.pred_error_32x32_th) {
-                                        ctx->tf_32x32_block_split_flag[ctx->idx_32x32] =
-                                            0;
-                                        memset(&ctx->tf_16x16_block_split_flag[ctx->idx_32x32][0], 0, sizeof(ctx->tf_16x16_block_split_flag[ctx->idx_32x32][0]) * 4);
-                                    } else {
-                                        tf_16x16_sub_pel_search(centre_pcs,
+                                    if (ctx->tf_ctrls.enable_8x8_pred) {
+                                        tf_8x8_sub_pel_search(centre_pcs,
                                             ctx,
                                             pcs_list[frame_index],
                                             list_input_picture_ptr[frame_index],
@@ -3283,84 +3299,65 @@ static EbErrorType produce_temporally_filtered_pic(
                                             (ctx->tf_ctrls.use_8bit_subpel)
                                             ? EB_EIGHT_BIT
                                             : encoder_bit_depth);
-
-                                        if (ctx->tf_ctrls.enable_8x8_pred) {
-                                            tf_8x8_sub_pel_search(centre_pcs,
-                                                ctx,
-                                                pcs_list[frame_index],
-                                                list_input_picture_ptr[frame_index],
-                                                pred,
-                                                pred_16bit,
-                                                stride_pred,
-                                                src_center_ptr,
-                                                altref_buffer_highbd_ptr,
-                                                stride,
-                                                (uint32_t)blk_col * BW,
-                                                (uint32_t)blk_row * BH,
-                                                ss_x,
-                                                (ctx->tf_ctrls.use_8bit_subpel)
-                                                ? EB_EIGHT_BIT
-                                                : encoder_bit_depth);
-                                        }
-
-                                        // Derive tf_32x32_block_split_flag
-                                        derive_tf_32x32_block_split_flag(ctx);
                                     }
-                                        // Perform MC using the information acquired using the ME step
-                                        tf_32x32_inter_prediction(centre_pcs,
-                                            ctx,
-                                            pcs_list[frame_index],
-                                            list_input_picture_ptr[frame_index],
-                                            pred,
-                                            pred_16bit,
-                                            (uint32_t)blk_col * BW,
-                                            (uint32_t)blk_row * BH,
-                                            ss_x,
-                                            encoder_bit_depth);
+
+                                    // Derive tf_32x32_block_split_flag
+                                    derive_tf_32x32_block_split_flag(ctx);
                                 }
+                                    // Perform MC using the information acquired using the ME step
+                                    tf_32x32_inter_prediction(centre_pcs,
+                                        ctx,
+                                        pcs_list[frame_index],
+                                        list_input_picture_ptr[frame_index],
+                                        pred,
+                                        pred_16bit,
+                                        (uint32_t)blk_col * BW,
+                                        (uint32_t)blk_row * BH,
+                                        ss_x,
+                                        encoder_bit_depth);
                             }
                         }
                     }
+                }
 
-                    for (int block_row = 0; block_row < 2; block_row++) {
-                        for (int block_col = 0; block_col < 2; block_col++) {
-                            ctx->tf_block_col = block_col;
-                            ctx->tf_block_row = block_row;
-
-                            apply_filtering_block_plane_wise(ctx,
-                                                             block_row,
-                                                             block_col,
-                                                             src_center_ptr,
-                                                             altref_buffer_highbd_ptr,
-                                                             pred,
-                                                             pred_16bit,
-                                                             accum,
-                                                             count,
-                                                             stride,
-                                                             stride_pred,
-                                                             BW >> 1,
-                                                             BH >> 1,
-                                                             ss_x,
-                                                             ss_y,
-                                                             encoder_bit_depth);
-                        }
+                for (int block_row = 0; block_row < 2; block_row++) {
+                    for (int block_col = 0; block_col < 2; block_col++) {
+                        ctx->tf_block_col = block_col;
+                        ctx->tf_block_row = block_row;
+
+                        apply_filtering_block_plane_wise(ctx,
+                                                         block_row,
+                                                         block_col,
+                                                         src_center_ptr,
+                                                         altref_buffer_highbd_ptr,
+                                                         pred,
+                                                         pred_16bit,
+                                                         accum,
+                                                         count,
+                                                         stride,
+                                                         stride_pred,
+                                                         BW >> 1,
+                                                         BH >> 1,
+                                                         ss_x,
+                                                         ss_y,
+                                                         encoder_bit_depth);
                     }
                 }
             }
-
-            // Normalize filter output to produce temporally filtered frame
-            get_final_filtered_pixels(ctx,
-                                      src_center_ptr_start,
-                                      altref_buffer_highbd_start,
-                                      accum,
-                                      count,
-                                      stride,
-                                      blk_y_src_offset,
-                                      blk_ch_src_offset,
-                                      blk_width_ch,
-                                      blk_height_ch,
-                                      is_highbd);
         }
+
+        // Normalize filter output to produce temporally filtered frame
+        get_final_filtered_pixels(ctx,
+                                  src_center_ptr_start,
+                                  altref_buffer_highbd_start,
+                                  accum,
+                                  count,
+                                  stride,
+                                  blk_y_src_offset,
+                                  blk_ch_src_offset,
+                                  blk_width_ch,
+                                  blk_height_ch,
+                                  is_highbd);
     }
     // Prep 8bit source if 8bit content or using 8bit for subpel
     if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel)
@@ -3377,8 +3374,7 @@ static EbErrorType produce_temporally_filtered_pic_ld(
     PictureParentControlSet **pcs_list,
     EbPictureBufferDesc **list_input_picture_ptr, uint8_t index_center,
     MotionEstimationContext_t *me_context_ptr,
-    const int32_t *noise_levels_log1p_fp16,
-    int32_t segment_index, Bool is_highbd) {
+    const int32_t *noise_levels_log1p_fp16, Bool is_highbd) {
     DECLARE_ALIGNED(16, uint32_t, accumulator[BLK_PELS * COLOR_CHANNELS]);
     DECLARE_ALIGNED(16, uint16_t, counter[BLK_PELS * COLOR_CHANNELS]);
     uint32_t *accum[COLOR_CHANNELS] = {
@@ -3419,22 +3415,6 @@ static EbErrorType produce_temporally_filtered_pic_ld(
                                        input_picture_ptr_central->stride_cb,
                                        input_picture_ptr_central->stride_cr};
     uint32_t stride_pred[COLOR_CHANNELS] = {BW, blk_width_ch, blk_width_ch};
-    uint32_t x_seg_idx;
-    uint32_t y_seg_idx;
-    uint32_t picture_width_in_b64  = blk_cols;
-    uint32_t picture_height_in_b64 = blk_rows;
-    SEGMENT_CONVERT_IDX_TO_XY(segment_index,
-                              x_seg_idx,
-                              y_seg_idx,
-                              centre_pcs->tf_segments_column_count);
-    uint32_t x_b64_start_idx = SEGMENT_START_IDX(
-        x_seg_idx, picture_width_in_b64, centre_pcs->tf_segments_column_count);
-    uint32_t x_b64_end_idx = SEGMENT_END_IDX(
-        x_seg_idx, picture_width_in_b64, centre_pcs->tf_segments_column_count);
-    uint32_t y_b64_start_idx = SEGMENT_START_IDX(
-        y_seg_idx, picture_height_in_b64, centre_pcs->tf_segments_row_count);
-    uint32_t y_b64_end_idx = SEGMENT_END_IDX(
-        y_seg_idx, picture_height_in_b64, centre_pcs->tf_segments_row_count);
 
     // first position of the frame buffer according to the index center
     EbByte src_center_ptr_start[COLOR_CHANNELS] = {
@@ -3537,221 +3517,220 @@ static EbErrorType produce_temporally_filtered_pic_ld(
                 decay_control, const_0dot7_fp16, noise_levels_log1p_fp16, tf_shift_factor, ctx->tf_chroma);
         }
     }
-    for (uint32_t blk_row = y_b64_start_idx; blk_row < y_b64_end_idx; blk_row++) {
-        for (uint32_t blk_col = x_b64_start_idx; blk_col < x_b64_end_idx; blk_col++) {
-            int blk_y_src_offset  = (blk_col * BW) + (blk_row * BH) * stride[C_Y];
-            int blk_ch_src_offset = (blk_col * blk_width_ch) +
-                (blk_row * blk_height_ch) * stride[C_U];
-
-            // reset accumulator and count
-            memset(accumulator, 0, BLK_PELS * COLOR_CHANNELS * sizeof(accumulator[0]));
-            memset(counter, 0, BLK_PELS * COLOR_CHANNELS * sizeof(counter[0]));
-            EbByte    src_center_ptr[COLOR_CHANNELS]           = {NULL};
-            uint16_t *altref_buffer_highbd_ptr[COLOR_CHANNELS] = {NULL};
-            // Prep 8bit source if 8bit content or using 8bit for subpel
-            if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel) {
-                src_center_ptr[C_Y] = src_center_ptr_start[C_Y] + blk_y_src_offset;
-                if (ctx->tf_chroma) {
-                    src_center_ptr[C_U] = src_center_ptr_start[C_U] + blk_ch_src_offset;
-                    src_center_ptr[C_V] = src_center_ptr_start[C_V] + blk_ch_src_offset;
-                }
+    uint32_t blk_row, blk_col;
+    while (tf_claim_block(centre_pcs, blk_cols, blk_rows, &blk_row, &blk_col)) {
+        int blk_y_src_offset  = (blk_col * BW) + (blk_row * BH) * stride[C_Y];
+        int blk_ch_src_offset = (blk_col * blk_width_ch) +
+            (blk_row * blk_height_ch) * stride[C_U];
+
+        // reset accumulator and count
+        memset(accumulator, 0, BLK_PELS * COLOR_CHANNELS * sizeof(accumulator[0]));
+        memset(counter, 0, BLK_PELS * COLOR_CHANNELS * sizeof(counter[0]));
+        EbByte    src_center_ptr[COLOR_CHANNELS]           = {NULL};
+        uint16_t *altref_buffer_highbd_ptr[COLOR_CHANNELS] = {NULL};
+        // Prep 8bit source if 8bit content or using 8bit for subpel
+        if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel) {
+            src_center_ptr[C_Y] = src_center_ptr_start[C_Y] + blk_y_src_offset;
+            if (ctx->tf_chroma) {
+                src_center_ptr[C_U] = src_center_ptr_start[C_U] + blk_ch_src_offset;
+                src_center_ptr[C_V] = src_center_ptr_start[C_V] + blk_ch_src_offset;
             }
+        }
 
-            if (is_highbd) {
-                altref_buffer_highbd_ptr[C_Y] = altref_buffer_highbd_start[C_Y] + blk_y_src_offset;
-                if (ctx->tf_chroma) {
-                    altref_buffer_highbd_ptr[C_U] = altref_buffer_highbd_start[C_U] +
-                        blk_ch_src_offset;
-                    altref_buffer_highbd_ptr[C_V] = altref_buffer_highbd_start[C_V] +
-                        blk_ch_src_offset;
-                }
+        if (is_highbd) {
+            altref_buffer_highbd_ptr[C_Y] = altref_buffer_highbd_start[C_Y] + blk_y_src_offset;
+            if (ctx->tf_chroma) {
+                altref_buffer_highbd_ptr[C_U] = altref_buffer_highbd_start[C_U] +
+                    blk_ch_src_offset;
+                altref_buffer_highbd_ptr[C_V] = altref_buffer_highbd_start[C_V] +
+                    blk_ch_src_offset;
             }
+        }
 
-            if (!is_highbd)
-                apply_filtering_central(ctx,
-                                        input_picture_ptr_central,
-                                        src_center_ptr,
-                                        accum,
-                                        count,
-                                        BW,
-                                        BH,
-                                        ss_x,
-                                        ss_y);
-            else
-                apply_filtering_central_highbd(ctx,
-                                               input_picture_ptr_central,
-                                               altref_buffer_highbd_ptr,
-                                               accum,
-                                               count,
-                                               BW,
-                                               BH,
-                                               ss_x,
-                                               ss_y);
-
-            // for every frame to filter
-            for (int frame_index = 0;
-                 frame_index < (centre_pcs->past_altref_nframes +
-                                centre_pcs->future_altref_nframes + 1);
-                 frame_index++) {
-                // ------------
-                // Step 1: motion estimation + compensation
-                // ------------
-                me_context_ptr->me_ctx->tf_frame_index  = frame_index;
-                me_context_ptr->me_ctx->tf_index_center = index_center;
-                // if frame to process is the center frame
-                if (frame_index != index_center) {
-                    // Initialize ME context
-                    create_me_context_and_picture_control(
-                        me_context_ptr,
-                        pcs_list[frame_index],
-                        pcs_list[index_center],
-                        input_picture_ptr_central,
-                        blk_row,
-                        blk_col,
-                        ss_x,
-                        ss_y);
-                    ctx->num_of_list_to_search = 1;
-                    ctx->num_of_ref_pic_to_search[0] = 1;
-                    ctx->num_of_ref_pic_to_search[1] = 0;
-                    ctx->temporal_layer_index =
-                        centre_pcs->temporal_layer_index;
-                    ctx->is_ref =
-                        centre_pcs->is_ref;
-
-                    EbPaReferenceObject *ref_object = (EbPaReferenceObject *)
-                                                                ctx->alt_ref_reference_ptr;
-                    ctx->me_ds_ref_array[0][0].picture_ptr =
-                        ref_object->input_padded_pic;
-                    ctx->me_ds_ref_array[0][0].sixteenth_picture_ptr =
-                        ref_object->sixteenth_downsampled_picture_ptr;
-                    ctx->me_ds_ref_array[0][0].quarter_picture_ptr =
-                        ref_object->quarter_downsampled_picture_ptr;
-                    ctx->me_ds_ref_array[0][0].picture_number =
-                        ref_object->picture_number;
-                    ctx->tf_me_exit_th =
-                        centre_pcs->tf_ctrls.me_exit_th;
-                    ctx->tf_use_pred_64x64_only_th =
-                        centre_pcs->tf_ctrls.use_pred_64x64_only_th;
-                    ctx->tf_subpel_early_exit_th =
-                        centre_pcs->tf_ctrls.subpel_early_exit_th;
-                    ctx->search_results[0][0].hme_sc_x = 0;
-                    ctx->search_results[0][0].hme_sc_y = 0;
-
-                    ctx->tf_64x64_mv_x = 0;
-                    ctx->tf_64x64_mv_y = 0;
-
-                    tf_64x64_inter_prediction(centre_pcs,
-                        ctx,
-                        pcs_list[frame_index],
-                        list_input_picture_ptr[frame_index],
-                        pred,
-                        pred_16bit,
-                        (uint32_t)blk_col * BW,
-                        (uint32_t)blk_row * BH,
-                        ss_x,
-                        encoder_bit_depth);
-
-                    ctx->tf_32x32_mv_x[0] = ctx->tf_64x64_mv_x;
-                    ctx->tf_32x32_mv_y[0] = ctx->tf_64x64_mv_y;
-
-                    ctx->tf_32x32_mv_x[1] = ctx->tf_64x64_mv_x;
-                    ctx->tf_32x32_mv_y[1] = ctx->tf_64x64_mv_y;
-
-                    ctx->tf_32x32_mv_x[2] = ctx->tf_64x64_mv_x;
-                    ctx->tf_32x32_mv_y[2] = ctx->tf_64x64_mv_y;
-
-                    ctx->tf_32x32_mv_x[3] = ctx->tf_64x64_mv_x;
-                    ctx->tf_32x32_mv_y[3] = ctx->tf_64x64_mv_y;
-
-                    ctx->tf_32x32_block_split_flag[0] = 0;
-                    ctx->tf_32x32_block_split_flag[1] = 0;
-                    ctx->tf_32x32_block_split_flag[2] = 0;
-                    ctx->tf_32x32_block_split_flag[3] = 0;
-
-                    // Update the 32x32 block-error
-                    for (int block_row = 0; block_row < 2; block_row++) {
-                        for (int block_col = 0; block_col < 2; block_col++) {
-
-                            uint32_t bsize = 32;
-                            uint64_t distortion;
-                            ctx->idx_32x32 = block_col + (block_row << 1);
-
-                            if (!is_highbd) {
-                                uint8_t* pred_y_ptr = pred[C_Y] + bsize * block_row * stride_pred[C_Y] + bsize * block_col;
-                                uint8_t* src_y_ptr = src_center_ptr[C_Y] + bsize * block_row * stride[C_Y] + bsize * block_col;
-
-                                const AomVarianceFnPtr* fn_ptr = centre_pcs->tf_ctrls.sub_sampling_shift ? &svt_aom_mefn_ptr[BLOCK_32X16]
-                                    : &svt_aom_mefn_ptr[BLOCK_32X32];
-                                unsigned int            sse;
-                                distortion = fn_ptr->vf(pred_y_ptr,
-                                    stride_pred[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
-                                    src_y_ptr,
-                                    stride[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
-                                    &sse)
-                                    << centre_pcs->tf_ctrls.sub_sampling_shift;
-                            }
-                            else {
-                                uint16_t* pred_y_ptr = pred_16bit[C_Y] +
-                                    bsize * block_row * stride_pred[C_Y] +
-                                    bsize * block_col;
-                                uint16_t* src_y_ptr = altref_buffer_highbd_ptr[C_Y] +
-                                    bsize * block_row * stride[C_Y] +
-                                    bsize * block_col;
-                                const AomVarianceFnPtr* fn_ptr = centre_pcs->tf_ctrls.sub_sampling_shift ? &svt_aom_mefn_ptr[BLOCK_32X16]
-                                    : &svt_aom_mefn_ptr[BLOCK_32X32];
-
-                                unsigned int sse;
-
-                                distortion = fn_ptr->vf_hbd_10(CONVERT_TO_BYTEPTR(pred_y_ptr),
-                                    stride_pred[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
-                                    CONVERT_TO_BYTEPTR(src_y_ptr),
-                                    stride[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
-                                    &sse)
-                                    << centre_pcs->tf_ctrls.sub_sampling_shift;
-                            }
-                            ctx->tf_32x32_block_error[ctx->idx_32x32] = distortion;
+        if (!is_highbd)
+            apply_filtering_central(ctx,
+                                    input_picture_ptr_central,
+                                    src_center_ptr,
+                                    accum,
+                                    count,
+                                    BW,
+                                    BH,
+                                    ss_x,
+                                    ss_y);
+        else
+            apply_filtering_central_highbd(ctx,
+                                           input_picture_ptr_central,
+                                           altref_buffer_highbd_ptr,
+                                           accum,
+                                           count,
+                                           BW,
+                                           BH,
+                                           ss_x,
+                                           ss_y);
+
+        // for every frame to filter
+        for (int frame_index = 0;
+             frame_index < (centre_pcs->past_altref_nframes +
+                            centre_pcs->future_altref_nframes + 1);
+             frame_index++) {
+            // ------------
+            // Step 1: motion estimation + compensation
+            // ------------
+            me_context_ptr->me_ctx->tf_frame_index  = frame_index;
+            me_context_ptr->me_ctx->tf_index_center = index_center;
+            // if frame to process is the center frame
+            if (frame_index != index_center) {
+                // Initialize ME context
+                create_me_context_and_picture_control(
+                    me_context_ptr,
+                    pcs_list[frame_index],
+                    pcs_list[index_center],
+                    input_picture_ptr_central,
+                    blk_row,
+                    blk_col,
+                    ss_x,
+                    ss_y);
+                ctx->num_of_list_to_search = 1;
+                ctx->num_of_ref_pic_to_search[0] = 1;
+                ctx->num_of_ref_pic_to_search[1] = 0;
+                ctx->temporal_layer_index =
+                    centre_pcs->temporal_layer_index;
+                ctx->is_ref =
+                    centre_pcs->is_ref;
+
+                EbPaReferenceObject *ref_object = (EbPaReferenceObject *)
+                                                            ctx->alt_ref_reference_ptr;
+                ctx->me_ds_ref_array[0][0].picture_ptr =
+                    ref_object->input_padded_pic;
+                ctx->me_ds_ref_array[0][0].sixteenth_picture_ptr =
+                    ref_object->sixteenth_downsampled_picture_ptr;
+                ctx->me_ds_ref_array[0][0].quarter_picture_ptr =
+                    ref_object->quarter_downsampled_picture_ptr;
+                ctx->me_ds_ref_array[0][0].picture_number =
+                    ref_object->picture_number;
+                ctx->tf_me_exit_th =
+                    centre_pcs->tf_ctrls.me_exit_th;
+                ctx->tf_use_pred_64x64_only_th =
+                    centre_pcs->tf_ctrls.use_pred_64x64_only_th;
+                ctx->tf_subpel_early_exit_th =
+                    centre_pcs->tf_ctrls.subpel_early_exit_th;
+                ctx->search_results[0][0].hme_sc_x = 0;
+                ctx->search_results[0][0].hme_sc_y = 0;
+
+                ctx->tf_64x64_mv_x = 0;
+                ctx->tf_64x64_mv_y = 0;
+
+                tf_64x64_inter_prediction(centre_pcs,
+                    ctx,
+                    pcs_list[frame_index],
+                    list_input_picture_ptr[frame_index],
+                    pred,
+                    pred_16bit,
+                    (uint32_t)blk_col * BW,
+                    (uint32_t)blk_row * BH,
+                    ss_x,
+                    encoder_bit_depth);
+
+                ctx->tf_32x32_mv_x[0] = ctx->tf_64x64_mv_x;
+                ctx->tf_32x32_mv_y[0] = ctx->tf_64x64_mv_y;
+
+                ctx->tf_32x32_mv_x[1] = ctx->tf_64x64_mv_x;
+                ctx->tf_32x32_mv_y[1] = ctx->tf_64x64_mv_y;
+
+                ctx->tf_32x32_mv_x[2] = ctx->tf_64x64_mv_x;
+                ctx->tf_32x32_mv_y[2] = ctx->tf_64x64_mv_y;
+
+                ctx->tf_32x32_mv_x[3] = ctx->tf_64x64_mv_x;
+                ctx->tf_32x32_mv_y[3] = ctx->tf_64x64_mv_y;
+
+                ctx->tf_32x32_block_split_flag[0] = 0;
+                ctx->tf_32x32_block_split_flag[1] = 0;
+                ctx->tf_32x32_block_split_flag[2] = 0;
+                ctx->tf_32x32_block_split_flag[3] = 0;
+
+                // Update the 32x32 block-error
+                for (int block_row = 0; block_row < 2; block_row++) {
+                    for (int block_col = 0; block_col < 2; block_col++) {
+
+                        uint32_t bsize = 32;
+                        uint64_t distortion;
+                        ctx->idx_32x32 = block_col + (block_row << 1);
+
+                        if (!is_highbd) {
+                            uint8_t* pred_y_ptr = pred[C_Y] + bsize * block_row * stride_pred[C_Y] + bsize * block_col;
+                            uint8_t* src_y_ptr = src_center_ptr[C_Y] + bsize * block_row * stride[C_Y] + bsize * block_col;
+
+                            const AomVarianceFnPtr* fn_ptr = centre_pcs->tf_ctrls.sub_sampling_shift ? &svt_aom_mefn_ptr[BLOCK_32X16]
+                                : &svt_aom_mefn_ptr[BLOCK_32X32];
+                            unsigned int            sse;
+                            distortion = fn_ptr->vf(pred_y_ptr,
+                                stride_pred[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
+                                src_y_ptr,
+                                stride[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
+                                &sse)
+                                << centre_pcs->tf_ctrls.sub_sampling_shift;
                         }
+                        else {
+                            uint16_t* pred_y_ptr = pred_16bit[C_Y] +
+                                bsize * block_row * stride_pred[C_Y] +
+                                bsize * block_col;
+                            uint16_t* src_y_ptr = altref_buffer_highbd_ptr[C_Y] +
+                                bsize * block_row * stride[C_Y] +
+                                bsize * block_col;
+                            const AomVarianceFnPtr* fn_ptr = centre_pcs->tf_ctrls.sub_sampling_shift ? &svt_aom_mefn_ptr[BLOCK_32X16]
+                                : &svt_aom_mefn_ptr[BLOCK_32X32];
+
+                            unsigned int sse;
+
+                            distortion = fn_ptr->vf_hbd_10(CONVERT_TO_BYTEPTR(pred_y_ptr),
+                                stride_pred[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
+                                CONVERT_TO_BYTEPTR(src_y_ptr),
+                                stride[C_Y] << centre_pcs->tf_ctrls.sub_sampling_shift,
+                                &sse)
+                                << centre_pcs->tf_ctrls.sub_sampling_shift;
+                        }
+                        ctx->tf_32x32_block_error[ctx->idx_32x32] = distortion;
                     }
+                }
 
-                    for (int block_row = 0; block_row < 2; block_row++) {
-                        for (int block_col = 0; block_col < 2; block_col++) {
-                            ctx->tf_block_col = block_col;
-                            ctx->tf_block_row = block_row;
-
-                            apply_filtering_block_plane_wise(ctx,
-                                                             block_row,
-                                                             block_col,
-                                                             src_center_ptr,
-                                                             altref_buffer_highbd_ptr,
-                                                             pred,
-                                                             pred_16bit,
-                                                             accum,
-                                                             count,
-                                                             stride,
-                                                             stride_pred,
-                                                             BW >> 1,
-                                                             BH >> 1,
-                                                             ss_x,
-                                                             ss_y,
-                                                             encoder_bit_depth);
-                        }
+                for (int block_row = 0; block_row < 2; block_row++) {
+                    for (int block_col = 0; block_col < 2; block_col++) {
+                        ctx->tf_block_col = block_col;
+                        ctx->tf_block_row = block_row;
+
+                        apply_filtering_block_plane_wise(ctx,
+                                                         block_row,
+                                                         block_col,
+                                                         src_center_ptr,
+                                                         altref_buffer_highbd_ptr,
+                                                         pred,
+                                                         pred_16bit,
+                                                         accum,
+                                                         count,
+                                                         stride,
+                                                         stride_pred,
+                                                         BW >> 1,
+                                                         BH >> 1,
+                                                         ss_x,
+                                                         ss_y,
+                                                         encoder_bit_depth);
                     }
                 }
             }
-
-            // Normalize filter output to produce temporally filtered frame
-            get_final_filtered_pixels(ctx,
-                                      src_center_ptr_start,
-                                      altref_buffer_highbd_start,
-                                      accum,
-                                      count,
-                                      stride,
-                                      blk_y_src_offset,
-                                      blk_ch_src_offset,
-                                      blk_width_ch,
-                                      blk_height_ch,
-                                      is_highbd);
         }
+
+        // Normalize filter output to produce temporally filtered frame
+        get_final_filtered_pixels(ctx,
+                                  src_center_ptr_start,
+                                  altref_buffer_highbd_start,
+                                  accum,
+                                  count,
+                                  stride,
+                                  blk_y_src_offset,
+                                  blk_ch_src_offset,
+                                  blk_width_ch,
+                                  blk_height_ch,
+                                  is_highbd);
     }
     // Prep 8bit source if 8bit content or using 8bit for subpel
     if (!is_highbd || ctx->tf_ctrls.use_8bit_subpel)
@@ -4063,7 +4042,7 @@ static uint32_t filt_unfilt_dist(
 EbErrorType svt_av1_init_temporal_filtering(
     PictureParentControlSet ** pcs_list,
     PictureParentControlSet *  centre_pcs,
-    MotionEstimationContext_t *me_context_ptr, int32_t segment_index) {
+    MotionEstimationContext_t *me_context_ptr) {
     uint8_t              index_center;
     EbPictureBufferDesc *central_picture_ptr;
     me_context_ptr->me_ctx->tf_ctrls = centre_pcs->tf_ctrls;
@@ -4164,7 +4143,6 @@ EbErrorType svt_av1_init_temporal_filtering(
                                         index_center,
                                         me_context_ptr,
                                         noise_levels_log1p_fp16,
-                                        segment_index,
                                         is_highbd);
     else
     produce_temporally_filtered_pic(pcs_list,
@@ -4172,7 +4150,6 @@ EbErrorType svt_av1_init_temporal_filtering(
                                     index_center,
                                     me_context_ptr,
                                     noise_levels_log1p_fp16,
-                                    segment_index,
                                     is_highbd);
 
     svt_block_on_mutex(centre_pcs->temp_filt_mutex);
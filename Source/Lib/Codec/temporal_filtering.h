@@ -104,7 +104,7 @@ extern "C" {
 #endif
 
 EbErrorType svt_av1_init_temporal_filtering(PictureParentControlSet **pcs_list, PictureParentControlSet *centre_pcs,
-                                            MotionEstimationContext_t *me_context_ptr, int32_t segment_index);
+                                            MotionEstimationContext_t *me_context_ptr);
 void        svt_av1_apply_zz_based_temporal_filter_planewise_medium_c(
            struct MeContext *me_ctx, const uint8_t *y_pre, int y_pre_stride, const uint8_t *u_pre, const uint8_t *v_pre,
            int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, uint32_t *y_accum,
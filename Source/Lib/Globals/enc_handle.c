@@ -51,6 +51,7 @@
 #include "ec_results.h"
 #include "pred_structure.h"
 #include "rest_process.h"
+#include "stat_report_process.h"
 #include "cdef_process.h"
 #include "dlf_process.h"
 #include "rc_results.h"
@@ -104,6 +105,9 @@
 #define ENCDEC_INPUT_PORT_MDC                                0
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
 #define ENCDEC_INPUT_PORT_INVALID                           -1
+#define DLF_INPUT_PORT_ENCDEC                                0
+#define DLF_INPUT_PORT_DLF                                   1
+#define DLF_INPUT_PORT_INVALID                              -1
 /**************************************
  * Globals
  **************************************/
@@ -621,13 +625,13 @@ void set_segments_numbers(SequenceControlSet* scs) {
         (((scs->max_input_luma_width + 32) / BLOCK_SIZE_64) < 10) ? 1 :
         (scs->input_resolution <= INPUT_SIZE_1080p_RANGE) ? 3 : 6;
 
-    //since restoration unit size is same for Luma and Chroma, Luma segments and chroma segments do not correspond to the same area!
-    //to keep proper processing, segments have to be configured based on chroma resolution.
+    // One restoration search segment per luma restoration unit, the search of a unit being the smallest
+    // independent task. The chroma units are split in the same proportions, some segments may have none.
     const uint32_t unit_size = RESTORATION_UNITSIZE_MAX;
-    const uint32_t rest_seg_w = MAX((scs->max_input_luma_width / 2 + (unit_size >> 1)) / unit_size, 1);
-    const uint32_t rest_seg_h = MAX((scs->max_input_luma_height / 2 + (unit_size >> 1)) / unit_size, 1);
-    scs->rest_segment_column_count = scs->input_resolution <= INPUT_SIZE_1080p_RANGE ? MIN(rest_seg_w, 6) : MIN(rest_seg_w, 9);
-    scs->rest_segment_row_count = scs->input_resolution <= INPUT_SIZE_1080p_RANGE ? MIN(rest_seg_h, 4) : MIN(rest_seg_h, 6);
+    const uint32_t rest_seg_w = MAX((scs->max_input_luma_width + (unit_size >> 1)) / unit_size, 1);
+    const uint32_t rest_seg_h = MAX((scs->max_input_luma_height + (unit_size >> 1)) / unit_size, 1);
+    scs->rest_segment_column_count = MIN(rest_seg_w, 255);
+    scs->rest_segment_row_count = MIN(rest_seg_h, 255);
 
     scs->tf_segment_column_count = me_seg_w;
     scs->tf_segment_row_count = me_seg_h;
@@ -719,18 +723,479 @@ void set_segments_numbers(SequenceControlSet    *scs) {
         (((scs->max_input_luma_width + 32) / BLOCK_SIZE_64) < 10) ? 1 :
         (scs->input_resolution <= INPUT_SIZE_1080p_RANGE) ? 3 : 6;
 
-    //since restoration unit size is same for Luma and Chroma, Luma segments and chroma segments do not correspond to the same area!
-    //to keep proper processing, segments have to be configured based on chroma resolution.
-    uint32_t unit_size = 256;
-    uint32_t rest_seg_w = MAX((scs->max_input_luma_width / 2 + (unit_size >> 1)) / unit_size, 1);
-    uint32_t rest_seg_h = MAX((scs->max_input_luma_height / 2 + (unit_size >> 1)) / unit_size, 1);
-    scs->rest_segment_column_count = scs->input_resolution <= INPUT_SIZE_1080p_RANGE ? MIN(rest_seg_w, 6) : MIN(rest_seg_w, 9);
-    scs->rest_segment_row_count = scs->input_resolution <= INPUT_SIZE_1080p_RANGE ? MIN(rest_seg_h, 4) : MIN(rest_seg_h, 6);
+    // One restoration search segment per luma restoration unit, the search of a unit being the smallest
+    // independent task. The chroma units are split in the same proportions, some segments may have none.
+    uint32_t unit_size = RESTORATION_UNITSIZE_MAX;
+    uint32_t rest_seg_w = MAX((scs->max_input_luma_width + (unit_size >> 1)) / unit_size, 1);
+    uint32_t rest_seg_h = MAX((scs->max_input_luma_height + (unit_size >> 1)) / unit_size, 1);
+    scs->rest_segment_column_count = MIN(rest_seg_w, 255);
+    scs->rest_segment_row_count = MIN(rest_seg_h, 255);
 
     scs->tf_segment_column_count = me_seg_w;
     scs->tf_segment_row_count = me_seg_h;
 }
 #endif
+/*
+* Raises the thread count of a stage to the number of workers (bounded by the
+* stage parallelism) and returns the number of threads added.
+*/
+static uint32_t adapt_process_count(uint32_t *process_count, uint32_t workers, uint32_t max_proc) {
+    const uint32_t target = (uint32_t)clamp(workers, 1, max_proc);
+    if (target <= *process_count)
+        return 0;
+    const uint32_t added = target - *process_count;
+    *process_count       = target;
+    return added;
+}
+
+void init_fn_ptr(void);
+void svt_av1_init_wedge_masks(void);
+
+// Sets the kernels of the cpu flags and the tables shared by the encoders, the block geometry is the one of scs
+static void init_global_tables(const SequenceControlSet *scs)
+{
+    svt_aom_setup_common_rtcd_internal(scs->static_config.use_cpu_flags);
+    svt_aom_setup_rtcd_internal(scs->static_config.use_cpu_flags);
+
+    svt_aom_asm_set_convolve_asm_table();
+
+    svt_aom_init_intra_dc_predictors_c_internal();
+
+    svt_aom_asm_set_convolve_hbd_asm_table();
+
+    svt_aom_init_intra_predictors_internal();
+    #ifdef MINIMAL_BUILD
+    if (!svt_aom_blk_geom_mds)
+        svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
+    #endif
+    svt_aom_build_blk_geom(scs->svt_aom_geom_idx);
+
+    svt_av1_init_me_luts();
+    init_fn_ptr();
+    svt_av1_init_wedge_masks();
+}
+
+EbErrorType svt_input_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr);
+
+EbErrorType svt_output_recon_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr);
+
+EbErrorType svt_overlay_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr);
+
+EbErrorType svt_output_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr object_init_data_ptr);
+
+void svt_input_buffer_header_destroyer(    EbPtr p);
+void svt_output_recon_buffer_header_destroyer(    EbPtr p);
+void svt_output_buffer_header_destroyer(    EbPtr p);
+
+EbErrorType svt_input_y8b_creator(EbPtr *object_dbl_ptr, EbPtr  object_init_data_ptr);
+void svt_input_y8b_destroyer(EbPtr p);
+
+// Init data of the parent picture control sets and of the motion estimation results
+static void ppcs_init_data(SequenceControlSet *scs, PictureControlSetInitData *input_data)
+{
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->color_format = scs->static_config.encoder_color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->ten_bit_format = scs->ten_bit_format;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->speed_control = (uint8_t)scs->speed_control_flag;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->bit_depth = scs->static_config.encoder_bit_depth;
+    input_data->log2_tile_rows = scs->static_config.tile_rows;
+    input_data->log2_tile_cols = scs->static_config.tile_columns;
+    input_data->log2_sb_size = (scs->super_block_size == 128) ? 5 : 4;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->non_m8_pad_w = scs->max_input_pad_right;
+    input_data->non_m8_pad_h = scs->max_input_pad_bottom;
+    input_data->enable_tpl_la = scs->tpl;
+    input_data->in_loop_ois = scs->in_loop_ois;
+    input_data->gm_tasks = scs->motion_estimation_process_init_count > 1;
+    input_data->enc_dec_segment_col = (uint16_t)scs->tpl_segment_col_count_array;
+    input_data->enc_dec_segment_row = (uint16_t)scs->tpl_segment_row_count_array;
+    input_data->final_pass_preset = scs->final_pass_preset;
+    input_data->rate_control_mode = scs->static_config.rate_control_mode;
+    MrpCtrls* mrp_ctrl = &(scs->mrp_ctrls);
+    input_data->ref_count_used_list0 =
+        MAX(mrp_ctrl->sc_base_ref_list0_count,
+            MAX(mrp_ctrl->base_ref_list0_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
+
+    input_data->ref_count_used_list1 =
+        MAX(mrp_ctrl->sc_base_ref_list1_count,
+            MAX(mrp_ctrl->base_ref_list1_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
+    input_data->tpl_synth_size = svt_aom_set_tpl_group(NULL,
+        svt_aom_get_tpl_group_level(
+            1,
+            scs->static_config.enc_mode,
+            scs->static_config.rate_control_mode),
+        input_data->picture_width, input_data->picture_height);
+    input_data->enable_adaptive_quantization = scs->static_config.enable_adaptive_quantization;
+    input_data->calculate_variance = scs->calculate_variance;
+    input_data->calc_hist = scs->calc_hist =
+        scs->static_config.scene_change_detection ||
+        scs->vq_ctrls.sharpness_ctrls.scene_transition ||
+        scs->tf_params_per_type[0].enabled ||
+        scs->tf_params_per_type[1].enabled ||
+        scs->tf_params_per_type[2].enabled;
+    input_data->tpl_lad_mg = scs->tpl_lad_mg;
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                           scs->static_config.resize_mode > RESIZE_NONE;
+    input_data->rtc_tune = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
+    input_data->enable_variance_boost = scs->static_config.enable_variance_boost;
+    input_data->variance_boost_strength = scs->static_config.variance_boost_strength;
+    input_data->variance_octile = scs->static_config.variance_octile;
+    input_data->sharpness = scs->static_config.sharpness;
+    input_data->qp_scale_compress_strength = scs->static_config.qp_scale_compress_strength;
+    input_data->frame_luma_bias = scs->static_config.frame_luma_bias;
+    input_data->max_32_tx_size = scs->static_config.max_32_tx_size;
+    input_data->adaptive_film_grain = scs->static_config.adaptive_film_grain;
+    input_data->tf_strength = scs->static_config.tf_strength;
+    input_data->kf_tf_strength = scs->static_config.kf_tf_strength;
+    input_data->noise_norm_strength = scs->static_config.noise_norm_strength;
+    input_data->psy_rd = scs->static_config.psy_rd;
+    input_data->spy_rd = scs->static_config.spy_rd;
+    input_data->static_config = scs->static_config;
+}
+
+// Init data of the child picture control sets and of the recon coef buffers, the tiles come from a parent picture
+static void pcs_init_data(const SequenceControlSet *scs, const PictureParentControlSet *parent_pcs,
+    PictureControlSetInitData *input_data)
+{
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    unsigned i;
+
+    input_data->enc_dec_segment_col = 0;
+    input_data->enc_dec_segment_row = 0;
+    for (i = 0; i <= scs->static_config.hierarchical_levels; ++i) {
+        input_data->enc_dec_segment_col = scs->enc_dec_segment_col_count_array[i] > input_data->enc_dec_segment_col ?
+            (uint16_t)scs->enc_dec_segment_col_count_array[i] :
+            input_data->enc_dec_segment_col;
+        input_data->enc_dec_segment_row = scs->enc_dec_segment_row_count_array[i] > input_data->enc_dec_segment_row ?
+            (uint16_t)scs->enc_dec_segment_row_count_array[i] :
+            input_data->enc_dec_segment_row;
+    }
+
+    input_data->init_max_block_cnt = scs->max_block_cnt;
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->bit_depth = scs->encoder_bit_depth;
+    input_data->color_format = scs->static_config.encoder_color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->sb_size = scs->super_block_size;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->cdf_mode = scs->cdf_mode;
+    input_data->mfmv = scs->mfmv_enabled;
+    input_data->cfg_palette = scs->static_config.screen_content_mode;
+    //Jing: Get tile info from parent_pcs
+    input_data->tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
+    input_data->tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->av1_cm = parent_pcs->av1_cm;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->static_config = scs->static_config;
+
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                           scs->static_config.resize_mode > RESIZE_NONE;
+}
+
+// Init data of the pa reference pictures
+static void pa_ref_init_data(const SequenceControlSet *scs, EbPaReferenceObjectDescInitData *init_data)
+{
+    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
+    // PA Reference Picture Buffers
+    // Currently, only Luma samples are needed in the PA
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
+    //No full-resolution pixel data is allocated for PA REF,
+    // it points directly to the Luma input samples of the app data
+    ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
+
+
+    ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
+    ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
+    ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
+    ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.mfmv                = 0;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
+    quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
+    quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    quart_pic_buf_desc_init_data.color_format = EB_YUV420;
+    quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.split_mode = FALSE;
+    quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    quart_pic_buf_desc_init_data.mfmv                = 0;
+    quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
+    sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
+    sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
+    sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
+    sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    sixteenth_pic_buf_desc_init_data.mfmv                = 0;
+    sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
+    init_data->sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+}
+
+// Init data of the tpl reference pictures
+static void tpl_ref_init_data(const SequenceControlSet *scs, EbTplReferenceObjectDescInitData *init_data)
+{
+    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
+    // PA Reference Picture Buffers
+    // Currently, only Luma samples are needed in the PA
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
+
+    // Allocate one ref pic to be used in TPL
+    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
+
+    ref_pic_buf_desc_init_data.left_padding = TPL_PADX;// scs->left_padding;
+    ref_pic_buf_desc_init_data.right_padding = TPL_PADX;// scs->right_padding;
+    ref_pic_buf_desc_init_data.top_padding = TPL_PADY;// scs->top_padding;
+    ref_pic_buf_desc_init_data.bot_padding = TPL_PADY;// scs->bot_padding;
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.mfmv = 0;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
+
+    ref_pic_buf_desc_init_data.rest_units_per_tile = 0;// rest not needed in tpl scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.sb_total_count = scs->sb_total_count;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+}
+
+// Init data of the reference pictures, the restoration units and the 64x64 blocks come from a child picture
+static void ref_init_data(SequenceControlSet *scs, EbReferenceObjectDescInitData *init_data)
+{
+    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
+    Bool is_16bit = (Bool)(scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
+    // Initialize the various Picture types
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = scs->encoder_bit_depth;
+    ref_pic_buf_desc_init_data.color_format = scs->static_config.encoder_color_format;
+    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.sb_total_count = scs->b64_total_count;
+    uint16_t padding = scs->super_block_size + 32;
+    if (scs->static_config.superres_mode > SUPERRES_NONE ||
+        scs->static_config.resize_mode > RESIZE_NONE) {
+        padding += scs->super_block_size;
+    }
+
+    ref_pic_buf_desc_init_data.left_padding = padding;
+    ref_pic_buf_desc_init_data.right_padding = padding;
+    ref_pic_buf_desc_init_data.top_padding = padding;
+    ref_pic_buf_desc_init_data.bot_padding = padding;
+    ref_pic_buf_desc_init_data.mfmv = scs->mfmv_enabled;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline = scs->is_16bit_pipeline;
+    // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
+
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
+    if (is_16bit)
+        ref_pic_buf_desc_init_data.bit_depth = EB_TEN_BIT;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->hbd_md =
+        scs->enable_hbd_mode_decision;
+    init_data->static_config = &scs->static_config;
+    init_data->subpel_cache_planes = scs->subpel_cache_planes;
+}
+
+/*
+* Memory of one object of each picture pool and of a mode decision context, measured by
+* allocating them with the configuration of the encoder
+*/
+typedef struct PoolObjectMemory {
+    uint64_t input;
+    uint64_t y8b;
+    uint64_t overlay;
+    uint64_t ppcs;
+    uint64_t me;
+    uint64_t pa_reference;
+    uint64_t tpl_reference;
+    uint64_t reference;
+    uint64_t subpel_plane;
+    uint64_t child;
+    uint64_t recon_coef;
+    uint64_t md_context;
+} PoolObjectMemory;
+
+static uint64_t account_bytes(const EbMemoryAccount *account) {
+    EbMemoryAccount amounts;
+    svt_memory_account_read(account, &amounts);
+    return amounts.amount[EB_N_PTR] + amounts.amount[EB_C_PTR] + amounts.amount[EB_A_PTR];
+}
+
+// Allocates a pool of one object charged to account, bytes is what the pool holds, 0 when it could not be allocated
+static EbSystemResource *probe_pool(EbMemoryAccount *account, uint64_t *bytes, EbCreator creator, EbPtr init_data,
+    EbDctor destroyer) {
+    const uint64_t    before   = account_bytes(account);
+    EbMemoryAccount  *previous = svt_memory_account_set(account);
+    EbSystemResource *pool;
+    EB_NO_THROW_NEW(pool, svt_system_resource_ctor, 1, 1, 0, creator, init_data, destroyer);
+    svt_memory_account_set(previous);
+    *bytes = pool ? account_bytes(account) - before : 0;
+    return pool;
+}
+
+static void measure_pool_object_memory(SequenceControlSet *scs, PoolObjectMemory *cost) {
+    EbMemoryAccount   account = {{0}};
+    EbSystemResource *pool;
+    memset(cost, 0, sizeof(*cost));
+    // the constructors use the kernels and the block geometry
+    init_global_tables(scs);
+
+    pool = probe_pool(&account, &cost->input, svt_input_buffer_header_creator, scs, svt_input_buffer_header_destroyer);
+    EB_DELETE(pool);
+    pool = probe_pool(&account, &cost->y8b, svt_input_y8b_creator, scs, svt_input_y8b_destroyer);
+    EB_DELETE(pool);
+    if (scs->static_config.enable_overlays) {
+        pool = probe_pool(&account, &cost->overlay, svt_overlay_buffer_header_creator, scs, svt_input_buffer_header_destroyer);
+        EB_DELETE(pool);
+    }
+
+    PictureControlSetInitData ppcs_data;
+    ppcs_init_data(scs, &ppcs_data);
+    EbSystemResource *ppcs_pool = probe_pool(&account, &cost->ppcs, svt_aom_picture_parent_control_set_creator, &ppcs_data, NULL);
+    pool = probe_pool(&account, &cost->me, svt_aom_me_creator, &ppcs_data, NULL);
+    EB_DELETE(pool);
+    if (ppcs_pool) {
+        // the child pictures take the tiles of the parent ones
+        PictureControlSetInitData pcs_data;
+        pcs_init_data(scs, ppcs_pool->wrapper_ptr_pool[0]->object_ptr, &pcs_data);
+        pool = probe_pool(&account, &cost->recon_coef, svt_aom_recon_coef_creator, &pcs_data, NULL);
+        EB_DELETE(pool);
+        pool = probe_pool(&account, &cost->child, svt_aom_picture_control_set_creator, &pcs_data, NULL);
+        if (pool) {
+            // the references are sized from a child picture, as init_encoder() does
+            const PictureControlSet *pcs = pool->wrapper_ptr_pool[0]->object_ptr;
+            scs->rest_units_per_tile     = pcs->rst_info[0 /*Y-plane*/].units_per_tile;
+            scs->b64_total_count         = pcs->b64_total_count;
+        }
+        EB_DELETE(pool);
+    }
+    EB_DELETE(ppcs_pool);
+
+    EbPaReferenceObjectDescInitData pa_ref_data;
+    pa_ref_init_data(scs, &pa_ref_data);
+    pool = probe_pool(&account, &cost->pa_reference, svt_pa_reference_object_creator, &pa_ref_data, NULL);
+    EB_DELETE(pool);
+    EbTplReferenceObjectDescInitData tpl_ref_data;
+    tpl_ref_init_data(scs, &tpl_ref_data);
+    pool = probe_pool(&account, &cost->tpl_reference, svt_tpl_reference_object_creator, &tpl_ref_data, NULL);
+    EB_DELETE(pool);
+    EbReferenceObjectDescInitData ref_data;
+    ref_init_data(scs, &ref_data);
+    pool = probe_pool(&account, &cost->reference, svt_reference_object_creator, &ref_data, NULL);
+    if (pool) {
+        // a cached sub-pel plane has the layout of the luma plane, with its tile states
+        const EbPictureBufferDesc *pic = ((EbReferenceObject *)pool->wrapper_ptr_pool[0]->object_ptr)->reference_picture;
+        const uint64_t tiles = (uint64_t)((pic->stride_y + (1 << SUBPEL_CACHE_TILE_LOG2) - 1) >> SUBPEL_CACHE_TILE_LOG2) *
+            ((pic->luma_size / pic->stride_y + (1 << SUBPEL_CACHE_TILE_LOG2) - 1) >> SUBPEL_CACHE_TILE_LOG2);
+        cost->subpel_plane = pic->luma_size + tiles * sizeof(uint32_t);
+    }
+    EB_DELETE(pool);
+
+    const uint64_t       before   = account_bytes(&account);
+    EbMemoryAccount     *previous = svt_memory_account_set(&account);
+    ModeDecisionContext *md_ctx;
+    EB_NO_THROW_NEW(md_ctx,
+                    svt_aom_mode_decision_context_ctor,
+                    scs->static_config.encoder_color_format,
+                    scs->super_block_size,
+                    scs->static_config.enc_mode,
+                    scs->max_block_cnt,
+                    scs->static_config.encoder_bit_depth,
+                    NULL,
+                    NULL,
+                    scs->enable_hbd_mode_decision == DEFAULT ? 2 : scs->enable_hbd_mode_decision,
+                    scs->static_config.screen_content_mode,
+                    scs->seq_qp_mod);
+    svt_memory_account_set(previous);
+    cost->md_context = md_ctx ? account_bytes(&account) - before : 0;
+    EB_DELETE(md_ctx);
+    svt_memory_account_close(&account);
+}
+
+// Memory of the sub-pel planes the references may cache for the MD sub-pel search, allocated while encoding
+static uint64_t estimate_subpel_cache_memory(const SequenceControlSet *scs, const PoolObjectMemory *cost) {
+    return (uint64_t)scs->reference_picture_buffer_init_count * scs->subpel_cache_planes * cost->subpel_plane;
+}
+
+/*
+* Memory of the picture pools from the measured cost of their objects. The kernel contexts
+* other than the mode decision ones and the sequence level buffers do not change with the
+* pool sizes, they are left out.
+*/
+static uint64_t estimate_pool_memory(const SequenceControlSet *scs, const PoolObjectMemory *cost) {
+    uint64_t bytes = scs->input_buffer_fifo_init_count * cost->input;
+    // the 8-bit luma is shared between the input and the pa reference pictures
+    bytes += MAX(scs->input_buffer_fifo_init_count, scs->pa_reference_picture_buffer_init_count) * cost->y8b;
+    bytes += scs->picture_control_set_pool_init_count * cost->ppcs;
+    bytes += scs->me_pool_init_count * cost->me;
+    bytes += scs->pa_reference_picture_buffer_init_count * cost->pa_reference;
+    bytes += scs->tpl_reference_picture_buffer_init_count * cost->tpl_reference;
+    bytes += scs->reference_picture_buffer_init_count * cost->reference;
+    bytes += scs->picture_control_set_pool_init_count_child * cost->child;
+    // each child picture also comes with an enc dec thread and its mode decision context
+    bytes += scs->enc_dec_pool_init_count * (cost->recon_coef + cost->md_context);
+    if (scs->static_config.enable_overlays)
+        bytes += scs->overlay_input_picture_buffer_init_count * cost->overlay;
+    bytes += estimate_subpel_cache_memory(scs, cost);
+    return bytes;
+}
+
 static EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *scs) {
     EbErrorType           return_error = EB_ErrorNone;
@@ -1015,6 +1480,45 @@ static EbErrorType load_default_buffer_configuration_settings(
     }
 #endif
 
+    scs->subpel_cache_planes = svt_aom_get_subpel_cache_planes(scs->static_config.enc_mode);
+    PoolObjectMemory pool_cost;
+    if (scs->static_config.memory_budget_mb) {
+        // Drop the sub-pel planes cached by the references first, then the extra mini-gops, then
+        // the pictures coded in parallel, down to what the prediction structure needs
+        const uint64_t budget = (uint64_t)scs->static_config.memory_budget_mb << 20;
+        measure_pool_object_memory(scs, &pool_cost);
+        while (estimate_pool_memory(scs, &pool_cost) > budget) {
+            if (scs->subpel_cache_planes) {
+                scs->subpel_cache_planes--;
+            }
+            else if (n_extra_mg) {
+                n_extra_mg--;
+                max_input  = min_input + (1 + mg_size) * n_extra_mg;
+                max_parent = max_input;
+                max_child  = MAX((mg_size / 2) * (n_extra_mg + 1), 1);
+                max_ref    = min_ref + num_ref_from_cur_mg * n_extra_mg;
+                max_paref  = min_paref + (1 + mg_size) * n_extra_mg;
+                max_me     = min_me + (1 + mg_size) * n_extra_mg;
+                max_recon  = (!scs->tpl && scs->static_config.recon_enabled) ? MAX(max_ref, 30) : max_ref;
+                scs->input_buffer_fifo_init_count = clamp(max_input, min_input, max_input);
+                scs->picture_control_set_pool_init_count = clamp(max_parent, min_parent, max_parent);
+                scs->pa_reference_picture_buffer_init_count = clamp(max_paref, min_paref, max_paref);
+                scs->output_recon_buffer_fifo_init_count = scs->reference_picture_buffer_init_count = MAX(max_recon, min_recon);
+                scs->me_pool_init_count = clamp(max_me, min_me, max_me);
+                scs->picture_control_set_pool_init_count_child = scs->enc_dec_pool_init_count =
+                    MIN(scs->picture_control_set_pool_init_count_child, max_child + superres_count);
+            }
+            else if (scs->picture_control_set_pool_init_count_child > min_child + superres_count) {
+                scs->picture_control_set_pool_init_count_child = --scs->enc_dec_pool_init_count;
+            }
+            else {
+                SVT_WARN("Memory budget of %u MB is below the %u MB of picture pools needed at the lowest picture parallelism\n",
+                    scs->static_config.memory_budget_mb, (uint32_t)(estimate_pool_memory(scs, &pool_cost) >> 20));
+                break;
+            }
+        }
+    }
+
     //#====================== Inter process Fifos ======================
     scs->resource_coordination_fifo_init_count       = 300;
     scs->picture_analysis_fifo_init_count            = 300;
@@ -1028,10 +1532,14 @@ static EbErrorType load_default_buffer_configuration_settings(
     scs->mode_decision_configuration_fifo_init_count = 300 * (MIN(9, 1<<scs->static_config.tile_rows));
     scs->motion_estimation_fifo_init_count           = 300;
     scs->entropy_coding_fifo_init_count              = 300;
-    scs->enc_dec_fifo_init_count                     = 300;
+    // DLF posts the SB rows of the pictures it filters back to its input
+    scs->enc_dec_fifo_init_count                     = MAX(300,
+        scs->picture_control_set_pool_init_count_child * ((scs->max_input_luma_height + 63) / 64 + 1));
     scs->dlf_fifo_init_count                         = 300;
     scs->cdef_fifo_init_count                        = 300;
-    scs->rest_fifo_init_count                        = 300;
+    // CDEF posts every restoration search segment of its pictures at once
+    scs->rest_fifo_init_count                        = MAX(300,
+        scs->picture_control_set_pool_init_count_child * scs->rest_segment_column_count * scs->rest_segment_row_count);
     //#====================== Processes number ======================
     scs->total_process_init_count                    = 0;
 
@@ -1179,6 +1687,33 @@ static EbErrorType load_default_buffer_configuration_settings(
     }
 #endif
 
+    // The stat report metrics of a picture are computed while it is entropy coded,
+    // with as many threads as Rest hands pictures over
+    scs->stat_report_process_init_count = scs->static_config.stat_report
+        ? clamp(scs->rest_process_init_count, 1, scs->picture_control_set_pool_init_count_child)
+        : 0;
+    scs->total_process_init_count += scs->stat_report_process_init_count;
+
+    if (scs->static_config.adaptive_threading) {
+        // Let every stage run on all the cores; the worker tokens bound the number
+        // of threads running at once so the cores go to the stages with queued work.
+        // The threads are all created here and the queue depths are never sampled:
+        // a free token goes to the first thread with work, whatever its stage
+        const uint32_t workers = core_count;
+        scs->total_process_init_count += adapt_process_count(&scs->picture_analysis_process_init_count, workers, max_pa_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->motion_estimation_process_init_count, workers, max_me_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->tpl_disp_process_init_count, workers, max_tpl_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->mode_decision_configuration_process_init_count, workers, max_mdc_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->enc_dec_process_init_count, workers, max_md_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->entropy_coding_process_init_count, workers, max_ec_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->dlf_process_init_count, workers, max_dlf_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->cdef_process_init_count, workers, max_cdef_proc);
+        scs->total_process_init_count += adapt_process_count(&scs->rest_process_init_count, workers, max_rest_proc);
+        if (scs->stat_report_process_init_count)
+            scs->total_process_init_count += adapt_process_count(&scs->stat_report_process_init_count, workers, scs->picture_control_set_pool_init_count_child);
+        scs->worker_token_count = workers;
+    }
+
     scs->total_process_init_count += 6; // single processes count
 #if CLN_LP_LVLS
     if (scs->static_config.pass == 0 || scs->static_config.pass == 2) {
@@ -1188,6 +1723,16 @@ static EbErrorType load_default_buffer_configuration_settings(
         SVT_INFO("Number of logical cores available: %u\n", core_count);
 #endif
         SVT_INFO("Number of PPCS %u\n", scs->picture_control_set_pool_init_count);
+        if (scs->static_config.memory_budget_mb)
+            SVT_INFO("Memory budget: %u MB, picture pools of %u MB with %u child PCS, up to %u MB of sub-pel planes\n",
+                     scs->static_config.memory_budget_mb,
+                     (uint32_t)(estimate_pool_memory(scs, &pool_cost) >> 20),
+                     scs->picture_control_set_pool_init_count_child,
+                     (uint32_t)(estimate_subpel_cache_memory(scs, &pool_cost) >> 20));
+        if (scs->subpel_cache_planes)
+            SVT_INFO("Sub-pel plane cache: %u planes per reference\n", scs->subpel_cache_planes);
+        if (scs->worker_token_count)
+            SVT_INFO("Adaptive threading: %u workers\n", scs->worker_token_count);
 
         /******************************************************************
         * Platform detection, limit cpu flags to hardware available CPU
@@ -1269,6 +1814,11 @@ static EncDecPorts_t enc_dec_ports[] = {
     {ENCDEC_INPUT_PORT_ENCDEC,     0},
     {ENCDEC_INPUT_PORT_INVALID,    0}
 };
+static EncDecPorts_t dlf_ports[] = {
+    {DLF_INPUT_PORT_ENCDEC,     0},
+    {DLF_INPUT_PORT_DLF,        0},
+    {DLF_INPUT_PORT_INVALID,    0}
+};
 static EncDecPorts_t tpl_ports[] = {
     {TPL_INPUT_PORT_SOP,     0},
     {TPL_INPUT_PORT_TPL,     0},
@@ -1296,6 +1846,28 @@ static uint32_t tpl_port_total_count(void){
     return total_count;
 }
 
+// DLF
+static uint32_t dlf_port_lookup(
+    int32_t  type,
+    uint32_t  port_type_index)
+{
+    uint32_t port_index = 0;
+    uint32_t port_count = 0;
+
+    while ((type != dlf_ports[port_index].type) && (type != DLF_INPUT_PORT_INVALID))
+        port_count += dlf_ports[port_index++].count;
+    return (port_count + port_type_index);
+}
+
+static uint32_t dlf_port_total_count(void){
+    uint32_t port_index = 0;
+    uint32_t total_count = 0;
+
+    while (dlf_ports[port_index].type != DLF_INPUT_PORT_INVALID)
+        total_count += dlf_ports[port_index++].count;
+    return total_count;
+}
+
 /*****************************************
  * Input Port Lookup
  *****************************************/
@@ -1370,6 +1942,7 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 
     // Rest Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->stat_report_thread_handle_array, control_set_ptr->stat_report_process_init_count);
 
     // Entropy Coding Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count);
@@ -1377,6 +1950,43 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     // Packetization
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
 }
+/*
+  Producer port of a sequential kernel of the stream. A process may only wait on one port of a
+  queue at a time, so the queues shared by the streams of a pipeline have the ports of every stream,
+  one range per stream in pipeline order.
+*/
+EbFifo *svt_aom_stream_producer_fifo(const EbEncHandle *enc_handle_ptr, EbSystemResource *resource_ptr,
+                                     uint32_t port) {
+    const uint32_t stream_port_count = resource_ptr->empty_queue->process_total_count / enc_handle_ptr->pipeline_count;
+    return svt_system_resource_get_producer_fifo(resource_ptr,
+                                                 enc_handle_ptr->pipeline_index * stream_port_count + port);
+}
+
+/*
+  The kernels, their queues and the shared pools of a segment encoder belong to its pipeline host,
+  which is deleted last: only the pointers are dropped.
+*/
+static void detach_pipeline(EbEncHandle *enc_handle_ptr)
+{
+    if (enc_handle_ptr->picture_control_set_pool_ptr_array)
+        enc_handle_ptr->picture_control_set_pool_ptr_array[0] = NULL;
+    if (enc_handle_ptr->enc_dec_pool_ptr_array)
+        enc_handle_ptr->enc_dec_pool_ptr_array[0] = NULL;
+    enc_handle_ptr->input_buffer_resource_ptr                  = NULL;
+    enc_handle_ptr->input_y8b_buffer_resource_ptr              = NULL;
+    enc_handle_ptr->resource_coordination_results_resource_ptr = NULL;
+    enc_handle_ptr->picture_decision_results_resource_ptr      = NULL;
+    enc_handle_ptr->initial_rate_control_results_resource_ptr  = NULL;
+    enc_handle_ptr->tpl_disp_res_srm                           = NULL;
+    enc_handle_ptr->rate_control_results_resource_ptr          = NULL;
+    enc_handle_ptr->enc_dec_tasks_resource_ptr                 = NULL;
+    enc_handle_ptr->enc_dec_results_resource_ptr               = NULL;
+    enc_handle_ptr->dlf_results_resource_ptr                   = NULL;
+    enc_handle_ptr->cdef_results_resource_ptr                  = NULL;
+    enc_handle_ptr->rest_results_resource_ptr                  = NULL;
+    enc_handle_ptr->stat_report_tasks_resource_ptr             = NULL;
+}
+
 /**********************************
 * Encoder Library Handle Deonstructor
 **********************************/
@@ -1384,6 +1994,8 @@ static void svt_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
     svt_enc_handle_stop_threads(enc_handle_ptr);
+    if (enc_handle_ptr->pipeline_host)
+        detach_pipeline(enc_handle_ptr);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1425,7 +2037,10 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->dlf_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->cdef_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->rest_results_resource_ptr);
+    EB_DELETE(enc_handle_ptr->stat_report_tasks_resource_ptr);
     EB_DELETE(enc_handle_ptr->entropy_coding_results_resource_ptr);
+    EB_DELETE(enc_handle_ptr->pipeline_profile);
+    EB_DELETE(enc_handle_ptr->segments);
 
     EB_DELETE(enc_handle_ptr->resource_coordination_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count);
@@ -1437,6 +2052,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->stat_report_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->picture_decision_context_ptr);
@@ -1445,7 +2061,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
+    svt_memory_account_close(&enc_handle_ptr->memory_account);
 }
 
 /**********************************
@@ -1461,6 +2077,7 @@ static EbErrorType svt_enc_handle_ctor(
 
     enc_handle_ptr->encode_instance_total_count                           = EB_EncodeInstancesTotalCount;
     enc_handle_ptr->compute_segments_total_count_array                    = EB_ComputeSegmentInitCount;
+    enc_handle_ptr->pipeline_count                                        = 1;
     // Initialize Callbacks
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_MALLOC(enc_handle_ptr->app_callback_ptr_array[0], sizeof(EbCallback));
@@ -1480,28 +2097,35 @@ static EbErrorType svt_enc_handle_ctor(
     return EB_ErrorNone;
 }
 
-EbErrorType svt_input_buffer_header_creator(
-    EbPtr *object_dbl_ptr,
-    EbPtr  object_init_data_ptr);
-
-EbErrorType svt_output_recon_buffer_header_creator(
-    EbPtr *object_dbl_ptr,
-    EbPtr  object_init_data_ptr);
-
-EbErrorType svt_overlay_buffer_header_creator(
-    EbPtr *object_dbl_ptr,
-    EbPtr  object_init_data_ptr);
 
-EbErrorType svt_output_buffer_header_creator(
-    EbPtr *object_dbl_ptr,
-    EbPtr object_init_data_ptr);
+/*
+  Header of the y8b and (uv8b + yuv2b) input buffers. With zero-copy input the
+  planes of the picture descriptor reference the caller frame instead of the
+  buffers allocated by the library, which are kept here.
+*/
+typedef struct EbInputBufferHeader {
+    EbBufferHeaderType header;
+    EbByte             own_y;
+    EbByte             own_cb;
+    EbByte             own_cr;
+    // caller frame referenced by a y8b buffer, buffer is NULL when none is held
+    EbExtFrameBuf      ext_frame;
+} EbInputBufferHeader;
 
-void svt_input_buffer_header_destroyer(    EbPtr p);
-void svt_output_recon_buffer_header_destroyer(    EbPtr p);
-void svt_output_buffer_header_destroyer(    EbPtr p);
+/*
+  Release hook of the y8b pool: the y8b buffer outlives the regular input buffer
+  of the same picture, so the caller frame is handed back once it is released.
+*/
+static void release_input_frame(EbPtr object_ptr, EbPtr release_data) {
+    EbInputBufferHeader      *input_buffer = (EbInputBufferHeader*)object_ptr;
+    EbSvtAv1EncConfiguration *config       = (EbSvtAv1EncConfiguration*)release_data;
 
-EbErrorType svt_input_y8b_creator(EbPtr *object_dbl_ptr, EbPtr  object_init_data_ptr);
-void svt_input_y8b_destroyer(EbPtr p);
+    if (!input_buffer->ext_frame.buffer)
+        return;
+    ((EbPictureBufferDesc*)input_buffer->header.p_buffer)->buffer_y = input_buffer->own_y;
+    config->release_input_frame(&input_buffer->ext_frame, config->release_input_frame_private);
+    input_buffer->ext_frame.buffer = NULL;
+}
 
 static EbErrorType in_cmd_ctor(
     InputCommand *context_ptr,
@@ -1627,70 +2251,34 @@ static EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+static EbErrorType stat_report_tasks_ctor(
+    StatReportTasks *context_ptr,
+    EbPtr object_init_data_ptr)
+{
+    (void)context_ptr;
+    (void)object_init_data_ptr;
+
+    return EB_ErrorNone;
+}
+
+static EbErrorType stat_report_tasks_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr object_init_data_ptr)
+{
+    StatReportTasks* obj;
+
+    *object_dbl_ptr = NULL;
+    EB_NEW(obj, stat_report_tasks_ctor, object_init_data_ptr);
+    *object_dbl_ptr = obj;
+
+    return EB_ErrorNone;
+}
+
 static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
         SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
         EbPaReferenceObjectDescInitData   eb_pa_ref_obj_ect_desc_init_data_structure;
-        EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
-        // PA Reference Picture Buffers
-        // Currently, only Luma samples are needed in the PA
-        ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-        ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-        ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
-        //No full-resolution pixel data is allocated for PA REF,
-        // it points directly to the Luma input samples of the app data
-        ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
-
-
-        ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
-        ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
-        ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
-        ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
-        ref_pic_buf_desc_init_data.split_mode = FALSE;
-        ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        ref_pic_buf_desc_init_data.mfmv                = 0;
-        ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
-        quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
-        quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        quart_pic_buf_desc_init_data.color_format = EB_YUV420;
-        quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.split_mode = FALSE;
-        quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        quart_pic_buf_desc_init_data.mfmv                = 0;
-        quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
-        sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
-        sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
-        sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
-        sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        sixteenth_pic_buf_desc_init_data.mfmv                = 0;
-        sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        eb_pa_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+        pa_ref_init_data(scs, &eb_pa_ref_obj_ect_desc_init_data_structure);
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1713,30 +2301,7 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 {
     SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
     EbTplReferenceObjectDescInitData   eb_tpl_ref_obj_ect_desc_init_data_structure;
-    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-    // PA Reference Picture Buffers
-    // Currently, only Luma samples are needed in the PA
-    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
-
-    // Allocate one ref pic to be used in TPL
-    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
-
-    ref_pic_buf_desc_init_data.left_padding = TPL_PADX;// scs->left_padding;
-    ref_pic_buf_desc_init_data.right_padding = TPL_PADX;// scs->right_padding;
-    ref_pic_buf_desc_init_data.top_padding = TPL_PADY;// scs->top_padding;
-    ref_pic_buf_desc_init_data.bot_padding = TPL_PADY;// scs->bot_padding;
-    ref_pic_buf_desc_init_data.split_mode = FALSE;
-    ref_pic_buf_desc_init_data.mfmv = 0;
-    ref_pic_buf_desc_init_data.is_16bit_pipeline = FALSE;
-    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
-
-    ref_pic_buf_desc_init_data.rest_units_per_tile = 0;// rest not needed in tpl scs->rest_units_per_tile;
-    ref_pic_buf_desc_init_data.sb_total_count = scs->sb_total_count;
-
-    eb_tpl_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    tpl_ref_init_data(scs, &eb_tpl_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index],
         svt_system_resource_ctor,
@@ -1757,40 +2322,8 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
     EbReferenceObjectDescInitData     eb_ref_obj_ect_desc_init_data_structure;
-    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
     SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
-    Bool is_16bit = (Bool)(scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
-    // Initialize the various Picture types
-    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-    ref_pic_buf_desc_init_data.bit_depth = scs->encoder_bit_depth;
-    ref_pic_buf_desc_init_data.color_format = scs->static_config.encoder_color_format;
-    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
-    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-    ref_pic_buf_desc_init_data.sb_total_count = scs->b64_total_count;
-    uint16_t padding = scs->super_block_size + 32;
-    if (scs->static_config.superres_mode > SUPERRES_NONE ||
-        scs->static_config.resize_mode > RESIZE_NONE) {
-        padding += scs->super_block_size;
-    }
-
-    ref_pic_buf_desc_init_data.left_padding = padding;
-    ref_pic_buf_desc_init_data.right_padding = padding;
-    ref_pic_buf_desc_init_data.top_padding = padding;
-    ref_pic_buf_desc_init_data.bot_padding = padding;
-    ref_pic_buf_desc_init_data.mfmv = scs->mfmv_enabled;
-    ref_pic_buf_desc_init_data.is_16bit_pipeline = scs->is_16bit_pipeline;
-    // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
-
-    ref_pic_buf_desc_init_data.split_mode = FALSE;
-    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
-    if (is_16bit)
-        ref_pic_buf_desc_init_data.bit_depth = EB_TEN_BIT;
-
-    eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-    eb_ref_obj_ect_desc_init_data_structure.hbd_md =
-        scs->enable_hbd_mode_decision;
-    eb_ref_obj_ect_desc_init_data_structure.static_config = &scs->static_config;
+    ref_init_data(scs, &eb_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(
             enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
@@ -1828,40 +2361,61 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     return 0;
 }
 
-void init_fn_ptr(void);
-void svt_av1_init_wedge_masks(void);
-/**********************************
-* Initialize Encoder Library
-**********************************/
-EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+/**********************************
+* Initialize Encoder Library
+**********************************/
+#ifdef _WIN32
+typedef GROUP_AFFINITY CallerAffinity;
+#elif defined(__linux__) && !defined(__ANDROID__)
+typedef cpu_set_t CallerAffinity;
+#else
+typedef int CallerAffinity;
+#endif
+
+/*
+* Pages are placed on the NUMA node of the thread writing them first. When the kernels are
+* bound to a socket, the calling thread is moved to that socket while the pools are
+* allocated and cleared, so the pictures end up on the node of the threads using them.
+*/
+static Bool bind_to_target_socket(const EbSvtAv1EncConfiguration *config_ptr, CallerAffinity *caller_affinity) {
+    if (config_ptr->target_socket == -1 || num_groups < 2)
+        return FALSE;
+#ifdef _WIN32
+    return SetThreadGroupAffinity(GetCurrentThread(), &svt_aom_group_affinity, caller_affinity) != 0;
+#elif defined(__linux__) && !defined(__ANDROID__)
+    if (!CPU_COUNT(&svt_aom_group_affinity) ||
+        pthread_getaffinity_np(pthread_self(), sizeof(*caller_affinity), caller_affinity))
+        return FALSE;
+    return pthread_setaffinity_np(pthread_self(), sizeof(svt_aom_group_affinity), &svt_aom_group_affinity) == 0;
+#else
+    (void)caller_affinity;
+    return FALSE;
+#endif
+}
+
+static void restore_caller_affinity(const CallerAffinity *caller_affinity) {
+#ifdef _WIN32
+    SetThreadGroupAffinity(GetCurrentThread(), caller_affinity, NULL);
+#elif defined(__linux__) && !defined(__ANDROID__)
+    pthread_setaffinity_np(pthread_self(), sizeof(*caller_affinity), caller_affinity);
+#else
+    (void)caller_affinity;
+#endif
+}
+
+static EbErrorType init_encoder(EbEncHandle *enc_handle_ptr)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instance_index;
     uint32_t process_index;
-    EbColorFormat color_format = enc_handle_ptr->scs_instance_array[0]->scs->static_config.encoder_color_format;
     SequenceControlSet* control_set_ptr;
+    // With parallel segments, the segment encoders run through the kernels of the pipeline host:
+    // the queues between the kernels are sized for all the streams. The lookahead and reference
+    // pools stay per stream, each closed GOP needs its own to complete.
+    EbEncHandle *host = enc_handle_ptr->pipeline_host;
+    const uint32_t pipeline_count = enc_handle_ptr->pipeline_count;
 
-    svt_aom_setup_common_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-    svt_aom_setup_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-
-    svt_aom_asm_set_convolve_asm_table();
-
-    svt_aom_init_intra_dc_predictors_c_internal();
-
-    svt_aom_asm_set_convolve_hbd_asm_table();
-
-    svt_aom_init_intra_predictors_internal();
-    #ifdef MINIMAL_BUILD
-    svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
-    #endif
-    svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
-
-    svt_av1_init_me_luts();
-    init_fn_ptr();
-    svt_av1_init_wedge_masks();
+    init_global_tables(enc_handle_ptr->scs_instance_array[0]->scs);
     /************************************
      * Sequence Control Set
      ************************************/
@@ -1883,77 +2437,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->me_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-        // The segment Width & Height Arrays are in units of SBs, not samples
         PictureControlSetInitData input_data;
-
-        input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-        input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-        input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-        input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-        input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-        input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-        input_data.color_format = color_format;
-        input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-        input_data.ten_bit_format = enc_handle_ptr->scs_instance_array[instance_index]->scs->ten_bit_format;
-        input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-        input_data.speed_control = (uint8_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->speed_control_flag;
-        input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-        input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.encoder_bit_depth;
-        input_data.log2_tile_rows = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_rows;
-        input_data.log2_tile_cols = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_columns;
-        input_data.log2_sb_size = (enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size == 128) ? 5 : 4;
-        input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-        input_data.non_m8_pad_w = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_right;
-        input_data.non_m8_pad_h = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_bottom;
-        input_data.enable_tpl_la = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl;
-        input_data.in_loop_ois = enc_handle_ptr->scs_instance_array[instance_index]->scs->in_loop_ois;
-        input_data.enc_dec_segment_col = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_col_count_array;
-        input_data.enc_dec_segment_row = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_row_count_array;
-        input_data.final_pass_preset = enc_handle_ptr->scs_instance_array[instance_index]->scs->final_pass_preset;
-        input_data.rate_control_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode;
-        MrpCtrls* mrp_ctrl = &(enc_handle_ptr->scs_instance_array[0]->scs->mrp_ctrls);
-        input_data.ref_count_used_list0 =
-            MAX(mrp_ctrl->sc_base_ref_list0_count,
-                MAX(mrp_ctrl->base_ref_list0_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
-
-        input_data.ref_count_used_list1 =
-            MAX(mrp_ctrl->sc_base_ref_list1_count,
-                MAX(mrp_ctrl->base_ref_list1_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
-        input_data.tpl_synth_size = svt_aom_set_tpl_group(NULL,
-            svt_aom_get_tpl_group_level(
-                1,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode),
-            input_data.picture_width, input_data.picture_height);
-        input_data.enable_adaptive_quantization = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_adaptive_quantization;
-        input_data.calculate_variance = enc_handle_ptr->scs_instance_array[instance_index]->scs->calculate_variance;
-        input_data.calc_hist = enc_handle_ptr->scs_instance_array[instance_index]->scs->calc_hist =
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.scene_change_detection ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->vq_ctrls.sharpness_ctrls.scene_transition ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[0].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[1].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[2].enabled;
-        input_data.tpl_lad_mg = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_lad_mg;
-        input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-        input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                              enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
-        input_data.rtc_tune = (enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
-        input_data.enable_variance_boost = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_variance_boost;
-        input_data.variance_boost_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_boost_strength;
-        input_data.variance_octile = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_octile;
-        input_data.sharpness = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.sharpness;
-        input_data.qp_scale_compress_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.qp_scale_compress_strength;
-        input_data.frame_luma_bias = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.frame_luma_bias;
-        input_data.max_32_tx_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.max_32_tx_size;
-        input_data.adaptive_film_grain = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.adaptive_film_grain;
-        input_data.tf_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tf_strength;
-        input_data.kf_tf_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.kf_tf_strength;
-        input_data.noise_norm_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.noise_norm_strength;
-        input_data.psy_rd = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.psy_rd;
-        input_data.spy_rd = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.spy_rd;
-        input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
+        ppcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs, &input_data);
 
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
@@ -1964,6 +2449,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             svt_aom_picture_parent_control_set_creator,
             &input_data,
             NULL);
+        enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->release_cb =
+            svt_aom_picture_parent_control_set_release;
 #if SRM_REPORT
         enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0]->empty_queue->log = 0;
 #endif
@@ -1987,51 +2474,21 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-            // The segment Width & Height Arrays are in units of SBs, not samples
-            PictureControlSetInitData input_data;
-            unsigned i;
-            input_data.enc_dec_segment_col = 0;
-            input_data.enc_dec_segment_row = 0;
-            for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.hierarchical_levels; ++i) {
-                input_data.enc_dec_segment_col = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] > input_data.enc_dec_segment_col ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] :
-                    input_data.enc_dec_segment_col;
-                input_data.enc_dec_segment_row = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] > input_data.enc_dec_segment_row ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] :
-                    input_data.enc_dec_segment_row;
+            // The recon coef buffers are only held while a picture is coded, shared by the streams
+            if (host) {
+                enc_handle_ptr->enc_dec_pool_ptr_array[instance_index] = host->enc_dec_pool_ptr_array[instance_index];
+                continue;
             }
-
-            input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-            input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-            input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-            input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-            input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-            input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-            input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->encoder_bit_depth;
-            input_data.color_format = color_format;
-            input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-            input_data.sb_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size;
-            input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-            input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->cdf_mode;
-            input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs->mfmv_enabled;
-            input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs->static_config.screen_content_mode;
-            //Jing: Get tile info from parent_pcs
-            PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-            input_data.tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
-            input_data.tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
-            input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-            input_data.av1_cm = parent_pcs->av1_cm;
-            input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-
-            input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-            input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                                  enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
+            PictureControlSetInitData input_data;
+            pcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs,
+                          enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr,
+                          &input_data);
 
             EB_NEW(
                 enc_handle_ptr->enc_dec_pool_ptr_array[instance_index],
                 svt_system_resource_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_pool_init_count, //EB_PictureControlSetPoolInitCountChild,
-                1,
+                pipeline_count,
                 0,
                 svt_aom_recon_coef_creator,
                 &input_data,
@@ -2047,58 +2504,27 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-            // The segment Width & Height Arrays are in units of SBs, not samples
-            PictureControlSetInitData input_data;
-            unsigned i;
-
-            input_data.enc_dec_segment_col = 0;
-            input_data.enc_dec_segment_row = 0;
-            for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.hierarchical_levels; ++i) {
-                input_data.enc_dec_segment_col = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] > input_data.enc_dec_segment_col ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] :
-                    input_data.enc_dec_segment_col;
-                input_data.enc_dec_segment_row = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] > input_data.enc_dec_segment_row ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] :
-                    input_data.enc_dec_segment_row;
+            // The child picture control sets are only held while a picture is coded, shared by the streams
+            if (host) {
+                enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index] = host->picture_control_set_pool_ptr_array[instance_index];
+                continue;
             }
-
-            input_data.init_max_block_cnt = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_block_cnt;
-            input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-            input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-            input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-            input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-            input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-            input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-            input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->encoder_bit_depth;
-            input_data.color_format = color_format;
-            input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-            input_data.sb_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size;
-            input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-            input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->cdf_mode;
-            input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs->mfmv_enabled;
-            input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs->static_config.screen_content_mode;
-            //Jing: Get tile info from parent_pcs
-            PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-            input_data.tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
-            input_data.tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
-            input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-            input_data.av1_cm = parent_pcs->av1_cm;
-            input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-            input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
-
-            input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-            input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                                  enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
+            PictureControlSetInitData input_data;
+            pcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs,
+                          enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr,
+                          &input_data);
 
             EB_NEW(
                 enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
                 svt_system_resource_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
-                1,
+                pipeline_count,
                 0,
                 svt_aom_picture_control_set_creator,
                 &input_data,
                 NULL);
+            enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index]->release_cb =
+                svt_aom_picture_control_set_release;
         }
 
     /************************************
@@ -2123,6 +2549,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     enc_dec_ports[ENCDEC_INPUT_PORT_MDC].count = enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count;
     enc_dec_ports[ENCDEC_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count;
+    dlf_ports[DLF_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count;
+    dlf_ports[DLF_INPUT_PORT_DLF].count = enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count;
     tpl_ports[TPL_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
     tpl_ports[TPL_INPUT_PORT_TPL].count = enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count;
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -2169,33 +2597,44 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         NULL);
     enc_handle_ptr->input_cmd_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_cmd_resource_ptr, 0);
 
-    //Picture Buffer SRM to hold (uv8b + yuv2b)
-    EB_NEW(
-        enc_handle_ptr->input_buffer_resource_ptr,
-        svt_system_resource_ctor,
-        enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count,
-        1,
-        0, //1/2 SRM; no consumer FIFO
-        svt_input_buffer_header_creator,
-        enc_handle_ptr->scs_instance_array[0]->scs,
-        svt_input_buffer_header_destroyer);
-    enc_handle_ptr->input_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
-
-    //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
-    EB_NEW(
-        enc_handle_ptr->input_y8b_buffer_resource_ptr,
-        svt_system_resource_ctor,
-        MAX(enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count, enc_handle_ptr->scs_instance_array[0]->scs->pa_reference_picture_buffer_init_count),
-        1,
-        0, //1/2 SRM; no consumer FIFO
-        svt_input_y8b_creator,
-        enc_handle_ptr->scs_instance_array[0]->scs,
-        svt_input_y8b_destroyer);
+    // The input pictures are only taken by svt_av1_enc_send_picture(), the streams of the segments
+    // that got their EOS release theirs without taking any
+    if (host) {
+        enc_handle_ptr->input_buffer_resource_ptr     = host->input_buffer_resource_ptr;
+        enc_handle_ptr->input_y8b_buffer_resource_ptr = host->input_y8b_buffer_resource_ptr;
+    } else {
+        //Picture Buffer SRM to hold (uv8b + yuv2b)
+        EB_NEW(
+            enc_handle_ptr->input_buffer_resource_ptr,
+            svt_system_resource_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count * pipeline_count,
+            pipeline_count,
+            0, //1/2 SRM; no consumer FIFO
+            svt_input_buffer_header_creator,
+            enc_handle_ptr->scs_instance_array[0]->scs,
+            svt_input_buffer_header_destroyer);
+
+        //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
+        EB_NEW(
+            enc_handle_ptr->input_y8b_buffer_resource_ptr,
+            svt_system_resource_ctor,
+            MAX(enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count, enc_handle_ptr->scs_instance_array[0]->scs->pa_reference_picture_buffer_init_count) * pipeline_count,
+            pipeline_count,
+            0, //1/2 SRM; no consumer FIFO
+            svt_input_y8b_creator,
+            enc_handle_ptr->scs_instance_array[0]->scs,
+            svt_input_y8b_destroyer);
 
 #if SRM_REPORT
-    enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
 #endif
-    enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
+        if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.zero_copy_input) {
+            enc_handle_ptr->input_y8b_buffer_resource_ptr->release_cb   = release_input_frame;
+            enc_handle_ptr->input_y8b_buffer_resource_ptr->release_data = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
+        }
+    }
+    enc_handle_ptr->input_buffer_producer_fifo_ptr = svt_aom_stream_producer_fifo(enc_handle_ptr, enc_handle_ptr->input_buffer_resource_ptr, 0);
+    enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_aom_stream_producer_fifo(enc_handle_ptr, enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
 
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -2231,14 +2670,17 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     // Resource Coordination Results
-    {
+    if (host)
+        enc_handle_ptr->resource_coordination_results_resource_ptr = host->resource_coordination_results_resource_ptr;
+    else {
         ResourceCoordinationResultInitData resource_coordination_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->resource_coordination_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->resource_coordination_fifo_init_count,
-            EB_ResourceCoordinationProcessInitCount,
+            enc_handle_ptr->scs_instance_array[0]->scs->resource_coordination_fifo_init_count * pipeline_count,
+            // resource coordination, then the picture analysis processes posting film grain denoise tasks
+            (EB_ResourceCoordinationProcessInitCount + enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count) * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count,
             svt_aom_resource_coordination_result_creator,
             &resource_coordination_result_init_data,
@@ -2261,14 +2703,17 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     // Picture Decision Results
-    {
+    if (host)
+        enc_handle_ptr->picture_decision_results_resource_ptr = host->picture_decision_results_resource_ptr;
+    else {
         PictureDecisionResultInitData picture_decision_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->picture_decision_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->picture_decision_fifo_init_count,
-            EB_PictureDecisionProcessInitCount + 2,  // 1 for rate control, another 1 for packetization when superres recoding is on
+            enc_handle_ptr->scs_instance_array[0]->scs->picture_decision_fifo_init_count * pipeline_count,
+            // 1 for rate control, another 1 for packetization when superres recoding is on, then the ME processes posting GM tasks
+            (EB_PictureDecisionProcessInitCount + 2 + enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count) * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count,
             svt_aom_picture_decision_result_creator,
             &picture_decision_result_init_data,
@@ -2292,14 +2737,16 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
 
     // Initial Rate Control Results
-    {
+    if (host)
+        enc_handle_ptr->initial_rate_control_results_resource_ptr = host->initial_rate_control_results_resource_ptr;
+    else {
         InitialRateControlResultInitData initial_rate_control_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->initial_rate_control_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->initial_rate_control_fifo_init_count,
-            EB_InitialRateControlProcessInitCount,
+            enc_handle_ptr->scs_instance_array[0]->scs->initial_rate_control_fifo_init_count * pipeline_count,
+            EB_InitialRateControlProcessInitCount * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count,
             svt_aom_initial_rate_control_results_creator,
             &initial_rate_control_result_init_data,
@@ -2322,13 +2769,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     // TPL dispenser Results
-    {
+    if (host)
+        enc_handle_ptr->tpl_disp_res_srm = host->tpl_disp_res_srm;
+    else {
         EntropyCodingResultsInitData tpl_disp_result_init_data;
         //TPL Dispenser tasks
         EB_NEW(
             enc_handle_ptr->tpl_disp_res_srm,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_fifo_init_count * pipeline_count,
             tpl_port_total_count(),
             enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count,
             tpl_disp_results_creator,
@@ -2352,21 +2801,25 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     // Rate Control Results
-    {
+    if (host)
+        enc_handle_ptr->rate_control_results_resource_ptr = host->rate_control_results_resource_ptr;
+    else {
         RateControlResultsInitData rate_control_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->rate_control_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->rate_control_fifo_init_count,
-            EB_RateControlProcessInitCount,
+            enc_handle_ptr->scs_instance_array[0]->scs->rate_control_fifo_init_count * pipeline_count,
+            EB_RateControlProcessInitCount * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count,
             svt_aom_rate_control_results_creator,
             &rate_control_result_init_data,
             NULL);
     }
     // EncDec Tasks
-    {
+    if (host)
+        enc_handle_ptr->enc_dec_tasks_resource_ptr = host->enc_dec_tasks_resource_ptr;
+    else {
         EncDecTasksInitData mode_decision_result_init_data;
         unsigned i;
 
@@ -2381,7 +2834,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_NEW(
             enc_handle_ptr->enc_dec_tasks_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_fifo_init_count * pipeline_count,
             enc_dec_port_total_count(),
             enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count,
             svt_aom_enc_dec_tasks_creator,
@@ -2390,14 +2843,16 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     // EncDec Results
-    {
+    if (host)
+        enc_handle_ptr->enc_dec_results_resource_ptr = host->enc_dec_results_resource_ptr;
+    else {
         EncDecResultsInitData enc_dec_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->enc_dec_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_fifo_init_count * pipeline_count,
+            dlf_port_total_count(),
             enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count,
             svt_aom_enc_dec_results_creator,
             &enc_dec_result_init_data,
@@ -2405,13 +2860,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
     //DLF results
-    {
+    if (host)
+        enc_handle_ptr->dlf_results_resource_ptr = host->dlf_results_resource_ptr;
+    else {
         EntropyCodingResultsInitData delf_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->dlf_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->dlf_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->dlf_fifo_init_count * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
             dlf_results_creator,
@@ -2419,13 +2876,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             NULL);
     }
     //CDEF results
-    {
+    if (host)
+        enc_handle_ptr->cdef_results_resource_ptr = host->cdef_results_resource_ptr;
+    else {
         EntropyCodingResultsInitData cdef_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->cdef_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->cdef_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->cdef_fifo_init_count * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
             cdef_results_creator,
@@ -2433,19 +2892,35 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             NULL);
     }
     //REST results
-    {
+    if (host)
+        enc_handle_ptr->rest_results_resource_ptr = host->rest_results_resource_ptr;
+    else {
         EntropyCodingResultsInitData rest_result_init_data;
 
         EB_NEW(
             enc_handle_ptr->rest_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->rest_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->rest_fifo_init_count * pipeline_count,
             enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count,
             rest_results_creator,
             &rest_result_init_data,
             NULL);
     }
+    // Stat report tasks, one per picture handed over by Rest
+    if (host)
+        enc_handle_ptr->stat_report_tasks_resource_ptr = host->stat_report_tasks_resource_ptr;
+    else if (enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count) {
+        EB_NEW(
+            enc_handle_ptr->stat_report_tasks_resource_ptr,
+            svt_system_resource_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs->picture_control_set_pool_init_count_child,
+            enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count,
+            stat_report_tasks_creator,
+            NULL,
+            NULL);
+    }
 
     // Entropy Coding Results
     {
@@ -2474,6 +2949,69 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.recon_enabled)
             enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->recon_output_fifo_ptr  = svt_system_resource_get_producer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[instance_index], 0);
     }
+    // Sequential kernel queues, the parallel kernels post to the queues of the picture stream
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        EncodeContext *enc_ctx = enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx;
+        enc_ctx->picture_analysis_results_resource_ptr  = enc_handle_ptr->picture_analysis_results_resource_ptr;
+        enc_ctx->motion_estimation_results_resource_ptr = enc_handle_ptr->motion_estimation_results_resource_ptr;
+        enc_ctx->picture_demux_results_resource_ptr     = enc_handle_ptr->picture_demux_results_resource_ptr;
+        enc_ctx->entropy_coding_results_resource_ptr    = enc_handle_ptr->entropy_coding_results_resource_ptr;
+    }
+
+    // Input resource of every kernel, consumer i of a resource is thread i of the kernel. The kernels of
+    // the stream are the sequential ones, the others run on the threads of the pipeline host.
+    const struct {
+        const EbSystemResource *resource;
+        const char             *stage;
+        Bool                    sequential;
+    } kernel_inputs[] = {
+        {enc_handle_ptr->input_cmd_resource_ptr, "resource_coordination", TRUE},
+        {enc_handle_ptr->resource_coordination_results_resource_ptr, "picture_analysis", FALSE},
+        {enc_handle_ptr->picture_analysis_results_resource_ptr, "picture_decision", TRUE},
+        {enc_handle_ptr->picture_decision_results_resource_ptr, "motion_estimation", FALSE},
+        {enc_handle_ptr->motion_estimation_results_resource_ptr, "initial_rate_control", TRUE},
+        {enc_handle_ptr->initial_rate_control_results_resource_ptr, "source_based_operations", FALSE},
+        {enc_handle_ptr->picture_demux_results_resource_ptr, "picture_manager", TRUE},
+        {enc_handle_ptr->tpl_disp_res_srm, "tpl_dispenser", FALSE},
+        {enc_handle_ptr->rate_control_tasks_resource_ptr, "rate_control", TRUE},
+        {enc_handle_ptr->rate_control_results_resource_ptr, "mode_decision_configuration", FALSE},
+        {enc_handle_ptr->enc_dec_tasks_resource_ptr, "enc_dec", FALSE},
+        {enc_handle_ptr->enc_dec_results_resource_ptr, "dlf", FALSE},
+        {enc_handle_ptr->dlf_results_resource_ptr, "cdef", FALSE},
+        {enc_handle_ptr->cdef_results_resource_ptr, "rest", FALSE},
+        {enc_handle_ptr->rest_results_resource_ptr, "entropy_coding", FALSE},
+        {enc_handle_ptr->entropy_coding_results_resource_ptr, "packetization", TRUE},
+        {enc_handle_ptr->stat_report_tasks_resource_ptr, "stat_report", FALSE}, // last, NULL unless stat_report is set
+    };
+    const uint32_t kernel_count = sizeof(kernel_inputs) / sizeof(kernel_inputs[0]) -
+        (enc_handle_ptr->stat_report_tasks_resource_ptr == NULL);
+
+    // Worker tokens shared by the kernels when adaptive threading is on
+    if (enc_handle_ptr->scs_instance_array[0]->scs->worker_token_count) {
+        SequenceControlSet *scs = enc_handle_ptr->scs_instance_array[0]->scs;
+        // the tokens may already be shared with other encoders (parallel segments)
+        if (!scs->worker_tokens)
+            EB_CREATE_SEMAPHORE(scs->worker_tokens, scs->worker_token_count, scs->worker_token_count);
+        for (uint32_t i = 0; i < kernel_count; i++)
+            if (!host || kernel_inputs[i].sequential)
+                svt_system_resource_set_worker_tokens(kernel_inputs[i].resource, scs->worker_tokens);
+    }
+
+    // Pipeline profile
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.pipeline_profile) {
+        uint32_t thread_total_count = 0;
+        for (uint32_t i = 0; i < kernel_count; i++)
+            if (!host || kernel_inputs[i].sequential)
+                thread_total_count += kernel_inputs[i].resource->full_queue->process_total_count;
+        EB_NEW(enc_handle_ptr->pipeline_profile, svt_aom_pipeline_profile_ctor, thread_total_count);
+        for (uint32_t i = 0; i < kernel_count; i++)
+            if (!host || kernel_inputs[i].sequential)
+                svt_system_resource_set_profile(
+                    kernel_inputs[i].resource,
+                    svt_aom_pipeline_profile_add_stage(enc_handle_ptr->pipeline_profile,
+                                                       kernel_inputs[i].stage,
+                                                       kernel_inputs[i].resource->full_queue->process_total_count));
+    }
 
     /************************************
     * Contexts
@@ -2485,17 +3023,21 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         svt_aom_resource_coordination_context_ctor,
         enc_handle_ptr);
 
-    // Picture Analysis Context
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count);
+    // The parallel kernels of a segment encoder are the ones of its pipeline host
+    if (!host) {
+        // Picture Analysis Context
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count);
 
-    for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count; ++process_index) {
+        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count; ++process_index) {
 
-        EB_NEW(
-            enc_handle_ptr->picture_analysis_context_ptr_array[process_index],
-            svt_aom_picture_analysis_context_ctor,
-            enc_handle_ptr,
-            process_index);
-   }
+            EB_NEW(
+                enc_handle_ptr->picture_analysis_context_ptr_array[process_index],
+                svt_aom_picture_analysis_context_ctor,
+                enc_handle_ptr,
+                process_index,
+                EB_ResourceCoordinationProcessInitCount + process_index); // denoise task port index
+       }
+    }
 
     // Picture Decision Context
     {
@@ -2509,45 +3051,49 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[instance_index]->scs->calc_hist);
     }
 
-    // Motion Analysis Context
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count);
+    if (!host) {
+        // Motion Analysis Context
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count);
 
-    for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count; ++process_index) {
-        EB_NEW(
-            enc_handle_ptr->motion_estimation_context_ptr_array[process_index],
-            svt_aom_motion_estimation_context_ctor,
-            enc_handle_ptr,
-            process_index);
+        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count; ++process_index) {
+            EB_NEW(
+                enc_handle_ptr->motion_estimation_context_ptr_array[process_index],
+                svt_aom_motion_estimation_context_ctor,
+                enc_handle_ptr,
+                process_index,
+                EB_PictureDecisionProcessInitCount + EB_RateControlProcessInitCount + EB_PacketizationProcessInitCount + process_index);  // me_port_index
+        }
     }
 
-
         // Initial Rate Control Context
         EB_NEW(
             enc_handle_ptr->initial_rate_control_context_ptr,
             svt_aom_initial_rate_control_context_ctor,
             enc_handle_ptr);
-        // Source Based Operations Context
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count);
+        if (!host) {
+            // Source Based Operations Context
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count);
 
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->source_based_operations_context_ptr_array[process_index],
-                svt_aom_source_based_operations_context_ctor,
-                enc_handle_ptr,
-                tpl_port_lookup(TPL_INPUT_PORT_SOP, process_index),
-                pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_SOP, process_index));
-        }
-        // TPL dispenser
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count);
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->source_based_operations_context_ptr_array[process_index],
+                    svt_aom_source_based_operations_context_ctor,
+                    enc_handle_ptr,
+                    tpl_port_lookup(TPL_INPUT_PORT_SOP, process_index),
+                    pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_SOP, process_index));
+            }
+            // TPL dispenser
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count);
 
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->tpl_disp_context_ptr_array[process_index],
-                svt_aom_tpl_disp_context_ctor,
-                enc_handle_ptr,
-                process_index,
-                tpl_port_lookup(TPL_INPUT_PORT_TPL, process_index)
-            );
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->tpl_disp_context_ptr_array[process_index],
+                    svt_aom_tpl_disp_context_ctor,
+                    enc_handle_ptr,
+                    process_index,
+                    tpl_port_lookup(TPL_INPUT_PORT_TPL, process_index)
+                );
+            }
         }
         // Picture Manager Context
         EB_NEW(
@@ -2562,77 +3108,93 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr,
             EB_PictureDecisionProcessInitCount);  // me_port_index
 
-        // Mode Decision Configuration Contexts
-        {
+        if (!host) {
             // Mode Decision Configuration Contexts
-            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count);
+            {
+                // Mode Decision Configuration Contexts
+                EB_ALLOC_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count);
+
+                for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count; ++process_index) {
+                    EB_NEW(
+                        enc_handle_ptr->mode_decision_configuration_context_ptr_array[process_index],
+                        svt_aom_mode_decision_configuration_context_ctor,
+                        enc_handle_ptr,
+                        process_index,
+                        enc_dec_port_lookup(ENCDEC_INPUT_PORT_MDC, process_index));
+                }
+            }
+            // EncDec Contexts
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count);
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->enc_dec_context_ptr_array[process_index],
+                    svt_aom_enc_dec_context_ctor,
+                    enc_handle_ptr,
+                    process_index,
+                    enc_dec_port_lookup(ENCDEC_INPUT_PORT_ENCDEC, process_index));
+            }
+
+            // Dlf Contexts
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count);
 
-            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count; ++process_index) {
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count; ++process_index) {
                 EB_NEW(
-                    enc_handle_ptr->mode_decision_configuration_context_ptr_array[process_index],
-                    svt_aom_mode_decision_configuration_context_ctor,
+                    enc_handle_ptr->dlf_context_ptr_array[process_index],
+                    svt_aom_dlf_context_ctor,
                     enc_handle_ptr,
                     process_index,
-                    enc_dec_port_lookup(ENCDEC_INPUT_PORT_MDC, process_index));
+                    dlf_port_lookup(DLF_INPUT_PORT_DLF, process_index));
             }
-        }
-        // EncDec Contexts
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count);
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->enc_dec_context_ptr_array[process_index],
-                svt_aom_enc_dec_context_ctor,
-                enc_handle_ptr,
-                process_index,
-                enc_dec_port_lookup(ENCDEC_INPUT_PORT_ENCDEC, process_index));
-        }
 
-        // Dlf Contexts
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count);
+            //CDEF Contexts
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count);
 
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->dlf_context_ptr_array[process_index],
-                svt_aom_dlf_context_ctor,
-                enc_handle_ptr,
-                process_index);
-        }
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->cdef_context_ptr_array[process_index],
+                    svt_aom_cdef_context_ctor,
+                    enc_handle_ptr,
+                    process_index);
+            }
+            //Rest Contexts
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count);
 
-        //CDEF Contexts
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count);
+            EbPictureBufferDescInitData input_data;
+            input_data.enc_mode = enc_handle_ptr->scs_instance_array[0]->scs->static_config.enc_mode;
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->rest_context_ptr_array[process_index],
+                    svt_aom_rest_context_ctor,
+                    enc_handle_ptr,
+                    &input_data,
+                    process_index,
+                    pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_REST, process_index));
+            }
 
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->cdef_context_ptr_array[process_index],
-                svt_aom_cdef_context_ctor,
-                enc_handle_ptr,
-                process_index);
-        }
-        //Rest Contexts
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count);
+            // Stat Report Contexts
+            if (enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count) {
+                EB_ALLOC_PTR_ARRAY(enc_handle_ptr->stat_report_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count);
 
-        EbPictureBufferDescInitData input_data;
-        input_data.enc_mode = enc_handle_ptr->scs_instance_array[0]->scs->static_config.enc_mode;
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->rest_context_ptr_array[process_index],
-                svt_aom_rest_context_ctor,
-                enc_handle_ptr,
-                &input_data,
-                process_index,
-                pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_REST, process_index));
-        }
+                for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->stat_report_process_init_count; ++process_index) {
+                    EB_NEW(
+                        enc_handle_ptr->stat_report_context_ptr_array[process_index],
+                        svt_aom_stat_report_context_ctor,
+                        enc_handle_ptr,
+                        process_index);
+                }
+            }
 
-        // Entropy Coding Contexts
-        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count);
+            // Entropy Coding Contexts
+            EB_ALLOC_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count);
 
-        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count; ++process_index) {
-            EB_NEW(
-                enc_handle_ptr->entropy_coding_context_ptr_array[process_index],
-                svt_aom_entropy_coding_context_ctor,
-                enc_handle_ptr,
-                process_index,
-                rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_ENTROPY_CODING, process_index));
+            for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count; ++process_index) {
+                EB_NEW(
+                    enc_handle_ptr->entropy_coding_context_ptr_array[process_index],
+                    svt_aom_entropy_coding_context_ctor,
+                    enc_handle_ptr,
+                    process_index,
+                    rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_ENTROPY_CODING, process_index));
+            }
         }
 
     // Packetization Context
@@ -2646,78 +3208,84 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * Thread Handles
     ************************************/
-    EbSvtAv1EncConfiguration   *config_ptr = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
-#if CLN_LP_LVLS
-    if (config_ptr->pin_threads || config_ptr->target_socket != -1)
-#else
-    if (config_ptr->pin_threads == 1)
-#endif
-        svt_set_thread_management_parameters(config_ptr);
-
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
 
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
-        svt_aom_picture_analysis_kernel,
-        enc_handle_ptr->picture_analysis_context_ptr_array);
+    if (!host) {
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
+            svt_aom_picture_analysis_kernel,
+            enc_handle_ptr->picture_analysis_context_ptr_array);
+    }
 
     // Picture Decision
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
-    // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
-        svt_aom_motion_estimation_kernel,
-        enc_handle_ptr->motion_estimation_context_ptr_array);
+    if (!host) {
+        // Motion Estimation
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+            svt_aom_motion_estimation_kernel,
+            enc_handle_ptr->motion_estimation_context_ptr_array);
+    }
 
         // Initial Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
-        // Source Based Oprations
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
-            svt_aom_source_based_operations_kernel,
-            enc_handle_ptr->source_based_operations_context_ptr_array);
+        if (!host) {
+            // Source Based Oprations
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
+                svt_aom_source_based_operations_kernel,
+                enc_handle_ptr->source_based_operations_context_ptr_array);
 
-        // TPL dispenser
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
-            svt_aom_tpl_disp_kernel,//TODOOMK
-            enc_handle_ptr->tpl_disp_context_ptr_array);
+            // TPL dispenser
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
+                svt_aom_tpl_disp_kernel,//TODOOMK
+                enc_handle_ptr->tpl_disp_context_ptr_array);
+        }
         // Picture Manager
         EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
         // Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
-        // Mode Decision Configuration Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
-            svt_aom_mode_decision_configuration_kernel,
-            enc_handle_ptr->mode_decision_configuration_context_ptr_array);
+        if (!host) {
+            // Mode Decision Configuration Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+                svt_aom_mode_decision_configuration_kernel,
+                enc_handle_ptr->mode_decision_configuration_context_ptr_array);
+
 
+            // EncDec Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+                svt_aom_mode_decision_kernel,
+                enc_handle_ptr->enc_dec_context_ptr_array);
 
-        // EncDec Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
-            svt_aom_mode_decision_kernel,
-            enc_handle_ptr->enc_dec_context_ptr_array);
+            // Dlf Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+                svt_aom_dlf_kernel,
+                enc_handle_ptr->dlf_context_ptr_array);
 
-        // Dlf Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
-            svt_aom_dlf_kernel,
-            enc_handle_ptr->dlf_context_ptr_array);
+            // Cdef Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+                svt_aom_cdef_kernel,
+                enc_handle_ptr->cdef_context_ptr_array);
 
-        // Cdef Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
-            svt_aom_cdef_kernel,
-            enc_handle_ptr->cdef_context_ptr_array);
+            // Rest Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+                svt_aom_rest_kernel,
+                enc_handle_ptr->rest_context_ptr_array);
 
-        // Rest Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
-            svt_aom_rest_kernel,
-            enc_handle_ptr->rest_context_ptr_array);
+            // Stat Report Process
+            if (control_set_ptr->stat_report_process_init_count)
+                EB_CREATE_THREAD_ARRAY(enc_handle_ptr->stat_report_thread_handle_array, control_set_ptr->stat_report_process_init_count,
+                    svt_aom_stat_report_kernel,
+                    enc_handle_ptr->stat_report_context_ptr_array);
 
-        // Entropy Coding Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
-            svt_aom_entropy_coding_kernel,
-            enc_handle_ptr->entropy_coding_context_ptr_array);
+            // Entropy Coding Process
+            EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+                svt_aom_entropy_coding_kernel,
+                enc_handle_ptr->entropy_coding_context_ptr_array);
 
+        }
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
 
@@ -2726,6 +3294,45 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     return return_error;
 }
 
+EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr->segments)
+        return svt_aom_segments_init(enc_handle_ptr->segments);
+    EbSvtAv1EncConfiguration *config_ptr = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
+#if CLN_LP_LVLS
+    if (config_ptr->pin_threads || config_ptr->target_socket != -1)
+#else
+    if (config_ptr->pin_threads == 1)
+#endif
+        svt_set_thread_management_parameters(config_ptr);
+
+    // The pools, contexts and threads created here are charged to the handle
+    EbMemoryAccount *previous_account    = svt_memory_account_set(&enc_handle_ptr->memory_account);
+    const Bool       previous_huge_pages = svt_huge_pages_set(config_ptr->huge_pages);
+    CallerAffinity   caller_affinity;
+    const Bool       bound = bind_to_target_socket(config_ptr, &caller_affinity);
+    EbErrorType      return_error        = init_encoder(enc_handle_ptr);
+    if (return_error == EB_ErrorNone) {
+        // Kept to start the next stream from the same state, see svt_av1_enc_reset()
+        enc_handle_ptr->stream_config = *config_ptr;
+        return_error = svt_aom_encode_context_save_start(enc_handle_ptr->scs_instance_array[0]->enc_ctx);
+        // the budget was fitted on the picture pools, the contexts of the kernels are only known now
+        const uint64_t held = account_bytes(&enc_handle_ptr->memory_account);
+        if (config_ptr->memory_budget_mb && held > (uint64_t)config_ptr->memory_budget_mb << 20)
+            SVT_WARN("Memory budget of %u MB exceeded, the encoder holds %u MB\n",
+                     config_ptr->memory_budget_mb,
+                     (uint32_t)(held >> 20));
+    }
+    if (bound)
+        restore_caller_affinity(&caller_affinity);
+    svt_huge_pages_set(previous_huge_pages);
+    svt_memory_account_set(previous_account);
+    return return_error;
+}
+
 static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     bool eos = false;
     do {
@@ -2745,6 +3352,123 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     return EB_ErrorNone;
 }
 
+/*
+  Waits until every object of the pool is back in its empty FIFO: they are all taken, which blocks
+  until the pipeline has released the last one, then handed back.
+*/
+static void wait_for_pool_release(EbSystemResource *resource_ptr) {
+    if (!resource_ptr)
+        return;
+    EbFifo *empty_fifo_ptr = svt_system_resource_get_producer_fifo(resource_ptr, 0);
+    for (uint32_t i = 0; i < resource_ptr->object_total_count; i++) {
+        EbObjectWrapper *wrapper_ptr;
+        svt_get_empty_object(empty_fifo_ptr, &wrapper_ptr);
+    }
+    for (uint32_t i = 0; i < resource_ptr->object_total_count; i++)
+        svt_release_object(resource_ptr->wrapper_ptr_pool[i]);
+}
+
+/**********************************
+* Reset Encoder Library
+**********************************/
+EB_API EbErrorType svt_av1_enc_reset(EbComponentType *svt_enc_component) {
+    if (!svt_enc_component || !svt_enc_component->p_component_private)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle *handle = svt_enc_component->p_component_private;
+    if (handle->segments || !handle->input_y8b_buffer_producer_fifo_ptr)
+        return EB_ErrorBadParameter;
+    SequenceControlSet *scs = handle->scs_instance_array[0]->scs;
+    if (scs->static_config.pass != ENC_SINGLE_PASS) {
+        SVT_ERROR("svt_av1_enc_reset is only supported for single pass encoding\n");
+        return EB_ErrorBadParameter;
+    }
+
+    if (handle->frame_received) {
+        if (!handle->eos_received) {
+            SVT_WARN("svt_av1_enc_reset called without sending EOS, the stream is terminated\n");
+            svt_av1_enc_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
+        }
+        EbErrorType return_error = enc_drain_queue(svt_enc_component);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    if (scs->max_input_luma_width != scs->max_initial_input_luma_width ||
+        scs->max_input_luma_height != scs->max_initial_input_luma_height) {
+        SVT_ERROR("svt_av1_enc_reset is not supported after a resolution change on the fly\n");
+        return EB_ErrorBadParameter;
+    }
+
+    // The last picture is only released at the start of the next stream, then the pipeline is idle once
+    // every picture and task is back in its pool. The output packets may still be held by the application.
+    svt_aom_resource_coordination_reset(handle->resource_coordination_context_ptr);
+    for (uint32_t instance_index = 0; instance_index < handle->encode_instance_total_count; instance_index++) {
+        wait_for_pool_release(handle->picture_parent_control_set_pool_ptr_array[instance_index]);
+        wait_for_pool_release(handle->me_pool_ptr_array[instance_index]);
+        wait_for_pool_release(handle->reference_picture_pool_ptr_array[instance_index]);
+        wait_for_pool_release(handle->tpl_reference_picture_pool_ptr_array[instance_index]);
+        wait_for_pool_release(handle->pa_reference_picture_pool_ptr_array[instance_index]);
+        wait_for_pool_release(handle->overlay_input_picture_pool_ptr_array[instance_index]);
+    }
+    wait_for_pool_release(handle->input_cmd_resource_ptr);
+    wait_for_pool_release(handle->picture_analysis_results_resource_ptr);
+    wait_for_pool_release(handle->motion_estimation_results_resource_ptr);
+    wait_for_pool_release(handle->picture_demux_results_resource_ptr);
+    wait_for_pool_release(handle->rate_control_tasks_resource_ptr);
+    wait_for_pool_release(handle->entropy_coding_results_resource_ptr);
+    // With parallel segments, the other streams keep running through the shared pipeline: the
+    // pictures of this one are out of it once their parent picture control sets are released
+    if (handle->pipeline_count == 1) {
+        for (uint32_t instance_index = 0; instance_index < handle->encode_instance_total_count; instance_index++) {
+            wait_for_pool_release(handle->picture_control_set_pool_ptr_array[instance_index]);
+            wait_for_pool_release(handle->enc_dec_pool_ptr_array[instance_index]);
+        }
+        wait_for_pool_release(handle->input_buffer_resource_ptr);
+        wait_for_pool_release(handle->input_y8b_buffer_resource_ptr);
+        wait_for_pool_release(handle->resource_coordination_results_resource_ptr);
+        wait_for_pool_release(handle->picture_decision_results_resource_ptr);
+        wait_for_pool_release(handle->initial_rate_control_results_resource_ptr);
+        wait_for_pool_release(handle->tpl_disp_res_srm);
+        wait_for_pool_release(handle->rate_control_results_resource_ptr);
+        wait_for_pool_release(handle->enc_dec_tasks_resource_ptr);
+        wait_for_pool_release(handle->enc_dec_results_resource_ptr);
+        wait_for_pool_release(handle->dlf_results_resource_ptr);
+        wait_for_pool_release(handle->cdef_results_resource_ptr);
+        wait_for_pool_release(handle->rest_results_resource_ptr);
+        wait_for_pool_release(handle->stat_report_tasks_resource_ptr);
+    }
+    // the recon pictures not fetched belong to the previous stream
+    if (scs->static_config.recon_enabled) {
+        EbObjectWrapper *recon_wrapper_ptr;
+        do {
+            recon_wrapper_ptr = NULL;
+            svt_get_full_object_non_blocking(handle->output_recon_buffer_consumer_fifo_ptr, &recon_wrapper_ptr);
+            if (recon_wrapper_ptr) {
+                EbBufferHeaderType *recon_ptr = (EbBufferHeaderType *)recon_wrapper_ptr->object_ptr;
+                if (recon_ptr->metadata)
+                    svt_metadata_array_free(&recon_ptr->metadata);
+                svt_release_object(recon_wrapper_ptr);
+            }
+        } while (recon_wrapper_ptr);
+    }
+
+    // The threads and buffers are kept, only the state of the stream is reset
+    svt_aom_picture_decision_reset(handle->picture_decision_context_ptr);
+    svt_aom_initial_rate_control_reset(handle->initial_rate_control_context_ptr);
+    svt_aom_picture_manager_reset(handle->picture_manager_context_ptr);
+    svt_aom_packetization_reset(handle->packetization_context_ptr);
+    svt_aom_encode_context_reset(handle->scs_instance_array[0]->enc_ctx);
+    svt_block_on_mutex(handle->scs_instance_array[0]->config_mutex);
+    scs->static_config = handle->stream_config;
+    svt_release_mutex(handle->scs_instance_array[0]->config_mutex);
+
+    handle->eos_received   = false;
+    handle->eos_sent       = false;
+    handle->frame_received = false;
+    handle->is_prev_valid  = true;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -2754,6 +3478,9 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
 
     EbEncHandle *handle = svt_enc_component->p_component_private;
 
+    if (handle->segments)
+        return svt_aom_segments_deinit(handle->segments);
+
     if (handle->input_y8b_buffer_producer_fifo_ptr && handle->frame_received) {
         if (!handle->eos_received) {
             SVT_ERROR("deinit called without sending EOS!\n");
@@ -2766,24 +3493,29 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     }
     #ifdef MINIMAL_BUILD
     svt_aom_free(svt_aom_blk_geom_mds);
+    svt_aom_blk_geom_mds = NULL;
     #endif
-    svt_shutdown_process(handle->input_buffer_resource_ptr);
     svt_shutdown_process(handle->input_cmd_resource_ptr);
-    svt_shutdown_process(handle->resource_coordination_results_resource_ptr);
     svt_shutdown_process(handle->picture_analysis_results_resource_ptr);
-    svt_shutdown_process(handle->picture_decision_results_resource_ptr);
     svt_shutdown_process(handle->motion_estimation_results_resource_ptr);
-    svt_shutdown_process(handle->initial_rate_control_results_resource_ptr);
     svt_shutdown_process(handle->picture_demux_results_resource_ptr);
-    svt_shutdown_process(handle->tpl_disp_res_srm);
     svt_shutdown_process(handle->rate_control_tasks_resource_ptr);
+    svt_shutdown_process(handle->entropy_coding_results_resource_ptr);
+    // the pipeline host stops the shared kernels once the segment encoders are done
+    if (handle->pipeline_host)
+        return EB_ErrorNone;
+    svt_shutdown_process(handle->input_buffer_resource_ptr);
+    svt_shutdown_process(handle->resource_coordination_results_resource_ptr);
+    svt_shutdown_process(handle->picture_decision_results_resource_ptr);
+    svt_shutdown_process(handle->initial_rate_control_results_resource_ptr);
+    svt_shutdown_process(handle->tpl_disp_res_srm);
     svt_shutdown_process(handle->rate_control_results_resource_ptr);
     svt_shutdown_process(handle->enc_dec_tasks_resource_ptr);
     svt_shutdown_process(handle->enc_dec_results_resource_ptr);
-    svt_shutdown_process(handle->entropy_coding_results_resource_ptr);
     svt_shutdown_process(handle->dlf_results_resource_ptr);
     svt_shutdown_process(handle->cdef_results_resource_ptr);
     svt_shutdown_process(handle->rest_results_resource_ptr);
+    svt_shutdown_process(handle->stat_report_tasks_resource_ptr);
 
     return EB_ErrorNone;
 }
@@ -4900,6 +5632,11 @@ static void copy_api_from_app(
     scs->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)config_struct)->logical_processors;
 #endif
     scs->static_config.pin_threads = ((EbSvtAv1EncConfiguration*)config_struct)->pin_threads;
+    scs->static_config.adaptive_threading = ((EbSvtAv1EncConfiguration*)config_struct)->adaptive_threading;
+    scs->static_config.pipeline_profile = ((EbSvtAv1EncConfiguration*)config_struct)->pipeline_profile;
+    scs->static_config.parallel_segments = ((EbSvtAv1EncConfiguration*)config_struct)->parallel_segments;
+    scs->static_config.memory_budget_mb = ((EbSvtAv1EncConfiguration*)config_struct)->memory_budget_mb;
+    scs->static_config.huge_pages = ((EbSvtAv1EncConfiguration*)config_struct)->huge_pages;
     scs->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
 #if !CLN_LP_LVLS
     if ((scs->static_config.pin_threads == 0) && (scs->static_config.target_socket != -1)){
@@ -5044,6 +5781,11 @@ static void copy_api_from_app(
     // Spy rd
     scs->static_config.spy_rd = config_struct->spy_rd;
 
+    // Zero-copy input
+    scs->static_config.zero_copy_input             = config_struct->zero_copy_input;
+    scs->static_config.release_input_frame         = config_struct->release_input_frame;
+    scs->static_config.release_input_frame_private = config_struct->release_input_frame_private;
+
     // Override settings for Still Picture tune
     if (scs->static_config.tune == 4) {
         SVT_WARN("Tune 4: Still Picture is experimental, expect frequent changes that may modify present behavior.\n");
@@ -5090,12 +5832,27 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     if (return_error == EB_ErrorBadParameter)
         return EB_ErrorBadParameter;
 
+    // Parallel segments: the segment encoders are set with the configuration instead of this handle
+    if (config_struct->parallel_segments > 1) {
+        EB_DELETE(enc_handle->segments);
+        // the handles of the segment encoders are charged here, their pools to themselves
+        EbMemoryAccount *previous_account = svt_memory_account_set(&enc_handle->memory_account);
+        EB_NO_THROW_NEW(enc_handle->segments,
+                        svt_aom_segments_ctor,
+                        config_struct,
+                        svt_enc_component->p_application_private);
+        svt_memory_account_set(previous_account);
+        return enc_handle->segments ? EB_ErrorNone : EB_ErrorInsufficientResources;
+    }
+
     set_param_based_on_input(
         enc_handle->scs_instance_array[instance_index]->scs);
     // Initialize the Prediction Structure Group
+    EbMemoryAccount *previous_account = svt_memory_account_set(&enc_handle->memory_account);
     EB_NO_THROW_NEW(
         enc_handle->scs_instance_array[instance_index]->enc_ctx->prediction_structure_group_ptr,
         svt_aom_prediction_structure_group_ctor);
+    svt_memory_account_set(previous_account);
     if (!enc_handle->scs_instance_array[instance_index]->enc_ctx->prediction_structure_group_ptr) {
         return EB_ErrorInsufficientResources;
     }
@@ -5123,6 +5880,9 @@ EB_API EbErrorType svt_av1_enc_stream_header(
         return EB_ErrorBadParameter;
 
     EbEncHandle             *enc_handle  = (EbEncHandle*)svt_enc_component->p_component_private;
+    // all the segment encoders share the sequence header
+    if (enc_handle->segments)
+        return svt_av1_enc_stream_header(enc_handle->segments->encoders[0].component, output_stream_ptr);
     SequenceControlSet      *scs = enc_handle->scs_instance_array[0]->scs;
     Bitstream                bitstream;
     OutputBitstreamUnit      output_bitstream;
@@ -5705,6 +6465,39 @@ static void memset_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst
         dst->p_app_private = NULL;
 }
 
+/*
+ Make the library buffers reference the planes of the caller frame (zero-copy input).
+ Returns FALSE when the frame does not have the layout of the library buffers,
+ see SVT_AV1_STREAM_INFO_INPUT_LAYOUT, and has to be copied.
+*/
+static Bool reference_frame_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
+                                   EbBufferHeaderType* dst_y8b, EbBufferHeaderType* src) {
+    EbSvtAv1EncConfiguration *config                = &scs->static_config;
+    EbPictureBufferDesc      *input_pic             = (EbPictureBufferDesc*)dst->p_buffer;
+    EbPictureBufferDesc      *y8b_input_picture_ptr = (EbPictureBufferDesc*)dst_y8b->p_buffer;
+    EbSvtIOFormat            *input_ptr             = (EbSvtIOFormat*)src->p_buffer;
+
+    // 10bit input is always unpacked into the 8bit + 2bit compressed library format
+    if (config->encoder_bit_depth > EB_EIGHT_BIT || scs->first_pass_ctrls.ds)
+        return FALSE;
+    if (input_ptr->y_stride != y8b_input_picture_ptr->stride_y || input_ptr->cb_stride != input_pic->stride_cb ||
+        input_ptr->cr_stride != input_pic->stride_cr)
+        return FALSE;
+
+    const uint32_t luma_buffer_offset   = input_pic->stride_y * scs->top_padding + scs->left_padding;
+    const uint32_t chroma_buffer_offset = input_pic->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1);
+
+    y8b_input_picture_ptr->buffer_y = input_ptr->luma - luma_buffer_offset;
+    input_pic->buffer_cb            = input_ptr->cb - chroma_buffer_offset;
+    input_pic->buffer_cr            = input_ptr->cr - chroma_buffer_offset;
+
+    EbExtFrameBuf *ext_frame = &((EbInputBufferHeader*)dst_y8b)->ext_frame;
+    ext_frame->buffer        = src->p_buffer;
+    ext_frame->buffer_size   = src->n_filled_len;
+    ext_frame->private_data  = config->release_input_frame_private;
+    return TRUE;
+}
+
 /*
  Copy the input buffer header content
 from the sample application to the library buffers
@@ -5730,7 +6523,8 @@ static void copy_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
         // Bypass copy for the unecessary picture in IPPP pass
         // Copy the picture buffer
         if (src->p_buffer != NULL) {
-            copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
+            if (!scs->static_config.zero_copy_input || !reference_frame_buffer(scs, dst, dst_y8b, src))
+                copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
             // Copy the metadata array
             if (svt_aom_copy_metadata_buffer(dst, src->metadata) != EB_ErrorNone)
                 dst->metadata = NULL;
@@ -5859,7 +6653,11 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr;
     EbBufferHeaderType   *app_hdr = p_buffer;
+    if (enc_handle_ptr->segments)
+        return svt_aom_segments_send_picture(enc_handle_ptr->segments, p_buffer);
     enc_handle_ptr->frame_received = true;
+    // the input buffers are resized here when the resolution changes
+    EbMemoryAccount *previous_account = svt_memory_account_set(&enc_handle_ptr->memory_account);
 
     // Exit the library if we detect an invalid API input buffer @ the previous library call
     if (enc_handle_ptr->is_prev_valid == false) {
@@ -5906,6 +6704,14 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         EbBufferHeaderType *lib_y8b_hdr = (EbBufferHeaderType*)y8b_wrapper->object_ptr;
         EbBufferHeaderType *lib_reg_hdr = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
 
+        // point the planes back to the library buffers, a caller frame is only referenced when
+        // it is not copied below
+        EbInputBufferHeader *y8b_buffer = (EbInputBufferHeader*)lib_y8b_hdr;
+        EbInputBufferHeader *reg_buffer = (EbInputBufferHeader*)lib_reg_hdr;
+        ((EbPictureBufferDesc*)lib_y8b_hdr->p_buffer)->buffer_y  = y8b_buffer->own_y;
+        ((EbPictureBufferDesc*)lib_reg_hdr->p_buffer)->buffer_cb = reg_buffer->own_cb;
+        ((EbPictureBufferDesc*)lib_reg_hdr->p_buffer)->buffer_cr = reg_buffer->own_cr;
+
         // check whether the n_filled_len has enough samples to be processed
         EbPictureBufferDesc* input_pic = (EbPictureBufferDesc*)lib_y8b_hdr->p_buffer;
         SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[0]->scs;
@@ -5941,6 +6747,11 @@ EB_API EbErrorType svt_av1_enc_send_picture(
                 app_hdr,
                 0);
         }
+        // a caller frame that was copied is no longer needed
+        if (config->zero_copy_input && app_hdr->p_buffer != NULL && !y8b_buffer->ext_frame.buffer) {
+            EbExtFrameBuf ext_frame = {app_hdr->p_buffer, app_hdr->n_filled_len, config->release_input_frame_private};
+            config->release_input_frame(&ext_frame, config->release_input_frame_private);
+        }
     }
 
     //Take a new App-RessCoord command
@@ -5954,6 +6765,7 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     input_cmd_obj->y8b_wrapper = y8b_wrapper;
     //Send to Lib
     svt_post_full_object(input_cmd_wrp);
+    svt_memory_account_set(previous_account);
     return return_val;
 }
 static void copy_output_recon_buffer(
@@ -5995,6 +6807,8 @@ EB_API EbErrorType svt_av1_enc_get_packet(
     EbEncHandle          *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr = NULL;
     EbBufferHeaderType    *packet;
+    if (enc_handle->segments)
+        return svt_aom_segments_get_packet(enc_handle->segments, p_buffer, pic_send_done);
     const EbSvtAv1EncConfiguration* cfg = &enc_handle->scs_instance_array[0]->scs->static_config;
 
     // check if the user is claiming that the last picture has been sent
@@ -6038,6 +6852,8 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 EB_API void svt_av1_enc_release_out_buffer(
     EbBufferHeaderType  **p_buffer)
 {
+    if (p_buffer && *p_buffer && svt_aom_segments_release_packet(*p_buffer))
+        return;
     if (p_buffer && (*p_buffer)->wrapper_ptr)
     {
         if((*p_buffer)->p_buffer)
@@ -6087,6 +6903,49 @@ EB_API EbErrorType svt_av1_get_recon(
     return return_error;
 }
 
+/**********************************
+* Scale Picture
+**********************************/
+EB_API EbErrorType svt_av1_scale_picture(
+    const EbSvtIOFormat  *src,
+    EbSvtIOFormat        *dst)
+{
+    if (!src || !dst || !src->width || !src->height || !dst->width || !dst->height)
+        return EB_ErrorBadParameter;
+    // the resize kernels are set up by the first svt_av1_enc_init()
+    if (!svt_av1_resize_plane || !svt_av1_highbd_resize_plane)
+        return EB_ErrorBadParameter;
+    const int ss_x = src->color_fmt == EB_YUV444 ? 0 : 1;
+    const int ss_y = src->color_fmt == EB_YUV420 ? 1 : 0;
+    const int num_planes = src->color_fmt == EB_YUV400 ? 1 : 3;
+    const uint8_t *const src_planes[3] = {src->luma, src->cb, src->cr};
+    uint8_t *const dst_planes[3] = {dst->luma, dst->cb, dst->cr};
+    const uint32_t src_strides[3] = {src->y_stride, src->cb_stride, src->cr_stride};
+    const uint32_t dst_strides[3] = {dst->y_stride, dst->cb_stride, dst->cr_stride};
+
+    for (int plane = 0; plane < num_planes; ++plane) {
+        const int sx = plane ? ss_x : 0;
+        const int sy = plane ? ss_y : 0;
+        const int width = (int)((src->width + sx) >> sx);
+        const int height = (int)((src->height + sy) >> sy);
+        const int width2 = (int)((dst->width + sx) >> sx);
+        const int height2 = (int)((dst->height + sy) >> sy);
+        EbErrorType return_error;
+        if (src->bit_depth > EB_EIGHT_BIT)
+            return_error = svt_av1_highbd_resize_plane(
+                (const uint16_t*)src_planes[plane], height, width, (int)src_strides[plane],
+                (uint16_t*)dst_planes[plane], height2, width2, (int)dst_strides[plane],
+                (int)src->bit_depth);
+        else
+            return_error = svt_av1_resize_plane(
+                src_planes[plane], height, width, (int)src_strides[plane],
+                dst_planes[plane], height2, width2, (int)dst_strides[plane]);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Encoder Error Handling
 **********************************/
@@ -6286,7 +7145,7 @@ EbErrorType svt_input_y8b_creator(
     SequenceControlSet        *scs = (SequenceControlSet*)object_init_data_ptr;
 
     *object_dbl_ptr = NULL;
-    EB_CALLOC(input_buffer, 1, sizeof(EbBufferHeaderType));
+    EB_CALLOC(input_buffer, 1, sizeof(EbInputBufferHeader));
     *object_dbl_ptr = (EbPtr)input_buffer;
     // Initialize Header
     input_buffer->size = sizeof(EbBufferHeaderType);
@@ -6296,6 +7155,7 @@ EbErrorType svt_input_y8b_creator(
         input_buffer);
     if (return_error != EB_ErrorNone)
         return return_error;
+    ((EbInputBufferHeader*)input_buffer)->own_y = ((EbPictureBufferDesc*)input_buffer->p_buffer)->buffer_y;
 
     input_buffer->p_app_private = NULL;
 
@@ -6309,6 +7169,7 @@ void svt_input_y8b_destroyer(EbPtr p)
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
     if (buf) {
+        buf->buffer_y = ((EbInputBufferHeader*)obj)->own_y;
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_y);
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cb);
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cr);
@@ -6329,7 +7190,7 @@ EbErrorType svt_input_buffer_header_creator(
     SequenceControlSet        *scs = (SequenceControlSet*)object_init_data_ptr;
 
     *object_dbl_ptr = NULL;
-    EB_CALLOC(input_buffer, 1, sizeof(EbBufferHeaderType));
+    EB_CALLOC(input_buffer, 1, sizeof(EbInputBufferHeader));
     *object_dbl_ptr = (EbPtr)input_buffer;
     // Initialize Header
     input_buffer->size = sizeof(EbBufferHeaderType);
@@ -6340,6 +7201,8 @@ EbErrorType svt_input_buffer_header_creator(
         TRUE);
     if (return_error != EB_ErrorNone)
         return return_error;
+    ((EbInputBufferHeader*)input_buffer)->own_cb = ((EbPictureBufferDesc*)input_buffer->p_buffer)->buffer_cb;
+    ((EbInputBufferHeader*)input_buffer)->own_cr = ((EbPictureBufferDesc*)input_buffer->p_buffer)->buffer_cr;
 
     input_buffer->p_app_private = NULL;
 
@@ -6351,6 +7214,8 @@ void svt_input_buffer_header_destroyer(    EbPtr p)
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
     if (buf) {
+        buf->buffer_cb = ((EbInputBufferHeader*)obj)->own_cb;
+        buf->buffer_cr = ((EbInputBufferHeader*)obj)->own_cr;
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_y);
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cb);
         EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cr);
@@ -6454,6 +7319,18 @@ void svt_output_recon_buffer_header_destroyer(    EbPtr p)
     EB_FREE(obj);
 }
 
+static void add_memory_usage(SvtAv1MemoryUsage* usage, const EbMemoryAccount* account) {
+    EbMemoryAccount held;
+    svt_memory_account_read(account, &held);
+    usage->malloc_bytes += held.amount[EB_N_PTR];
+    usage->calloc_bytes += held.amount[EB_C_PTR];
+    usage->aligned_bytes += held.amount[EB_A_PTR];
+    usage->total_bytes += held.amount[EB_N_PTR] + held.amount[EB_C_PTR] + held.amount[EB_A_PTR];
+    usage->mutex_count += (uint32_t)held.amount[EB_MUTEX];
+    usage->semaphore_count += (uint32_t)held.amount[EB_SEMAPHORE];
+    usage->thread_count += (uint32_t)held.amount[EB_THREAD];
+}
+
 /**********************************
 * svt_av1_enc_get_stream_info get stream information from encoder
 **********************************/
@@ -6464,6 +7341,20 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         return EB_ErrorBadParameter;
     }
     EbEncHandle         *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_USAGE) {
+        SvtAv1MemoryUsage* usage = (SvtAv1MemoryUsage*)info;
+        memset(usage, 0, sizeof(*usage));
+        add_memory_usage(usage, &enc_handle->memory_account);
+        // the segment encoders hold the pools of their streams, the first one also the shared pipeline
+        if (enc_handle->segments)
+            for (uint32_t i = 0; i < enc_handle->segments->encoder_count; i++)
+                add_memory_usage(usage,
+                    &((EbEncHandle*)enc_handle->segments->encoders[i].component->p_component_private)->memory_account);
+        return EB_ErrorNone;
+    }
+    // the segment encoders run the same configuration, the first one reports for all
+    if (enc_handle->segments)
+        return svt_av1_enc_get_stream_info(enc_handle->segments->encoders[0].component, stream_info_id, info);
     if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT) {
         EncodeContext*      context = enc_handle->scs_instance_array[0]->enc_ctx;
         SvtAv1FixedBuf*     first_pass_stats = (SvtAv1FixedBuf*)info;
@@ -6471,6 +7362,33 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW)
+        return svt_av1_first_pass_stats_new(enc_handle->scs_instance_array[0]->enc_ctx, (SvtAv1FixedBuf*)info);
+    if (stream_info_id == SVT_AV1_STREAM_INFO_PIPELINE_PROFILE) {
+        if (!enc_handle->pipeline_profile)
+            return EB_ErrorBadParameter;
+        return svt_aom_pipeline_profile_get(enc_handle->pipeline_profile, (SvtAv1PipelineProfile*)info);
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_INPUT_LAYOUT) {
+        if (!enc_handle->input_buffer_resource_ptr || !enc_handle->input_y8b_buffer_resource_ptr)
+            return EB_ErrorBadParameter;
+        EbPictureBufferDesc* input_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)
+            enc_handle->input_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr)->p_buffer;
+        EbPictureBufferDesc* y8b_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)
+            enc_handle->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr)->p_buffer;
+        EbSvtIOFormat*       layout = (EbSvtIOFormat*)info;
+        memset(layout, 0, sizeof(*layout));
+        layout->y_stride  = y8b_pic->stride_y;
+        layout->cb_stride = input_pic->stride_cb;
+        layout->cr_stride = input_pic->stride_cr;
+        layout->width     = y8b_pic->stride_y;
+        layout->height    = y8b_pic->luma_size / y8b_pic->stride_y;
+        layout->org_x     = input_pic->org_x;
+        layout->org_y     = input_pic->org_y;
+        layout->color_fmt = input_pic->color_format;
+        layout->bit_depth = input_pic->bit_depth;
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
@@ -18,6 +18,8 @@
 #include "sys_resource_manager.h"
 #include "sequence_control_set.h"
 #include "object.h"
+#include "pipeline_profile.h"
+#include "enc_segments.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -73,6 +75,7 @@ struct _EbEncHandle {
     EbHandle *dlf_thread_handle_array;
     EbHandle *cdef_thread_handle_array;
     EbHandle *rest_thread_handle_array;
+    EbHandle *stat_report_thread_handle_array;
 
     EbHandle packetization_thread_handle;
 
@@ -92,6 +95,7 @@ struct _EbEncHandle {
     EbThreadContext **dlf_context_ptr_array;
     EbThreadContext **cdef_context_ptr_array;
     EbThreadContext **rest_context_ptr_array;
+    EbThreadContext **stat_report_context_ptr_array;
     EbThreadContext  *packetization_context_ptr;
 
     // System Resource Managers
@@ -116,6 +120,26 @@ struct _EbEncHandle {
     EbSystemResource  *dlf_results_resource_ptr;
     EbSystemResource  *cdef_results_resource_ptr;
     EbSystemResource  *rest_results_resource_ptr;
+    EbSystemResource  *stat_report_tasks_resource_ptr;
+
+    // Kernel threads profile, NULL unless pipeline_profile is set
+    EbPipelineProfile *pipeline_profile;
+
+    // Segment encoders, NULL unless parallel_segments is set; the handle then has no pipeline of its own
+    EbEncSegments *segments;
+    // Pipeline host of a segment encoder: the first segment encoder, whose kernel threads, queues
+    // and child picture, recon coef and input pools code the stream of this one. NULL for the host
+    // and for a standalone encoder.
+    struct _EbEncHandle *pipeline_host;
+    // Number of streams running through the pipeline of the handle, 1 for a standalone encoder
+    uint32_t pipeline_count;
+    // Position of the stream in the pipeline, it selects the producer ports of its sequential
+    // kernels on the shared queues, 0 for the host and for a standalone encoder
+    uint32_t pipeline_index;
+
+    // Memory held by the encoder: allocated by svt_av1_enc_set_parameter(), svt_av1_enc_init(),
+    // the threads of the kernels and svt_av1_enc_send_picture(), and not freed yet
+    EbMemoryAccount memory_account;
 
     // Callbacks
     EbCallback **app_callback_ptr_array;
@@ -130,6 +154,11 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+
+    // Configuration once initialized, restored by svt_av1_enc_reset() for the next stream
+    EbSvtAv1EncConfiguration stream_config;
 };
 void set_segments_numbers(SequenceControlSet *scs);
+EbFifo *svt_aom_stream_producer_fifo(const EbEncHandle *enc_handle_ptr, EbSystemResource *resource_ptr,
+                                     uint32_t port);
 #endif // EbEncHandle_h
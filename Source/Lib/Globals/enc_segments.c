@@ -0,0 +1,325 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "enc_segments.h"
+#include "enc_handle.h"
+#include "svt_log.h"
+#include "svt_malloc.h"
+
+/**************************************
+ * Packet moved out of a segment encoder, the header is handed to the application
+ **************************************/
+typedef struct SegmentPacket {
+    EbBufferHeaderType    header;
+    struct SegmentPacket *next;
+} SegmentPacket;
+
+// Marks the headers of the packets owned by the segments in their wrapper_ptr
+static const uint8_t segment_packet_tag;
+
+#define SEGMENT_PACKET_TAG ((void *)&segment_packet_tag)
+
+static SequenceControlSet *segment_scs(const SegmentEncoder *encoder) {
+    return ((EbEncHandle *)encoder->component->p_component_private)->scs_instance_array[0]->scs;
+}
+
+static void free_packet(SegmentPacket *packet) {
+    if (packet->header.p_buffer)
+        EB_FREE(packet->header.p_buffer);
+    EB_FREE(packet);
+}
+
+static void svt_aom_segments_dctor(EbPtr p) {
+    EbEncSegments *obj = (EbEncSegments *)p;
+    if (obj->encoders) {
+        // The first encoder owns the shared pipeline and the worker tokens, delete it last
+        for (int32_t i = (int32_t)obj->encoder_count - 1; i >= 0; i--) {
+            SegmentEncoder *encoder = &obj->encoders[i];
+            EB_DESTROY_THREAD(encoder->collector_thread);
+            while (encoder->head) {
+                SegmentPacket *packet = encoder->head;
+                encoder->head         = packet->next;
+                free_packet(packet);
+            }
+            if (encoder->component) {
+                if (i > 0 && obj->encoders[0].component)
+                    if (segment_scs(encoder)->worker_tokens == segment_scs(&obj->encoders[0])->worker_tokens)
+                        segment_scs(encoder)->worker_tokens = NULL;
+                svt_av1_enc_deinit_handle(encoder->component);
+            }
+            EB_DESTROY_MUTEX(encoder->packet_mutex);
+        }
+    }
+    EB_FREE_ARRAY(obj->encoders);
+    EB_DESTROY_MUTEX(obj->frames_mutex);
+}
+
+EbErrorType svt_aom_segments_ctor(EbEncSegments *segments, EbSvtAv1EncConfiguration *config,
+                                  void *app_data) {
+    segments->dctor         = svt_aom_segments_dctor;
+    segments->encoder_count = config->parallel_segments;
+    EB_CALLOC_ARRAY(segments->encoders, segments->encoder_count);
+    EB_CREATE_MUTEX(segments->frames_mutex);
+
+    // Every segment is a stream of its own, started with a key frame after the encoder reset
+    EbSvtAv1EncConfiguration segment_config = *config;
+    segment_config.parallel_segments        = 0;
+    // The lookahead and reference pools are per encoder, each one gets its share of the budget
+    if (config->memory_budget_mb)
+        segment_config.memory_budget_mb = config->memory_budget_mb > segments->encoder_count
+            ? config->memory_budget_mb / segments->encoder_count
+            : 1;
+
+    for (uint32_t i = 0; i < segments->encoder_count; i++) {
+        SegmentEncoder          *encoder = &segments->encoders[i];
+        EbSvtAv1EncConfiguration default_config;
+        EbErrorType              return_error = svt_av1_enc_init_handle(&encoder->component, app_data, &default_config);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        EB_CREATE_MUTEX(encoder->packet_mutex);
+        if (svt_create_cond_var(&encoder->packet_count))
+            return EB_ErrorInsufficientResources;
+
+        EbSvtAv1EncConfiguration encoder_config = segment_config;
+        return_error                            = svt_av1_enc_set_parameter(encoder->component, &encoder_config);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    segments->segment_length = (uint32_t)segment_scs(&segments->encoders[0])->static_config.intra_period_length + 1;
+    SVT_INFO("Parallel segments: %u encoders, %u pictures per segment\n",
+             segments->encoder_count,
+             segments->segment_length);
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_segments_init(EbEncSegments *segments) {
+    // The first encoder is the pipeline host: its kernel threads code the pictures of all the
+    // segments, the other encoders only run the sequential kernels of their streams
+    EbEncHandle *host    = (EbEncHandle *)segments->encoders[0].component->p_component_private;
+    host->pipeline_count = segments->encoder_count;
+    for (uint32_t i = 0; i < segments->encoder_count; i++) {
+        SegmentEncoder     *encoder = &segments->encoders[i];
+        SequenceControlSet *scs     = segment_scs(encoder);
+        if (i) {
+            EbEncHandle *handle    = (EbEncHandle *)encoder->component->p_component_private;
+            handle->pipeline_host  = host;
+            handle->pipeline_count = segments->encoder_count;
+            handle->pipeline_index = i;
+            // With adaptive threading the sequential kernels take the worker tokens of the host,
+            // so the threads of all the segments share one token per core
+            scs->worker_tokens = segment_scs(&segments->encoders[0])->worker_tokens;
+        }
+        EbErrorType return_error = svt_av1_enc_init(encoder->component);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return EB_ErrorNone;
+}
+
+/*
+* Moves the packets of a segment encoder to its packet list as soon as they are produced,
+* so that the encoder never waits for the segments before its own to be sent out.
+*/
+static void *segment_collector_kernel(void *input_ptr) {
+    SegmentEncoder *encoder = (SegmentEncoder *)input_ptr;
+    EbEncHandle    *handle  = (EbEncHandle *)encoder->component->p_component_private;
+    bool            eos     = false;
+
+    while (!eos) {
+        EbObjectWrapper *wrapper = NULL;
+        svt_get_full_object(handle->output_stream_buffer_consumer_fifo_ptr, &wrapper);
+        if (!wrapper)
+            break;
+        EbBufferHeaderType *output = (EbBufferHeaderType *)wrapper->object_ptr;
+        eos                        = output->flags & EB_BUFFERFLAG_EOS;
+
+        // The end of the encoder stream is not the end of the output, only pictures are queued
+        SegmentPacket *packet = NULL;
+        if (!eos || output->n_filled_len) {
+            EB_NO_THROW_MALLOC(packet, sizeof(*packet));
+            if (!packet)
+                SVT_ERROR("failed to allocate a segment packet\n");
+        }
+        if (packet) {
+            // Take over the bitstream buffer, the output buffer goes back to the encoder
+            packet->header             = *output;
+            packet->header.flags       = output->flags & ~EB_BUFFERFLAG_EOS;
+            packet->header.wrapper_ptr = SEGMENT_PACKET_TAG;
+            packet->next               = NULL;
+            output->p_buffer           = NULL;
+        } else if (output->p_buffer)
+            EB_FREE(output->p_buffer);
+        svt_release_object(wrapper);
+        if (!packet)
+            continue;
+
+        svt_block_on_mutex(encoder->packet_mutex);
+        if (encoder->tail)
+            encoder->tail->next = packet;
+        else
+            encoder->head = packet;
+        encoder->tail = packet;
+        svt_release_mutex(encoder->packet_mutex);
+        svt_set_cond_var(&encoder->packet_count, ++encoder->packets_queued);
+    }
+    handle->eos_sent = true;
+    return NULL;
+}
+
+static SegmentPacket *pop_packet(SegmentEncoder *encoder, bool wait) {
+    if (wait)
+        svt_wait_cond_var(&encoder->packet_count, encoder->packets_popped);
+    svt_block_on_mutex(encoder->packet_mutex);
+    SegmentPacket *packet = encoder->head;
+    if (packet) {
+        encoder->head = packet->next;
+        if (!encoder->head)
+            encoder->tail = NULL;
+        encoder->packets_popped++;
+    }
+    svt_release_mutex(encoder->packet_mutex);
+    return packet;
+}
+
+static EbErrorType end_segment(SegmentEncoder *encoder) {
+    encoder->stream_open = false;
+    return svt_av1_enc_send_picture(encoder->component,
+                                    &(EbBufferHeaderType){.size     = sizeof(EbBufferHeaderType),
+                                                          .flags    = EB_BUFFERFLAG_EOS,
+                                                          .pic_type = EB_AV1_INVALID_PICTURE});
+}
+
+/*
+* Starts a new stream on the encoder: once the previous segment is out, the encoder is reset so
+* that nothing of the previous segment (lookahead, TF, scene detection, rate control) carries over.
+*/
+static EbErrorType start_segment(SegmentEncoder *encoder) {
+    if (encoder->collector_thread) {
+        // The collector returns with the EOS of the previous segment
+        EB_DESTROY_THREAD(encoder->collector_thread);
+        EbErrorType return_error = svt_av1_enc_reset(encoder->component);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    // The collector only moves packets, it is not pinned with the kernel threads
+    encoder->collector_thread = svt_create_thread(segment_collector_kernel, encoder);
+    if (!encoder->collector_thread)
+        return EB_ErrorInsufficientResources;
+    EB_ADD_MEM(encoder->collector_thread, 1, EB_THREAD);
+    encoder->stream_open = true;
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_segments_send_picture(EbEncSegments *segments, EbBufferHeaderType *p_buffer) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (p_buffer->flags & EB_BUFFERFLAG_EOS) {
+        svt_block_on_mutex(segments->frames_mutex);
+        segments->eos_received = true;
+        svt_release_mutex(segments->frames_mutex);
+        // Only the encoder of the last segment may still have a stream to end
+        for (uint32_t i = 0; i < segments->encoder_count; i++) {
+            if (!segments->encoders[i].stream_open)
+                continue;
+            EbErrorType error = end_segment(&segments->encoders[i]);
+            if (error != EB_ErrorNone)
+                return_error = error;
+        }
+        return return_error;
+    }
+
+    const uint64_t  frame    = segments->frames_sent;
+    const uint32_t  position = (uint32_t)(frame % segments->segment_length);
+    SegmentEncoder *encoder  = &segments->encoders[(frame / segments->segment_length) % segments->encoder_count];
+    if (!position) {
+        return_error = start_segment(encoder);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
+    return_error = svt_av1_enc_send_picture(encoder->component, p_buffer);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    if (position == segments->segment_length - 1)
+        return_error = end_segment(encoder);
+
+    svt_block_on_mutex(segments->frames_mutex);
+    segments->frames_sent++;
+    svt_release_mutex(segments->frames_mutex);
+    return return_error;
+}
+
+EbErrorType svt_aom_segments_get_packet(EbEncSegments *segments, EbBufferHeaderType **p_buffer,
+                                        unsigned char pic_send_done) {
+    *p_buffer = NULL;
+    if (segments->eos_sent)
+        return EB_NoErrorEmptyQueue;
+
+    svt_block_on_mutex(segments->frames_mutex);
+    const uint64_t frames_sent  = segments->frames_sent;
+    const bool     eos_received = segments->eos_received;
+    svt_release_mutex(segments->frames_mutex);
+
+    const uint64_t frame = segments->out_segment * segments->segment_length + segments->out_position;
+    SegmentPacket *packet;
+    if (frame < frames_sent) {
+        packet = pop_packet(&segments->encoders[segments->out_segment % segments->encoder_count], pic_send_done);
+        if (!packet)
+            return EB_NoErrorEmptyQueue;
+        if (++segments->out_position == segments->segment_length) {
+            segments->out_position = 0;
+            segments->out_segment++;
+        }
+    } else {
+        if (!eos_received)
+            return EB_NoErrorEmptyQueue;
+        // All the pictures were sent out, end the stream with an empty EOS packet like a single encoder
+        EB_NO_THROW_CALLOC(packet, 1, sizeof(*packet));
+        if (!packet)
+            return EB_ErrorInsufficientResources;
+        packet->header.size        = sizeof(EbBufferHeaderType);
+        packet->header.flags       = EB_BUFFERFLAG_EOS;
+        packet->header.pic_type    = EB_AV1_INVALID_PICTURE;
+        packet->header.wrapper_ptr = SEGMENT_PACKET_TAG;
+        segments->eos_sent         = true;
+    }
+
+    *p_buffer = &packet->header;
+    return (packet->header.flags & 0xfffffff0) ? EB_ErrorMax : EB_ErrorNone;
+}
+
+bool svt_aom_segments_release_packet(EbBufferHeaderType *packet) {
+    if (packet->wrapper_ptr != SEGMENT_PACKET_TAG)
+        return false;
+    free_packet((SegmentPacket *)packet);
+    return true;
+}
+
+EbErrorType svt_aom_segments_deinit(EbEncSegments *segments) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (segments->frames_sent && !segments->eos_received) {
+        SVT_ERROR("deinit called without sending EOS!\n");
+        svt_aom_segments_send_picture(segments, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
+    }
+    // The collectors return once their encoder sent out the EOS of its last segment
+    for (uint32_t i = 0; i < segments->encoder_count; i++) EB_DESTROY_THREAD(segments->encoders[i].collector_thread);
+    // The pipeline host stops the shared kernels, after the other encoders
+    for (int32_t i = (int32_t)segments->encoder_count - 1; i >= 0; i--) {
+        EbErrorType error = svt_av1_enc_deinit(segments->encoders[i].component);
+        if (error != EB_ErrorNone)
+            return_error = error;
+    }
+    return return_error;
+}
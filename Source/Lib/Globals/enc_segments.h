@@ -0,0 +1,87 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbEncSegments_h
+#define EbEncSegments_h
+
+#include <stdbool.h>
+
+#include "EbSvtAv1Enc.h"
+#include "object.h"
+#include "svt_threads.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct SegmentPacket;
+
+/**************************************
+ * Segment encoder: one encoder stream with the packets it produced
+ **************************************/
+typedef struct SegmentEncoder {
+    EbComponentType *component;
+    // Moves the packets of the current segment out of the encoder output queue,
+    // created with the first picture of the segment and returning at its EOS
+    EbHandle collector_thread;
+    // A segment was started and its EOS is not sent yet
+    bool     stream_open;
+    EbHandle packet_mutex;
+    // Number of packets queued so far, signaled on every new packet
+    CondVar               packet_count;
+    int32_t               packets_queued;
+    int32_t               packets_popped;
+    struct SegmentPacket *head;
+    struct SegmentPacket *tail;
+} SegmentEncoder;
+
+/**************************************
+ * Parallel segments: the input is cut in segments of segment_length pictures,
+ * segment s is encoded by encoder s % encoder_count and the packets are sent
+ * out in segment order. Every segment is a stream of its own: the encoder gets
+ * an EOS after the last picture of the segment and is reset before the next
+ * one, so the segments are encoded as by a standalone encoder. The encoders
+ * share one pipeline: the kernel threads coding several pictures at once, the
+ * queues between them and the child picture, recon coef and input pools are
+ * the ones of the first encoder, the other encoders only keep the sequential
+ * kernels and the lookahead and reference pools of their streams.
+ **************************************/
+typedef struct EbEncSegments {
+    EbDctor         dctor;
+    uint32_t        encoder_count;
+    uint32_t        segment_length;
+    SegmentEncoder *encoders;
+
+    // Input side, written by svt_av1_enc_send_picture()
+    EbHandle frames_mutex;
+    uint64_t frames_sent;
+    bool     eos_received;
+
+    // Output side, only used by svt_av1_enc_get_packet()
+    uint64_t out_segment;
+    uint32_t out_position;
+    bool     eos_sent;
+} EbEncSegments;
+
+EbErrorType svt_aom_segments_ctor(EbEncSegments *segments, EbSvtAv1EncConfiguration *config,
+                                  void *app_data);
+EbErrorType svt_aom_segments_init(EbEncSegments *segments);
+EbErrorType svt_aom_segments_deinit(EbEncSegments *segments);
+EbErrorType svt_aom_segments_send_picture(EbEncSegments *segments, EbBufferHeaderType *p_buffer);
+EbErrorType svt_aom_segments_get_packet(EbEncSegments *segments, EbBufferHeaderType **p_buffer,
+                                        unsigned char pic_send_done);
+// Frees a packet returned by svt_aom_segments_get_packet(), returns false for any other packet
+bool svt_aom_segments_release_packet(EbBufferHeaderType *packet);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbEncSegments_h
@@ -22,6 +22,7 @@
 #include "EbSvtAv1Enc.h"
 #include "EbSvtAv1Metadata.h"
 #include "enc_settings.h"
+#include "firstpass.h"
 
 #include "svt_log.h"
 
@@ -282,6 +283,17 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         SVT_ERROR("Instance %u: Only rate control mode 0~2 are supported for 2-pass \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->rc_stats_buffer.buf) {
+        SvtAv1FixedBuf entries;
+        if (svt_av1_stats_entries(&config->rc_stats_buffer, &entries) != EB_ErrorNone) {
+            SVT_ERROR("Instance %u: The stats were written by an incompatible version of the encoder\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        } else if (entries.sz < sizeof(FIRSTPASS_STATS)) {
+            SVT_ERROR("Instance %u: The stats hold no first pass entries\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
     if (config->profile > 2) {
         SVT_ERROR("Instance %u: The maximum allowed profile value is 2 \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -944,9 +956,50 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->zero_copy_input && !config->release_input_frame) {
+        SVT_ERROR("Instance %u: zero-copy input requires a release_input_frame callback\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->parallel_segments > 16) {
+        SVT_ERROR("Instance %u: parallel-segments must be between 0 and 16\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->parallel_segments > 1) {
+        if (config->pass != ENC_SINGLE_PASS || config->rc_stats_buffer.sz) {
+            SVT_ERROR("Instance %u: parallel segments are only supported with single pass encoding\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->pred_structure != SVT_AV1_PRED_RANDOM_ACCESS) {
+            SVT_ERROR("Instance %u: parallel segments are only supported with random access\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->rate_control_mode == SVT_AV1_RC_MODE_CBR) {
+            SVT_ERROR("Instance %u: parallel segments are not supported with CBR\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->intra_period_length == -1) {
+            SVT_ERROR("Instance %u: parallel segments require a key frame interval\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->recon_enabled || config->frame_scale_evts.evt_num) {
+            SVT_ERROR("Instance %u: parallel segments do not support recon output or resize events\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
     return return_error;
 }
 
+// The fields added to the public configuration are taken out of its padding, so its size
+// does not change. 624 bytes with 8-byte pointers and doubles (LP64 and LLP64).
+#if !defined(_MSC_VER) || defined(__clang__)
+_Static_assert(sizeof(void *) != 8 || sizeof(EbSvtAv1EncConfiguration) == 624,
+               "sizeof(EbSvtAv1EncConfiguration) changed, fix the padding of the struct");
+#endif
+
 /**********************************
 Set Default Library Params
 **********************************/
@@ -1113,6 +1166,14 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->kf_tf_strength                    = 1;
     config_ptr->noise_norm_strength               = 0;
     config_ptr->spy_rd                            = 0;
+    config_ptr->zero_copy_input                   = FALSE;
+    config_ptr->release_input_frame               = NULL;
+    config_ptr->release_input_frame_private       = NULL;
+    config_ptr->adaptive_threading                = FALSE;
+    config_ptr->pipeline_profile                  = FALSE;
+    config_ptr->parallel_segments                 = 0;
+    config_ptr->memory_budget_mb                  = 0;
+    config_ptr->huge_pages                        = FALSE;
     return return_error;
 }
 
@@ -2136,6 +2197,8 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"input-depth", &config_struct->encoder_bit_depth},
         {"forced-max-frame-width", &config_struct->forced_max_frame_width},
         {"forced-max-frame-height", &config_struct->forced_max_frame_height},
+        {"parallel-segments", &config_struct->parallel_segments},
+        {"memory-budget", &config_struct->memory_budget_mb},
     };
     const size_t uint_opts_size = sizeof(uint_opts) / sizeof(uint_opts[0]);
 
@@ -2300,6 +2363,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"max-32-tx-size", &config_struct->max_32_tx_size},
         {"adaptive-film-grain", &config_struct->adaptive_film_grain},
         {"spy-rd", &config_struct->spy_rd},
+        {"adaptive-threading", &config_struct->adaptive_threading},
+        {"pipeline-profile", &config_struct->pipeline_profile},
+        {"huge-pages", &config_struct->huge_pages},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
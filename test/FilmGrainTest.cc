@@ -204,6 +204,12 @@ class AddFilmGrainTest : public ::testing::Test {
         luma_ = (uint8_t *)svt_aom_malloc(luma_size);
         cb_ = (uint8_t *)svt_aom_malloc(chroma_size);
         cr_ = (uint8_t *)svt_aom_malloc(chroma_size);
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+        EbCpuFlags cpu_flags = svt_aom_get_cpu_flags_to_use();
+#else
+        EbCpuFlags cpu_flags = 0;
+#endif
+        svt_aom_setup_rtcd_internal(cpu_flags);
     }
 
     void TearDown() override {
@@ -263,6 +269,160 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+// The SIMD versions must add exactly the grain of the C versions
+class AddNoiseTest : public ::testing::TestWithParam<int> {
+  public:
+    static const int kMaxSize = 64;
+    static const int kStride = 2 * kMaxSize + 8;
+
+    void SetUp() override {
+        rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+        bit_depth_ = GetParam();
+    }
+
+  protected:
+    void init_data(int max_pixel) {
+        for (int i = 0; i < 256; ++i)
+            scaling_lut_[i] = rnd_.Rand8();
+        const int grain_center = 128 << (bit_depth_ - 8);
+        for (int i = 0; i < kMaxSize * kStride; ++i)
+            grain_[i] = rnd_.PseudoUniform(2 * grain_center) - grain_center;
+        for (int i = 0; i < 2 * kMaxSize * kStride; ++i) {
+            luma_[i] = rnd_.PseudoUniform(max_pixel + 1);
+            luma16_[i] = rnd_.PseudoUniform(max_pixel + 1);
+        }
+        for (int i = 0; i < kMaxSize * kStride; ++i) {
+            luma_ref_[i] = luma_tst_[i] = rnd_.PseudoUniform(max_pixel + 1);
+            luma16_ref_[i] = luma16_tst_[i] =
+                rnd_.PseudoUniform(max_pixel + 1);
+            chroma_ref_[i] = chroma_tst_[i] = rnd_.PseudoUniform(max_pixel + 1);
+            chroma16_ref_[i] = chroma16_tst_[i] =
+                rnd_.PseudoUniform(max_pixel + 1);
+        }
+    }
+
+    // Legal range clipping, or none
+    void pick_range(int max_pixel, int *min, int *max) {
+        if (rnd_.Rand8() & 1) {
+            *min = 16 << (bit_depth_ - 8);
+            *max = 235 << (bit_depth_ - 8);
+        } else {
+            *min = 0;
+            *max = max_pixel;
+        }
+    }
+
+    void RunCheckLuma(int num_iters) {
+        const int max_pixel = (1 << bit_depth_) - 1;
+        for (int iter = 0; iter < num_iters; ++iter) {
+            init_data(max_pixel);
+            const int width = 1 + rnd_.PseudoUniform(kMaxSize);
+            const int height = 1 + rnd_.PseudoUniform(kMaxSize);
+            const int scaling_shift = 8 + rnd_.PseudoUniform(4);
+            int min, max;
+            pick_range(max_pixel, &min, &max);
+            if (bit_depth_ == 8) {
+                svt_av1_add_noise_luma_c(scaling_lut_, luma_ref_, kStride,
+                                         grain_, kStride, width, height,
+                                         scaling_shift, min, max);
+                svt_av1_add_noise_luma_avx2(scaling_lut_, luma_tst_, kStride,
+                                            grain_, kStride, width, height,
+                                            scaling_shift, min, max);
+                ASSERT_EQ(0, memcmp(luma_ref_, luma_tst_, sizeof(luma_ref_)))
+                    << "width " << width << " height " << height;
+            } else {
+                svt_av1_add_noise_luma_hbd_c(
+                    scaling_lut_, luma16_ref_, kStride, grain_, kStride,
+                    width, height, scaling_shift, min, max, bit_depth_);
+                svt_av1_add_noise_luma_hbd_avx2(
+                    scaling_lut_, luma16_tst_, kStride, grain_, kStride,
+                    width, height, scaling_shift, min, max, bit_depth_);
+                ASSERT_EQ(0,
+                          memcmp(luma16_ref_, luma16_tst_, sizeof(luma16_ref_)))
+                    << "width " << width << " height " << height;
+            }
+        }
+    }
+
+    void RunCheckChroma(int num_iters) {
+        const int max_pixel = (1 << bit_depth_) - 1;
+        for (int iter = 0; iter < num_iters; ++iter) {
+            init_data(max_pixel);
+            const int ss_x = rnd_.Rand8() & 1;
+            const int ss_y = ss_x ? rnd_.Rand8() & 1 : 0;
+            const int width = 1 + rnd_.PseudoUniform(kMaxSize);
+            const int height = 1 + rnd_.PseudoUniform(kMaxSize);
+            const int scaling_shift = 8 + rnd_.PseudoUniform(4);
+            int min, max;
+            pick_range(max_pixel, &min, &max);
+            int luma_mult, mult, offset;
+            if (rnd_.Rand8() & 1) {
+                // chroma scaling from luma
+                luma_mult = 64;
+                mult = offset = 0;
+            } else {
+                luma_mult = rnd_.Rand8() - 128;
+                mult = rnd_.Rand8() - 128;
+                offset = (rnd_.PseudoUniform(512) << (bit_depth_ - 8)) -
+                         (1 << bit_depth_);
+            }
+            if (bit_depth_ == 8) {
+                svt_av1_add_noise_chroma_c(scaling_lut_, chroma_ref_, kStride,
+                                           luma_, kStride, grain_, kStride,
+                                           width, height, luma_mult, mult,
+                                           offset, scaling_shift, min, max,
+                                           ss_x, ss_y);
+                svt_av1_add_noise_chroma_avx2(
+                    scaling_lut_, chroma_tst_, kStride, luma_, kStride, grain_,
+                    kStride, width, height, luma_mult, mult, offset,
+                    scaling_shift, min, max, ss_x, ss_y);
+                ASSERT_EQ(0, memcmp(chroma_ref_, chroma_tst_,
+                                    sizeof(chroma_ref_)))
+                    << "width " << width << " height " << height << " ss "
+                    << ss_x << ss_y;
+            } else {
+                svt_av1_add_noise_chroma_hbd_c(
+                    scaling_lut_, chroma16_ref_, kStride, luma16_, kStride,
+                    grain_, kStride, width, height, luma_mult, mult, offset,
+                    scaling_shift, min, max, ss_x, ss_y, bit_depth_);
+                svt_av1_add_noise_chroma_hbd_avx2(
+                    scaling_lut_, chroma16_tst_, kStride, luma16_, kStride,
+                    grain_, kStride, width, height, luma_mult, mult, offset,
+                    scaling_shift, min, max, ss_x, ss_y, bit_depth_);
+                ASSERT_EQ(0, memcmp(chroma16_ref_, chroma16_tst_,
+                                    sizeof(chroma16_ref_)))
+                    << "width " << width << " height " << height << " ss "
+                    << ss_x << ss_y;
+            }
+        }
+    }
+
+    libaom_test::ACMRandom rnd_;
+    int bit_depth_;
+    int32_t scaling_lut_[256];
+    int32_t grain_[kMaxSize * kStride];
+    uint8_t luma_[2 * kMaxSize * kStride];
+    uint16_t luma16_[2 * kMaxSize * kStride];
+    uint8_t luma_ref_[kMaxSize * kStride];
+    uint8_t luma_tst_[kMaxSize * kStride];
+    uint16_t luma16_ref_[kMaxSize * kStride];
+    uint16_t luma16_tst_[kMaxSize * kStride];
+    uint8_t chroma_ref_[kMaxSize * kStride];
+    uint8_t chroma_tst_[kMaxSize * kStride];
+    uint16_t chroma16_ref_[kMaxSize * kStride];
+    uint16_t chroma16_tst_[kMaxSize * kStride];
+};
+
+TEST_P(AddNoiseTest, LumaMatch) {
+    RunCheckLuma(1000);
+}
+
+TEST_P(AddNoiseTest, ChromaMatch) {
+    RunCheckChroma(1000);
+}
+
+INSTANTIATE_TEST_SUITE_P(AVX2, AddNoiseTest, ::testing::Values(8, 10, 12));
+
 extern "C" {
 #include "pcs.h"
 #include "pic_buffer_desc.h"
@@ -384,6 +544,7 @@ class DenoiseModelRunTest : public ::testing::Test {
         fg_init_data.encoder_color_format = EB_YUV420;
         fg_init_data.noise_level = 4;  // TODO: check the range;
         fg_init_data.denoise_apply = FALSE;
+        fg_init_data.adaptive_film_grain = FALSE;
         fg_init_data.width = width_;
         fg_init_data.height = height_;
         fg_init_data.stride_y = width_;
@@ -444,6 +605,20 @@ class DenoiseModelRunTest : public ::testing::Test {
             &noise_model, &in_pic_, &output_film_grain, 0);
     }
 
+    // Denoise the planes one by one in reverse order, as the picture analysis
+    // tasks may do
+    void run_plane_test() {
+        init_data();
+
+        ASSERT_EQ(svt_aom_denoise_and_model_start(&noise_model, &in_pic_, 0),
+                  1);
+        for (int c = 2; c >= 0; --c)
+            ASSERT_EQ(svt_aom_denoise_and_model_plane(&noise_model, c), 1);
+        ASSERT_EQ(svt_aom_denoise_and_model_finish(
+                      &noise_model, &in_pic_, &output_film_grain, 0),
+                  1);
+    }
+
   protected:
     int subsampling_x_;
     int subsampling_y_;
@@ -460,3 +635,9 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+TEST_F(DenoiseModelRunTest, OutputFilmGrainCheckPlaneTasks) {
+    run_plane_test();
+    check_filmgrain();
+    EXPECT_FALSE(HasFailure());
+}
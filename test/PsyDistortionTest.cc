@@ -0,0 +1,247 @@
+/*
+ * Copyright(c) 2024 Gianni Rosato
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "svt_time.h"
+#include "unit_test_utility.h"
+#include "util.h"
+
+namespace {
+
+typedef enum { VAL_MIN, VAL_MAX, VAL_RANDOM } TestPattern;
+typedef std::tuple<uint32_t, uint32_t> AreaSize;
+
+// All the block sizes psy-rd is evaluated on, and other multiples of 8 the C
+// kernel accepts, such as widths that are odd multiples of 8
+AreaSize TEST_AREA_SIZES[] = {
+    AreaSize(4, 4),     AreaSize(4, 8),    AreaSize(8, 4),
+    AreaSize(8, 8),     AreaSize(4, 16),   AreaSize(16, 4),
+    AreaSize(8, 16),    AreaSize(16, 8),   AreaSize(16, 16),
+    AreaSize(8, 32),    AreaSize(32, 8),   AreaSize(16, 32),
+    AreaSize(32, 16),   AreaSize(32, 32),  AreaSize(16, 64),
+    AreaSize(64, 16),   AreaSize(32, 64),  AreaSize(64, 32),
+    AreaSize(64, 64),   AreaSize(64, 128), AreaSize(128, 64),
+    AreaSize(128, 128), AreaSize(24, 8),   AreaSize(24, 24),
+    AreaSize(8, 24),    AreaSize(40, 16),  AreaSize(56, 32),
+    AreaSize(120, 8)};
+
+template <typename Pixel>
+using PsyDistortionFunc = uint64_t (*)(const Pixel *input,
+                                       uint32_t input_stride,
+                                       const Pixel *recon,
+                                       uint32_t recon_stride, uint32_t width,
+                                       uint32_t height);
+
+/**
+ * @brief Unit test for psy-rd distortion functions include:
+ *  - svt_psy_distortion_{avx2,avx512}
+ *  - svt_psy_distortion_hbd_{avx2,avx512}
+ *
+ * Test strategy:
+ *  Compare the result of the SIMD function with the C reference for every
+ * block size psy-rd is evaluated on, for the patterns VAL_MIN, VAL_MAX and
+ * VAL_RANDOM. Input and recon use distinct random strides and are not
+ * aligned.
+ *
+ * Expect result:
+ *  Results from reference function and SIMD function are equal.
+ */
+template <typename Pixel>
+class PsyDistortionTest
+    : public ::testing::TestWithParam<
+          std::tuple<AreaSize, PsyDistortionFunc<Pixel>>> {
+  public:
+    PsyDistortionTest() {
+        width_ = std::get<0>(std::get<0>(this->GetParam()));
+        height_ = std::get<1>(std::get<0>(this->GetParam()));
+        test_func_ = std::get<1>(this->GetParam());
+        ref_func_ = get_ref_func();
+        bd_ = sizeof(Pixel) == 1 ? 8 : 10;
+    }
+
+    void SetUp() override {
+        input_stride_ = svt_create_random_aligned_stride(MAX_SB_SIZE, 64);
+        recon_stride_ = svt_create_random_aligned_stride(MAX_SB_SIZE, 64);
+        input_size_ = MAX_SB_SIZE * input_stride_ + 1;
+        recon_size_ = MAX_SB_SIZE * recon_stride_ + 1;
+        input_ = reinterpret_cast<Pixel *>(
+            malloc(sizeof(*input_) * input_size_));
+        recon_ = reinterpret_cast<Pixel *>(
+            malloc(sizeof(*recon_) * recon_size_));
+        ASSERT_NE(input_, nullptr);
+        ASSERT_NE(recon_, nullptr);
+    }
+
+    void TearDown() override {
+        free(recon_);
+        free(input_);
+    }
+
+  protected:
+    static PsyDistortionFunc<Pixel> get_ref_func();
+
+    void fill(Pixel *buf, int size, TestPattern pattern) {
+        const Pixel max = (Pixel)((1 << bd_) - 1);
+        for (int i = 0; i < size; i++) {
+            switch (pattern) {
+            case VAL_MIN: buf[i] = 0; break;
+            case VAL_MAX: buf[i] = max; break;
+            default: buf[i] = (Pixel)(rand() & max); break;
+            }
+        }
+    }
+
+    void RunCheckOutput(TestPattern pattern) {
+        for (int i = 0; i < 10; i++) {
+            fill(input_, input_size_, pattern);
+            fill(recon_, recon_size_, pattern == VAL_MAX ? VAL_MIN : pattern);
+
+            // Odd offsets so the blocks are never aligned
+            const uint64_t ref = ref_func_(
+                input_ + 1, input_stride_, recon_ + 1, recon_stride_, width_, height_);
+            const uint64_t tst = test_func_(
+                input_ + 1, input_stride_, recon_ + 1, recon_stride_, width_, height_);
+            ASSERT_EQ(ref, tst) << "Compare error at block " << width_ << "x"
+                                << height_ << ", iteration " << i;
+        }
+    }
+
+    void RunSpeedTest() {
+        const int num_loops = 1000000 / (width_ * height_);
+        uint64_t ref = 0, tst = 0;
+        double time_c, time_o;
+        uint64_t start_time_seconds, start_time_useconds;
+        uint64_t middle_time_seconds, middle_time_useconds;
+        uint64_t finish_time_seconds, finish_time_useconds;
+
+        fill(input_, input_size_, VAL_RANDOM);
+        fill(recon_, recon_size_, VAL_RANDOM);
+
+        svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+        for (int i = 0; i < num_loops; i++)
+            ref += ref_func_(
+                input_, input_stride_, recon_, recon_stride_, width_, height_);
+        svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+        for (int i = 0; i < num_loops; i++)
+            tst += test_func_(
+                input_, input_stride_, recon_, recon_stride_, width_, height_);
+        svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+
+        time_c = svt_av1_compute_overall_elapsed_time_ms(start_time_seconds,
+                                                         start_time_useconds,
+                                                         middle_time_seconds,
+                                                         middle_time_useconds);
+        time_o = svt_av1_compute_overall_elapsed_time_ms(middle_time_seconds,
+                                                         middle_time_useconds,
+                                                         finish_time_seconds,
+                                                         finish_time_useconds);
+
+        EXPECT_EQ(ref, tst) << "Output mismatch \n";
+        printf("psy distortion (%2dx%3d, %2d-bit): c_time = %f \t o_time = %f "
+               "\t Gain = %4.2f \n",
+               width_,
+               height_,
+               bd_,
+               time_c,
+               time_o,
+               time_c / time_o);
+    }
+
+    uint32_t width_, height_;
+    int bd_;
+    int input_size_, recon_size_;
+    uint32_t input_stride_, recon_stride_;
+    Pixel *input_;
+    Pixel *recon_;
+    PsyDistortionFunc<Pixel> test_func_;
+    PsyDistortionFunc<Pixel> ref_func_;
+};
+
+template <>
+PsyDistortionFunc<uint8_t> PsyDistortionTest<uint8_t>::get_ref_func() {
+    return svt_psy_distortion_c;
+}
+
+template <>
+PsyDistortionFunc<uint16_t> PsyDistortionTest<uint16_t>::get_ref_func() {
+    return svt_psy_distortion_hbd_c;
+}
+
+using PsyDistortionLbdTest = PsyDistortionTest<uint8_t>;
+using PsyDistortionHbdTest = PsyDistortionTest<uint16_t>;
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyDistortionLbdTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyDistortionHbdTest);
+
+TEST_P(PsyDistortionLbdTest, Random) {
+    RunCheckOutput(VAL_RANDOM);
+}
+
+TEST_P(PsyDistortionLbdTest, ExtremeMin) {
+    RunCheckOutput(VAL_MIN);
+}
+
+TEST_P(PsyDistortionLbdTest, ExtremeMax) {
+    RunCheckOutput(VAL_MAX);
+}
+
+TEST_P(PsyDistortionLbdTest, DISABLED_Speed) {
+    RunSpeedTest();
+}
+
+TEST_P(PsyDistortionHbdTest, Random) {
+    RunCheckOutput(VAL_RANDOM);
+}
+
+TEST_P(PsyDistortionHbdTest, ExtremeMin) {
+    RunCheckOutput(VAL_MIN);
+}
+
+TEST_P(PsyDistortionHbdTest, ExtremeMax) {
+    RunCheckOutput(VAL_MAX);
+}
+
+TEST_P(PsyDistortionHbdTest, DISABLED_Speed) {
+    RunSpeedTest();
+}
+
+#ifdef ARCH_X86_64
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyDistortionLbdTest,
+    ::testing::Combine(::testing::ValuesIn(TEST_AREA_SIZES),
+                       ::testing::Values(svt_psy_distortion_avx2)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyDistortionHbdTest,
+    ::testing::Combine(::testing::ValuesIn(TEST_AREA_SIZES),
+                       ::testing::Values(svt_psy_distortion_hbd_avx2)));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyDistortionLbdTest,
+    ::testing::Combine(::testing::ValuesIn(TEST_AREA_SIZES),
+                       ::testing::Values(svt_psy_distortion_avx512)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyDistortionHbdTest,
+    ::testing::Combine(::testing::ValuesIn(TEST_AREA_SIZES),
+                       ::testing::Values(svt_psy_distortion_hbd_avx512)));
+#endif
+#endif  // ARCH_X86_64
+
+}  // namespace
@@ -0,0 +1,179 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SubpelCacheTest.cc
+ *
+ * @brief Unit test for the sub-pel plane cache of the references:
+ * - svt_aom_subpel_cache_get_block
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "random.h"
+extern "C" {
+#include "pic_buffer_desc.h"
+#include "reference_object.h"
+#include "svt_threads.h"
+}
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+static const int kWidth = 320;
+static const int kHeight = 192;
+static const int kPadding = 80;
+static const int kBlockSizes[] = {4, 8, 16, 32, 64};
+
+/** Checks the blocks returned by the cache against a direct interpolation at
+ * random positions and phases, returns the number of blocks not served */
+static int check_random_blocks(SubpelPlaneCache *cache, int filter,
+                               uint32_t seed, int block_count) {
+    DECLARE_ALIGNED(16, uint8_t, pred[64 * 64]);
+    const EbPictureBufferDesc *pic = cache->pic;
+    const int stride = pic->stride_y;
+    const int x_limit = stride - SUBPEL_CACHE_BORDER;
+    const int y_limit = SUBPEL_CACHE_BORDER +
+                        (((int)(pic->luma_size / stride) -
+                          2 * SUBPEL_CACHE_BORDER) &
+                         ~7);
+    SVTRandom rnd(0, 1 << 30, seed);
+    int not_served = 0;
+    for (int i = 0; i < block_count; i++) {
+        const int w = kBlockSizes[rnd.random() % 5];
+        const int h = kBlockSizes[rnd.random() % 5];
+        const int x = SUBPEL_CACHE_BORDER +
+                      rnd.random() % (x_limit - w - SUBPEL_CACHE_BORDER + 1);
+        const int y = SUBPEL_CACHE_BORDER +
+                      rnd.random() % (y_limit - h - SUBPEL_CACHE_BORDER + 1);
+        const int phase = 1 + rnd.random() % 15;
+        const int subpel_x_q3 = (phase & 3) << 1;
+        const int subpel_y_q3 = (phase >> 2) << 1;
+        const uint8_t *ref = pic->buffer_y + y * stride + x;
+
+        svt_aom_upsampled_pred(NULL, NULL, 0, 0, NULL, pred, w, h, subpel_x_q3,
+                               subpel_y_q3, ref, stride, filter);
+        const uint8_t *cached = svt_aom_subpel_cache_get_block(
+            cache, ref, w, h, subpel_x_q3, subpel_y_q3, filter);
+        if (!cached) {
+            not_served++;
+            continue;
+        }
+        for (int r = 0; r < h; r++)
+            EXPECT_EQ(0, memcmp(cached + r * stride, pred + r * w, w))
+                << "filter " << filter << " phase (" << subpel_x_q3 << ", "
+                << subpel_y_q3 << ") block " << w << "x" << h << " at (" << x
+                << ", " << y << ") row " << r;
+    }
+    return not_served;
+}
+
+typedef struct CheckThreadContext {
+    SubpelPlaneCache *cache;
+    int filter;
+    uint32_t seed;
+} CheckThreadContext;
+
+static void *check_thread(void *input_ptr) {
+    CheckThreadContext *context = (CheckThreadContext *)input_ptr;
+    check_random_blocks(context->cache, context->filter, context->seed, 2000);
+    return NULL;
+}
+
+/**
+ * @brief Unit test of the sub-pel plane cache of a reference
+ *
+ * Test strategy:
+ * Fill a padded luma plane with random samples and query blocks of random
+ * sizes, positions and phases for each interpolation filter, from one thread
+ * and then from several threads sharing the cache.
+ *
+ * Expect result:
+ * The blocks read from the cache match svt_aom_upsampled_pred on the
+ * reference. From one thread with a plane per phase every block is served,
+ * threads that find a tile being filled by another get no block.
+ */
+class SubpelCacheTest : public ::testing::TestWithParam<int> {
+  protected:
+    void SetUp() override {
+        setup_test_env();
+        EbPictureBufferDescInitData init_data;
+        memset(&init_data, 0, sizeof(init_data));
+        init_data.max_width = kWidth;
+        init_data.max_height = kHeight;
+        init_data.bit_depth = EB_EIGHT_BIT;
+        init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+        init_data.left_padding = kPadding;
+        init_data.right_padding = kPadding;
+        init_data.top_padding = kPadding;
+        init_data.bot_padding = kPadding;
+        init_data.color_format = EB_YUV420;
+        init_data.split_mode = FALSE;
+        memset(&pic_, 0, sizeof(pic_));
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_picture_buffer_desc_ctor(&pic_, &init_data));
+        SVTRandom rnd(8, false);
+        for (uint32_t i = 0; i < pic_.luma_size; i++)
+            pic_.buffer_y[i] = (uint8_t)rnd.random();
+
+        memset(&cache_, 0, sizeof(cache_));
+        cache_.pic = &pic_;
+        cache_.max_planes = SUBPEL_CACHE_PHASES;
+        cache_.mutex = svt_create_mutex();
+        ASSERT_NE(cache_.mutex, nullptr);
+    }
+
+    void TearDown() override {
+        for (int i = 0; i < cache_.num_planes; i++) {
+            EB_FREE_ALIGNED_ARRAY(cache_.plane[i]);
+            EB_FREE_ARRAY(cache_.tile_state[i]);
+        }
+        svt_destroy_mutex(cache_.mutex);
+        pic_.dctor(&pic_);
+    }
+
+    EbPictureBufferDesc pic_;
+    SubpelPlaneCache cache_;
+};
+
+TEST_P(SubpelCacheTest, MatchUpsampledPred) {
+    EXPECT_EQ(0, check_random_blocks(&cache_, GetParam(), 0, 5000));
+}
+
+TEST_P(SubpelCacheTest, MatchUpsampledPredThreads) {
+    const uint32_t thread_count = 4;
+    std::vector<CheckThreadContext> contexts(thread_count);
+    std::vector<EbHandle> threads(thread_count);
+    for (uint32_t i = 0; i < thread_count; i++) {
+        contexts[i].cache = &cache_;
+        contexts[i].filter = GetParam();
+        contexts[i].seed = i + 1;
+        threads[i] = svt_create_thread(check_thread, &contexts[i]);
+        ASSERT_NE(threads[i], nullptr);
+    }
+    for (uint32_t i = 0; i < thread_count; i++)
+        svt_destroy_thread(threads[i]);
+    // from one thread again every block is served
+    EXPECT_EQ(0, check_random_blocks(&cache_, GetParam(), 0, 1000));
+}
+
+INSTANTIATE_TEST_SUITE_P(SubpelCache, SubpelCacheTest,
+                         ::testing::Values((int)USE_2_TAPS, (int)USE_4_TAPS,
+                                           (int)USE_8_TAPS));
+
+}  // namespace
@@ -0,0 +1,300 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SystemResourceTest.cc
+ *
+ * @brief Unit test for the system resource queues between the pipeline
+ * kernels, with the mutex or the lock-free (LOCKFREE_FIFO) backend, and for
+ * the worker tokens the kernels share with adaptive threading
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <tuple>
+#include <vector>
+#include "gtest/gtest.h"
+#include "sys_resource_manager.h"
+#include "svt_threads.h"
+
+namespace {
+
+// Item carried by the objects, producer kStopProducer tells a consumer to exit
+typedef struct TestItem {
+    uint32_t producer;
+    uint32_t seq;
+} TestItem;
+
+static const uint32_t kStopProducer = 0xFFFFFFFF;
+
+static EbErrorType test_item_creator(EbPtr *object_dbl_ptr,
+                                     EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestItem));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void test_item_destroyer(EbPtr p) {
+    free(p);
+}
+
+typedef struct ProducerContext {
+    EbFifo *empty_fifo;
+    uint32_t producer;
+    uint32_t item_count;
+} ProducerContext;
+
+typedef struct ConsumerContext {
+    EbFifo *full_fifo;
+    uint32_t producer_count;
+    // received - items received per producer, in arrival order
+    std::vector<std::vector<uint32_t>> received;
+} ConsumerContext;
+
+static void *producer_kernel(void *input_ptr) {
+    ProducerContext *context = (ProducerContext *)input_ptr;
+    for (uint32_t seq = 0; seq < context->item_count; ++seq) {
+        EbObjectWrapper *wrapper;
+        svt_get_empty_object(context->empty_fifo, &wrapper);
+        TestItem *item = (TestItem *)wrapper->object_ptr;
+        item->producer = context->producer;
+        item->seq = seq;
+        svt_post_full_object(wrapper);
+    }
+    return NULL;
+}
+
+static void *consumer_kernel(void *input_ptr) {
+    ConsumerContext *context = (ConsumerContext *)input_ptr;
+    for (;;) {
+        EbObjectWrapper *wrapper;
+        svt_get_full_object(context->full_fifo, &wrapper);
+        const TestItem item = *(TestItem *)wrapper->object_ptr;
+        svt_release_object(wrapper);
+        if (item.producer == kStopProducer)
+            break;
+        if (item.producer < context->producer_count)
+            context->received[item.producer].push_back(item.seq);
+    }
+    return NULL;
+}
+
+// object count, producer count, consumer count
+typedef std::tuple<uint32_t, uint32_t, uint32_t> SystemResourceParam;
+
+/**
+ * @brief Multi-producer / multi-consumer test of the system resource queues
+ *
+ * Test strategy:
+ * Producer threads post numbered items through a resource with fewer objects
+ * than items, so the empty and full queues wrap around many times, while
+ * consumer threads receive them. Each consumer exits on a stop item posted
+ * once the producers are done.
+ *
+ * Expect result:
+ * Every item is received exactly once, and each consumer receives the items
+ * of a producer in the order they were posted.
+ */
+class SystemResourceTest
+    : public ::testing::TestWithParam<SystemResourceParam> {
+  protected:
+    void run(uint32_t item_count) {
+        const uint32_t object_count = std::get<0>(GetParam());
+        const uint32_t producer_count = std::get<1>(GetParam());
+        const uint32_t consumer_count = std::get<2>(GetParam());
+
+        EbSystemResource *resource =
+            (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+        ASSERT_NE(resource, nullptr);
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_system_resource_ctor(resource,
+                                           object_count,
+                                           producer_count,
+                                           consumer_count,
+                                           test_item_creator,
+                                           NULL,
+                                           test_item_destroyer));
+
+        std::vector<ProducerContext> producers(producer_count);
+        std::vector<ConsumerContext> consumers(consumer_count);
+        std::vector<EbHandle> producer_threads(producer_count);
+        std::vector<EbHandle> consumer_threads(consumer_count);
+        for (uint32_t i = 0; i < consumer_count; ++i) {
+            consumers[i].full_fifo =
+                svt_system_resource_get_consumer_fifo(resource, i);
+            consumers[i].producer_count = producer_count;
+            consumers[i].received.resize(producer_count);
+            consumer_threads[i] =
+                svt_create_thread(consumer_kernel, &consumers[i]);
+            ASSERT_NE(consumer_threads[i], nullptr);
+        }
+        for (uint32_t i = 0; i < producer_count; ++i) {
+            producers[i].empty_fifo =
+                svt_system_resource_get_producer_fifo(resource, i);
+            producers[i].producer = i;
+            producers[i].item_count = item_count;
+            producer_threads[i] =
+                svt_create_thread(producer_kernel, &producers[i]);
+            ASSERT_NE(producer_threads[i], nullptr);
+        }
+        for (uint32_t i = 0; i < producer_count; ++i)
+            svt_destroy_thread(producer_threads[i]);
+
+        // One stop item per consumer, a consumer exits on the first it gets
+        for (uint32_t i = 0; i < consumer_count; ++i) {
+            EbObjectWrapper *wrapper;
+            svt_get_empty_object(producers[0].empty_fifo, &wrapper);
+            ((TestItem *)wrapper->object_ptr)->producer = kStopProducer;
+            svt_post_full_object(wrapper);
+        }
+        for (uint32_t i = 0; i < consumer_count; ++i)
+            svt_destroy_thread(consumer_threads[i]);
+
+        std::vector<uint32_t> hits(producer_count * item_count, 0);
+        for (uint32_t c = 0; c < consumer_count; ++c) {
+            for (uint32_t p = 0; p < producer_count; ++p) {
+                const std::vector<uint32_t> &seqs = consumers[c].received[p];
+                for (size_t i = 0; i < seqs.size(); ++i) {
+                    ASSERT_LT(seqs[i], item_count);
+                    if (i)
+                        ASSERT_LT(seqs[i - 1], seqs[i])
+                            << "consumer " << c << " producer " << p;
+                    hits[p * item_count + seqs[i]]++;
+                }
+            }
+        }
+        for (uint32_t i = 0; i < producer_count * item_count; ++i)
+            ASSERT_EQ(1u, hits[i]) << "producer " << i / item_count
+                                   << " item " << i % item_count;
+
+        resource->dctor(resource);
+        free(resource);
+    }
+};
+
+TEST_P(SystemResourceTest, MatchPostedItems) {
+    run(10000);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SystemResource, SystemResourceTest,
+    ::testing::Combine(::testing::Values(1, 3, 64), ::testing::Values(1, 4),
+                       ::testing::Values(1, 4)));
+
+typedef struct TokenConsumerContext {
+    EbFifo *full_fifo;
+    volatile int32_t *running;
+    volatile uint32_t *peak_running;
+    volatile int32_t *processed;
+} TokenConsumerContext;
+
+// Counts the consumers running a task and records the peak of the count
+static void *token_consumer_kernel(void *input_ptr) {
+    TokenConsumerContext *context = (TokenConsumerContext *)input_ptr;
+    for (;;) {
+        EbObjectWrapper *wrapper;
+        if (svt_get_full_object(context->full_fifo, &wrapper) != EB_ErrorNone)
+            break;
+        for (uint32_t part = 0; part < 2; ++part) {
+            const uint32_t running =
+                (uint32_t)(svt_atomic_fetch_add_i32(context->running, 1) + 1);
+            uint32_t peak = svt_atomic_load_u32(context->peak_running);
+            while (running > peak &&
+                   !svt_atomic_cas_u32(context->peak_running, peak, running))
+                peak = svt_atomic_load_u32(context->peak_running);
+            for (uint32_t i = 0; i < 2000; ++i)
+                svt_cpu_pause();
+            svt_atomic_fetch_add_i32(context->running, -1);
+            // Wait in the middle of the task, as a kernel blocked on another
+            if (!part) {
+                svt_yield_worker_token();
+                svt_resume_worker_token();
+            }
+        }
+        svt_atomic_fetch_add_i32(context->processed, 1);
+        svt_release_object(wrapper);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Worker token test of the system resource queues
+ *
+ * Test strategy:
+ * More consumer threads than worker tokens share the tokens, and yield their
+ * token in the middle of each task as a kernel does when it blocks on another
+ * kernel. The consumers exit on the shutdown of the resource.
+ *
+ * Expect result:
+ * No more consumers run a task at once than there are tokens, every item is
+ * processed, and all the tokens are back in the semaphore once the consumers
+ * have exited.
+ */
+TEST(WorkerTokenTest, RunningBoundedByTokens) {
+    const uint32_t token_count = 2;
+    const uint32_t consumer_count = 8;
+    const int32_t item_count = 2000;
+
+    EbSystemResource *resource =
+        (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+    ASSERT_NE(resource, nullptr);
+    ASSERT_EQ(EB_ErrorNone,
+              svt_system_resource_ctor(resource,
+                                       16,
+                                       1,
+                                       consumer_count,
+                                       test_item_creator,
+                                       NULL,
+                                       test_item_destroyer));
+    EbHandle tokens = svt_create_semaphore(token_count, token_count);
+    ASSERT_NE(tokens, nullptr);
+    svt_system_resource_set_worker_tokens(resource, tokens);
+
+    volatile int32_t running = 0, processed = 0;
+    volatile uint32_t peak_running = 0;
+    std::vector<TokenConsumerContext> consumers(consumer_count);
+    std::vector<EbHandle> consumer_threads(consumer_count);
+    for (uint32_t i = 0; i < consumer_count; ++i) {
+        consumers[i].full_fifo =
+            svt_system_resource_get_consumer_fifo(resource, i);
+        consumers[i].running = &running;
+        consumers[i].peak_running = &peak_running;
+        consumers[i].processed = &processed;
+        consumer_threads[i] =
+            svt_create_thread(token_consumer_kernel, &consumers[i]);
+        ASSERT_NE(consumer_threads[i], nullptr);
+    }
+
+    // The posting thread is not a kernel thread, it holds no token
+    EbFifo *empty_fifo = svt_system_resource_get_producer_fifo(resource, 0);
+    for (int32_t i = 0; i < item_count; ++i) {
+        EbObjectWrapper *wrapper;
+        svt_get_empty_object(empty_fifo, &wrapper);
+        svt_post_full_object(wrapper);
+    }
+    while (svt_atomic_fetch_add_i32(&processed, 0) < item_count)
+        svt_cpu_pause();
+    svt_shutdown_process(resource);
+    for (uint32_t i = 0; i < consumer_count; ++i)
+        svt_destroy_thread(consumer_threads[i]);
+
+    EXPECT_GE(peak_running, 1u);
+    EXPECT_LE(peak_running, token_count);
+    // A lost token would block here
+    for (uint32_t i = 0; i < token_count; ++i)
+        svt_block_on_semaphore(tokens);
+
+    svt_destroy_semaphore(tokens);
+    resource->dctor(resource);
+    free(resource);
+}
+
+}  // namespace
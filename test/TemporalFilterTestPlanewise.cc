@@ -967,6 +967,239 @@ INSTANTIATE_TEST_SUITE_P(
 
 #endif  // ARCH_AARCH64
 
+typedef void (*TemporalFilterZzFunc)(
+    struct MeContext *me_ctx, const uint8_t *y_pre, int y_pre_stride,
+    const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride,
+    unsigned int block_width, unsigned int block_height, int ss_x, int ss_y,
+    uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count,
+    uint32_t *v_accum, uint16_t *v_count);
+
+typedef void (*TemporalFilterZzFuncHbd)(
+    struct MeContext *me_ctx, const uint16_t *y_pre, int y_pre_stride,
+    const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride,
+    unsigned int block_width, unsigned int block_height, int ss_x, int ss_y,
+    uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count,
+    uint32_t *v_accum, uint16_t *v_count, uint32_t encoder_bit_depth);
+
+/* Zero-motion filter: the weight of each quarter of the 32x32 block comes from
+ * the ME block errors, so those are randomized along with the predictors and
+ * the accumulators the kernels add to. */
+template <typename Pixel>
+class TemporalFilterZzTestBase {
+  protected:
+    TemporalFilterZzTestBase() : rnd_(0, 65535) {
+    }
+
+    void Alloc() {
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            pred_[c] = reinterpret_cast<Pixel *>(
+                svt_aom_memalign(16, MAX_STRIDE * MAX_STRIDE * sizeof(Pixel)));
+            accum_ref_[c] = reinterpret_cast<uint32_t *>(svt_aom_memalign(
+                16, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)));
+            accum_tst_[c] = reinterpret_cast<uint32_t *>(svt_aom_memalign(
+                16, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)));
+            count_ref_[c] = reinterpret_cast<uint16_t *>(svt_aom_memalign(
+                16, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)));
+            count_tst_[c] = reinterpret_cast<uint16_t *>(svt_aom_memalign(
+                16, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)));
+            memset(pred_[c], 0, MAX_STRIDE * MAX_STRIDE * sizeof(Pixel));
+            memset(accum_ref_[c], 0, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t));
+            memset(accum_tst_[c], 0, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t));
+            memset(count_ref_[c], 0, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t));
+            memset(count_tst_[c], 0, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t));
+        }
+    }
+
+    void Free() {
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            svt_aom_free(pred_[c]);
+            svt_aom_free(accum_ref_[c]);
+            svt_aom_free(accum_tst_[c]);
+            svt_aom_free(count_ref_[c]);
+            svt_aom_free(count_tst_[c]);
+        }
+    }
+
+    void GenRandomData(MeContext *me_ctx, int bit_depth) {
+        me_ctx->tf_block_col = rnd_.Rand16() & 1;
+        me_ctx->tf_block_row = rnd_.Rand16() & 1;
+        // Small errors give the largest weights, large ones saturate the
+        // exponential table.
+        const uint32_t err_range = (rnd_.Rand16() & 1) ? 1 << 22 : 1 << 16;
+        for (int i = 0; i < 4; i++) {
+            me_ctx->tf_32x32_block_split_flag[i] = rnd_.Rand16() & 1;
+            me_ctx->tf_32x32_block_error[i] = Rand32() % (err_range << 2);
+        }
+        for (int i = 0; i < 16; i++)
+            me_ctx->tf_16x16_block_error[i] = Rand32() % err_range;
+        for (int c = 0; c < COLOR_CHANNELS; c++)
+            me_ctx->tf_decay_factor_fp16[c] = Rand32() % (1 << 26);
+
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            // Only the rows of the 32x32 block are read and written.
+            for (int i = 0; i < MAX_STRIDE * 32; i++) {
+                pred_[c][i] = rnd_.Rand16() & ((1 << bit_depth) - 1);
+                accum_ref_[c][i] = accum_tst_[c][i] = Rand32() % (1 << 24);
+                count_ref_[c][i] = count_tst_[c][i] = rnd_.Rand16() & 0x3fff;
+            }
+        }
+    }
+
+    void CheckOutput() {
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            ASSERT_EQ(memcmp(accum_ref_[c],
+                             accum_tst_[c],
+                             MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)),
+                      0)
+                << "accum mismatch in plane " << c;
+            ASSERT_EQ(memcmp(count_ref_[c],
+                             count_tst_[c],
+                             MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)),
+                      0)
+                << "count mismatch in plane " << c;
+        }
+    }
+
+    uint32_t Rand32() {
+        return ((uint32_t)rnd_.Rand16() << 16) | rnd_.Rand16();
+    }
+
+    SVTRandom rnd_;
+    Pixel *pred_[COLOR_CHANNELS];
+    uint32_t *accum_ref_[COLOR_CHANNELS];
+    uint32_t *accum_tst_[COLOR_CHANNELS];
+    uint16_t *count_ref_[COLOR_CHANNELS];
+    uint16_t *count_tst_[COLOR_CHANNELS];
+};
+
+class TemporalFilterTestZzPlanewiseMedium
+    : public ::testing::TestWithParam<TemporalFilterZzFunc>,
+      public TemporalFilterZzTestBase<uint8_t> {
+  public:
+    void SetUp() {
+        setup_test_env();
+        tst_func_ = GetParam();
+        Alloc();
+    }
+
+    void TearDown() {
+        Free();
+    }
+
+    void RunTest(int ss, int run_times) {
+        struct MeContext me_ctx;
+        memset(&me_ctx, 0, sizeof(me_ctx));
+        for (int j = 0; j < run_times; j++) {
+            GenRandomData(&me_ctx, 8);
+            me_ctx.tf_chroma = j & 1 ? 1 : (rnd_.Rand16() & 1);
+            svt_av1_apply_zz_based_temporal_filter_planewise_medium_c(
+                &me_ctx, pred_[C_Y], MAX_STRIDE, pred_[C_U], pred_[C_V],
+                MAX_STRIDE, 32, 32, ss, ss, accum_ref_[C_Y], count_ref_[C_Y],
+                accum_ref_[C_U], count_ref_[C_U], accum_ref_[C_V],
+                count_ref_[C_V]);
+            tst_func_(&me_ctx, pred_[C_Y], MAX_STRIDE, pred_[C_U], pred_[C_V],
+                      MAX_STRIDE, 32, 32, ss, ss, accum_tst_[C_Y],
+                      count_tst_[C_Y], accum_tst_[C_U], count_tst_[C_U],
+                      accum_tst_[C_V], count_tst_[C_V]);
+            CheckOutput();
+        }
+    }
+
+  private:
+    TemporalFilterZzFunc tst_func_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(
+    TemporalFilterTestZzPlanewiseMedium);
+
+TEST_P(TemporalFilterTestZzPlanewiseMedium, OperationCheck) {
+    RunTest(1, 100);
+    RunTest(0, 100);
+}
+
+class TemporalFilterTestZzPlanewiseMediumHbd
+    : public ::testing::TestWithParam<TemporalFilterZzFuncHbd>,
+      public TemporalFilterZzTestBase<uint16_t> {
+  public:
+    void SetUp() {
+        setup_test_env();
+        tst_func_ = GetParam();
+        Alloc();
+    }
+
+    void TearDown() {
+        Free();
+    }
+
+    void RunTest(int ss, int bit_depth, int run_times) {
+        struct MeContext me_ctx;
+        memset(&me_ctx, 0, sizeof(me_ctx));
+        for (int j = 0; j < run_times; j++) {
+            GenRandomData(&me_ctx, bit_depth);
+            me_ctx.tf_chroma = j & 1 ? 1 : (rnd_.Rand16() & 1);
+            svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_c(
+                &me_ctx, pred_[C_Y], MAX_STRIDE, pred_[C_U], pred_[C_V],
+                MAX_STRIDE, 32, 32, ss, ss, accum_ref_[C_Y], count_ref_[C_Y],
+                accum_ref_[C_U], count_ref_[C_U], accum_ref_[C_V],
+                count_ref_[C_V], bit_depth);
+            tst_func_(&me_ctx, pred_[C_Y], MAX_STRIDE, pred_[C_U], pred_[C_V],
+                      MAX_STRIDE, 32, 32, ss, ss, accum_tst_[C_Y],
+                      count_tst_[C_Y], accum_tst_[C_U], count_tst_[C_U],
+                      accum_tst_[C_V], count_tst_[C_V], bit_depth);
+            CheckOutput();
+        }
+    }
+
+  private:
+    TemporalFilterZzFuncHbd tst_func_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(
+    TemporalFilterTestZzPlanewiseMediumHbd);
+
+TEST_P(TemporalFilterTestZzPlanewiseMediumHbd, OperationCheck) {
+    for (int bit_depth = 10; bit_depth <= 12; bit_depth += 2) {
+        RunTest(1, bit_depth, 100);
+        RunTest(0, bit_depth, 100);
+    }
+}
+
+#ifdef ARCH_X86_64
+
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_1, TemporalFilterTestZzPlanewiseMedium,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_sse4_1));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TemporalFilterTestZzPlanewiseMedium,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_avx2));
+
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_1, TemporalFilterTestZzPlanewiseMediumHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_sse4_1));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TemporalFilterTestZzPlanewiseMediumHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_avx2));
+
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, TemporalFilterTestZzPlanewiseMedium,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_neon));
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, TemporalFilterTestZzPlanewiseMediumHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_neon));
+
+#endif  // ARCH_AARCH64
+
 typedef void (*get_final_filtered_pixels_fn)(
     struct MeContext *me_ctx, EbByte *src_center_ptr_start,
     uint16_t **altref_buffer_highbd_start, uint32_t **accum, uint16_t **count,
@@ -100,6 +100,8 @@ TEST(EncApiTest, check_null_pointer) {
     // return value, just feed nullptr as parameter. release output buffer with
     // null pointer
     svt_av1_enc_release_out_buffer(nullptr);
+    // reset encoder with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_reset(nullptr));
     // close encoder with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_deinit(nullptr));
     // destory encoder handle with null pointer
@@ -0,0 +1,451 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncEncodeTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, check the packets of short encodes
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+#include "SvtAv1EncApiTest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+typedef std::vector<std::vector<uint8_t>> PacketList;
+
+static const uint32_t kWidth = 176;
+static const uint32_t kHeight = 144;
+
+/** Fill a 8-bit 4:2:0 picture with a gradient moving with the picture index,
+ * plus some deterministic texture so that the search tools have work */
+static void fill_picture(std::vector<uint8_t> &buf, uint32_t index) {
+    const uint32_t chroma_width = kWidth >> 1, chroma_height = kHeight >> 1;
+    buf.resize(kWidth * kHeight + 2 * chroma_width * chroma_height);
+    uint8_t *luma = buf.data();
+    for (uint32_t y = 0; y < kHeight; ++y)
+        for (uint32_t x = 0; x < kWidth; ++x) {
+            const uint32_t hash = (x * 73856093u) ^ (y * 19349663u);
+            luma[y * kWidth + x] =
+                (uint8_t)(((x + 2 * index) * 3 + y * 2) % 200 + 16 +
+                          ((hash >> 7) & 7));
+        }
+    uint8_t *cb = luma + kWidth * kHeight;
+    uint8_t *cr = cb + chroma_width * chroma_height;
+    for (uint32_t y = 0; y < chroma_height; ++y)
+        for (uint32_t x = 0; x < chroma_width; ++x) {
+            cb[y * chroma_width + x] = (uint8_t)(96 + ((x + index) & 63));
+            cr[y * chroma_width + x] = (uint8_t)(160 - ((y + index) & 63));
+        }
+}
+
+/** Initialize an encoder for kWidth x kHeight 8-bit input, with the
+ * configuration tweaked by the caller */
+template <typename Config>
+static EbComponentType *create_encoder(SvtAv1Context &context,
+                                       Config config) {
+    memset(&context, 0, sizeof(context));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params))
+        << "svt_av1_enc_init_handle failed";
+    context.enc_params.source_width = kWidth;
+    context.enc_params.source_height = kHeight;
+    context.enc_params.encoder_bit_depth = 8;
+    context.enc_params.enc_mode = 8;
+    config(context.enc_params);
+    EXPECT_EQ(
+        EB_ErrorNone,
+        svt_av1_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "svt_av1_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+        << "svt_av1_enc_init failed";
+    return context.enc_handle;
+}
+
+static void destroy_encoder(SvtAv1Context &context) {
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+        << "svt_av1_enc_deinit failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+        << "svt_av1_enc_deinit_handle failed";
+}
+
+/** Send the picture filled in buf with the given pts */
+static void send_picture(EbComponentType *handle, std::vector<uint8_t> &buf,
+                         int64_t pts) {
+    EbSvtIOFormat pic;
+    memset(&pic, 0, sizeof(pic));
+    pic.luma = buf.data();
+    pic.cb = pic.luma + kWidth * kHeight;
+    pic.cr = pic.cb + (kWidth >> 1) * (kHeight >> 1);
+    pic.y_stride = kWidth;
+    pic.cb_stride = kWidth >> 1;
+    pic.cr_stride = kWidth >> 1;
+    pic.width = kWidth;
+    pic.height = kHeight;
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.size = sizeof(header);
+    header.p_buffer = (uint8_t *)&pic;
+    header.n_filled_len = (uint32_t)buf.size();
+    header.pts = pts;
+    header.pic_type = EB_AV1_INVALID_PICTURE;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &header));
+}
+
+/** Send an EOS and return the packets of the stream */
+static PacketList finish_stream(EbComponentType *handle) {
+    EbBufferHeaderType eos;
+    memset(&eos, 0, sizeof(eos));
+    eos.flags = EB_BUFFERFLAG_EOS;
+    eos.pic_type = EB_AV1_INVALID_PICTURE;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &eos));
+
+    PacketList packets;
+    for (;;) {
+        EbBufferHeaderType *packet = nullptr;
+        EbErrorType ret = svt_av1_enc_get_packet(handle, &packet, 1);
+        if (ret == EB_NoErrorEmptyQueue)
+            continue;
+        EXPECT_EQ(EB_ErrorNone, ret) << "svt_av1_enc_get_packet failed";
+        if (ret != EB_ErrorNone)
+            break;
+        const bool eos_reached = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+        if (packet->n_filled_len)
+            packets.push_back(std::vector<uint8_t>(
+                packet->p_buffer, packet->p_buffer + packet->n_filled_len));
+        svt_av1_enc_release_out_buffer(&packet);
+        if (eos_reached)
+            break;
+    }
+    return packets;
+}
+
+/** Send the pictures [first, first + count) with their index as pts, followed
+ * by an EOS, and return the packets of the stream */
+static PacketList encode_pictures(EbComponentType *handle, uint32_t first,
+                                  uint32_t count) {
+    std::vector<uint8_t> buf;
+    for (uint32_t i = 0; i < count; ++i) {
+        fill_picture(buf, first + i);
+        send_picture(handle, buf, first + i);
+    }
+    return finish_stream(handle);
+}
+
+/** Encode the pictures [first, first + count) with a new encoder */
+template <typename Config>
+static PacketList encode_stream(Config config, uint32_t first,
+                                uint32_t count) {
+    SvtAv1Context context;
+    EbComponentType *handle = create_encoder(context, config);
+    PacketList packets = encode_pictures(handle, first, count);
+    destroy_encoder(context);
+    return packets;
+}
+
+/** @brief dlf_segments_match_frame_search is an encode test case
+ * EncEncodeTest.dlf_segments_match_frame_search checks the DLF level search
+ * split in SB-row segments against the search on the whole picture
+ *
+ * Test strategy: <br>
+ * Encode the same pictures at a preset searching the DLF levels on the full
+ * picture, with one DLF thread (frame-level search) and with several DLF
+ * threads (segmented search).
+ *
+ * Expected result: <br>
+ * The packets are the same, so the filter levels picked are the same.
+ *
+ * Test coverage:
+ * svt_av1_pick_filter_level_segments_start, svt_av1_loop_filter_segment.
+ */
+TEST(EncEncodeTest, dlf_segments_match_frame_search) {
+    const uint32_t frames = 10;
+    const PacketList frame_search = encode_stream(
+        [](EbSvtAv1EncConfiguration &cfg) {
+            cfg.enc_mode = 5;
+            cfg.level_of_parallelism = 1;
+        },
+        0,
+        frames);
+    const PacketList segment_search = encode_stream(
+        [](EbSvtAv1EncConfiguration &cfg) {
+            cfg.enc_mode = 5;
+            cfg.level_of_parallelism = 6;
+        },
+        0,
+        frames);
+    ASSERT_EQ(frames, frame_search.size());
+    EXPECT_TRUE(frame_search == segment_search);
+}
+
+/** @brief reset_reencode_match is an encode test case
+ * EncEncodeTest.reset_reencode_match checks that a reset encoder starts a
+ * stream from scratch
+ *
+ * Test strategy: <br>
+ * Encode pictures to the EOS, reset the encoder and encode the same pictures
+ * again. Then send a few pictures without an EOS, reset and encode the
+ * pictures a third time.
+ *
+ * Expected result: <br>
+ * The packets of the second and third streams are the same as the first.
+ *
+ * Test coverage:
+ * svt_av1_enc_reset.
+ */
+TEST(EncEncodeTest, reset_reencode_match) {
+    const uint32_t frames = 12;
+    SvtAv1Context context;
+    EbComponentType *handle =
+        create_encoder(context, [](EbSvtAv1EncConfiguration &) {});
+    const PacketList first = encode_pictures(handle, 0, frames);
+    ASSERT_EQ(frames, first.size());
+
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(handle));
+    const PacketList second = encode_pictures(handle, 0, frames);
+    EXPECT_TRUE(first == second);
+
+    // Reset a stream still open
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(handle));
+    std::vector<uint8_t> buf;
+    for (uint32_t i = 0; i < 5; ++i) {
+        fill_picture(buf, 100 + i);
+        send_picture(handle, buf, i);
+    }
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(handle));
+    const PacketList third = encode_pictures(handle, 0, frames);
+    EXPECT_TRUE(first == third);
+
+    destroy_encoder(context);
+}
+
+/** @brief adaptive_threading_match is an encode test case
+ * EncEncodeTest.adaptive_threading_match checks an encode whose kernel
+ * threads share the worker tokens
+ *
+ * Test strategy: <br>
+ * Encode the same pictures with the fixed per-stage thread counts and with
+ * adaptive threading, where every stage has up to one thread per core and
+ * the threads take a worker token to run.
+ *
+ * Expected result: <br>
+ * The adaptive threading encode completes and its packets are the same.
+ *
+ * Test coverage:
+ * svt_yield_worker_token, svt_resume_worker_token.
+ */
+TEST(EncEncodeTest, adaptive_threading_match) {
+    const uint32_t frames = 10;
+    const PacketList fixed = encode_stream(
+        [](EbSvtAv1EncConfiguration &cfg) { cfg.level_of_parallelism = 3; },
+        0,
+        frames);
+    const PacketList adaptive = encode_stream(
+        [](EbSvtAv1EncConfiguration &cfg) {
+            cfg.level_of_parallelism = 3;
+            cfg.adaptive_threading = 1;
+        },
+        0,
+        frames);
+    ASSERT_EQ(frames, fixed.size());
+    EXPECT_TRUE(fixed == adaptive);
+}
+
+/** @brief parallel_segments_match_standalone is an encode test case
+ * EncEncodeTest.parallel_segments_match_standalone checks that the segments of
+ * a parallel segments encode do not depend on each other
+ *
+ * Test strategy: <br>
+ * Encode pictures with two segment encoders and segments of 8 pictures, with
+ * a partial last segment, then encode the pictures of each segment with a new
+ * encoder.
+ *
+ * Expected result: <br>
+ * The packets of the parallel encode are the packets of the standalone
+ * encodes in segment order.
+ *
+ * Test coverage:
+ * svt_aom_segments_send_picture, svt_aom_segments_get_packet.
+ */
+TEST(EncEncodeTest, parallel_segments_match_standalone) {
+    const uint32_t segment_length = 8;
+    const uint32_t frames = 3 * segment_length + 5;
+    const auto config = [](EbSvtAv1EncConfiguration &cfg) {
+        cfg.intra_period_length = segment_length - 1;
+    };
+    const PacketList parallel = encode_stream(
+        [&](EbSvtAv1EncConfiguration &cfg) {
+            config(cfg);
+            cfg.parallel_segments = 2;
+        },
+        0,
+        frames);
+    ASSERT_EQ(frames, parallel.size());
+
+    PacketList standalone;
+    for (uint32_t first = 0; first < frames; first += segment_length) {
+        const PacketList segment = encode_stream(
+            config, first, std::min(segment_length, frames - first));
+        standalone.insert(standalone.end(), segment.begin(), segment.end());
+    }
+    EXPECT_TRUE(parallel == standalone);
+}
+
+/** Pictures sent with zero_copy_input and the number of times each one was
+ * released, the callback runs on the encoder threads */
+typedef struct ZeroCopyFrames {
+    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<EbSvtIOFormat> pictures;
+    std::vector<uint32_t> releases;
+    uint32_t unknown_releases;
+    std::mutex mutex;
+} ZeroCopyFrames;
+
+static int count_release(EbExtFrameBuf *fb, void *private_data) {
+    ZeroCopyFrames *frames = (ZeroCopyFrames *)private_data;
+    std::lock_guard<std::mutex> lock(frames->mutex);
+    for (size_t i = 0; i < frames->pictures.size(); ++i) {
+        if (fb->buffer == (uint8_t *)&frames->pictures[i]) {
+            frames->releases[i]++;
+            return 0;
+        }
+    }
+    frames->unknown_releases++;
+    return 0;
+}
+
+/** Copy the picture filled in buf to the planes of pic */
+static void copy_picture(const std::vector<uint8_t> &buf,
+                         const EbSvtIOFormat &pic) {
+    const uint8_t *luma = buf.data();
+    const uint8_t *cb = luma + kWidth * kHeight;
+    const uint8_t *cr = cb + (kWidth >> 1) * (kHeight >> 1);
+    for (uint32_t y = 0; y < kHeight; ++y)
+        memcpy(pic.luma + y * pic.y_stride, luma + y * kWidth, kWidth);
+    for (uint32_t y = 0; y < (kHeight >> 1); ++y) {
+        memcpy(pic.cb + y * pic.cb_stride,
+               cb + y * (kWidth >> 1),
+               kWidth >> 1);
+        memcpy(pic.cr + y * pic.cr_stride,
+               cr + y * (kWidth >> 1),
+               kWidth >> 1);
+    }
+}
+
+/** @brief zero_copy_input_release is an encode test case
+ * EncEncodeTest.zero_copy_input_release checks the release of the pictures
+ * sent with zero_copy_input
+ *
+ * Test strategy: <br>
+ * Encode pictures with zero_copy_input, every other picture laid out as
+ * reported by SVT_AV1_STREAM_INFO_INPUT_LAYOUT, so read in place, the others
+ * with the strides of the picture, so copied. Encode the same pictures without
+ * zero_copy_input.
+ *
+ * Expected result: <br>
+ * release_input_frame is called once for every picture, the copied ones
+ * before svt_av1_enc_send_picture() returns, and the packets are the same.
+ *
+ * Test coverage:
+ * svt_av1_enc_send_picture, svt_av1_enc_get_stream_info.
+ */
+TEST(EncEncodeTest, zero_copy_input_release) {
+    const uint32_t frames = 12;
+    ZeroCopyFrames zero_copy;
+    zero_copy.unknown_releases = 0;
+    zero_copy.buffers.resize(frames);
+    zero_copy.pictures.resize(frames);
+    zero_copy.releases.assign(frames, 0);
+
+    SvtAv1Context context;
+    EbComponentType *handle =
+        create_encoder(context, [&](EbSvtAv1EncConfiguration &cfg) {
+            cfg.zero_copy_input = 1;
+            cfg.release_input_frame = count_release;
+            cfg.release_input_frame_private = &zero_copy;
+        });
+    EbSvtIOFormat layout;
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_get_stream_info(
+                  handle, SVT_AV1_STREAM_INFO_INPUT_LAYOUT, &layout));
+    ASSERT_GE(layout.width, kWidth + 2 * layout.org_x);
+    ASSERT_GE(layout.height, kHeight + 2 * layout.org_y);
+
+    std::vector<uint8_t> buf;
+    for (uint32_t i = 0; i < frames; ++i) {
+        fill_picture(buf, i);
+        EbSvtIOFormat &pic = zero_copy.pictures[i];
+        std::vector<uint8_t> &frame = zero_copy.buffers[i];
+        memset(&pic, 0, sizeof(pic));
+        if (i & 1) {
+            frame = buf;
+            pic.luma = frame.data();
+            pic.cb = pic.luma + kWidth * kHeight;
+            pic.cr = pic.cb + (kWidth >> 1) * (kHeight >> 1);
+            pic.y_stride = kWidth;
+            pic.cb_stride = kWidth >> 1;
+            pic.cr_stride = kWidth >> 1;
+        } else {
+            const size_t luma_size = (size_t)layout.y_stride * layout.height;
+            const size_t chroma_size =
+                (size_t)layout.cb_stride * (layout.height >> 1);
+            frame.assign(luma_size + 2 * chroma_size, 0);
+            const size_t chroma_offset =
+                (layout.org_y >> 1) * layout.cb_stride + (layout.org_x >> 1);
+            pic.luma =
+                frame.data() + layout.org_y * layout.y_stride + layout.org_x;
+            pic.cb = frame.data() + luma_size + chroma_offset;
+            pic.cr = frame.data() + luma_size + chroma_size + chroma_offset;
+            pic.y_stride = layout.y_stride;
+            pic.cb_stride = layout.cb_stride;
+            pic.cr_stride = layout.cr_stride;
+            copy_picture(buf, pic);
+        }
+        pic.width = kWidth;
+        pic.height = kHeight;
+
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.p_buffer = (uint8_t *)&pic;
+        header.n_filled_len = (uint32_t)buf.size();
+        header.pts = i;
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &header));
+        if (i & 1) {
+            std::lock_guard<std::mutex> lock(zero_copy.mutex);
+            EXPECT_EQ(1u, zero_copy.releases[i]) << "copied picture " << i;
+        }
+    }
+    const PacketList packets = finish_stream(handle);
+    destroy_encoder(context);
+
+    for (uint32_t i = 0; i < frames; ++i)
+        EXPECT_EQ(1u, zero_copy.releases[i]) << "picture " << i;
+    EXPECT_EQ(0u, zero_copy.unknown_releases);
+
+    const PacketList copied =
+        encode_stream([](EbSvtAv1EncConfiguration &) {}, 0, frames);
+    ASSERT_EQ(frames, packets.size());
+    EXPECT_TRUE(packets == copied);
+}
+
+}  // namespace
@@ -813,3 +813,71 @@ static const std::vector<EncTestSetting> generate_aq_mode_1_settings() {
 INSTANTIATE_TEST_SUITE_P(SEGMENTTEST, SegmentTest,
                          ::testing::ValuesIn(generate_aq_mode_1_settings()),
                          EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder benchmark of the huge page allocation of the picture
+ * buffers
+ *
+ * Test strategy:
+ * Encode the same test vectors with HugePages off then on, and report the
+ * speed of both encodes and the fps delta.
+ *
+ * Expected result:
+ * No error is reported in encoding progress.
+ *
+ * Test coverage:
+ * 720p test vector at presets 8 and 12
+ */
+class HugePagesBenchmark : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+    void post_process() override {
+        frame_count_ += video_src_->get_frame_count();
+        SvtAv1E2ETestFramework::post_process();
+    }
+    /** encode all the test vectors with the HugePages setting, returns the
+     * encoding speed in fps */
+    double run_fps(const char *huge_pages) {
+        static const char ENCODING[] = "encoding";
+        enc_setting.setting["HugePages"] = huge_pages;
+        frame_count_ = 0;
+        const uint64_t start_ms = collect_->read_count(ENCODING);
+        run_test();
+        const uint64_t enc_ms = collect_->read_count(ENCODING) - start_ms;
+        return enc_ms ? (double)frame_count_ * 1000 / enc_ms : 0;
+    }
+
+    uint32_t frame_count_ = 0;
+};
+
+TEST_P(HugePagesBenchmark, DISABLED_FpsDeltaTest) {
+    const double fps_off = run_fps("0");
+    const double fps_on = run_fps("1");
+    printf("HugePages: %.4f FPS off, %.4f FPS on, delta %+.2f%%\n",
+           fps_off,
+           fps_on,
+           fps_off > 0 ? (fps_on / fps_off - 1) * 100 : 0.0);
+}
+
+static const std::vector<EncTestSetting> generate_huge_pages_settings() {
+    static const std::string test_prefix = "HugePages_";
+    std::vector<EncTestSetting> settings;
+
+    static const EncSetting param_vecs[] = {{{"EncoderMode", "8"}},
+                                            {{"EncoderMode", "12"}}};
+    int count = 0;
+    for (EncSetting param : param_vecs) {
+        string name = test_prefix + std::to_string(count);
+        EncTestSetting setting{name, param, segment_test_vectors};
+        settings.push_back(setting);
+        count++;
+    }
+    return settings;
+}
+
+INSTANTIATE_TEST_SUITE_P(HUGEPAGESBENCHMARK, HugePagesBenchmark,
+                         ::testing::ValuesIn(generate_huge_pages_settings()),
+                         EncTestSetting::GetSettingName);
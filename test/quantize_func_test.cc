@@ -19,6 +19,7 @@
 
 #include "definitions.h"
 #include "pcs.h"
+#include "sequence_control_set.h"
 #include "transforms.h"
 #include "unit_test_utility.h"
 #include "q_matrices.h"
@@ -29,7 +30,24 @@ using svt_av1_test_tool::SVTRandom;
 extern "C" void svt_av1_build_quantizer(
     EbBitDepth bit_depth, int32_t y_dc_delta_q, int32_t u_dc_delta_q,
     int32_t u_ac_delta_q, int32_t v_dc_delta_q, int32_t v_ac_delta_q,
-    Quants *const quants, Dequants *const deq);
+    Quants *const quants, Dequants *const deq, PictureParentControlSet *pcs);
+
+// Build the quantizer tables with the default tune and sharpness, the picture
+// qindex only matters with a sharpness
+static void build_default_quantizer(EbBitDepth bit_depth, Quants *const quants,
+                                    Dequants *const deq) {
+    SequenceControlSet *scs =
+        static_cast<SequenceControlSet *>(calloc(1, sizeof(*scs)));
+    PictureParentControlSet *ppcs =
+        static_cast<PictureParentControlSet *>(calloc(1, sizeof(*ppcs)));
+    ASSERT_NE(scs, nullptr);
+    ASSERT_NE(ppcs, nullptr);
+    ppcs->scs = scs;
+    svt_av1_build_quantizer(bit_depth, 0, 0, 0, 0, 0, quants, deq, ppcs);
+    free(ppcs);
+    free(scs);
+}
+
 
 #define QUAN_PARAM_LIST                                                      \
     const TranLow *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,    \
@@ -99,8 +117,7 @@ class QuantizeTest : public ::testing::TestWithParam<ParamType> {
     }
 
     void InitQuantizer() {
-        svt_av1_build_quantizer(
-            bd_, 0, 0, 0, 0, 0, &qtab_->quant, &qtab_->dequant);
+        build_default_quantizer(bd_, &qtab_->quant, &qtab_->dequant);
     }
 
     virtual void QuantizeRun(bool is_loop, int q = 0, int test_num = 1) = 0;
@@ -974,6 +991,105 @@ INSTANTIATE_TEST_SUITE_P(AVX2, QuantizeQmTest,
 INSTANTIATE_TEST_SUITE_P(AVX2, QuantizeQmHbdTest,
                          ::testing::ValuesIn(kQmParamHbdArrayAvx2));
 #endif  // HAS_AVX2
+
+#if EN_AVX512_SUPPORT
+const QuantizeHbdParam kQHbdParamArrayAvx512[] = {
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_64X64), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_64X64), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_c,
+               &svt_av1_highbd_quantize_fp_avx512,
+               static_cast<TxSize>(TX_64X64), TYPE_FP, EB_TWELVE_BIT)};
+
+const QuantizeQmParam kQmParamArrayAvx512[] = {
+    make_tuple(&svt_av1_quantize_fp_qm_c, &svt_av1_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_quantize_fp_qm_c, &svt_av1_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_quantize_fp_qm_c, &svt_av1_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_quantize_fp_qm_c, &svt_av1_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_EIGHT_BIT),
+    make_tuple(&svt_av1_quantize_fp_qm_c, &svt_av1_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_EIGHT_BIT)};
+
+const QuantizeQmParam kQmParamHbdArrayAvx512[] = {
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_TEN_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X16), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_4X16), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_16X4), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_32X8), TYPE_FP, EB_TWELVE_BIT),
+    make_tuple(&svt_av1_highbd_quantize_fp_qm_c, &svt_av1_highbd_quantize_fp_qm_avx512,
+               static_cast<TxSize>(TX_8X32), TYPE_FP, EB_TWELVE_BIT)};
+
+INSTANTIATE_TEST_SUITE_P(AVX512, QuantizeHbdTest,
+                         ::testing::ValuesIn(kQHbdParamArrayAvx512));
+INSTANTIATE_TEST_SUITE_P(AVX512, QuantizeQmTest,
+                         ::testing::ValuesIn(kQmParamArrayAvx512));
+INSTANTIATE_TEST_SUITE_P(AVX512, QuantizeQmHbdTest,
+                         ::testing::ValuesIn(kQmParamHbdArrayAvx512));
+#endif  // EN_AVX512_SUPPORT
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "util.h"
+#include "acm_random.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+
+typedef int (*RansacFindInliersFunc)(const double *mat, const double *corners1,
+                                     const double *corners2, int npoints,
+                                     int *inlier_indices, double *sum_distance,
+                                     double *sum_distance_squared);
+
+// The SIMD versions must pick the same inliers and accumulate the same sums
+// as the C version, bit for bit, as the sums choose between the models.
+class RansacFindInliersTest
+    : public ::testing::TestWithParam<RansacFindInliersFunc> {
+  public:
+    void SetUp() override {
+        rnd_.Reset(ACMRandom::DeterministicSeed());
+        target_func_ = GetParam();
+    }
+
+  protected:
+    static const int kMaxPoints = 1024;
+
+    // Uniform value in [-range, range]
+    double RandRange(double range) {
+        return (rnd_.Rand16() / 65535.0 * 2 - 1) * range;
+    }
+
+    void RunCheckOutput(int num_iters) {
+        double corners1[2 * kMaxPoints], corners2[2 * kMaxPoints];
+        int inliers_ref[kMaxPoints], inliers_tst[kMaxPoints];
+        for (int iter = 0; iter < num_iters; ++iter) {
+            const int npoints = 1 + rnd_.PseudoUniform(kMaxPoints);
+            double mat[6];
+            mat[0] = RandRange(16);
+            mat[1] = RandRange(16);
+            mat[2] = 1 + RandRange(0.05);
+            mat[3] = RandRange(0.05);
+            mat[4] = RandRange(0.05);
+            mat[5] = 1 + RandRange(0.05);
+            for (int i = 0; i < npoints; ++i) {
+                const double x = rnd_.PseudoUniform(1920);
+                const double y = rnd_.PseudoUniform(1080);
+                corners1[2 * i] = x;
+                corners1[2 * i + 1] = y;
+                // Matches around the projection, about half of them inliers
+                corners2[2 * i] =
+                    (int)(mat[2] * x + mat[3] * y + mat[0] + RandRange(2));
+                corners2[2 * i + 1] =
+                    (int)(mat[4] * x + mat[5] * y + mat[1] + RandRange(2));
+            }
+            double sum_ref, sum_sq_ref, sum_tst, sum_sq_tst;
+            const int num_ref =
+                svt_av1_ransac_find_inliers_c(mat,
+                                              corners1,
+                                              corners2,
+                                              npoints,
+                                              inliers_ref,
+                                              &sum_ref,
+                                              &sum_sq_ref);
+            const int num_tst = target_func_(mat,
+                                             corners1,
+                                             corners2,
+                                             npoints,
+                                             inliers_tst,
+                                             &sum_tst,
+                                             &sum_sq_tst);
+            ASSERT_EQ(num_ref, num_tst) << "npoints " << npoints;
+            for (int i = 0; i < num_ref; ++i)
+                ASSERT_EQ(inliers_ref[i], inliers_tst[i]) << "inlier " << i;
+            ASSERT_EQ(sum_ref, sum_tst);
+            ASSERT_EQ(sum_sq_ref, sum_sq_tst);
+        }
+    }
+
+    ACMRandom rnd_;
+    RansacFindInliersFunc target_func_;
+};
+
+TEST_P(RansacFindInliersTest, CheckOutput) {
+    RunCheckOutput(1000);
+}
+
+INSTANTIATE_TEST_SUITE_P(AVX2, RansacFindInliersTest,
+                         ::testing::Values(svt_av1_ransac_find_inliers_avx2));
+
+}  // namespace